@@ -144,6 +144,7 @@ camera_metadata_t* CameraMetadata::release() {
     }
     camera_metadata_t *released = mBuffer;
     mBuffer = NULL;
+    invalidateHotKeyCache();
     return released;
 }
 
@@ -156,6 +157,7 @@ void CameraMetadata::clear() {
         free_camera_metadata(mBuffer);
         mBuffer = NULL;
     }
+    invalidateHotKeyCache();
 }
 
 void CameraMetadata::acquire(camera_metadata_t *buffer) {
@@ -191,6 +193,7 @@ status_t CameraMetadata::append(const camera_metadata_t* other) {
     size_t extraEntries = get_camera_metadata_entry_count(other);
     size_t extraData = get_camera_metadata_data_count(other);
     resizeIfNeeded(extraEntries, extraData);
+    invalidateHotKeyCache();
 
     return append_camera_metadata(mBuffer, other);
 }
@@ -214,6 +217,7 @@ status_t CameraMetadata::sort() {
         ALOGE("%s: CameraMetadata is locked", __FUNCTION__);
         return INVALID_OPERATION;
     }
+    invalidateHotKeyCache();
     return sort_camera_metadata(mBuffer);
 }
 
@@ -376,6 +380,7 @@ status_t CameraMetadata::updateImpl(uint32_t tag, const void *data,
             res = update_camera_metadata_entry(mBuffer,
                     entry.index, data, data_count, NULL);
         }
+        invalidateHotKeyCache();
     }
 
     if (res != OK) {
@@ -397,10 +402,63 @@ status_t CameraMetadata::updateImpl(uint32_t tag, const void *data,
 }
 
 bool CameraMetadata::exists(uint32_t tag) const {
+    size_t cachedIndex;
+    if (findCachedEntryIndex(tag, &cachedIndex)) {
+        return cachedIndex != kHotKeyAbsent;
+    }
     camera_metadata_ro_entry entry;
     return find_camera_metadata_ro_entry(mBuffer, tag, &entry) == 0;
 }
 
+void CameraMetadata::registerHotKeys(const uint32_t *tags, size_t count) {
+    mHotKeyTags.clear();
+    mHotKeyIndices.clear();
+    mHotKeyCacheValid = false;
+    if (tags == NULL) return;
+    for (size_t i = 0; i < count; i++) {
+        if (mHotKeyTags.size() >= kMaxHotKeys) {
+            ALOGW("%s: Only caching the first %zu of %zu hot keys",
+                    __FUNCTION__, kMaxHotKeys, count);
+            break;
+        }
+        // Skip duplicates so the cache holds one slot per tag.
+        size_t j = 0;
+        for (; j < mHotKeyTags.size(); j++) {
+            if (mHotKeyTags[j] == tags[i]) break;
+        }
+        if (j == mHotKeyTags.size()) {
+            mHotKeyTags.push_back(tags[i]);
+        }
+    }
+}
+
+bool CameraMetadata::findCachedEntryIndex(uint32_t tag, size_t *index) const {
+    if (mHotKeyTags.isEmpty() || mBuffer == NULL) {
+        return false;
+    }
+    if (CC_UNLIKELY( !mHotKeyCacheValid )) {
+        mHotKeyIndices.clear();
+        for (size_t i = 0; i < mHotKeyTags.size(); i++) {
+            camera_metadata_ro_entry entry;
+            status_t res = find_camera_metadata_ro_entry(
+                    mBuffer, mHotKeyTags[i], &entry);
+            mHotKeyIndices.push_back(res == OK ? entry.index : kHotKeyAbsent);
+        }
+        mHotKeyCacheValid = true;
+    }
+    for (size_t i = 0; i < mHotKeyTags.size(); i++) {
+        if (mHotKeyTags[i] == tag) {
+            *index = mHotKeyIndices[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void CameraMetadata::invalidateHotKeyCache() {
+    mHotKeyCacheValid = false;
+}
+
 camera_metadata_entry_t CameraMetadata::find(uint32_t tag) {
     status_t res;
     camera_metadata_entry entry;
@@ -409,7 +467,13 @@ camera_metadata_entry_t CameraMetadata::find(uint32_t tag) {
         entry.count = 0;
         return entry;
     }
-    res = find_camera_metadata_entry(mBuffer, tag, &entry);
+    size_t cachedIndex;
+    if (findCachedEntryIndex(tag, &cachedIndex)) {
+        res = (cachedIndex == kHotKeyAbsent) ? NAME_NOT_FOUND :
+                get_camera_metadata_entry(mBuffer, cachedIndex, &entry);
+    } else {
+        res = find_camera_metadata_entry(mBuffer, tag, &entry);
+    }
     if (CC_UNLIKELY( res != OK )) {
         entry.count = 0;
         entry.data.u8 = NULL;
@@ -420,7 +484,13 @@ camera_metadata_entry_t CameraMetadata::find(uint32_t tag) {
 camera_metadata_ro_entry_t CameraMetadata::find(uint32_t tag) const {
     status_t res;
     camera_metadata_ro_entry entry;
-    res = find_camera_metadata_ro_entry(mBuffer, tag, &entry);
+    size_t cachedIndex;
+    if (findCachedEntryIndex(tag, &cachedIndex)) {
+        res = (cachedIndex == kHotKeyAbsent) ? NAME_NOT_FOUND :
+                get_camera_metadata_ro_entry(mBuffer, cachedIndex, &entry);
+    } else {
+        res = find_camera_metadata_ro_entry(mBuffer, tag, &entry);
+    }
     if (CC_UNLIKELY( res != OK )) {
         entry.count = 0;
         entry.data.u8 = NULL;
@@ -447,6 +517,7 @@ status_t CameraMetadata::erase(uint32_t tag) {
         return res;
     }
     res = delete_camera_metadata_entry(mBuffer, entry.index);
+    invalidateHotKeyCache();
     if (res != OK) {
         ALOGE("%s: Error deleting entry %s.%s (%x): %s %d",
                 __FUNCTION__,
@@ -818,6 +889,9 @@ void CameraMetadata::swap(CameraMetadata& other) {
 
     other.mBuffer = thisBuf;
     mBuffer = otherBuf;
+
+    invalidateHotKeyCache();
+    other.invalidateHotKeyCache();
 }
 
 status_t CameraMetadata::getTagFromName(const char *name,
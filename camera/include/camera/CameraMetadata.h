@@ -214,6 +214,19 @@ class CameraMetadata: public Parcelable {
      */
     camera_metadata_ro_entry find(uint32_t tag) const;
 
+    /**
+     * Register a small set of tags that are looked up repeatedly on this
+     * object (e.g. once per capture result). find() and exists() serve these
+     * tags from a cached entry index instead of binary-searching the packed
+     * buffer on every call. The cache is rebuilt lazily after any operation
+     * that may restructure the buffer, so registration is safe at any point.
+     * At most kMaxHotKeys distinct tags are retained; extra tags fall back to
+     * the regular lookup path. Registration is per-object and is not carried
+     * over by copy or move.
+     */
+    static constexpr size_t kMaxHotKeys = 16;
+    void registerHotKeys(const uint32_t *tags, size_t count);
+
     /**
      * Delete metadata entry by tag
      */
@@ -308,6 +321,24 @@ class CameraMetadata: public Parcelable {
      */
     status_t resizeIfNeeded(size_t extraEntries, size_t extraData);
 
+    /**
+     * Entry indices for the tags registered via registerHotKeys(), rebuilt
+     * lazily on the first lookup after the buffer may have been restructured.
+     * kHotKeyAbsent marks a registered tag with no entry in the buffer.
+     */
+    static constexpr size_t kHotKeyAbsent = ~static_cast<size_t>(0);
+    mutable Vector<uint32_t> mHotKeyTags;
+    mutable Vector<size_t>   mHotKeyIndices;
+    mutable bool             mHotKeyCacheValid = false;
+
+    /**
+     * If tag is a registered hot key, write its cached entry index (or
+     * kHotKeyAbsent) to index and return true; rebuilds the cache first if
+     * necessary. Returns false for unregistered tags.
+     */
+    bool findCachedEntryIndex(uint32_t tag, size_t *index) const;
+
+    void invalidateHotKeyCache();
 };
 
 namespace hardware {
@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 
 #include <assert.h>
@@ -477,6 +481,124 @@ static status_t writeWinscopeMetadata(const Vector<std::int64_t>& timestampsMono
     return AMediaMuxer_writeSampleData(muxer, metaTrackIdx, buffer->data(), &bufferInfo);
 }
 
+/*
+ * Hands encoded samples from the encoder drain loop to the muxer on a
+ * dedicated thread.  AMediaMuxer_writeSampleData() can stall on filesystem
+ * writeback; if that happens on the drain loop the encoder runs out of
+ * output buffers and SurfaceFlinger drops frames.  Samples are copied out
+ * of the codec buffer so it can be released back to the encoder right away,
+ * and the queue is bounded so a persistently slow disk applies backpressure
+ * instead of exhausting memory.
+ */
+class MuxerWriter {
+public:
+    explicit MuxerWriter(AMediaMuxer* muxer) : mMuxer(muxer) {}
+
+    ~MuxerWriter() {
+        stop();
+    }
+
+    // Must be called after AMediaMuxer_start(), before the first write().
+    void start(ssize_t trackIdx) {
+        mTrackIdx = trackIdx;
+        mThread = std::thread(&MuxerWriter::threadLoop, this);
+    }
+
+    // Copies the sample and queues it for the writer thread.  Blocks only
+    // if the queue is full.  Returns the first write error, if any.
+    status_t write(const uint8_t* data, size_t size, int64_t ptsUsec,
+            uint32_t flags) {
+        sp<ABuffer> copy = new ABuffer(size);
+        memcpy(copy->data(), data, size);
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (mErr == NO_ERROR && mQueuedBytes + size > kMaxQueuedBytes) {
+            mNotFullCondition.wait(lock);
+        }
+        if (mErr != NO_ERROR) {
+            return mErr;
+        }
+        mQueue.push_back({copy, ptsUsec, flags});
+        mQueuedBytes += size;
+        mNotEmptyCondition.notify_one();
+        return NO_ERROR;
+    }
+
+    // Waits until all queued samples have been written and joins the
+    // thread.  Idempotent; returns the first write error, if any.
+    status_t stop() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopRequested = true;
+            mNotEmptyCondition.notify_one();
+        }
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+        return mErr;
+    }
+
+private:
+    struct Sample {
+        sp<ABuffer> data;
+        int64_t ptsUsec;
+        uint32_t flags;
+    };
+
+    // Roughly two seconds of video at a generous 80Mbps before the drain
+    // loop blocks waiting for the disk to catch up.
+    static const size_t kMaxQueuedBytes = 20 * 1024 * 1024;
+
+    void threadLoop() {
+        for (;;) {
+            Sample sample;
+            bool skipWrite;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                while (mQueue.empty() && !mStopRequested) {
+                    mNotEmptyCondition.wait(lock);
+                }
+                if (mQueue.empty()) {
+                    break;      // stopped and fully drained
+                }
+                sample = mQueue.front();
+                mQueue.pop_front();
+                mQueuedBytes -= sample.data->size();
+                skipWrite = (mErr != NO_ERROR);
+                mNotFullCondition.notify_one();
+            }
+            if (skipWrite) {
+                continue;       // discard the backlog after an error
+            }
+            ATRACE_NAME("write sample");
+            AMediaCodecBufferInfo bufferInfo = {
+                0 /* offset */,
+                static_cast<int32_t>(sample.data->size()),
+                sample.ptsUsec /* presentationTimeUs */,
+                sample.flags
+            };
+            status_t err = AMediaMuxer_writeSampleData(mMuxer, mTrackIdx,
+                    sample.data->data(), &bufferInfo);
+            if (err != NO_ERROR) {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mErr = err;
+                mNotFullCondition.notify_all();
+            }
+        }
+    }
+
+    AMediaMuxer* const mMuxer;
+    ssize_t mTrackIdx = -1;
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mNotEmptyCondition;
+    std::condition_variable mNotFullCondition;
+    std::deque<Sample> mQueue;
+    size_t mQueuedBytes = 0;
+    bool mStopRequested = false;
+    status_t mErr = NO_ERROR;
+};
+
 /*
  * Runs the MediaCodec encoder, sending the output to the MediaMuxer.  The
  * input frames are coming from the virtual display as fast as SurfaceFlinger
@@ -499,6 +621,8 @@ static status_t runEncoder(const sp<MediaCodec>& encoder,
     int64_t endWhenNsec = startWhenNsec + seconds_to_nanoseconds(gTimeLimitSec);
     Vector<int64_t> timestampsMonotonicUs;
     bool firstFrame = true;
+    int64_t lastOrientationCheckNsec = 0;
+    MuxerWriter muxerWriter(muxer);
 
     assert((rawFp == NULL && muxer != NULL) || (rawFp != NULL && muxer == NULL));
 
@@ -547,12 +671,18 @@ static status_t runEncoder(const sp<MediaCodec>& encoder,
                 ALOGV("Got data in buffer %zu, size=%zu, pts=%" PRId64,
                         bufIndex, size, ptsUsec);
 
-                { // scope
+                int64_t nowNsec = systemTime(CLOCK_MONOTONIC);
+                if (nowNsec - lastOrientationCheckNsec >= ms2ns(250)) {
                     ATRACE_NAME("orientation");
+                    lastOrientationCheckNsec = nowNsec;
                     // Check orientation, update if it has changed.
                     //
                     // Polling for changes is inefficient and wrong, but the
                     // useful stuff is hard to get at without a Dalvik VM.
+                    // Each check is a binder round-trip to SurfaceFlinger, so
+                    // don't pay for one on every frame; rotations are rare and
+                    // a quarter second of stale projection hides inside the
+                    // rotation animation.
                     ui::DisplayState displayState;
                     err = SurfaceComposerClient::getDisplayState(display, &displayState);
                     if (err != NO_ERROR) {
@@ -587,20 +717,13 @@ static status_t runEncoder(const sp<MediaCodec>& encoder,
                     // need to pass either the full set of BufferInfo flags, or
                     // (flags & BUFFER_FLAG_SYNCFRAME).
                     //
-                    // If this blocks for too long we could drop frames.  We may
-                    // want to queue these up and do them on a different thread.
-                    ATRACE_NAME("write sample");
+                    // Hand the sample to the writer thread so a slow disk
+                    // doesn't stall the drain loop and drop frames.  This
+                    // blocks only if the writer's queue is full.
+                    ATRACE_NAME("queue sample");
                     assert(trackIdx != -1);
-                    // TODO
-                    sp<ABuffer> buffer = new ABuffer(
-                            buffers[bufIndex]->data(), buffers[bufIndex]->size());
-                    AMediaCodecBufferInfo bufferInfo = {
-                        0 /* offset */,
-                        static_cast<int32_t>(buffer->size()),
-                        ptsUsec /* presentationTimeUs */,
-                        flags
-                    };
-                    err = AMediaMuxer_writeSampleData(muxer, trackIdx, buffer->data(), &bufferInfo);
+                    err = muxerWriter.write(buffers[bufIndex]->data() + offset,
+                            size, ptsUsec, flags);
                     if (err != NO_ERROR) {
                         fprintf(stderr,
                             "Failed writing data to muxer (err=%d)\n", err);
@@ -650,6 +773,7 @@ static status_t runEncoder(const sp<MediaCodec>& encoder,
                         fprintf(stderr, "Unable to start muxer (err=%d)\n", err);
                         return err;
                     }
+                    muxerWriter.start(trackIdx);
                 }
             }
             break;
@@ -673,6 +797,14 @@ static status_t runEncoder(const sp<MediaCodec>& encoder,
         }
     }
 
+    // Flush any queued samples before touching the muxer from this thread
+    // again (for the winscope tracks below and the caller's muxer stop).
+    err = muxerWriter.stop();
+    if (err != NO_ERROR) {
+        fprintf(stderr, "Failed writing data to muxer (err=%d)\n", err);
+        return err;
+    }
+
     ALOGV("Encoder stopping (req=%d)", gStopRequested);
     if (gVerbose) {
         printf("Encoder stopping; recorded %u frames in %" PRId64 " seconds\n",
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <errno.h>
 #include <inttypes.h>
 #include <fcntl.h>
+#include <sched.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
@@ -82,10 +84,13 @@ static bool gForceToUseHardwareCodec;
 static bool gPlaybackAudio;
 static bool gWriteMP4;
 static bool gDisplayHistogram;
+static bool gJsonOutput;
+static long gPinnedCpu;     // if not -1, pin decoding to this cpu.
 static bool gVerbose = false;
 static bool showProgress = true;
 static String8 gWriteMP4Filename;
 static String8 gComponentNameOverride;
+static String8 gBenchmarkInputName;  // identifies the input in -j output
 
 static sp<ANativeWindow> gSurface;
 
@@ -100,6 +105,11 @@ static int CompareIncreasing(const int64_t *a, const int64_t *b) {
     return (*a) < (*b) ? -1 : (*a) > (*b) ? 1 : 0;
 }
 
+// Expects "sortedTimesUs" to be sorted in increasing order.
+static int64_t percentileUs(const Vector<int64_t> &sortedTimesUs, int pct) {
+    return sortedTimesUs.itemAt((sortedTimesUs.size() - 1) * pct / 100);
+}
+
 static void displayDecodeHistogram(Vector<int64_t> *decodeTimesUs) {
     printf("decode times:\n");
 
@@ -111,6 +121,10 @@ static void displayDecodeHistogram(Vector<int64_t> *decodeTimesUs) {
 
     printf("min decode time %" PRId64 " us (%.2f secs)\n", minUs, minUs / 1E6);
     printf("max decode time %" PRId64 " us (%.2f secs)\n", maxUs, maxUs / 1E6);
+    printf("p50/p90/p99 decode time %" PRId64 "/%" PRId64 "/%" PRId64 " us\n",
+           percentileUs(*decodeTimesUs, 50),
+           percentileUs(*decodeTimesUs, 90),
+           percentileUs(*decodeTimesUs, 99));
 
     size_t counts[100];
     for (size_t i = 0; i < 100; ++i) {
@@ -353,7 +367,7 @@ static void playSource(sp<MediaSource> &source) {
             }
 
             if (buffer->range_length() > 0) {
-                if (gDisplayHistogram && n > 0) {
+                if ((gDisplayHistogram || gJsonOutput) && n > 0) {
                     // Ignore the first time since it includes some setup
                     // cost.
                     decodeTimesUs.push(delayDecodeUs);
@@ -397,9 +411,40 @@ static void playSource(sp<MediaSource> &source) {
     }
 
     rawSource->stop();
-    printf("\n");
+    if (showProgress) {
+        printf("\n");
+    }
 
     int64_t delay = getNowUs() - startTime;
+
+    if (gJsonOutput) {
+        // One object per line so batch runs over a corpus can be collected
+        // with a shell loop and fed straight to a regression checker.
+        printf("{\"input\": \"%s\", \"mime\": \"%s\", \"repetitions\": %ld"
+               ", \"frames\": %d, \"total_bytes\": %" PRId64
+               ", \"elapsed_us\": %" PRId64,
+               gBenchmarkInputName.string(), mime, gNumRepetitions, n, totalBytes, delay);
+        if (!strncasecmp("video/", mime, 6) && delay > 0) {
+            printf(", \"avg_fps\": %.2f", n * 1E6 / delay);
+        }
+        if (n > 0) {
+            printf(", \"avg_read_us\": %.2f", (double)sumDecodeUs / n);
+        }
+        if (!decodeTimesUs.isEmpty()) {
+            decodeTimesUs.sort(CompareIncreasing);
+            printf(", \"read_us\": {\"min\": %" PRId64 ", \"p50\": %" PRId64
+                   ", \"p90\": %" PRId64 ", \"p99\": %" PRId64
+                   ", \"max\": %" PRId64 "}",
+                   decodeTimesUs.itemAt(0),
+                   percentileUs(decodeTimesUs, 50),
+                   percentileUs(decodeTimesUs, 90),
+                   percentileUs(decodeTimesUs, 99),
+                   decodeTimesUs.itemAt(decodeTimesUs.size() - 1));
+        }
+        printf("}\n");
+        return;
+    }
+
     if (!strncasecmp("video/", mime, 6)) {
         printf("avg. %.2f fps\n", n * 1E6 / delay);
 
@@ -646,6 +691,10 @@ static void usage(const char *me) {
     fprintf(stderr, "       -N(ame) of the component\n");
     fprintf(stderr, "       -x display a histogram of decoding times/fps "
                     "(video only)\n");
+    fprintf(stderr, "       -j print decode stats as one JSON object per "
+                    "input (implies -q)\n");
+    fprintf(stderr, "       -c cpu pin this process to the given cpu for "
+                    "reproducible timing\n");
     fprintf(stderr, "       -q don't show progress indicator\n");
     fprintf(stderr, "       -S allocate buffers from a surface\n");
     fprintf(stderr, "       -T allocate buffers from a surface texture\n");
@@ -805,11 +854,13 @@ int main(int argc, char **argv) {
     gPlaybackAudio = false;
     gWriteMP4 = false;
     gDisplayHistogram = false;
+    gJsonOutput = false;
+    gPinnedCpu = -1;
 
     sp<android::ALooper> looper;
 
     int res;
-    while ((res = getopt(argc, argv, "vhaqn:lm:b:itsrow:kN:xSTd:D:P:")) >= 0) {
+    while ((res = getopt(argc, argv, "vhaqn:lm:b:itsrow:kN:xSTd:D:P:jc:")) >= 0) {
         switch (res) {
             case 'a':
             {
@@ -924,6 +975,27 @@ int main(int argc, char **argv) {
                 break;
             }
 
+            case 'j':
+            {
+                gJsonOutput = true;
+                showProgress = false;
+                break;
+            }
+
+            case 'c':
+            {
+                char *end;
+                long x = strtol(optarg, &end, 10);
+
+                if (*end != '\0' || end == optarg || x < 0) {
+                    fprintf(stderr, "invalid cpu '%s'\n", optarg);
+                    exit(1);
+                }
+
+                gPinnedCpu = x;
+                break;
+            }
+
             case 'S':
             {
                 useSurfaceAlloc = true;
@@ -958,6 +1030,21 @@ int main(int argc, char **argv) {
         gPlaybackAudio = false;
     }
 
+    if (gPinnedCpu >= 0) {
+        // Pin the whole process so extraction and in-process (software)
+        // decoding run on one core; this takes cpufreq migration noise out
+        // of benchmark numbers. Codecs running in a remote codec process
+        // are unaffected.
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(gPinnedCpu, &set);
+        if (sched_setaffinity(0 /* this process */, sizeof(set), &set) != 0) {
+            fprintf(stderr, "unable to pin to cpu %ld: %s\n",
+                    gPinnedCpu, strerror(errno));
+            return 1;
+        }
+    }
+
     argc -= optind;
     argv += optind;
 
@@ -1290,6 +1377,7 @@ int main(int argc, char **argv) {
         } else if (seekTest) {
             performSeekTest(mediaSource);
         } else {
+            gBenchmarkInputName.setTo(filename);
             playSource(mediaSource);
         }
     }
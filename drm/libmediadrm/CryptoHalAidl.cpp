@@ -27,6 +27,7 @@
 #include <media/stagefright/foundation/hexdump.h>
 #include <mediadrm/CryptoHalAidl.h>
 #include <mediadrm/DrmUtils.h>
+#include <utils/Timers.h>
 
 using ::aidl::android::hardware::drm::CryptoSchemes;
 using DestinationBufferAidl = ::aidl::android::hardware::drm::DestinationBuffer;
@@ -218,6 +219,8 @@ status_t CryptoHalAidl::destroyPlugin() {
         return mInitCheck;
     }
 
+    mDecryptTimeUs.ReportToMediaMetrics("mediadrm.decrypt");
+
     mPlugin.reset();
     mInitCheck = NO_INIT;
     return OK;
@@ -304,12 +307,10 @@ ssize_t CryptoHalAidl::decrypt(const uint8_t keyId[16], const uint8_t iv[16],
     aPattern.encryptBlocks = pattern.mEncryptBlocks;
     aPattern.skipBlocks = pattern.mSkipBlocks;
 
-    std::vector<SubSample> stdSubSamples;
+    std::vector<SubSample> stdSubSamples(numSubSamples);
     for (size_t i = 0; i < numSubSamples; i++) {
-        SubSample subSample;
-        subSample.numBytesOfClearData = subSamples[i].mNumBytesOfClearData;
-        subSample.numBytesOfEncryptedData = subSamples[i].mNumBytesOfEncryptedData;
-        stdSubSamples.push_back(subSample);
+        stdSubSamples[i].numBytesOfClearData = subSamples[i].mNumBytesOfClearData;
+        stdSubSamples[i].numBytesOfEncryptedData = subSamples[i].mNumBytesOfEncryptedData;
     }
 
     bool secure;
@@ -350,7 +351,9 @@ ssize_t CryptoHalAidl::decrypt(const uint8_t keyId[16], const uint8_t iv[16],
 
 
     int32_t result = 0;
+    nsecs_t startTimeNs = systemTime();
     ::ndk::ScopedAStatus statusAidl = mPlugin->decrypt(args, &result);
+    mDecryptTimeUs.Record(ns2us(systemTime() - startTimeNs));
 
     err = statusAidlToStatusT(statusAidl);
     std::string msgStr(statusAidl.getMessage());
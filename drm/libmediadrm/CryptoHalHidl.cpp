@@ -29,6 +29,7 @@
 #include <media/stagefright/foundation/hexdump.h>
 #include <mediadrm/CryptoHalHidl.h>
 #include <mediadrm/DrmUtils.h>
+#include <utils/Timers.h>
 
 using drm::V1_0::BufferType;
 using drm::V1_0::DestinationBuffer;
@@ -188,6 +189,8 @@ status_t CryptoHalHidl::destroyPlugin() {
         return mInitCheck;
     }
 
+    mDecryptTimeUs.ReportToMediaMetrics("mediadrm.decrypt");
+
     mPlugin.clear();
     mPluginV1_2.clear();
     mInitCheck = NO_INIT;
@@ -306,14 +309,15 @@ ssize_t CryptoHalHidl::decrypt(const uint8_t keyId[16], const uint8_t iv[16],
     hPattern.encryptBlocks = pattern.mEncryptBlocks;
     hPattern.skipBlocks = pattern.mSkipBlocks;
 
-    std::vector<SubSample> stdSubSamples;
+    // Fill the hidl_vec in place: going through an intermediate std::vector
+    // cost a second allocation and a copy of the descriptors on every decrypt
+    // call.
+    hidl_vec<SubSample> hSubSamples;
+    hSubSamples.resize(numSubSamples);
     for (size_t i = 0; i < numSubSamples; i++) {
-        SubSample subSample;
-        subSample.numBytesOfClearData = subSamples[i].mNumBytesOfClearData;
-        subSample.numBytesOfEncryptedData = subSamples[i].mNumBytesOfEncryptedData;
-        stdSubSamples.push_back(subSample);
+        hSubSamples[i].numBytesOfClearData = subSamples[i].mNumBytesOfClearData;
+        hSubSamples[i].numBytesOfEncryptedData = subSamples[i].mNumBytesOfEncryptedData;
     }
-    auto hSubSamples = hidl_vec<SubSample>(stdSubSamples);
 
     bool secure;
     if (hDestination.type == BufferType::SHARED_MEMORY) {
@@ -340,6 +344,7 @@ ssize_t CryptoHalHidl::decrypt(const uint8_t keyId[16], const uint8_t iv[16],
     Return<void> hResult;
 
     mLock.unlock();
+    nsecs_t startTimeNs = systemTime();
     if (mPluginV1_2 != NULL) {
         hResult = mPluginV1_2->decrypt_1_2(
                 secure, toHidlArray16(keyId), toHidlArray16(iv), hMode, hPattern, hSubSamples,
@@ -368,6 +373,8 @@ ssize_t CryptoHalHidl::decrypt(const uint8_t keyId[16], const uint8_t iv[16],
                 });
     }
 
+    mDecryptTimeUs.Record(ns2us(systemTime() - startTimeNs));
+
     err = hResult.isOk() ? err : DEAD_OBJECT;
     if (err == OK) {
         return bytesWritten;
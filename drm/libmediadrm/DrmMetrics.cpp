@@ -18,6 +18,7 @@
 #include <utility>
 
 #include <android-base/macros.h>
+#include <media/MediaMetrics.h>
 #include <media/stagefright/foundation/base64.h>
 #include <mediadrm/DrmMetrics.h>
 #include <sys/time.h>
@@ -48,6 +49,68 @@ std::string ToHexString(const android::Vector<uint8_t> &sessionId) {
 
 namespace android {
 
+void DrmLatencyHistogram::Record(int64_t durationUs) {
+    if (durationUs < 0) {
+        durationUs = 0;
+    }
+    size_t bucket = 0;
+    while (bucket + 1 < kNumBuckets && durationUs >= (int64_t(1) << (bucket + 1))) {
+        bucket++;
+    }
+    mBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mTotalUs.fetch_add(durationUs, std::memory_order_relaxed);
+}
+
+int64_t DrmLatencyHistogram::GetAverageUs() const {
+    int64_t count = mCount.load(std::memory_order_relaxed);
+    if (count == 0) {
+        return 0;
+    }
+    return mTotalUs.load(std::memory_order_relaxed) / count;
+}
+
+int64_t DrmLatencyHistogram::GetPercentileUs(int percentile) const {
+    // Take a relaxed snapshot of the buckets; concurrent Record() calls may
+    // land before or after the snapshot, either of which is acceptable for
+    // an approximate percentile.
+    int64_t counts[kNumBuckets];
+    int64_t total = 0;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        counts[i] = mBuckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    int64_t target = (total * percentile + 99) / 100;
+    int64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            return int64_t(1) << (i + 1);
+        }
+    }
+    return int64_t(1) << kNumBuckets;
+}
+
+void DrmLatencyHistogram::ReportToMediaMetrics(const char* name) const {
+    int64_t count = GetCount();
+    if (count == 0) {
+        return;
+    }
+    mediametrics_handle_t item(mediametrics_create(name));
+    mediametrics_setInt64(item, "count", count);
+    mediametrics_setInt64(item, "average_time_us", GetAverageUs());
+    mediametrics_setInt64(item, "p50_time_us", GetPercentileUs(50));
+    mediametrics_setInt64(item, "p90_time_us", GetPercentileUs(90));
+    mediametrics_setInt64(item, "p99_time_us", GetPercentileUs(99));
+    if (!mediametrics_selfRecord(item)) {
+        ALOGE("%s: selfrecord() returned false", __func__);
+    }
+    mediametrics_delete(item);
+}
+
 MediaDrmMetrics::MediaDrmMetrics()
     : mOpenSessionCounter("drm.mediadrm.open_session", "status"),
       mCloseSessionCounter("drm.mediadrm.close_session", "status"),
@@ -19,6 +19,7 @@
 
 #include <aidl/android/hardware/drm/ICryptoPlugin.h>
 #include <aidl/android/hardware/drm/IDrmFactory.h>
+#include <mediadrm/DrmMetrics.h>
 #include <mediadrm/ICrypto.h>
 #include <utils/KeyedVector.h>
 #include <utils/threads.h>
@@ -76,6 +77,14 @@ struct CryptoHalAidl : public ICrypto {
     KeyedVector<int32_t, size_t> mHeapSizes;
     int32_t mHeapSeqNum;
 
+    /**
+     * Latency of the plugin decrypt() round trip. Recording uses only
+     * relaxed atomics, so it does not add contention between concurrent
+     * decrypt calls; the histogram is published through mediametrics when
+     * the plugin is destroyed.
+     */
+    DrmLatencyHistogram mDecryptTimeUs;
+
     std::shared_ptr<ICryptoPluginAidl> makeCryptoPlugin(
             const std::shared_ptr<IDrmFactoryAidl>& factory, const Uuid& uuidAidl,
             const std::vector<uint8_t> initData);
@@ -23,6 +23,7 @@
 #include <android/hardware/drm/1.2/ICryptoPlugin.h>
 #include <android/hardware/drm/1.4/ICryptoPlugin.h>
 
+#include <mediadrm/DrmMetrics.h>
 #include <mediadrm/ICrypto.h>
 #include <utils/KeyedVector.h>
 #include <utils/threads.h>
@@ -91,6 +92,14 @@ private:
     KeyedVector<int32_t, size_t> mHeapSizes;
     int32_t mHeapSeqNum;
 
+    /**
+     * Latency of the plugin decrypt() round trip. Recording uses only
+     * relaxed atomics, so it does not add contention between concurrent
+     * decrypt calls; the histogram is published through mediametrics when
+     * the plugin is destroyed.
+     */
+    DrmLatencyHistogram mDecryptTimeUs;
+
     Vector<sp<ICryptoFactory>> makeCryptoFactories();
     sp<ICryptoPlugin> makeCryptoPlugin(const sp<ICryptoFactory>& factory,
             const uint8_t uuid[16], const void *initData, size_t size);
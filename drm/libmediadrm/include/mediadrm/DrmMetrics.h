@@ -17,6 +17,7 @@
 #ifndef DRM_METRICS_H_
 #define DRM_METRICS_H_
 
+#include <atomic>
 #include <map>
 
 #include <android/hardware/drm/1.0/types.h>
@@ -29,6 +30,44 @@
 
 namespace android {
 
+/**
+ * A lock-free histogram of operation latencies.
+ *
+ * Record() performs only relaxed atomic increments, so samples can be taken
+ * on hot paths (e.g. per decrypt call) without adding a lock that other
+ * threads could contend on. Buckets cover power-of-two microsecond ranges,
+ * so percentiles computed on export are approximate: they round up to the
+ * enclosing bucket boundary.
+ */
+class DrmLatencyHistogram {
+ public:
+  // Bucket i counts samples in [2^i, 2^(i+1)) microseconds; the last bucket
+  // absorbs everything longer.
+  static constexpr size_t kNumBuckets = 16;
+
+  // Adds one sample. Safe to call concurrently from any thread.
+  void Record(int64_t durationUs);
+
+  // Number of samples recorded so far.
+  int64_t GetCount() const { return mCount.load(std::memory_order_relaxed); }
+
+  // Mean latency in microseconds, or 0 if nothing was recorded.
+  int64_t GetAverageUs() const;
+
+  // Approximate latency percentile (0-100) in microseconds, rounded up to
+  // the enclosing bucket boundary. Returns 0 if nothing was recorded.
+  int64_t GetPercentileUs(int percentile) const;
+
+  // Publishes count, average and p50/p90/p99 latencies as a mediametrics
+  // item with the given name. No-op if nothing was recorded.
+  void ReportToMediaMetrics(const char* name) const;
+
+ private:
+  std::atomic<int64_t> mBuckets[kNumBuckets]{};
+  std::atomic<int64_t> mCount{0};
+  std::atomic<int64_t> mTotalUs{0};
+};
+
 /**
  * This class contains the definition of metrics captured within MediaDrm.
  * It also contains a method for exporting all of the metrics to a
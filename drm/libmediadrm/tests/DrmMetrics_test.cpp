@@ -65,6 +65,26 @@ TEST_F(MediaDrmMetricsTest, EmptySuccess) {
   EXPECT_TRUE(bundle.empty());
 }
 
+TEST_F(MediaDrmMetricsTest, LatencyHistogramPercentiles) {
+  DrmLatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.GetCount());
+  EXPECT_EQ(0, histogram.GetPercentileUs(99));
+
+  for (int i = 0; i < 90; i++) {
+    histogram.Record(100);  // [64, 128) bucket
+  }
+  for (int i = 0; i < 10; i++) {
+    histogram.Record(5000);  // [4096, 8192) bucket
+  }
+
+  EXPECT_EQ(100, histogram.GetCount());
+  EXPECT_EQ(590, histogram.GetAverageUs());
+  // Percentiles round up to the enclosing bucket boundary.
+  EXPECT_EQ(128, histogram.GetPercentileUs(50));
+  EXPECT_EQ(128, histogram.GetPercentileUs(90));
+  EXPECT_EQ(8192, histogram.GetPercentileUs(99));
+}
+
 TEST_F(MediaDrmMetricsTest, AllValuesSuccessCounts) {
   MediaDrmMetrics metrics;
 
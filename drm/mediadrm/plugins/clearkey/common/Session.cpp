@@ -44,8 +44,6 @@ CdmResponseType Session::provideKeyResponse(const std::vector<uint8_t>& response
     JsonWebKey parser;
     if (parser.extractKeysFromJsonWebKeySet(responseString, &keys)) {
         for (auto& key : keys) {
-            std::string first(key.first.begin(), key.first.end());
-            std::string second(key.second.begin(), key.second.end());
             mKeyMap.insert(
                     std::pair<std::vector<uint8_t>, std::vector<uint8_t>>(key.first, key.second));
         }
@@ -66,11 +64,8 @@ CdmResponseType Session::decrypt(const KeyId keyId, const Iv iv,
         return getMockError();
     }
 
-    std::vector<uint8_t> keyIdVector;
-    keyIdVector.clear();
-    keyIdVector.insert(keyIdVector.end(), keyId, keyId + kBlockSize);
-    std::map<std::vector<uint8_t>, std::vector<uint8_t>>::iterator itr;
-    itr = mKeyMap.find(keyIdVector);
+    const std::vector<uint8_t> keyIdVector(keyId, keyId + kBlockSize);
+    const auto itr = mKeyMap.find(keyIdVector);
     if (itr == mKeyMap.end()) {
         return clearkeydrm::ERROR_NO_LICENSE;
     }
@@ -69,11 +69,12 @@ status_t Session::decrypt(
 
     Vector<uint8_t> keyIdVector;
     keyIdVector.appendArray(keyId, kBlockSize);
-    if (mKeyMap.indexOfKey(keyIdVector) < 0) {
+    const ssize_t index = mKeyMap.indexOfKey(keyIdVector);
+    if (index < 0) {
         return android::ERROR_DRM_NO_LICENSE;
     }
 
-    const Vector<uint8_t>& key = mKeyMap.valueFor(keyIdVector);
+    const Vector<uint8_t>& key = mKeyMap.valueAt(index);
     AesCtrDecryptor decryptor;
     return decryptor.decrypt(
             key, iv,
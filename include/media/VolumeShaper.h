@@ -21,6 +21,7 @@
 #include <list>
 #include <math.h>
 #include <sstream>
+#include <vector>
 
 #include <android/media/VolumeShaperConfiguration.h>
 #include <android/media/VolumeShaperConfigurationOptionFlag.h>
@@ -75,6 +76,17 @@ public:
      */
     static const int kSystemVolumeShapersMax = 16;
 
+    /* kVolumeTableSegments is the number of line segments used when a curve
+     * is precompiled into a volume table at VolumeShaper construction time.
+     * The mix-thread lookup then linearly interpolates between adjacent table
+     * entries instead of evaluating the spline (and powf() for dBFS curves)
+     * on every mix cycle.  129 floats per shaper keeps the table within a
+     * few cache lines while the 1/128 grid holds the interpolation error of
+     * any valid (bounded, monotone-segment) curve well below 24-bit audio
+     * resolution.
+     */
+    static const int kVolumeTableSegments = 128;
+
     /* kUserVolumeShapersMax is the maximum number of application
      * VolumeShapers for a player/track.  Application VolumeShapers are
      * assigned on creation by the client, and have Ids ranging
@@ -711,6 +723,11 @@ public:
                 && (getFlags() & VolumeShaper::Operation::FLAG_DELAY) == 0) {
             mLastVolume = configuration->first().second;
         }
+        if (configuration.get() != nullptr
+                && configuration->getType() == VolumeShaper::Configuration::TYPE_SCALE
+                && configuration->size() >= 2) {
+            buildVolumeTable();
+        }
     }
 
     // We allow a null operation here, though VolumeHandler always provides one.
@@ -806,6 +823,25 @@ private:
     S mLastXOffset;      // last computed interpolated xOffset/time (x-axis)
     S mDelayXOffset;     // xOffset to use for first invocation of VolumeShaper.
 
+    // Adjusted (linear) volume sampled at i / kVolumeTableSegments of the
+    // normalized curve time; empty if the configuration has no usable curve.
+    // Built once at construction and immutable afterwards; the curve in the
+    // shared configuration must not be modified once the shaper exists.
+    std::vector<T> mVolumeTable;
+
+    /* Precompiles the configured curve so computeVolumeFromXOffset() becomes
+     * a table interpolation on the mix thread.  Exact spline evaluation (and
+     * the dBFS-to-linear powf()) only happens here.
+     */
+    void buildVolumeTable() {
+        mVolumeTable.resize(kVolumeTableSegments + 1);
+        static const S step = (MAX_CURVE_TIME - MIN_CURVE_TIME) / kVolumeTableSegments;
+        for (int i = 0; i <= kVolumeTableSegments; ++i) {
+            const S x = MIN_CURVE_TIME + i * step;
+            mVolumeTable[i] = mConfiguration->adjustVolume(mConfiguration->findY(x));
+        }
+    }
+
     // Called internally to adjust mXTranslate for first time start.
     void updatePosition(int64_t startFrame, double sampleRate, S xOffset) {
         double scale = (mConfiguration->last().first - mConfiguration->first().first)
@@ -824,6 +860,16 @@ private:
     }
 
     T computeVolumeFromXOffset(S xOffset) const {
+        if (!mVolumeTable.empty()) {
+            const S pos = (xOffset - MIN_CURVE_TIME)
+                    / (MAX_CURVE_TIME - MIN_CURVE_TIME) * kVolumeTableSegments;
+            const int index = clamp(static_cast<int>(pos), 0, kVolumeTableSegments - 1);
+            const T frac = pos - index;
+            const T volume = mVolumeTable[index]
+                    + frac * (mVolumeTable[index + 1] - mVolumeTable[index]);
+            VS_LOG("computeVolumeFromXOffset (table) %f -> %f", xOffset, volume);
+            return volume;
+        }
         const T unscaledVolume = mConfiguration->findY(xOffset);
         const T volume = mConfiguration->adjustVolume(unscaledVolume); // handle log scale
         VS_LOG("computeVolumeFromXOffset %f -> %f -> %f", xOffset, unscaledVolume, volume);
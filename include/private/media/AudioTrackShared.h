@@ -363,8 +363,15 @@ public:
     //  NOT_ENOUGH_DATA Server has disabled the track because of underrun: restart the track
     //              if still in active state.
     // Assertion failure on entry, if buffer == NULL or buffer->mFrameCount == 0.
+    //
+    // If part2 is non-NULL then a region that wraps around the end of the ring buffer is
+    // returned in one call: buffer describes the first part as usual and part2 the wrapped
+    // part, with part2->mFrameCount == 0 and part2->mRaw == NULL when the region is
+    // contiguous or on error.  Both parts may then be filled (or read) and released with a
+    // single releaseBuffer() of the total frame count, so the other side observes the whole
+    // transfer as one step of the ring buffer index.
     status_t    obtainBuffer(Buffer* buffer, const struct timespec *requested = NULL,
-            struct timespec *elapsed = NULL);
+            struct timespec *elapsed = NULL, Buffer* part2 = NULL);
 
     // Release (some of) the frames last obtained.
     // On entry, buffer->mFrameCount should have the number of frames to release,
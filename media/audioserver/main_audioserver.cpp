@@ -34,6 +34,7 @@
 #include <hidl/HidlTransportSupport.h>
 #include <mediautils/LimitProcessMemory.h>
 #include <utils/Log.h>
+#include <utils/Timers.h>
 
 // from include_dirs
 #include "AudioFlinger.h"
@@ -147,8 +148,15 @@ int main(int argc __unused, char **argv)
         sp<ProcessState> proc(ProcessState::self());
         sp<IServiceManager> sm = defaultServiceManager();
         ALOGI("ServiceManager: %p", sm.get());
+        // Bring-up here is inherently ordered: the policy service resolves the
+        // audio flinger service on creation, and the AAudio decision below
+        // needs the loaded policy's MMAP info. Log where the time goes so
+        // boot-to-first-audio regressions are attributable per stage.
+        const nsecs_t bringUpStartNs = systemTime();
         AudioFlinger::instantiate();
+        const nsecs_t flingerReadyNs = systemTime();
         AudioPolicyService::instantiate();
+        const nsecs_t policyReadyNs = systemTime();
 
         // AAudioService should only be used in OC-MR1 and later.
         // And only enable the AAudioService if the system MMAP policy explicitly allows it.
@@ -172,6 +180,13 @@ int main(int argc __unused, char **argv)
             ALOGD("Do not init aaudio service, status %d, policy info size %zu",
                   status, policyInfos.size());
         }
+        const nsecs_t bringUpEndNs = systemTime();
+        ALOGI("Service bring-up: AudioFlinger %.1f ms, AudioPolicyService %.1f ms,"
+                " AAudio %.1f ms, total %.1f ms",
+                (flingerReadyNs - bringUpStartNs) / 1e6,
+                (policyReadyNs - flingerReadyNs) / 1e6,
+                (bringUpEndNs - policyReadyNs) / 1e6,
+                (bringUpEndNs - bringUpStartNs) / 1e6);
 
         ProcessState::self()->startThreadPool();
         IPCThreadState::self()->joinThreadPool();
@@ -151,7 +151,8 @@ uint32_t Accessor::Impl::sSeqId = time(nullptr) & kSeqIdMax;
 
 Accessor::Impl::Impl(
         const std::shared_ptr<BufferPoolAllocator> &allocator)
-        : mAllocator(allocator), mScheduleEvictTs(0) {}
+        : mAllocator(allocator), mScheduleEvictTs(0),
+          mLastPeriodicCleanUpUs(getTimestampNow()) {}
 
 Accessor::Impl::~Impl() {
 }
@@ -262,6 +263,20 @@ ResultStatus Accessor::Impl::fetch(
 }
 
 void Accessor::Impl::cleanUp(bool clearCache) {
+    if (!clearCache) {
+        // Periodic clean-ups are requested from the per-buffer transfer paths
+        // of every client of the pool, and the pool gates them by time anyway
+        // once the lock is held. Do the time check before taking the lock so
+        // that steady-state traffic does not serialize on the pool lock just
+        // to find out there is nothing to do. Pending status messages are
+        // still drained by the next allocate/fetch or gated clean-up.
+        int64_t now = getTimestampNow();
+        if (now < mLastPeriodicCleanUpUs.load(std::memory_order_relaxed)
+                + kCleanUpDurationUs) {
+            return;
+        }
+        mLastPeriodicCleanUpUs.store(now, std::memory_order_relaxed);
+    }
     // transaction timeout, buffer cacheing TTL handling
     std::lock_guard<std::mutex> lock(mBufferPool.mMutex);
     mBufferPool.processStatusMessages();
@@ -83,6 +83,11 @@ private:
 
     nsecs_t mScheduleEvictTs;
 
+    // Timestamp of the last periodic clean-up. Read and updated without the
+    // pool lock, so the per-buffer transfer paths can skip clean-up requests
+    // cheaply when one has run recently.
+    std::atomic<int64_t> mLastPeriodicCleanUpUs;
+
     /**
      * Buffer pool implementation.
      *
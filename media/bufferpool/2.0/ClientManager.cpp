@@ -127,6 +127,17 @@ public:
                           TransactionId *transactionId,
                           int64_t *timestampUs);
 
+    ResultStatus allocate(ConnectionId connectionId,
+                          const std::vector<uint8_t> &params,
+                          size_t count,
+                          std::vector<native_handle_t *> *handles,
+                          std::vector<std::shared_ptr<BufferPoolData>> *buffers);
+
+    ResultStatus postSend(ConnectionId receiverId,
+                          const std::vector<std::shared_ptr<BufferPoolData>> &buffers,
+                          std::vector<TransactionId> *transactionIds,
+                          std::vector<int64_t> *timestampsUs);
+
     ResultStatus getAccessor(ConnectionId connectionId,
                              sp<IAccessor> *accessor);
 
@@ -415,6 +426,99 @@ ResultStatus ClientManager::Impl::postSend(
     return client->postSend(receiverId, buffer, transactionId, timestampUs);
 }
 
+ResultStatus ClientManager::Impl::allocate(
+        ConnectionId connectionId, const std::vector<uint8_t> &params,
+        size_t count, std::vector<native_handle_t *> *handles,
+        std::vector<std::shared_ptr<BufferPoolData>> *buffers) {
+    handles->clear();
+    buffers->clear();
+    std::shared_ptr<BufferPoolClient> client;
+    {
+        std::lock_guard<std::mutex> lock(mActive.mMutex);
+        auto it = mActive.mClients.find(connectionId);
+        if (it == mActive.mClients.end()) {
+            return ResultStatus::NOT_FOUND;
+        }
+        client = it->second;
+    }
+    handles->reserve(count);
+    buffers->reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        native_handle_t *handle = nullptr;
+        std::shared_ptr<BufferPoolData> buffer;
+#ifdef BUFFERPOOL_CLONE_HANDLES
+        native_handle_t *origHandle = nullptr;
+        ResultStatus res = client->allocate(params, &origHandle, &buffer);
+        if (res == ResultStatus::OK) {
+            handle = native_handle_clone(origHandle);
+            if (handle == NULL) {
+                buffer.reset();
+                res = ResultStatus::NO_MEMORY;
+            }
+        }
+#else
+        ResultStatus res = client->allocate(params, &handle, &buffer);
+#endif
+        if (res != ResultStatus::OK) {
+#ifdef BUFFERPOOL_CLONE_HANDLES
+            for (native_handle_t *cloned : *handles) {
+                native_handle_close(cloned);
+                native_handle_delete(cloned);
+            }
+#endif
+            // buffers allocated so far are returned to the pool as their
+            // references are dropped here.
+            handles->clear();
+            buffers->clear();
+            return res;
+        }
+        handles->push_back(handle);
+        buffers->push_back(std::move(buffer));
+    }
+    return ResultStatus::OK;
+}
+
+ResultStatus ClientManager::Impl::postSend(
+        ConnectionId receiverId,
+        const std::vector<std::shared_ptr<BufferPoolData>> &buffers,
+        std::vector<TransactionId> *transactionIds,
+        std::vector<int64_t> *timestampsUs) {
+    transactionIds->clear();
+    timestampsUs->clear();
+    if (buffers.size() == 0) {
+        return ResultStatus::OK;
+    }
+    ConnectionId connectionId = buffers.front()->mConnectionId;
+    for (const std::shared_ptr<BufferPoolData> &buffer : buffers) {
+        if (!buffer || buffer->mConnectionId != connectionId) {
+            return ResultStatus::CRITICAL_ERROR;
+        }
+    }
+    std::shared_ptr<BufferPoolClient> client;
+    {
+        std::lock_guard<std::mutex> lock(mActive.mMutex);
+        auto it = mActive.mClients.find(connectionId);
+        if (it == mActive.mClients.end()) {
+            return ResultStatus::NOT_FOUND;
+        }
+        client = it->second;
+    }
+    transactionIds->reserve(buffers.size());
+    timestampsUs->reserve(buffers.size());
+    for (const std::shared_ptr<BufferPoolData> &buffer : buffers) {
+        TransactionId transactionId;
+        int64_t timestampUs;
+        ResultStatus res = client->postSend(
+                receiverId, buffer, &transactionId, &timestampUs);
+        if (res != ResultStatus::OK) {
+            return res;
+        }
+        transactionIds->push_back(transactionId);
+        timestampsUs->push_back(timestampUs);
+    }
+    return ResultStatus::OK;
+}
+
 ResultStatus ClientManager::Impl::getAccessor(
         ConnectionId connectionId, sp<IAccessor> *accessor) {
     std::shared_ptr<BufferPoolClient> client;
@@ -555,6 +659,27 @@ ResultStatus ClientManager::postSend(
     return ResultStatus::CRITICAL_ERROR;
 }
 
+ResultStatus ClientManager::allocate(
+        ConnectionId connectionId, const std::vector<uint8_t> &params,
+        size_t count, std::vector<native_handle_t *> *handles,
+        std::vector<std::shared_ptr<BufferPoolData>> *buffers) {
+    if (mImpl) {
+        return mImpl->allocate(connectionId, params, count, handles, buffers);
+    }
+    return ResultStatus::CRITICAL_ERROR;
+}
+
+ResultStatus ClientManager::postSend(
+        ConnectionId receiverId,
+        const std::vector<std::shared_ptr<BufferPoolData>> &buffers,
+        std::vector<TransactionId> *transactionIds,
+        std::vector<int64_t> *timestampsUs) {
+    if (mImpl) {
+        return mImpl->postSend(receiverId, buffers, transactionIds, timestampsUs);
+    }
+    return ResultStatus::CRITICAL_ERROR;
+}
+
 void ClientManager::cleanUp() {
     if (mImpl) {
         mImpl->cleanUp(true);
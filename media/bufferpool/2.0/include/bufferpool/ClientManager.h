@@ -168,6 +168,53 @@ struct ClientManager : public IClientManager {
                           TransactionId *transactionId,
                           int64_t *timestampUs);
 
+    /**
+     * Allocates a group of buffers from the specified connection. This is
+     * equivalent to calling allocate() count times, but the connection is
+     * resolved only once for the whole batch. Output handles follow the same
+     * ownership rules as allocate().
+     *
+     * @param connectionId  The id of the connection.
+     * @param params        The allocation parameters.
+     * @param count         The number of buffers to allocate.
+     * @param handles       The native handles to the allocated buffers.
+     * @param buffers       The allocated buffers.
+     *
+     * @return OK when all buffers were allocated successfully.
+     *         NOT_FOUND when the specified connection was not found.
+     *         NO_MEMORY when there is no memory. Buffers allocated before the
+     *         failure are returned to the pool and the outputs are emptied.
+     *         CRITICAL_ERROR otherwise.
+     */
+    ResultStatus allocate(ConnectionId connectionId,
+                          const std::vector<uint8_t> &params,
+                          size_t count,
+                          std::vector<native_handle_t *> *handles,
+                          std::vector<std::shared_ptr<BufferPoolData>> *buffers);
+
+    /**
+     * Posts transfer transactions for a group of buffers - typically all the
+     * buffers of one frame - to the buffer pool. This is equivalent to calling
+     * postSend() for each buffer, but the sending connection is resolved only
+     * once for the whole batch. All buffers must belong to the same
+     * connection.
+     *
+     * @param receiverId     The id of the receiving connection.
+     * @param buffers        The buffers to transfer.
+     * @param transactionIds Ids of the posted transfer transactions.
+     * @param timestampsUs   The timestamps the buffer transactions are being
+     *                       posted.
+     *
+     * @return OK when all buffer transactions were posted successfully.
+     *         NOT_FOUND when the sending connection was not found.
+     *         CRITICAL_ERROR otherwise. Transactions posted before the failure
+     *         remain in the outputs and will time out unless relayed.
+     */
+    ResultStatus postSend(ConnectionId receiverId,
+                          const std::vector<std::shared_ptr<BufferPoolData>> &buffers,
+                          std::vector<TransactionId> *transactionIds,
+                          std::vector<int64_t> *timestampsUs);
+
     /**
      *  Time out inactive lingering connections and close.
      */
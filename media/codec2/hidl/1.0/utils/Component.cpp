@@ -33,8 +33,10 @@
 #include <C2Debug.h>
 #include <C2PlatformSupport.h>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 namespace android {
 namespace hardware {
@@ -94,6 +96,7 @@ struct Component::Listener : public C2Component::Listener {
     virtual void onWorkDone_nb(
             std::weak_ptr<C2Component> /* c2component */,
             std::list<std::unique_ptr<C2Work>> c2workItems) override {
+        sp<Component> strongComponent = mComponent.promote();
         for (const std::unique_ptr<C2Work>& work : c2workItems) {
             if (work) {
                 if (work->worklets.empty()
@@ -102,6 +105,10 @@ struct Component::Listener : public C2Component::Listener {
                             C2FrameData::FLAG_INCOMPLETE) == 0) {
                     InputBufferManager::
                             unregisterFrameData(mListener, work->input);
+                    if (strongComponent) {
+                        strongComponent->noteWorkDone(
+                                work->input.ordinal.frameIndex.peeku());
+                    }
                 }
             }
         }
@@ -110,7 +117,6 @@ struct Component::Listener : public C2Component::Listener {
         if (listener) {
             WorkBundle workBundle;
 
-            sp<Component> strongComponent = mComponent.promote();
             beginTransferBufferQueueBlocks(c2workItems, true);
             if (!objcpy(&workBundle, c2workItems, strongComponent ?
                     &strongComponent->mBufferPoolSender : nullptr)) {
@@ -222,6 +228,82 @@ c2_status_t Component::status() const {
     return mInit;
 }
 
+void Component::noteWorkDone(uint64_t frameIndex) {
+    const nsecs_t nowNs = systemTime();
+    std::lock_guard<std::mutex> lock(mWorkMetricsMutex);
+    ++mWorkMetrics.worksDone;
+    auto it = mWorkMetrics.queueTimesNs.find(frameIndex);
+    if (it == mWorkMetrics.queueTimesNs.end()) {
+        return;
+    }
+    const nsecs_t latencyNs = nowNs - it->second;
+    mWorkMetrics.queueTimesNs.erase(it);
+    mWorkMetrics.latencyTotalNs += latencyNs;
+    const int64_t latencyMs = latencyNs / 1000000;
+    size_t bucket = 0;
+    while (bucket + 1 < WorkMetrics::kNumLatencyBuckets
+            && latencyMs >= (int64_t(1) << bucket)) {
+        ++bucket;
+    }
+    ++mWorkMetrics.latencyBuckets[bucket];
+}
+
+void Component::noteWorkFlushed(uint64_t frameIndex) {
+    std::lock_guard<std::mutex> lock(mWorkMetricsMutex);
+    ++mWorkMetrics.worksFlushed;
+    mWorkMetrics.queueTimesNs.erase(frameIndex);
+}
+
+std::ostream& Component::dumpWorkMetrics(std::ostream& out) {
+    constexpr const char indent[] = "    ";
+
+    std::lock_guard<std::mutex> lock(mWorkMetricsMutex);
+    out << indent << "Works queued: " << mWorkMetrics.worksQueued
+        << ", done: " << mWorkMetrics.worksDone
+        << ", flushed: " << mWorkMetrics.worksFlushed << std::endl;
+
+    // Incomplete flushed works are not observed by noteWorkFlushed(), so the
+    // difference below may overestimate the number of works still inside the
+    // codec; clamp at zero to keep the dump readable either way.
+    int64_t inFlight = int64_t(mWorkMetrics.worksQueued)
+            - int64_t(mWorkMetrics.worksDone)
+            - int64_t(mWorkMetrics.worksFlushed);
+    out << indent << "Works in flight: " << std::max(inFlight, int64_t(0))
+        << std::endl;
+
+    uint64_t samples = 0;
+    for (uint64_t count : mWorkMetrics.latencyBuckets) {
+        samples += count;
+    }
+    if (samples != 0) {
+        out << indent << "Queue-to-done latency: avg "
+            << (mWorkMetrics.latencyTotalNs / samples / 1000) << " us"
+            << std::endl;
+        out << indent << "Latency histogram (ms):";
+        int64_t lower = 0;
+        for (size_t i = 0; i < WorkMetrics::kNumLatencyBuckets; ++i) {
+            if (i + 1 < WorkMetrics::kNumLatencyBuckets) {
+                const int64_t upper = int64_t(1) << i;
+                out << " [" << lower << ',' << upper << ")="
+                    << mWorkMetrics.latencyBuckets[i];
+                lower = upper;
+            } else {
+                out << " [" << lower << ",inf)="
+                    << mWorkMetrics.latencyBuckets[i];
+            }
+        }
+        out << std::endl;
+    }
+
+    {
+        std::lock_guard<std::mutex> poolLock(mBlockPoolsMutex);
+        out << indent << "Block pools created: " << mBlockPools.size()
+            << std::endl;
+    }
+
+    return out;
+}
+
 // Methods from ::android::hardware::media::c2::V1_0::IComponent
 Return<Status> Component::queue(const WorkBundle& workBundle) {
     std::list<std::unique_ptr<C2Work>> c2works;
@@ -231,14 +313,30 @@ Return<Status> Component::queue(const WorkBundle& workBundle) {
     }
 
     // Register input buffers.
+    std::vector<uint64_t> frameIndices;
+    frameIndices.reserve(c2works.size());
     for (const std::unique_ptr<C2Work>& work : c2works) {
         if (work) {
             InputBufferManager::
                     registerFrameData(mListener, work->input);
+            frameIndices.push_back(work->input.ordinal.frameIndex.peeku());
         }
     }
 
-    return static_cast<Status>(mComponent->queue_nb(&c2works));
+    // queue_nb() empties the list, so the frame indices were saved above.
+    c2_status_t c2res = mComponent->queue_nb(&c2works);
+    if (c2res == C2_OK) {
+        const nsecs_t nowNs = systemTime();
+        std::lock_guard<std::mutex> lock(mWorkMetricsMutex);
+        for (uint64_t frameIndex : frameIndices) {
+            ++mWorkMetrics.worksQueued;
+            if (mWorkMetrics.queueTimesNs.size() <
+                    WorkMetrics::kMaxPendingTimestamps) {
+                mWorkMetrics.queueTimesNs.emplace(frameIndex, nowNs);
+            }
+        }
+    }
+    return static_cast<Status>(c2res);
 }
 
 Return<void> Component::flush(flush_cb _hidl_cb) {
@@ -256,6 +354,7 @@ Return<void> Component::flush(flush_cb _hidl_cb) {
                         C2FrameData::FLAG_INCOMPLETE) == 0) {
                 InputBufferManager::
                         unregisterFrameData(mListener, work->input);
+                noteWorkFlushed(work->input.ordinal.frameIndex.peeku());
             }
         }
     }
@@ -501,7 +501,8 @@ Return<void> ComponentStore::debug(
                 out << indent << indent << "NONE" << std::endl << std::endl;
             } else {
                 for (auto& pair : mComponentRoster) {
-                    dump(out, pair.second) << std::endl;
+                    dump(out, pair.second);
+                    pair.first->dumpWorkMetrics(out) << std::endl;
                 }
             }
         }
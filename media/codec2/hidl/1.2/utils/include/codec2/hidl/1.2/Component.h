@@ -28,6 +28,7 @@
 #include <codec2/hidl/1.2/types.h>
 #include <hidl/Status.h>
 #include <hwbinder/IBinder.h>
+#include <utils/Timers.h>
 
 #include <C2Component.h>
 #include <C2Buffer.h>
@@ -36,6 +37,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <ostream>
 
 namespace android {
 namespace hardware {
@@ -116,6 +118,10 @@ struct Component : public IComponent,
     static std::shared_ptr<C2Component> findLocalComponent(
             const sp<IInputSink>& sink);
 
+    // Appends this component's work metrics to a dump produced by
+    // ComponentStore::debug().
+    std::ostream& dumpWorkMetrics(std::ostream& out);
+
 protected:
     c2_status_t mInit;
     std::shared_ptr<C2Component> mComponent;
@@ -135,6 +141,35 @@ protected:
     // destroyBlockPool(), reset() or release(), or by destroying the component.
     std::map<uint64_t, std::shared_ptr<C2BlockPool>> mBlockPools;
 
+    // Always-on, fixed-footprint counters describing the flow of work through
+    // this component. Updated on queue(), flush() and onWorkDone_nb(); read by
+    // dumpWorkMetrics(). Every update is O(1).
+    struct WorkMetrics {
+        // Works accepted by queue(), works reported complete by the codec, and
+        // works returned by flush() before completing.
+        uint64_t worksQueued{0};
+        uint64_t worksDone{0};
+        uint64_t worksFlushed{0};
+
+        // Queue-to-done latency histogram with power-of-two millisecond
+        // buckets: [0,1), [1,2), [2,4), ..., [128,inf) ms.
+        static constexpr size_t kNumLatencyBuckets = 9;
+        uint64_t latencyBuckets[kNumLatencyBuckets]{};
+        nsecs_t latencyTotalNs{0};
+
+        // Queue timestamps of works still inside the codec, keyed by input
+        // frame index. Bounded so a stalled codec cannot grow the map; works
+        // queued beyond the cap complete normally but do not contribute
+        // latency samples.
+        static constexpr size_t kMaxPendingTimestamps = 64;
+        std::map<uint64_t, nsecs_t> queueTimesNs;
+    };
+    std::mutex mWorkMetricsMutex;
+    WorkMetrics mWorkMetrics;
+
+    void noteWorkDone(uint64_t frameIndex);
+    void noteWorkFlushed(uint64_t frameIndex);
+
     void initListener(const sp<Component>& self);
 
     virtual ~Component() override;
@@ -686,6 +686,9 @@ private:
 CCodec::CCodec()
     : mChannel(new CCodecBufferChannel(std::make_shared<CCodecCallbackImpl>(this))),
       mConfig(new CCodecConfig) {
+    // Buffer-flow messages (kWhatWorkDone et al.) should not queue behind
+    // housekeeping from other handlers sharing the codec looper.
+    setMessageLane(ALooper::kLaneRealtime);
 }
 
 CCodec::~CCodec() {
@@ -2294,6 +2297,102 @@ void CCodec::onWorkDone(std::list<std::unique_ptr<C2Work>> &workItems) {
     (new AMessage(kWhatWorkDone, this))->post();
 }
 
+void CCodec::handleWorkDone(std::unique_ptr<C2Work> work) {
+    // handle configuration changes in work done
+    std::shared_ptr<const C2StreamInitDataInfo::output> initData;
+    sp<AMessage> outputFormat = nullptr;
+    {
+        Mutexed<std::unique_ptr<Config>>::Locked configLocked(mConfig);
+        const std::unique_ptr<Config> &config = *configLocked;
+        Config::Watcher<C2StreamInitDataInfo::output> initDataWatcher =
+            config->watch<C2StreamInitDataInfo::output>();
+        if (!work->worklets.empty()
+                && (work->worklets.front()->output.flags
+                        & C2FrameData::FLAG_DISCARD_FRAME) == 0) {
+
+            // copy buffer info to config
+            std::vector<std::unique_ptr<C2Param>> updates;
+            for (const std::unique_ptr<C2Param> &param
+                    : work->worklets.front()->output.configUpdate) {
+                updates.push_back(C2Param::Copy(*param));
+            }
+            unsigned stream = 0;
+            std::vector<std::shared_ptr<C2Buffer>> &outputBuffers =
+                work->worklets.front()->output.buffers;
+            for (const std::shared_ptr<C2Buffer> &buf : outputBuffers) {
+                for (const std::shared_ptr<const C2Info> &info : buf->info()) {
+                    // move all info into output-stream #0 domain
+                    updates.emplace_back(
+                            C2Param::CopyAsStream(*info, true /* output */, stream));
+                }
+
+                const std::vector<C2ConstGraphicBlock> blocks = buf->data().graphicBlocks();
+                // for now only do the first block
+                if (!blocks.empty()) {
+                    // ALOGV("got output buffer with crop %u,%u+%u,%u and size %u,%u",
+                    //      block.crop().left, block.crop().top,
+                    //      block.crop().width, block.crop().height,
+                    //      block.width(), block.height());
+                    const C2ConstGraphicBlock &block = blocks[0];
+                    updates.emplace_back(new C2StreamCropRectInfo::output(
+                            stream, block.crop()));
+                }
+                ++stream;
+            }
+
+            sp<AMessage> oldFormat = config->mOutputFormat;
+            config->updateConfiguration(updates, config->mOutputDomain);
+            RevertOutputFormatIfNeeded(oldFormat, config->mOutputFormat);
+
+            // copy standard infos to graphic buffers if not already present (otherwise, we
+            // may overwrite the actual intermediate value with a final value)
+            stream = 0;
+            const static C2Param::Index stdGfxInfos[] = {
+                C2StreamRotationInfo::output::PARAM_TYPE,
+                C2StreamColorAspectsInfo::output::PARAM_TYPE,
+                C2StreamDataSpaceInfo::output::PARAM_TYPE,
+                C2StreamHdrStaticInfo::output::PARAM_TYPE,
+                C2StreamHdr10PlusInfo::output::PARAM_TYPE,  // will be deprecated
+                C2StreamHdrDynamicMetadataInfo::output::PARAM_TYPE,
+                C2StreamPixelAspectRatioInfo::output::PARAM_TYPE,
+                C2StreamSurfaceScalingInfo::output::PARAM_TYPE
+            };
+            for (const std::shared_ptr<C2Buffer> &buf : outputBuffers) {
+                if (buf->data().graphicBlocks().size()) {
+                    for (C2Param::Index ix : stdGfxInfos) {
+                        if (!buf->hasInfo(ix)) {
+                            const C2Param *param =
+                                config->getConfigParameterValue(ix.withStream(stream));
+                            if (param) {
+                                std::shared_ptr<C2Param> info(C2Param::Copy(*param));
+                                buf->setInfo(std::static_pointer_cast<C2Info>(info));
+                            }
+                        }
+                    }
+                }
+                ++stream;
+            }
+        }
+        if (config->mInputSurface) {
+            if (work->worklets.empty()
+                   || !work->worklets.back()
+                   || (work->worklets.back()->output.flags
+                          & C2FrameData::FLAG_INCOMPLETE) == 0) {
+                config->mInputSurface->onInputBufferDone(work->input.ordinal.frameIndex);
+            }
+        }
+        if (initDataWatcher.hasChanged()) {
+            initData = initDataWatcher.update();
+            AmendOutputFormatWithCodecSpecificData(
+                    initData->m.value, initData->flexCount(), config->mCodingMediaType,
+                    config->mOutputFormat);
+        }
+        outputFormat = config->mOutputFormat;
+    }
+    mChannel->onWorkDone(
+            std::move(work), outputFormat, initData ? initData.get() : nullptr);
+}
+
 void CCodec::onInputBufferDone(uint64_t frameIndex, size_t arrayIndex) {
     mChannel->onInputBufferDone(frameIndex, arrayIndex);
     if (arrayIndex == 0) {
@@ -2370,114 +2469,18 @@ void CCodec::onMessageReceived(const sp<AMessage> &msg) {
             break;
         }
         case kWhatWorkDone: {
-            std::unique_ptr<C2Work> work;
-            bool shouldPost = false;
+            // Drain all the work items that are already queued, so that a batch of
+            // work completed in one interrupt is handled with a single message
+            // instead of one posted message per work item. Work queued while we are
+            // draining is handled by the message that was posted along with it.
+            std::list<std::unique_ptr<C2Work>> workItems;
             {
                 Mutexed<std::list<std::unique_ptr<C2Work>>>::Locked queue(mWorkDoneQueue);
-                if (queue->empty()) {
-                    break;
-                }
-                work.swap(queue->front());
-                queue->pop_front();
-                shouldPost = !queue->empty();
-            }
-            if (shouldPost) {
-                (new AMessage(kWhatWorkDone, this))->post();
+                workItems.swap(*queue);
             }
-
-            // handle configuration changes in work done
-            std::shared_ptr<const C2StreamInitDataInfo::output> initData;
-            sp<AMessage> outputFormat = nullptr;
-            {
-                Mutexed<std::unique_ptr<Config>>::Locked configLocked(mConfig);
-                const std::unique_ptr<Config> &config = *configLocked;
-                Config::Watcher<C2StreamInitDataInfo::output> initDataWatcher =
-                    config->watch<C2StreamInitDataInfo::output>();
-                if (!work->worklets.empty()
-                        && (work->worklets.front()->output.flags
-                                & C2FrameData::FLAG_DISCARD_FRAME) == 0) {
-
-                    // copy buffer info to config
-                    std::vector<std::unique_ptr<C2Param>> updates;
-                    for (const std::unique_ptr<C2Param> &param
-                            : work->worklets.front()->output.configUpdate) {
-                        updates.push_back(C2Param::Copy(*param));
-                    }
-                    unsigned stream = 0;
-                    std::vector<std::shared_ptr<C2Buffer>> &outputBuffers =
-                        work->worklets.front()->output.buffers;
-                    for (const std::shared_ptr<C2Buffer> &buf : outputBuffers) {
-                        for (const std::shared_ptr<const C2Info> &info : buf->info()) {
-                            // move all info into output-stream #0 domain
-                            updates.emplace_back(
-                                    C2Param::CopyAsStream(*info, true /* output */, stream));
-                        }
-
-                        const std::vector<C2ConstGraphicBlock> blocks = buf->data().graphicBlocks();
-                        // for now only do the first block
-                        if (!blocks.empty()) {
-                            // ALOGV("got output buffer with crop %u,%u+%u,%u and size %u,%u",
-                            //      block.crop().left, block.crop().top,
-                            //      block.crop().width, block.crop().height,
-                            //      block.width(), block.height());
-                            const C2ConstGraphicBlock &block = blocks[0];
-                            updates.emplace_back(new C2StreamCropRectInfo::output(
-                                    stream, block.crop()));
-                        }
-                        ++stream;
-                    }
-
-                    sp<AMessage> oldFormat = config->mOutputFormat;
-                    config->updateConfiguration(updates, config->mOutputDomain);
-                    RevertOutputFormatIfNeeded(oldFormat, config->mOutputFormat);
-
-                    // copy standard infos to graphic buffers if not already present (otherwise, we
-                    // may overwrite the actual intermediate value with a final value)
-                    stream = 0;
-                    const static C2Param::Index stdGfxInfos[] = {
-                        C2StreamRotationInfo::output::PARAM_TYPE,
-                        C2StreamColorAspectsInfo::output::PARAM_TYPE,
-                        C2StreamDataSpaceInfo::output::PARAM_TYPE,
-                        C2StreamHdrStaticInfo::output::PARAM_TYPE,
-                        C2StreamHdr10PlusInfo::output::PARAM_TYPE,  // will be deprecated
-                        C2StreamHdrDynamicMetadataInfo::output::PARAM_TYPE,
-                        C2StreamPixelAspectRatioInfo::output::PARAM_TYPE,
-                        C2StreamSurfaceScalingInfo::output::PARAM_TYPE
-                    };
-                    for (const std::shared_ptr<C2Buffer> &buf : outputBuffers) {
-                        if (buf->data().graphicBlocks().size()) {
-                            for (C2Param::Index ix : stdGfxInfos) {
-                                if (!buf->hasInfo(ix)) {
-                                    const C2Param *param =
-                                        config->getConfigParameterValue(ix.withStream(stream));
-                                    if (param) {
-                                        std::shared_ptr<C2Param> info(C2Param::Copy(*param));
-                                        buf->setInfo(std::static_pointer_cast<C2Info>(info));
-                                    }
-                                }
-                            }
-                        }
-                        ++stream;
-                    }
-                }
-                if (config->mInputSurface) {
-                    if (work->worklets.empty()
-                           || !work->worklets.back()
-                           || (work->worklets.back()->output.flags
-                                  & C2FrameData::FLAG_INCOMPLETE) == 0) {
-                        config->mInputSurface->onInputBufferDone(work->input.ordinal.frameIndex);
-                    }
-                }
-                if (initDataWatcher.hasChanged()) {
-                    initData = initDataWatcher.update();
-                    AmendOutputFormatWithCodecSpecificData(
-                            initData->m.value, initData->flexCount(), config->mCodingMediaType,
-                            config->mOutputFormat);
-                }
-                outputFormat = config->mOutputFormat;
+            for (std::unique_ptr<C2Work> &work : workItems) {
+                handleWorkDone(std::move(work));
             }
-            mChannel->onWorkDone(
-                    std::move(work), outputFormat, initData ? initData.get() : nullptr);
             break;
         }
         case kWhatWatch: {
@@ -51,9 +51,12 @@
 #include <media/stagefright/MediaCodecConstants.h>
 #include <media/stagefright/SkipCutBuffer.h>
 #include <media/stagefright/SurfaceUtils.h>
+#include <media/nblog/WriterPool.h>
 #include <media/MediaCodecBuffer.h>
 #include <mediadrm/ICrypto.h>
+#include <private/android_filesystem_config.h>
 #include <system/window.h>
+#include <unistd.h>
 
 #include "CCodecBufferChannel.h"
 #include "Codec2Buffer.h"
@@ -86,6 +89,9 @@ const static size_t kDequeueTimeoutNs = 0;
 // after app resume to foreground to notify HAL something
 const static uint64_t kPipelinePausedTimeoutMs = 500;
 
+// Size of the NBLog timeline for per-work pipeline residency events.
+constexpr size_t kNBLogSize = 4096;
+
 }  // namespace
 
 CCodecBufferChannel::QueueGuard::QueueGuard(
@@ -189,6 +195,9 @@ CCodecBufferChannel::~CCodecBufferChannel() {
     if (mCrypto != nullptr && mHeapSeqNum >= 0) {
         mCrypto->unsetHeap(mHeapSeqNum);
     }
+    if (mNBLogWriter != nullptr) {
+        NBLog::WriterPool::getDefault()->unregisterWriter(mNBLogWriter);
+    }
 }
 
 void CCodecBufferChannel::setComponent(
@@ -196,6 +205,13 @@ void CCodecBufferChannel::setComponent(
     mComponent = component;
     mComponentName = component->getName() + StringPrintf("#%d", int(uintptr_t(component.get()) % 997));
     mName = mComponentName.c_str();
+    // media.log only accepts writers from native media services; when the
+    // codec is hosted in an application process skip the shared memory setup
+    // so the per-work cost stays at a null check.
+    if (mNBLogWriter == nullptr && getuid() < AID_APP_START) {
+        mNBLogWriter = NBLog::WriterPool::getDefault()->newWriter(
+                kNBLogSize, mComponentName.c_str());
+    }
 }
 
 status_t CCodecBufferChannel::setInputSurface(
@@ -236,6 +252,11 @@ status_t CCodecBufferChannel::queueInputBufferInternal(
     if (buffer->meta()->findInt32("csd", &tmp) && tmp) {
         flags |= C2FrameData::FLAG_CODEC_CONFIG;
     }
+    if (buffer->meta()->findInt32("decode-only", &tmp) && tmp) {
+        // The client doesn't want this frame's output; components that
+        // honor the flag can skip their output stages for it.
+        flags |= C2FrameData::FLAG_DROP_FRAME;
+    }
     if (buffer->meta()->findInt32("tunnel-first-frame", &tmp) && tmp) {
         tunnelFirstFrame = true;
     }
@@ -394,6 +415,16 @@ status_t CCodecBufferChannel::setParameters(std::vector<std::unique_ptr<C2Param>
 status_t CCodecBufferChannel::attachBuffer(
         const std::shared_ptr<C2Buffer> &c2Buffer,
         const sp<MediaCodecBuffer> &buffer) {
+    // Blocks obtained via the block model API are fetched with the component's
+    // own usage and allocator (see CCodec::FetchLinearBlock), so pass them to
+    // the component as-is instead of copying into a freshly fetched pool
+    // block. The property restores the copy for components that only accept
+    // input from their own pool; wrap failure falls back to the copy anyway.
+    static const bool kWrapInput =
+            property_get_bool("debug.stagefright.ccodec-wrap-input", true);
+    if (kWrapInput && buffer->wrap(c2Buffer)) {
+        return OK;
+    }
     if (!buffer->copy(c2Buffer)) {
         return -ENOSYS;
     }
@@ -1028,6 +1059,16 @@ status_t CCodecBufferChannel::renderOutputBuffer(
         ALOGV("[%s] queue buffer successful", mName);
     }
 
+    {
+        // Keep a reference to this frame so setSurface() can replay it to a
+        // new surface. The render fence has been consumed by the queue above;
+        // a replay of an already displayed frame does not need to wait.
+        Mutexed<LastRenderedFrame>::Locked last(mLastRenderedFrame);
+        last->buffer = c2Buffer;
+        qbi.fence = Fence::NO_FENCE;
+        last->qbi = qbi;
+    }
+
     int64_t mediaTimeUs = 0;
     (void)buffer->meta()->findInt64("timeUs", &mediaTimeUs);
     mCCodecCallback->onOutputFramesRendered(mediaTimeUs, timestampNs);
@@ -1515,11 +1556,14 @@ status_t CCodecBufferChannel::start(
     // newly initialized pipeline capacity.
 
     if (inputFormat || outputFormat) {
+        uint32_t pipelineDepth = android::base::GetUintProperty(
+                "debug.stagefright.c2-pipeline-depth", uint32_t(0));
         Mutexed<PipelineWatcher>::Locked watcher(mPipelineWatcher);
         watcher->inputDelay(inputDelayValue)
                 .pipelineDelay(pipelineDelayValue)
                 .outputDelay(outputDelayValue)
-                .smoothnessFactor(kSmoothnessFactor);
+                .smoothnessFactor(kSmoothnessFactor)
+                .targetDepth(pipelineDepth);
         watcher->flush();
     }
 
@@ -1654,10 +1698,30 @@ void CCodecBufferChannel::stopUseOutputSurface(bool pushBlankBuffer) {
 
 void CCodecBufferChannel::reset() {
     stop();
+    {
+        Mutexed<LastRenderedFrame>::Locked last(mLastRenderedFrame);
+        last->buffer.reset();
+        last->qbi.reset();
+    }
     if (mInputSurface != nullptr) {
         mInputSurface.reset();
     }
-    mPipelineWatcher.lock()->flush();
+    {
+        Mutexed<PipelineWatcher>::Locked watcher(mPipelineWatcher);
+        const PipelineWatcher::LatencyStats &stats = watcher->latencyStats();
+        if (stats.count > 0) {
+            ALOGD("[%s] pipeline residency: %zu work item(s); "
+                  "min %lldus max %lldus avg %lldus",
+                  mName, stats.count,
+                  (long long)std::chrono::duration_cast<std::chrono::microseconds>(
+                          stats.min).count(),
+                  (long long)std::chrono::duration_cast<std::chrono::microseconds>(
+                          stats.max).count(),
+                  (long long)std::chrono::duration_cast<std::chrono::microseconds>(
+                          stats.total).count() / (long long)stats.count);
+        }
+        watcher->flush();
+    }
     {
         Mutexed<Input>::Locked input(mInput);
         input->buffers.reset(new DummyInputBuffers(""));
@@ -1684,6 +1748,12 @@ void CCodecBufferChannel::release() {
 
 void CCodecBufferChannel::flush(const std::list<std::unique_ptr<C2Work>> &flushedWork) {
     ALOGV("[%s] flush", mName);
+    {
+        // don't replay a pre-flush frame to a new surface
+        Mutexed<LastRenderedFrame>::Locked last(mLastRenderedFrame);
+        last->buffer.reset();
+        last->qbi.reset();
+    }
     std::list<std::unique_ptr<C2Work>> configs;
     mInput.lock()->lastFlushIndex = mFrameIndex.load(std::memory_order_relaxed);
     {
@@ -1691,14 +1761,14 @@ void CCodecBufferChannel::flush(const std::list<std::unique_ptr<C2Work>> &flushe
         for (const std::unique_ptr<C2Work> &work : flushedWork) {
             uint64_t frameIndex = work->input.ordinal.frameIndex.peeku();
             if (!(work->input.flags & C2FrameData::FLAG_CODEC_CONFIG)) {
-                watcher->onWorkDone(frameIndex);
+                watcher->onWorkEvicted(frameIndex);
                 continue;
             }
             if (work->input.buffers.empty()
                     || work->input.buffers.front() == nullptr
                     || work->input.buffers.front()->data().linearBlocks().empty()) {
                 ALOGD("[%s] no linear codec config data found", mName);
-                watcher->onWorkDone(frameIndex);
+                watcher->onWorkEvicted(frameIndex);
                 continue;
             }
             std::unique_ptr<C2Work> copy(new C2Work);
@@ -1718,7 +1788,7 @@ void CCodecBufferChannel::flush(const std::list<std::unique_ptr<C2Work>> &flushe
                     work->input.infoBuffers.end());
             copy->worklets.emplace_back(new C2Worklet);
             configs.push_back(std::move(copy));
-            watcher->onWorkDone(frameIndex);
+            watcher->onWorkEvicted(frameIndex);
             ALOGV("[%s] stashed flushed codec config data", mName);
         }
     }
@@ -1811,8 +1881,13 @@ bool CCodecBufferChannel::handleWork(
             || !work->worklets.front()
             || !(work->worklets.front()->output.flags &
                  C2FrameData::FLAG_INCOMPLETE))) {
-        mPipelineWatcher.lock()->onWorkDone(
-                work->input.ordinal.frameIndex.peeku());
+        const PipelineWatcher::Clock::duration residency =
+                mPipelineWatcher.lock()->onWorkDone(
+                        work->input.ordinal.frameIndex.peeku());
+        if (mNBLogWriter != nullptr) {
+            mNBLogWriter->log<NBLog::EVENT_WORK_TIME>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(residency).count());
+        }
     }
 
     // NOTE: MediaCodec usage supposedly have only one worklet
@@ -2213,6 +2288,30 @@ status_t CCodecBufferChannel::setSurface(const sp<Surface> &newSurface, bool pus
         output->generation = generation;
     }
 
+    if (!pushBlankBuffer) {
+        // Replay the last rendered frame to the new surface so the handoff is
+        // not a blank or frozen window until the next frame is rendered
+        // (e.g. moving playback between views / picture-in-picture).
+        std::shared_ptr<C2Buffer> lastBuffer;
+        std::optional<IGraphicBufferProducer::QueueBufferInput> lastQbi;
+        {
+            Mutexed<LastRenderedFrame>::Locked last(mLastRenderedFrame);
+            lastBuffer = last->buffer;
+            lastQbi = last->qbi;
+        }
+        if (lastBuffer && lastQbi) {
+            std::vector<C2ConstGraphicBlock> blocks = lastBuffer->data().graphicBlocks();
+            if (blocks.size() == 1u) {
+                IGraphicBufferProducer::QueueBufferOutput qbo;
+                status_t result = mComponent->queueToOutputSurface(
+                        blocks.front(), *lastQbi, &qbo);
+                if (result != OK) {
+                    ALOGI("[%s] setSurface: failed to replay last frame: %d", mName, result);
+                }
+            }
+        }
+    }
+
     if (oldSurface && pushBlankBuffer) {
         // When ReleaseSurface was set from MediaCodec,
         // pushing a blank buffer at the end might be necessary.
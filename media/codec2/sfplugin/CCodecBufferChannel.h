@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <mutex>
 
@@ -28,6 +29,8 @@
 #include <Codec2Mapper.h>
 
 #include <codec2/hidl/client.h>
+#include <gui/IGraphicBufferProducer.h>
+#include <media/nblog/Writer.h>
 #include <media/stagefright/foundation/Mutexed.h>
 #include <media/stagefright/CodecBase.h>
 
@@ -323,6 +326,16 @@ private:
     };
     Mutexed<OutputSurface> mOutputSurface;
 
+    // The most recently rendered frame, kept so that a surface switch can
+    // replay it to the new surface right away instead of leaving the new
+    // surface blank (or frozen on stale content) until the next output frame
+    // is rendered. Cleared on flush and reset.
+    struct LastRenderedFrame {
+        std::shared_ptr<C2Buffer> buffer;
+        std::optional<IGraphicBufferProducer::QueueBufferInput> qbi;
+    };
+    Mutexed<LastRenderedFrame> mLastRenderedFrame;
+
     struct BlockPools {
         C2Allocator::id_t inputAllocatorId;
         std::shared_ptr<C2BlockPool> inputPool;
@@ -338,6 +351,11 @@ private:
 
     Mutexed<PipelineWatcher> mPipelineWatcher;
 
+    // Typed log of per-work pipeline residency, merged into media.log when
+    // this process runs as a native media service (no-op writer otherwise).
+    // Only written from the work-done callback thread.
+    sp<NBLog::Writer> mNBLogWriter;
+
     std::atomic_bool mInputMetEos;
     std::once_flag mRenderWarningFlag;
 
@@ -18,6 +18,8 @@
 #define LOG_TAG "CCodecConfig"
 
 #include <initializer_list>
+#include <map>
+#include <mutex>
 
 #include <cutils/properties.h>
 #include <log/log.h>
@@ -57,6 +59,56 @@ namespace android {
 
 namespace {
 
+/**
+ * A reflector that memoizes describe() results process-wide, keyed by
+ * component name and core index.
+ *
+ * A component's param structs are immutable for as long as the process lives,
+ * but describing one is an IPC to the codec service, and initialize() below
+ * reflects hundreds of them every time a codec is created — including every
+ * recreation on an adaptive stream's resolution switch.
+ */
+class CachingParamReflector : public C2ParamReflector {
+public:
+    CachingParamReflector(
+            const std::string &componentName,
+            const std::shared_ptr<C2ParamReflector> &reflector)
+        : mComponentName(componentName), mReflector(reflector) { }
+
+    std::unique_ptr<C2StructDescriptor> describe(C2Param::CoreIndex coreIndex) const override {
+        const std::pair<std::string, uint32_t> key(mComponentName, coreIndex.coreIndex());
+        {
+            std::lock_guard<std::mutex> lock(sMutex);
+            auto it = sCache.find(key);
+            if (it != sCache.end()) {
+                return std::make_unique<C2StructDescriptor>(*it->second);
+            }
+        }
+        std::unique_ptr<C2StructDescriptor> desc = mReflector->describe(coreIndex);
+        if (desc) {
+            std::lock_guard<std::mutex> lock(sMutex);
+            sCache.emplace(key, std::make_shared<const C2StructDescriptor>(*desc));
+        }
+        // failures are not cached; a subsequent query may succeed, and repeated
+        // failures are cheap on the service side
+        return desc;
+    }
+
+private:
+    std::string mComponentName;
+    std::shared_ptr<C2ParamReflector> mReflector;
+
+    static std::mutex sMutex;
+    static std::map<std::pair<std::string, uint32_t>,
+                    std::shared_ptr<const C2StructDescriptor>> sCache;
+};
+
+// static
+std::mutex CachingParamReflector::sMutex;
+// static
+std::map<std::pair<std::string, uint32_t>, std::shared_ptr<const C2StructDescriptor>>
+        CachingParamReflector::sCache;
+
 void C2ValueToMessageItem(const C2Value &value, AMessage::ItemData &item) {
     int32_t int32Value;
     uint32_t uint32Value;
@@ -1092,11 +1144,13 @@ status_t CCodecConfig::initialize(
         mSupportedIndices.emplace(desc->index());
     }
 
-    mReflector = reflector;
-    if (mReflector == nullptr) {
+    if (reflector == nullptr) {
         ALOGE("Null param reflector");
         return UNKNOWN_ERROR;
     }
+    // Route all struct descriptions through the process-wide cache; the
+    // addParamDesc() call below describes every supported param.
+    mReflector = std::make_shared<CachingParamReflector>(configurable->getName(), reflector);
 
     // enumerate all fields
     mParamUpdater = std::make_shared<ReflectedParamUpdater>();
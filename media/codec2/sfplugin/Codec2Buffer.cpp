@@ -152,9 +152,16 @@ sp<LinearBlockBuffer> LinearBlockBuffer::Allocate(
 }
 
 std::shared_ptr<C2Buffer> LinearBlockBuffer::asC2Buffer() {
+    if (mWrappedBufferRef) {
+        return mWrappedBufferRef;
+    }
     return C2Buffer::CreateLinearBuffer(mBlock->share(offset(), size(), C2Fence()));
 }
 
+void LinearBlockBuffer::clearC2BufferRefs() {
+    mWrappedBufferRef.reset();
+}
+
 bool LinearBlockBuffer::canCopy(const std::shared_ptr<C2Buffer> &buffer) const {
     return canCopyLinear(buffer);
 }
@@ -163,6 +170,23 @@ bool LinearBlockBuffer::copy(const std::shared_ptr<C2Buffer> &buffer) {
     return copyLinear(buffer);
 }
 
+bool LinearBlockBuffer::wrap(const std::shared_ptr<C2Buffer> &buffer) {
+    if (!buffer
+            || buffer->data().type() != C2BufferData::LINEAR
+            || buffer->data().linearBlocks().size() != 1u) {
+        return false;
+    }
+    const C2ConstLinearBlock &block = buffer->data().linearBlocks()[0];
+    if (block.size() > capacity()) {
+        // Keep the same size contract as the copy path.
+        return false;
+    }
+    mWrappedBufferRef = buffer;
+    // Keep size() consistent with the buffer actually queued to the component.
+    setRange(0, block.size());
+    return true;
+}
+
 LinearBlockBuffer::LinearBlockBuffer(
         const sp<AMessage> &format,
         C2WriteView&& writeView,
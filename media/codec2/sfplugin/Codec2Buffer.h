@@ -145,9 +145,22 @@ public:
     virtual ~LinearBlockBuffer() = default;
 
     std::shared_ptr<C2Buffer> asC2Buffer() override;
+    void clearC2BufferRefs() override;
     bool canCopy(const std::shared_ptr<C2Buffer> &buffer) const override;
     bool copy(const std::shared_ptr<C2Buffer> &buffer) override;
 
+    /**
+     * Wrap around |buffer| instead of copying its contents into the own block.
+     * On success asC2Buffer() returns the wrapped buffer and the own block is
+     * left untouched; the wrapped reference is dropped at clearC2BufferRefs().
+     *
+     * \param   buffer  C2Buffer object to wrap. Must consist of a single
+     *                  linear block that fits the own block's capacity.
+     * \return          true if the buffer was wrapped; false if the caller
+     *                  should fall back to copy().
+     */
+    bool wrap(const std::shared_ptr<C2Buffer> &buffer) override;
+
 private:
     LinearBlockBuffer(
             const sp<AMessage> &format,
@@ -157,6 +170,7 @@ private:
 
     C2WriteView mWriteView;
     std::shared_ptr<C2LinearBlock> mBlock;
+    std::shared_ptr<C2Buffer> mWrappedBufferRef;
 };
 
 /**
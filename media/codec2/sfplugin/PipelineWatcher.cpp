@@ -17,6 +17,7 @@
 //#define LOG_NDEBUG 0
 #define LOG_TAG "PipelineWatcher"
 
+#include <algorithm>
 #include <numeric>
 
 #include <log/log.h>
@@ -45,6 +46,11 @@ PipelineWatcher &PipelineWatcher::smoothnessFactor(uint32_t value) {
     return *this;
 }
 
+PipelineWatcher &PipelineWatcher::targetDepth(uint32_t value) {
+    mTargetDepth = value;
+    return *this;
+}
+
 void PipelineWatcher::onWorkQueued(
         uint64_t frameIndex,
         std::vector<std::shared_ptr<C2Buffer>> &&buffers,
@@ -83,15 +89,30 @@ std::shared_ptr<C2Buffer> PipelineWatcher::onInputBufferReleased(
     return buffer;
 }
 
-void PipelineWatcher::onWorkDone(uint64_t frameIndex) {
+PipelineWatcher::Clock::duration PipelineWatcher::onWorkDone(uint64_t frameIndex) {
     ALOGV("onWorkDone(frameIndex=%llu)", (unsigned long long)frameIndex);
     auto it = mFramesInPipeline.find(frameIndex);
     if (it == mFramesInPipeline.end()) {
         ALOGD("onWorkDone: frameIndex not found (%llu); ignored",
               (unsigned long long)frameIndex);
-        return;
+        return Clock::duration::zero();
+    }
+    Clock::duration residency = Clock::now() - it->second.queuedAt;
+    if (mLatencyStats.count == 0 || residency < mLatencyStats.min) {
+        mLatencyStats.min = residency;
+    }
+    if (mLatencyStats.count == 0 || residency > mLatencyStats.max) {
+        mLatencyStats.max = residency;
     }
+    mLatencyStats.total += residency;
+    ++mLatencyStats.count;
     (void)mFramesInPipeline.erase(it);
+    return residency;
+}
+
+void PipelineWatcher::onWorkEvicted(uint64_t frameIndex) {
+    ALOGV("onWorkEvicted(frameIndex=%llu)", (unsigned long long)frameIndex);
+    (void)mFramesInPipeline.erase(frameIndex);
 }
 
 void PipelineWatcher::flush() {
@@ -99,9 +120,19 @@ void PipelineWatcher::flush() {
     mFramesInPipeline.clear();
 }
 
+const PipelineWatcher::LatencyStats &PipelineWatcher::latencyStats() const {
+    return mLatencyStats;
+}
+
 bool PipelineWatcher::pipelineFull() const {
-    if (mFramesInPipeline.size() >=
-            mInputDelay + mPipelineDelay + mOutputDelay + mSmoothnessFactor) {
+    size_t allowed = mInputDelay + mPipelineDelay + mOutputDelay + mSmoothnessFactor;
+    if (mTargetDepth > 0) {
+        // cap the depth at the target, but never starve the component of the
+        // frames it needs to make progress
+        allowed = std::max<size_t>(
+                std::min<size_t>(allowed, mTargetDepth), mPipelineDelay + 1);
+    }
+    if (mFramesInPipeline.size() >= allowed) {
         ALOGV("pipelineFull: too many frames in pipeline (%zu)", mFramesInPipeline.size());
         return true;
     }
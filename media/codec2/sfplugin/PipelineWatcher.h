@@ -37,7 +37,8 @@ public:
         : mInputDelay(0),
           mPipelineDelay(0),
           mOutputDelay(0),
-          mSmoothnessFactor(0) {}
+          mSmoothnessFactor(0),
+          mTargetDepth(0) {}
     ~PipelineWatcher() = default;
 
     /**
@@ -64,6 +65,17 @@ public:
      */
     PipelineWatcher &smoothnessFactor(uint32_t value);
 
+    /**
+     * Sets the target pipeline depth. When nonzero, it caps the number of
+     * work items allowed in the pipeline below what the delays and the
+     * smoothness factor would permit, trading throughput for latency. The
+     * cap never goes below what the component needs to make progress.
+     *
+     * \param value the target pipeline depth; 0 means no cap
+     * \return  this object
+     */
+    PipelineWatcher &targetDepth(uint32_t value);
+
     /**
      * Client queued a work item to the component.
      *
@@ -88,17 +100,46 @@ public:
             uint64_t frameIndex, size_t arrayIndex);
 
     /**
-     * The component finished processing a work item.
+     * The component finished processing a work item. The time the work item
+     * spent in the pipeline is recorded in the residency statistics.
      *
      * \param frameIndex  input frame index
+     * \return  the pipeline residency of this work item, or zero if the
+     *          frame index was not found in the pipeline.
      */
-    void onWorkDone(uint64_t frameIndex);
+    Clock::duration onWorkDone(uint64_t frameIndex);
+
+    /**
+     * A work item left the pipeline without completing (e.g. it was flushed).
+     * The work item is removed without being counted in the residency
+     * statistics.
+     *
+     * \param frameIndex  input frame index
+     */
+    void onWorkEvicted(uint64_t frameIndex);
 
     /**
      * Flush the pipeline.
      */
     void flush();
 
+    /**
+     * Pipeline residency statistics: the time completed work items spent in
+     * the pipeline from queueing to completion. Cumulative over the lifetime
+     * of this object; not cleared by flush().
+     */
+    struct LatencyStats {
+        size_t count = 0;  ///< # of completed work items
+        Clock::duration min = Clock::duration::zero();  ///< shortest residency
+        Clock::duration max = Clock::duration::zero();  ///< longest residency
+        Clock::duration total = Clock::duration::zero();  ///< sum of residencies
+    };
+
+    /**
+     * \return  the pipeline residency statistics so far.
+     */
+    const LatencyStats &latencyStats() const;
+
     /**
      * \return  true  if pipeline does not need more work items to proceed
      *                smoothly, considering delays and smoothness factor;
@@ -122,6 +163,8 @@ private:
     uint32_t mPipelineDelay;
     uint32_t mOutputDelay;
     uint32_t mSmoothnessFactor;
+    uint32_t mTargetDepth;
+    LatencyStats mLatencyStats;
 
     struct Frame {
         Frame(std::vector<std::shared_ptr<C2Buffer>> &&b,
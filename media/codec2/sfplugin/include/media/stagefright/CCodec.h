@@ -127,6 +127,9 @@ private:
     void setInputSurface(const sp<PersistentSurface> &surface);
     status_t setupInputSurface(const std::shared_ptr<InputSurfaceWrapper> &surface);
 
+    /// handle one work item from the work done queue
+    void handleWorkDone(std::unique_ptr<C2Work> work);
+
     void setDeadline(
             const TimePoint &now,
             const std::chrono::milliseconds &timeout,
@@ -914,4 +914,38 @@ TEST(LinearOutputBuffersTest, PcmConvertFormat) {
     ASSERT_TRUE(buffers->releaseBuffer(clientBuffer, &c2Buffer));
 }
 
+TEST(LinearBlockBufferTest, WrapClientBuffer) {
+    std::shared_ptr<C2BlockPool> pool;
+    ASSERT_EQ(OK, GetCodec2BlockPool(C2BlockPool::BASIC_LINEAR, nullptr, &pool));
+
+    std::shared_ptr<C2LinearBlock> ownBlock;
+    ASSERT_EQ(OK, pool->fetchLinearBlock(
+            1024, C2MemoryUsage{C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE}, &ownBlock));
+    sp<LinearBlockBuffer> buffer = LinearBlockBuffer::Allocate(new AMessage, ownBlock);
+    ASSERT_NE(nullptr, buffer);
+
+    std::shared_ptr<C2LinearBlock> clientBlock;
+    ASSERT_EQ(OK, pool->fetchLinearBlock(
+            1024, C2MemoryUsage{C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE}, &clientBlock));
+    std::shared_ptr<C2Buffer> clientBuffer =
+        C2Buffer::CreateLinearBuffer(clientBlock->share(0, 100, C2Fence()));
+
+    // A wrapped buffer is handed to the component as-is.
+    ASSERT_TRUE(buffer->wrap(clientBuffer));
+    EXPECT_EQ(clientBuffer, buffer->asC2Buffer());
+    EXPECT_EQ(100u, buffer->size());
+
+    // Dropping the ref restores the own block.
+    buffer->clearC2BufferRefs();
+    EXPECT_NE(clientBuffer, buffer->asC2Buffer());
+
+    // Buffers that don't fit the own block cannot be wrapped.
+    std::shared_ptr<C2LinearBlock> largeBlock;
+    ASSERT_EQ(OK, pool->fetchLinearBlock(
+            4096, C2MemoryUsage{C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE}, &largeBlock));
+    std::shared_ptr<C2Buffer> largeBuffer =
+        C2Buffer::CreateLinearBuffer(largeBlock->share(0, 4096, C2Fence()));
+    EXPECT_FALSE(buffer->wrap(largeBuffer));
+}
+
 } // namespace android
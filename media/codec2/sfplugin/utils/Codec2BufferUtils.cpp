@@ -67,15 +67,10 @@ struct MemCopier<false, S> {
  */
 template<bool ToMediaImage, typename View, typename ImagePixel>
 static status_t _ImageCopy(View &view, const MediaImage2 *img, ImagePixel *imgBase) {
-    // TODO: more efficient copying --- e.g. copy interleaved planes together, etc.
     const C2PlanarLayout &layout = view.layout();
     const size_t bpp = divUp(img->mBitDepthAllocated, 8u);
 
     for (uint32_t i = 0; i < layout.numPlanes; ++i) {
-        typename std::conditional<ToMediaImage, uint8_t, const uint8_t>::type *imgRow =
-            imgBase + img->mPlane[i].mOffset;
-        typename std::conditional<ToMediaImage, const uint8_t, uint8_t>::type *viewRow =
-            viewRow = view.data()[i];
         const C2PlaneInfo &plane = layout.planes[i];
         if (plane.colSampling != img->mPlane[i].mHorizSubsampling
                 || plane.rowSampling != img->mPlane[i].mVertSubsampling
@@ -86,6 +81,18 @@ static status_t _ImageCopy(View &view, const MediaImage2 *img, ImagePixel *imgBa
                 || (bpp > 1 && plane.endianness != plane.NATIVE)) {
             return BAD_VALUE;
         }
+    }
+
+    uint32_t handled = 0; // bitmask of planes copied as part of an interleaved pair
+    for (uint32_t i = 0; i < layout.numPlanes; ++i) {
+        if (handled & (1u << i)) {
+            continue;
+        }
+        typename std::conditional<ToMediaImage, uint8_t, const uint8_t>::type *imgRow =
+            imgBase + img->mPlane[i].mOffset;
+        typename std::conditional<ToMediaImage, const uint8_t, uint8_t>::type *viewRow =
+            view.data()[i];
+        const C2PlaneInfo &plane = layout.planes[i];
 
         uint32_t planeW = img->mWidth / plane.colSampling;
         uint32_t planeH = img->mHeight / plane.rowSampling;
@@ -94,26 +101,70 @@ static status_t _ImageCopy(View &view, const MediaImage2 *img, ImagePixel *imgBa
         bool canCopyByPlane = canCopyByRow && (plane.rowInc == img->mPlane[i].mRowInc);
         if (canCopyByPlane) {
             MemCopier<ToMediaImage, 0>::copy(imgRow, viewRow, plane.rowInc * planeH);
-        } else if (canCopyByRow) {
+            continue;
+        }
+        if (canCopyByRow) {
             for (uint32_t row = 0; row < planeH; ++row) {
                 MemCopier<ToMediaImage, 0>::copy(
                         imgRow, viewRow, std::min(plane.rowInc, img->mPlane[i].mRowInc));
                 imgRow += img->mPlane[i].mRowInc;
                 viewRow += plane.rowInc;
             }
-        } else {
-            for (uint32_t row = 0; row < planeH; ++row) {
-                decltype(imgRow) imgPtr = imgRow;
-                decltype(viewRow) viewPtr = viewRow;
-                for (uint32_t col = 0; col < planeW; ++col) {
-                    MemCopier<ToMediaImage, 0>::copy(imgPtr, viewPtr, bpp);
-                    imgPtr += img->mPlane[i].mColInc;
-                    viewPtr += plane.colInc;
+            continue;
+        }
+        // Interleaved sibling planes (such as the chroma planes of a
+        // semiplanar layout) can be copied together, one span per row, when
+        // both sides interleave them identically. This matters for 10+ bit
+        // semiplanar formats like P010 which have no libyuv shortcut and
+        // would otherwise fall into the per-pixel loop below for every frame.
+        bool paired = false;
+        if (plane.colInc == (int32_t)(2 * bpp)
+                && img->mPlane[i].mColInc == (int32_t)(2 * bpp)) {
+            for (uint32_t j = i + 1; j < layout.numPlanes; ++j) {
+                const C2PlaneInfo &other = layout.planes[j];
+                ssize_t viewDelta = view.data()[j] - view.data()[i];
+                ssize_t imgDelta = (ssize_t)img->mPlane[j].mOffset
+                        - (ssize_t)img->mPlane[i].mOffset;
+                if ((handled & (1u << j)) == 0
+                        && other.colInc == plane.colInc
+                        && other.rowInc == plane.rowInc
+                        && other.colSampling == plane.colSampling
+                        && other.rowSampling == plane.rowSampling
+                        && img->mPlane[j].mColInc == img->mPlane[i].mColInc
+                        && img->mPlane[j].mRowInc == img->mPlane[i].mRowInc
+                        && viewDelta == imgDelta
+                        && (viewDelta == (ssize_t)bpp || viewDelta == -(ssize_t)bpp)) {
+                    handled |= (1u << j);
+                    if (viewDelta < 0) {
+                        // plane j comes first in memory; start the span there
+                        imgRow = imgBase + img->mPlane[j].mOffset;
+                        viewRow = view.data()[j];
+                    }
+                    size_t rowSpan = (planeW - 1) * plane.colInc + 2 * bpp;
+                    for (uint32_t row = 0; row < planeH; ++row) {
+                        MemCopier<ToMediaImage, 0>::copy(imgRow, viewRow, rowSpan);
+                        imgRow += img->mPlane[i].mRowInc;
+                        viewRow += plane.rowInc;
+                    }
+                    paired = true;
+                    break;
                 }
-                imgRow += img->mPlane[i].mRowInc;
-                viewRow += plane.rowInc;
             }
         }
+        if (paired) {
+            continue;
+        }
+        for (uint32_t row = 0; row < planeH; ++row) {
+            decltype(imgRow) imgPtr = imgRow;
+            decltype(viewRow) viewPtr = viewRow;
+            for (uint32_t col = 0; col < planeW; ++col) {
+                MemCopier<ToMediaImage, 0>::copy(imgPtr, viewPtr, bpp);
+                imgPtr += img->mPlane[i].mColInc;
+                viewPtr += plane.colInc;
+            }
+            imgRow += img->mPlane[i].mRowInc;
+            viewRow += plane.rowInc;
+        }
     }
     return OK;
 }
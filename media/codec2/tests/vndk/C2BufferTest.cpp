@@ -20,6 +20,7 @@
 #include <C2Buffer.h>
 #include <C2BufferPriv.h>
 #include <C2Config.h>
+#include <C2FenceFactory.h>
 #include <C2ParamDef.h>
 #include <C2PlatformSupport.h>
 
@@ -771,6 +772,14 @@ TEST_F(C2BufferTest, MultipleLinearMapTest) {
     }
 }
 
+TEST_F(C2BufferTest, WaitAllFencesTest) {
+    // An empty batch and batches of null/ready fences complete without blocking.
+    ASSERT_EQ(C2_OK, _C2FenceFactory::WaitAllFences({}, 0));
+    std::vector<C2Fence> fences(4);  // null fences are always ready
+    ASSERT_EQ(C2_OK, _C2FenceFactory::WaitAllFences(fences, 0));
+    ASSERT_EQ(C2_OK, _C2FenceFactory::WaitAllFences(fences, -1));
+}
+
 TEST_F(C2BufferTest, InfoBufferTest) {
     constexpr size_t kCapacity = 524288u;
 
@@ -233,11 +233,34 @@ public:
     }
 };
 
+// Plane layout of a gralloc buffer never changes once allocated, but querying
+// it is a mapper transaction. Cache the computed C2PlanarLayout and the plane
+// offsets (relative to the mapped base) per allocation, so that only the first
+// map of a pooled block pays for the metadata query; later maps just lock.
+struct Gralloc4LayoutCache {
+    bool valid = false;
+    C2PlanarLayout layout;
+    uint32_t planeOffsetsInBytes[C2PlanarLayout::MAX_NUM_PLANES] = {};
+};
+
 static
 c2_status_t Gralloc4Mapper_lock(native_handle_t *handle, uint64_t usage, const Rect& bounds,
-        C2PlanarLayout *layout, uint8_t **addr) {
+        C2PlanarLayout *layout, uint8_t **addr, Gralloc4LayoutCache *cache) {
     GraphicBufferMapper &mapper = GraphicBufferMapper::get();
 
+    if (cache != nullptr && cache->valid) {
+        uint8_t *pointer = nullptr;
+        status_t err = mapper.lock(handle, usage, bounds, (void **)&pointer, nullptr, nullptr);
+        if (err != NO_ERROR || pointer == nullptr) {
+            return C2_CORRUPTED;
+        }
+        *layout = cache->layout;
+        for (uint32_t i = 0; i < layout->numPlanes; ++i) {
+            addr[i] = pointer + cache->planeOffsetsInBytes[i];
+        }
+        return C2_OK;
+    }
+
     std::vector<ui::PlaneLayout> planes;
     // this method is only supported on Gralloc 4 or later
     status_t err = mapper.getPlaneLayouts(handle, &planes);
@@ -311,6 +334,16 @@ c2_status_t Gralloc4Mapper_lock(native_handle_t *handle, uint64_t usage, const R
             lastOffsetInBits = component.offsetInBits + component.sizeInBits;
         }
     }
+
+    if (cache != nullptr) {
+        cache->layout = *layout;
+        // plane ids are contiguous (Y/U/V checked above), so the addresses
+        // filled in for this layout are addr[0..numPlanes)
+        for (uint32_t i = 0; i < layout->numPlanes; ++i) {
+            cache->planeOffsetsInBytes[i] = addr[i] - pointer;
+        }
+        cache->valid = true;
+    }
     return C2_OK;
 }
 
@@ -376,6 +409,7 @@ private:
     bool mLocked;
     C2Allocator::id_t mAllocatorId;
     std::mutex mMappedLock;
+    Gralloc4LayoutCache mGralloc4LayoutCache;  // guarded by mMappedLock
 };
 
 C2AllocationGralloc::C2AllocationGralloc(
@@ -761,7 +795,8 @@ c2_status_t C2AllocationGralloc::map(
             // We don't know what it is, let's try to lock it with gralloc4
             android_ycbcr ycbcrLayout;
             c2_status_t status = Gralloc4Mapper_lock(
-                    const_cast<native_handle_t*>(mBuffer), grallocUsage, rect, layout, addr);
+                    const_cast<native_handle_t*>(mBuffer), grallocUsage, rect, layout, addr,
+                    &mGralloc4LayoutCache);
             if (status == C2_OK) {
                 break;
             }
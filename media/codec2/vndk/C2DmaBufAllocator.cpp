@@ -40,8 +40,94 @@ namespace {
 
     // max padding after ion/dmabuf allocations in bytes
     constexpr uint32_t MAX_PADDING = 0x8000; // 32KB
+
+    // budget for the free list of recently released dmabuf allocations
+    constexpr size_t FREE_LIST_MAX_BYTES = 32 * 1048576;
+    constexpr size_t FREE_LIST_MAX_ENTRIES = 64;
 }
 
+/* =========================== FREE LIST =========================== */
+/**
+ * Process-wide cache of recently released dmabuf allocations.
+ *
+ * Steady-state users - a transcode session, a looping player - allocate linear
+ * blocks of the same few sizes over and over, and each allocation is a trip
+ * into the dmabuf heap driver (fd creation plus zeroed pages). Keeping a short
+ * free list of released buffers lets those allocations reuse a warm buffer
+ * instead. Only buffers allocated by this process from the heap are cached;
+ * handles wrapped from another process are owned elsewhere. Only an exact
+ * size/heap/flags match is reused so a client is never handed an oversized
+ * buffer.
+ */
+class C2DmaBufFreeList {
+public:
+    static C2DmaBufFreeList &Get() {
+        static C2DmaBufFreeList sFreeList;
+        return sFreeList;
+    }
+
+    // Returns a cached buffer fd for this exact size/heap/flags, or -1 on a miss.
+    int fetch(size_t allocSize, const C2String& heap_name, unsigned flags) {
+        Mutexed<State>::Locked state(mState);
+        for (auto it = state->entries.begin(); it != state->entries.end(); ++it) {
+            if (it->allocSize == allocSize && it->flags == flags
+                    && it->heapName == heap_name) {
+                int fd = it->fd;
+                state->totalBytes -= it->allocSize;
+                state->entries.erase(it);
+                return fd;
+            }
+        }
+        return -1;
+    }
+
+    // Takes ownership of |fd| if it fits in the cache budget. Returns false if
+    // the caller keeps ownership and should close the fd itself.
+    bool recycle(int fd, size_t allocSize, const C2String& heap_name, unsigned flags) {
+        if (allocSize > FREE_LIST_MAX_BYTES) {
+            return false;
+        }
+        Mutexed<State>::Locked state(mState);
+        state->entries.push_front({fd, allocSize, heap_name, flags});
+        state->totalBytes += allocSize;
+        // evict least recently released buffers when over budget
+        while (state->totalBytes > FREE_LIST_MAX_BYTES
+                || state->entries.size() > FREE_LIST_MAX_ENTRIES) {
+            state->totalBytes -= state->entries.back().allocSize;
+            close(state->entries.back().fd);
+            state->entries.pop_back();
+        }
+        return true;
+    }
+
+    // Returns all cached buffers to the heap. Called when the heap signals
+    // pressure by failing an allocation.
+    void trim() {
+        std::list<Entry> entries;
+        {
+            Mutexed<State>::Locked state(mState);
+            entries.swap(state->entries);
+            state->totalBytes = 0;
+        }
+        for (const Entry& entry : entries) {
+            close(entry.fd);
+        }
+    }
+
+private:
+    struct Entry {
+        int fd;
+        size_t allocSize;
+        C2String heapName;
+        unsigned flags;
+    };
+    struct State {
+        std::list<Entry> entries;  // most recently released first
+        size_t totalBytes = 0;
+    };
+    Mutexed<State> mState;
+};
+
 /* =========================== BUFFER HANDLE =========================== */
 /**
  * Buffer handle
@@ -157,6 +243,11 @@ class C2DmaBufAllocation : public C2LinearAllocation {
     C2Allocator::id_t mId;
     C2HandleBuf mHandle;
     c2_status_t mInit;
+    // set only for allocations made from the dmabuf heap by this process;
+    // wrapped allocations keep the default and are never recycled
+    size_t mRecycleSize = 0;
+    C2String mRecycleHeapName;
+    unsigned mRecycleFlags = 0;
     struct Mapping {
         void* addr;
         size_t alignmentBytes;
@@ -264,7 +355,11 @@ C2DmaBufAllocation::~C2DmaBufAllocation() {
         }
     }
     if (mInit == C2_OK) {
-        native_handle_close(&mHandle);
+        if (mRecycleSize == 0 ||
+            !C2DmaBufFreeList::Get().recycle(mHandle.bufferFd(), mRecycleSize,
+                                             mRecycleHeapName, mRecycleFlags)) {
+            native_handle_close(&mHandle);
+        }
     }
 }
 
@@ -274,9 +369,21 @@ C2DmaBufAllocation::C2DmaBufAllocation(BufferAllocator& alloc, size_t allocSize,
     int bufferFd = -1;
     int ret = 0;
 
-    bufferFd = alloc.Alloc(heap_name, allocSize, flags);
+    bufferFd = C2DmaBufFreeList::Get().fetch(allocSize, heap_name, flags);
+    if (bufferFd < 0) {
+        bufferFd = alloc.Alloc(heap_name, allocSize, flags);
+        if (bufferFd == -ENOMEM) {
+            // the heap is under pressure; give the cached buffers back and retry
+            C2DmaBufFreeList::Get().trim();
+            bufferFd = alloc.Alloc(heap_name, allocSize, flags);
+        }
+    }
     if (bufferFd < 0) {
         ret = bufferFd;
+    } else {
+        mRecycleSize = allocSize;
+        mRecycleHeapName = heap_name;
+        mRecycleFlags = flags;
     }
 
     // this may be a non-working handle if bufferFd is negative
@@ -16,8 +16,12 @@
 
 //#define LOG_NDEBUG 0
 #define LOG_TAG "C2FenceFactory"
+#include <errno.h>
+#include <poll.h>
+
 #include <cutils/native_handle.h>
 #include <utils/Log.h>
+#include <utils/Timers.h>
 #include <ui/Fence.h>
 
 #include <C2FenceFactory.h>
@@ -297,3 +301,86 @@ C2Fence _C2FenceFactory::CreateFromNativeHandle(const native_handle_t* handle) {
     return C2Fence(p);
 }
 
+c2_status_t _C2FenceFactory::WaitAllFences(
+        const std::vector<C2Fence>& fences, c2_nsecs_t timeoutNs) {
+    // Waits taking longer than this are logged with their batch size so slow
+    // vendor fences show up in the logs instead of only as missed frames.
+    constexpr nsecs_t kSlowWaitLogNs = 20 * 1000000;
+
+    const nsecs_t startNs = systemTime();
+    const nsecs_t deadlineNs = (timeoutNs < 0) ? -1 : startNs + timeoutNs;
+
+    // Partition the batch: sync fds go into a single poll set, fences without
+    // an fd (e.g. surface fences) have to be waited on one by one.
+    std::vector<struct pollfd> pollFds;
+    std::vector<C2Fence> fdlessFences;
+    for (const C2Fence &fence : fences) {
+        if (!fence.valid() || fence.ready()) {
+            continue;
+        }
+        int fd = fence.fd();  // dup; closed below
+        if (fd >= 0) {
+            pollFds.push_back({ fd, POLLIN, 0 });
+        } else {
+            fdlessFences.push_back(fence);
+        }
+    }
+
+    c2_status_t result = C2_OK;
+    size_t pending = pollFds.size();
+    while (pending > 0 && result == C2_OK) {
+        int timeoutMs = -1;
+        if (deadlineNs >= 0) {
+            nsecs_t remainingNs = deadlineNs - systemTime();
+            if (remainingNs < 0) {
+                remainingNs = 0;
+            }
+            int64_t remainingMs = (remainingNs + 999999) / 1000000;
+            timeoutMs = (remainingMs > INT_MAX) ? INT_MAX : (int)remainingMs;
+        }
+        int ret = poll(pollFds.data(), pollFds.size(), timeoutMs);
+        if (ret > 0) {
+            for (struct pollfd &pollFd : pollFds) {
+                if (pollFd.fd >= 0 && pollFd.revents != 0) {
+                    // Signaled (or errored) fds are dropped from subsequent
+                    // rounds; poll() ignores negative fds.
+                    close(pollFd.fd);
+                    pollFd.fd = -1;
+                    --pending;
+                }
+            }
+        } else if (ret == 0) {
+            result = C2_TIMED_OUT;
+        } else if (errno != EINTR) {
+            ALOGD("poll for %zu fences failed: %d", pending, errno);
+            result = C2_CORRUPTED;
+        }
+    }
+    for (const struct pollfd &pollFd : pollFds) {
+        if (pollFd.fd >= 0) {
+            close(pollFd.fd);
+        }
+    }
+
+    for (const C2Fence &fence : fdlessFences) {
+        c2_nsecs_t remainingNs = timeoutNs;
+        if (deadlineNs >= 0) {
+            remainingNs = deadlineNs - systemTime();
+            if (remainingNs < 0) {
+                remainingNs = 0;
+            }
+        }
+        c2_status_t err = C2Fence(fence).wait(remainingNs);
+        if (err != C2_OK && result == C2_OK) {
+            result = err;
+        }
+    }
+
+    const nsecs_t durationNs = systemTime() - startNs;
+    if (durationNs >= kSlowWaitLogNs) {
+        ALOGD("slow fence batch: waited %lldms for %zu fences (%zu sync fds): %d",
+              (long long)ns2ms(durationNs), fences.size(), pollFds.size(), result);
+    }
+    return result;
+}
+
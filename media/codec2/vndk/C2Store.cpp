@@ -34,9 +34,12 @@
 #include <dlfcn.h>
 #include <unistd.h> // getpagesize
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 #ifdef __ANDROID_APEX__
 #include <android-base/properties.h>
@@ -1147,18 +1150,54 @@ void C2PlatformComponentStore::visitComponents() {
     if (mVisited) {
         return;
     }
+    // Load the component modules concurrently. Each loader guards its module
+    // with its own lock and distinct libraries are independent, so the first
+    // codec list query pays for the slowest module instead of the sum of all
+    // of them. Traits are collected in map order afterwards to keep the
+    // component list deterministic.
+    std::vector<std::pair<const C2String *, ComponentLoader *>> loaders;
     for (auto &pathAndLoader : mComponents) {
-        const C2String &path = pathAndLoader.first;
-        ComponentLoader &loader = pathAndLoader.second;
-        std::shared_ptr<ComponentModule> module;
-        if (loader.fetchModule(&module) == C2_OK) {
-            std::shared_ptr<const C2Component::Traits> traits = module->getTraits();
-            if (traits) {
-                mComponentList.push_back(traits);
-                mComponentNameToPath.emplace(traits->name, path);
-                for (const C2String &alias : traits->aliases) {
-                    mComponentNameToPath.emplace(alias, path);
+        loaders.emplace_back(&pathAndLoader.first, &pathAndLoader.second);
+    }
+    std::vector<std::shared_ptr<ComponentModule>> modules(loaders.size());
+    constexpr size_t kMaxLoadThreads = 4;
+    size_t numThreads = std::min(kMaxLoadThreads, loaders.size());
+    if (numThreads > 1) {
+        std::atomic<size_t> nextIx(0);
+        std::vector<std::thread> pool;
+        for (size_t i = 0; i < numThreads; ++i) {
+            pool.emplace_back([&loaders, &modules, &nextIx] {
+                for (size_t ix = nextIx.fetch_add(1); ix < loaders.size();
+                        ix = nextIx.fetch_add(1)) {
+                    std::shared_ptr<ComponentModule> module;
+                    if (loaders[ix].second->fetchModule(&module) == C2_OK) {
+                        modules[ix] = module;
+                    }
                 }
+            });
+        }
+        for (std::thread &worker : pool) {
+            worker.join();
+        }
+    } else {
+        for (size_t ix = 0; ix < loaders.size(); ++ix) {
+            std::shared_ptr<ComponentModule> module;
+            if (loaders[ix].second->fetchModule(&module) == C2_OK) {
+                modules[ix] = module;
+            }
+        }
+    }
+    for (size_t ix = 0; ix < loaders.size(); ++ix) {
+        if (!modules[ix]) {
+            continue;
+        }
+        const C2String &path = *loaders[ix].first;
+        std::shared_ptr<const C2Component::Traits> traits = modules[ix]->getTraits();
+        if (traits) {
+            mComponentList.push_back(traits);
+            mComponentNameToPath.emplace(traits->name, path);
+            for (const C2String &alias : traits->aliases) {
+                mComponentNameToPath.emplace(alias, path);
             }
         }
     }
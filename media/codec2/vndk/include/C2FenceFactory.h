@@ -63,6 +63,23 @@ struct _C2FenceFactory {
      *                         still own the handle and have to close it.
      */
     static C2Fence CreateFromNativeHandle(const native_handle_t* handle);
+
+    /*
+     * Wait for a batch of fences with a single blocking call where possible.
+     *
+     * Fences backed by sync fds are polled together, so one syscall covers
+     * the whole batch instead of one wait per fence; fences without an fd
+     * (e.g. surface fences) are waited on individually against the same
+     * deadline. Already-signaled fences cost nothing.
+     *
+     * \param fences            Fences to wait for. Invalid/null fences are ignored.
+     * \param timeoutNs         Timeout for the whole batch. A negative value waits indefinitely.
+     *
+     * \retval C2_OK            all fences signaled
+     * \retval C2_TIMED_OUT     timeout expired with at least one fence pending
+     * \retval C2_CORRUPTED     a wait failed for an unknown reason
+     */
+    static c2_status_t WaitAllFences(const std::vector<C2Fence>& fences, c2_nsecs_t timeoutNs);
 };
 
 
@@ -131,6 +131,29 @@ static size_t getAdtsFrameLength(DataSourceHelper *source, off64_t offset, size_
     return frameSize;
 }
 
+// Returns the frame length in bytes from an ADTS header already in memory,
+//     or 0 if the header is invalid. The first six bytes of the header must
+//     be present. Mirrors getAdtsFrameLength() for buffered data.
+static size_t parseAdtsFrameLength(const uint8_t *data) {
+
+    const size_t kAdtsHeaderLengthNoCrc = 7;
+    const size_t kAdtsHeaderLengthWithCrc = 9;
+
+    if ((data[0] != 0xff) || ((data[1] & 0xf6) != 0xf0)) {
+        return 0;
+    }
+
+    size_t frameSize = (data[3] & 0x3) << 11 | data[4] << 3 | data[5] >> 5;
+
+    // protectionAbsent is 0 if there is CRC
+    size_t headSize = (data[1] & 0x1) ? kAdtsHeaderLengthNoCrc : kAdtsHeaderLengthWithCrc;
+    if (headSize > frameSize) {
+        return 0;
+    }
+
+    return frameSize;
+}
+
 AACExtractor::AACExtractor(
         DataSourceHelper *source, off64_t offset)
     : mDataSource(source),
@@ -160,8 +183,24 @@ AACExtractor::AACExtractor(
     int64_t duration = 0;
 
     if (mDataSource->getSize(&streamSize) == OK) {
-         while (offset < streamSize) {
-            if ((frameSize = getAdtsFrameLength(source, offset, NULL)) == 0) {
+        // Index the stream through a buffered window; parsing each header
+        // straight from the source costs three small reads per frame, which
+        // dominates open time on long streams.
+        const size_t kAdtsHeaderSize = 6;  // syncword through frame length
+        uint8_t window[8192];
+        off64_t windowOffset = 0;
+        ssize_t windowValid = 0;
+        while (offset < streamSize) {
+            if (offset < windowOffset
+                    || offset + (off64_t)kAdtsHeaderSize > windowOffset + windowValid) {
+                windowValid = mDataSource->readAt(offset, window, sizeof(window));
+                if (windowValid < (ssize_t)kAdtsHeaderSize) {
+                    break;
+                }
+                windowOffset = offset;
+            }
+
+            if ((frameSize = parseAdtsFrameLength(&window[offset - windowOffset])) == 0) {
                 ALOGW("prematured AAC stream (%lld vs %lld)",
                         (long long)offset, (long long)streamSize);
                 break;
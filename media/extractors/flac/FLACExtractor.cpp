@@ -93,6 +93,11 @@ class FLACParser {
 public:
     enum {
         kMaxChannels = FCC_8,
+        // Decode up to this many consecutive frames into one media buffer
+        // per read. High-rate multichannel material produces very short
+        // frames (a 4096-sample block is only ~21ms at 192kHz), and
+        // batching amortizes the per-buffer overhead across the decode.
+        kMaxFramesPerBuffer = 4,
     };
 
     explicit FLACParser(
@@ -153,6 +158,8 @@ private:
     // current position within the data source
     off64_t mCurrentPos;
     bool mEOF;
+    // set when the stream delivered an invalid frame; cleared on seek
+    bool mFatalError;
 
     // cached when the STREAMINFO metadata is parsed by libFLAC
     FLAC__StreamMetadata_StreamInfo mStreamInfo;
@@ -403,12 +410,15 @@ void FLACParser::errorCallback(FLAC__StreamDecoderErrorStatus status)
 // Copy samples from FLAC native 32-bit non-interleaved to 16-bit signed
 // or 32-bit float interleaved.
 // TODO: Consider moving to audio_utils.
-// These are candidates for optimization if needed.
-static void copyTo16Signed(
+// The implementations are templated on the channel count so the compiler
+// sees a constant inner-loop trip count and can unroll and vectorize the
+// interleave; with multichannel high-rate material this copy is a
+// significant part of the per-frame cost.
+template<unsigned nChannels>
+static void copyTo16SignedImpl(
         short *dst,
         const int *const *src,
         unsigned nSamples,
-        unsigned nChannels,
         unsigned bitsPerSample) {
     const int leftShift = 16 - (int)bitsPerSample; // cast to int to prevent unsigned overflow.
     if (leftShift >= 0) {
@@ -427,12 +437,45 @@ static void copyTo16Signed(
     }
 }
 
-static void copyToFloat(
-        float *dst,
+static void copyTo16Signed(
+        short *dst,
         const int *const *src,
         unsigned nSamples,
         unsigned nChannels,
         unsigned bitsPerSample) {
+    switch (nChannels) {
+    case 1: copyTo16SignedImpl<1>(dst, src, nSamples, bitsPerSample); break;
+    case 2: copyTo16SignedImpl<2>(dst, src, nSamples, bitsPerSample); break;
+    case 6: copyTo16SignedImpl<6>(dst, src, nSamples, bitsPerSample); break;
+    case 8: copyTo16SignedImpl<8>(dst, src, nSamples, bitsPerSample); break;
+    default:
+        {
+        const int leftShift = 16 - (int)bitsPerSample;
+        if (leftShift >= 0) {
+            for (unsigned i = 0; i < nSamples; ++i) {
+                for (unsigned c = 0; c < nChannels; ++c) {
+                    *dst++ = src[c][i] << leftShift;
+                }
+            }
+        } else {
+            const int rightShift = -leftShift;
+            for (unsigned i = 0; i < nSamples; ++i) {
+                for (unsigned c = 0; c < nChannels; ++c) {
+                    *dst++ = src[c][i] >> rightShift;
+                }
+            }
+        }
+        }
+        break;
+    }
+}
+
+template<unsigned nChannels>
+static void copyToFloatImpl(
+        float *dst,
+        const int *const *src,
+        unsigned nSamples,
+        unsigned bitsPerSample) {
     const unsigned leftShift = 32 - bitsPerSample;
     for (unsigned i = 0; i < nSamples; ++i) {
         for (unsigned c = 0; c < nChannels; ++c) {
@@ -441,6 +484,30 @@ static void copyToFloat(
     }
 }
 
+static void copyToFloat(
+        float *dst,
+        const int *const *src,
+        unsigned nSamples,
+        unsigned nChannels,
+        unsigned bitsPerSample) {
+    switch (nChannels) {
+    case 1: copyToFloatImpl<1>(dst, src, nSamples, bitsPerSample); break;
+    case 2: copyToFloatImpl<2>(dst, src, nSamples, bitsPerSample); break;
+    case 6: copyToFloatImpl<6>(dst, src, nSamples, bitsPerSample); break;
+    case 8: copyToFloatImpl<8>(dst, src, nSamples, bitsPerSample); break;
+    default:
+        {
+        const unsigned leftShift = 32 - bitsPerSample;
+        for (unsigned i = 0; i < nSamples; ++i) {
+            for (unsigned c = 0; c < nChannels; ++c) {
+                *dst++ = float_from_i32(src[c][i] << leftShift);
+            }
+        }
+        }
+        break;
+    }
+}
+
 // FLACParser
 
 FLACParser::FLACParser(
@@ -458,6 +525,7 @@ FLACParser::FLACParser(
       mDecoder(NULL),
       mCurrentPos(0LL),
       mEOF(false),
+      mFatalError(false),
       mStreamInfoValid(false),
       mWriteRequested(false),
       mWriteCompleted(false),
@@ -562,7 +630,8 @@ status_t FLACParser::init()
                 AMEDIAFORMAT_KEY_MIME, MEDIA_MIMETYPE_AUDIO_FLAC);
     }
     mMaxBufferSize = getMaxBlockSize() * getChannels() * getOutputSampleSize();
-    AMediaFormat_setInt32(mTrackMetadata, AMEDIAFORMAT_KEY_MAX_INPUT_SIZE, mMaxBufferSize);
+    AMediaFormat_setInt32(mTrackMetadata, AMEDIAFORMAT_KEY_MAX_INPUT_SIZE,
+            mMaxBufferSize * kMaxFramesPerBuffer);
     return OK;
 }
 
@@ -570,7 +639,7 @@ void FLACParser::allocateBuffers(MediaBufferGroupHelper *group)
 {
     CHECK(mGroup == NULL);
     mGroup = group;
-    mGroup->add_buffer(mMaxBufferSize);
+    mGroup->add_buffer(mMaxBufferSize * kMaxFramesPerBuffer);
 }
 
 void FLACParser::releaseBuffers()
@@ -579,68 +648,94 @@ void FLACParser::releaseBuffers()
 
 MediaBufferHelper *FLACParser::readBuffer(bool doSeek, FLAC__uint64 sample)
 {
-    mWriteRequested = true;
-    mWriteCompleted = false;
     if (doSeek) {
-        // We implement the seek callback, so this works without explicit flush
-        if (!FLAC__stream_decoder_seek_absolute(mDecoder, sample)) {
-            ALOGE("FLACParser::readBuffer seek to sample %lld failed", (long long)sample);
-            return NULL;
-        }
-        ALOGV("FLACParser::readBuffer seek to sample %lld succeeded", (long long)sample);
-    } else {
-        if (!FLAC__stream_decoder_process_single(mDecoder)) {
-            ALOGE("FLACParser::readBuffer process_single failed");
-            return NULL;
-        }
-    }
-    if (!mWriteCompleted) {
-        ALOGV("FLACParser::readBuffer write did not complete");
-        return NULL;
-    }
-    // verify that block header keeps the promises made by STREAMINFO
-    unsigned blocksize = mWriteHeader.blocksize;
-    if (blocksize == 0 || blocksize > getMaxBlockSize()) {
-        ALOGE("FLACParser::readBuffer write invalid blocksize %u", blocksize);
+        mFatalError = false;
+    } else if (mFatalError) {
         return NULL;
     }
-    if (mWriteHeader.sample_rate != getSampleRate() ||
-        mWriteHeader.channels != getChannels() ||
-        mWriteHeader.bits_per_sample != getBitsPerSample()) {
-        ALOGE("FLACParser::readBuffer write changed parameters mid-stream: %d/%d/%d -> %d/%d/%d",
-                getSampleRate(), getChannels(), getBitsPerSample(),
-                mWriteHeader.sample_rate, mWriteHeader.channels, mWriteHeader.bits_per_sample);
-        return NULL;
+
+    MediaBufferHelper *buffer = NULL;
+    size_t bufferOffset = 0;
+    int64_t timeUs = 0;
+
+    // Decode up to kMaxFramesPerBuffer consecutive frames into one buffer.
+    for (unsigned frames = 0; frames < kMaxFramesPerBuffer; ++frames) {
+        mWriteRequested = true;
+        mWriteCompleted = false;
+        if (doSeek && frames == 0) {
+            // We implement the seek callback, so this works without explicit flush
+            if (!FLAC__stream_decoder_seek_absolute(mDecoder, sample)) {
+                ALOGE("FLACParser::readBuffer seek to sample %lld failed", (long long)sample);
+                return NULL;
+            }
+            ALOGV("FLACParser::readBuffer seek to sample %lld succeeded", (long long)sample);
+        } else {
+            if (!FLAC__stream_decoder_process_single(mDecoder)) {
+                ALOGE("FLACParser::readBuffer process_single failed");
+                break;
+            }
+        }
+        if (!mWriteCompleted) {
+            ALOGV("FLACParser::readBuffer write did not complete");
+            break;
+        }
+        // verify that block header keeps the promises made by STREAMINFO
+        unsigned blocksize = mWriteHeader.blocksize;
+        if (blocksize == 0 || blocksize > getMaxBlockSize()) {
+            ALOGE("FLACParser::readBuffer write invalid blocksize %u", blocksize);
+            mFatalError = true;
+            break;
+        }
+        if (mWriteHeader.sample_rate != getSampleRate() ||
+            mWriteHeader.channels != getChannels() ||
+            mWriteHeader.bits_per_sample != getBitsPerSample()) {
+            ALOGE("FLACParser::readBuffer write changed parameters mid-stream: %d/%d/%d -> %d/%d/%d",
+                    getSampleRate(), getChannels(), getBitsPerSample(),
+                    mWriteHeader.sample_rate, mWriteHeader.channels, mWriteHeader.bits_per_sample);
+            mFatalError = true;
+            break;
+        }
+        if (buffer == NULL) {
+            // acquire a media buffer
+            CHECK(mGroup != NULL);
+            status_t err = mGroup->acquire_buffer(&buffer);
+            if (err != OK) {
+                return NULL;
+            }
+            // the buffer is stamped with the time of its first frame
+            CHECK(mWriteHeader.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER);
+            FLAC__uint64 sampleNumber = mWriteHeader.number.sample_number;
+            timeUs = (1000000LL * sampleNumber) / getSampleRate();
+        }
+        const size_t frameSize = blocksize * getChannels() * getOutputSampleSize();
+        CHECK(bufferOffset + frameSize <= mMaxBufferSize * kMaxFramesPerBuffer);
+        // copy PCM from FLAC write buffer to our media buffer, with interleaving
+        const unsigned bitsPerSample = getBitsPerSample();
+        uint8_t *dst = reinterpret_cast<uint8_t*>(buffer->data()) + bufferOffset;
+        if (mOutputFloat) {
+            copyToFloat(reinterpret_cast<float*>(dst),
+                        mWriteBuffer,
+                        blocksize,
+                        getChannels(),
+                        bitsPerSample);
+        } else {
+            copyTo16Signed(reinterpret_cast<short*>(dst),
+                           mWriteBuffer,
+                           blocksize,
+                           getChannels(),
+                           bitsPerSample);
+        }
+        bufferOffset += frameSize;
+        // stop batching if a worst-case frame would no longer fit
+        if (bufferOffset + mMaxBufferSize > mMaxBufferSize * kMaxFramesPerBuffer) {
+            break;
+        }
     }
-    // acquire a media buffer
-    CHECK(mGroup != NULL);
-    MediaBufferHelper *buffer;
-    status_t err = mGroup->acquire_buffer(&buffer);
-    if (err != OK) {
+    if (buffer == NULL) {
         return NULL;
     }
-    const size_t bufferSize = blocksize * getChannels() * getOutputSampleSize();
-    CHECK(bufferSize <= mMaxBufferSize);
-    buffer->set_range(0, bufferSize);
-    // copy PCM from FLAC write buffer to our media buffer, with interleaving
-    const unsigned bitsPerSample = getBitsPerSample();
-    if (mOutputFloat) {
-        copyToFloat(reinterpret_cast<float*>(buffer->data()),
-                    mWriteBuffer,
-                    blocksize,
-                    getChannels(),
-                    bitsPerSample);
-    } else {
-        copyTo16Signed(reinterpret_cast<short*>(buffer->data()),
-                       mWriteBuffer,
-                       blocksize,
-                       getChannels(),
-                       bitsPerSample);
-    }
+    buffer->set_range(0, bufferOffset);
     // fill in buffer metadata
-    CHECK(mWriteHeader.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER);
-    FLAC__uint64 sampleNumber = mWriteHeader.number.sample_number;
-    int64_t timeUs = (1000000LL * sampleNumber) / getSampleRate();
     AMediaFormat *meta = buffer->meta_data();
     AMediaFormat_setInt64(meta, AMEDIAFORMAT_KEY_TIME_US, timeUs);
     AMediaFormat_setInt32(meta, AMEDIAFORMAT_KEY_IS_SYNC_FRAME, 1);
@@ -230,6 +230,58 @@ const mkvparser::CuePoint::TrackPosition *MatroskaExtractor::TrackInfo::find(
     return cp->Find(track);
 }
 
+// Don't index keyframes closer together than this; the index only needs to
+// provide a nearby starting cluster for seekwithoutcue_l(), and the spacing
+// bounds its memory use on intra-only streams.
+static const long long kMinKeyframeIndexSpacingNs = 1000000000ll;
+
+void MatroskaExtractor::recordKeyframe_l(
+        long long timeNs, const mkvparser::Cluster *cluster) {
+    // The index stays sorted by time; entries mostly arrive in order during
+    // linear playback, so search from the back.
+    size_t i = mKeyframeIndex.size();
+    while (i > 0 && mKeyframeIndex.itemAt(i - 1).mTimeNs > timeNs) {
+        --i;
+    }
+
+    if (i > 0
+            && timeNs - mKeyframeIndex.itemAt(i - 1).mTimeNs
+                    < kMinKeyframeIndexSpacingNs) {
+        return;
+    }
+    if (i < mKeyframeIndex.size()
+            && mKeyframeIndex.itemAt(i).mTimeNs - timeNs
+                    < kMinKeyframeIndexSpacingNs) {
+        return;
+    }
+
+    KeyframeEntry entry;
+    entry.mTimeNs = timeNs;
+    entry.mCluster = cluster;
+    mKeyframeIndex.insertAt(entry, i);
+}
+
+const MatroskaExtractor::KeyframeEntry *MatroskaExtractor::findIndexedKeyframe_l(
+        long long timeNs) const {
+    // Binary search for the last indexed keyframe at or before timeNs.
+    size_t lo = 0;
+    size_t hi = mKeyframeIndex.size();
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (mKeyframeIndex.itemAt(mid).mTimeNs <= timeNs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        return NULL;
+    }
+
+    return &mKeyframeIndex.itemAt(lo - 1);
+}
+
 MatroskaSource::MatroskaSource(
         MatroskaExtractor *extractor, size_t index)
     : mExtractor(extractor),
@@ -410,6 +462,10 @@ void BlockIterator::advance_l() {
         ++mBlockEntryIndex;
 
         if (mBlockEntry->GetBlock()->GetTrackNumber() == mTrackNum) {
+            if (mTrackType == 1 && mBlockEntry->GetBlock()->IsKey()) {
+                mExtractor->recordKeyframe_l(
+                        mBlockEntry->GetBlock()->GetTime(mCluster), mCluster);
+            }
             break;
         }
     }
@@ -585,6 +641,18 @@ int64_t BlockIterator::blockTimeUs() const {
 
 void BlockIterator::seekwithoutcue_l(int64_t seekTimeUs, int64_t *actualFrameTimeUs) {
     mCluster = mExtractor->mSegment->FindCluster(seekTimeUs * 1000ll);
+
+    // If an already indexed keyframe lies between the cluster FindCluster
+    // picked and the seek point, start there instead. The walk below then
+    // only covers territory that has never been parsed before.
+    const MatroskaExtractor::KeyframeEntry *indexed =
+        mExtractor->findIndexedKeyframe_l(seekTimeUs * 1000ll);
+    if (indexed != NULL
+            && (mCluster == NULL || mCluster->EOS()
+                    || indexed->mCluster->GetTime() > mCluster->GetTime())) {
+        mCluster = indexed->mCluster;
+    }
+
     const long status = mCluster->GetFirst(mBlockEntry);
     if (status < 0) {  // error
         ALOGE("get last blockenry failed!");
@@ -1395,13 +1463,18 @@ MatroskaExtractor::MatroskaExtractor(DataSourceHelper *source)
                 }
             }
 
+            long len;
+            ret = mSegment->LoadCluster(pos, len);
             if (mCues) {
-                long len;
-                ret = mSegment->LoadCluster(pos, len);
                 ALOGV("has Cue data, Cluster num=%ld", mSegment->GetCount());
             } else  {
-                long status_Load = mSegment->Load();
-                ALOGW("no Cue data,Segment Load status:%ld",status_Load);
+                // Don't Load() the whole segment here; that scans every
+                // cluster in the file on the caller thread before the first
+                // sample can be read. Clusters are parsed on demand as
+                // playback and seeks advance through the segment, and
+                // BlockIterator builds a keyframe index along the way so
+                // that seeks into parsed territory stay cheap.
+                ALOGV("no Cue data, Cluster num=%ld", mSegment->GetCount());
             }
         } else if (ret > 0) {
             ret = mkvparser::E_BUFFER_NOT_FULL;
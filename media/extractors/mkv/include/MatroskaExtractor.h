@@ -81,8 +81,18 @@ private:
         const mkvparser::CuePoint::TrackPosition *find(long long timeNs) const;
     };
 
+    // One video keyframe encountered while parsing clusters. For files
+    // without Cues this index is grown incrementally as playback and seeks
+    // walk the segment, so repeated seeks into territory that has already
+    // been parsed become binary searches instead of linear cluster walks.
+    struct KeyframeEntry {
+        long long mTimeNs;
+        const mkvparser::Cluster *mCluster;
+    };
+
     Mutex mLock;
     Vector<TrackInfo> mTracks;
+    Vector<KeyframeEntry> mKeyframeIndex;
 
     DataSourceHelper *mDataSource;
     DataSourceBaseReader *mReader;
@@ -105,6 +115,8 @@ private:
             const mkvparser::VideoTrack *vtrack,
             AMediaFormat *meta);
     bool isLiveStreaming() const;
+    void recordKeyframe_l(long long timeNs, const mkvparser::Cluster *cluster);
+    const KeyframeEntry *findIndexedKeyframe_l(long long timeNs) const;
 
     MatroskaExtractor(const MatroskaExtractor &);
     MatroskaExtractor &operator=(const MatroskaExtractor &);
@@ -34,6 +34,7 @@
 #include <media/stagefright/MediaErrors.h>
 #include <media/stagefright/MetaData.h>
 #include <utils/String8.h>
+#include <utils/Vector.h>
 
 namespace android {
 
@@ -133,6 +134,26 @@ static bool Resync(
             }
         }
 
+        if (*tmp != 0xff) {
+            // A frame sync begins with eleven 1-bits, so the first byte must
+            // be 0xff. Let memchr (vectorized in libc) skip runs of non-sync
+            // bytes in bulk instead of probing one byte at a time.
+            const uint8_t *candidate =
+                (const uint8_t *)memchr(tmp, 0xff, remainingBytes);
+            if (candidate == NULL) {
+                pos += remainingBytes;
+                tmp += remainingBytes;
+                remainingBytes = 0;
+                continue;
+            }
+            pos += candidate - tmp;
+            remainingBytes -= candidate - tmp;
+            tmp = const_cast<uint8_t *>(candidate);
+            if (remainingBytes < 4) {
+                continue;
+            }
+        }
+
         uint32_t header = U32_AT(tmp);
 
         if (match_header != 0 && (header & kMask) != (match_header & kMask)) {
@@ -239,6 +260,19 @@ private:
     int64_t mBasisTimeUs = 0;
     int64_t mSamplesRead = 0;
 
+    // Frame positions learned while playing files that carry no Xing/VBRI
+    // seek information. Later seeks into a region that has already been
+    // played restart from a recorded anchor instead of a bitrate estimate
+    // followed by a resync scan.
+    struct SeekTableEntry {
+        int64_t timeUs;
+        off64_t pos;
+    };
+    Vector<SeekTableEntry> mSeekTable;
+
+    bool findSeekAnchor(int64_t timeUs, SeekTableEntry *entry) const;
+    void recordSeekAnchor();
+
     MP3Source(const MP3Source &);
     MP3Source &operator=(const MP3Source &);
 };
@@ -438,6 +472,12 @@ media_status_t MP3Extractor::getTrackMetaData(
 // Set our max frame size to the nearest power of 2 above this size (aka, 4kB)
 const size_t MP3Source::kMaxFrameSize = (1 << 12); /* 4096 bytes */
 
+// Record at most one seek anchor per second of audio and stop once the
+// table is full; at 16 bytes per entry the table tops out at 128kB while
+// still covering over two hours of playback.
+static const int64_t kSeekAnchorSpacingUs = 1000000ll;
+static const size_t kMaxSeekTableEntries = 8192;
+
 MP3Source::MP3Source(
         AMediaFormat *meta, DataSourceHelper *source,
         off64_t first_frame_pos, uint32_t fixed_header,
@@ -483,6 +523,50 @@ media_status_t MP3Source::getFormat(AMediaFormat *meta) {
     return AMediaFormat_copy(meta, mMeta);
 }
 
+bool MP3Source::findSeekAnchor(int64_t timeUs, SeekTableEntry *entry) const {
+    // Binary search for the last anchor at or before timeUs.
+    size_t lo = 0;
+    size_t hi = mSeekTable.size();
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (mSeekTable.itemAt(mid).timeUs <= timeUs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        return false;
+    }
+
+    *entry = mSeekTable.itemAt(lo - 1);
+
+    // Only trust the anchor if the target falls within the span of audio
+    // that was actually played; past the end of the table a bitrate
+    // estimate gets closer to the target than the last anchor would.
+    return timeUs - entry->timeUs < 2 * kSeekAnchorSpacingUs;
+}
+
+void MP3Source::recordSeekAnchor() {
+    if (mSeekTable.size() >= kMaxSeekTableEntries) {
+        return;
+    }
+
+    if (!mSeekTable.isEmpty()) {
+        const SeekTableEntry &last = mSeekTable.itemAt(mSeekTable.size() - 1);
+        if (mCurrentTimeUs < last.timeUs + kSeekAnchorSpacingUs
+                || mCurrentPos <= last.pos) {
+            return;
+        }
+    }
+
+    SeekTableEntry entry;
+    entry.timeUs = mCurrentTimeUs;
+    entry.pos = mCurrentPos;
+    mSeekTable.push_back(entry);
+}
+
 media_status_t MP3Source::read(
         MediaBufferHelper **out, const ReadOptions *options) {
     *out = NULL;
@@ -493,8 +577,16 @@ media_status_t MP3Source::read(
 
     if (options != NULL && options->getSeekTo(&seekTimeUs, &mode)) {
         int64_t actualSeekTimeUs = seekTimeUs;
-        if (mSeeker == NULL
-                || !mSeeker->getOffsetForTime(&actualSeekTimeUs, &mCurrentPos)) {
+        SeekTableEntry anchor;
+        if (mSeeker != NULL
+                && mSeeker->getOffsetForTime(&actualSeekTimeUs, &mCurrentPos)) {
+            mCurrentTimeUs = actualSeekTimeUs;
+        } else if (findSeekAnchor(seekTimeUs, &anchor)) {
+            // This region was played before; restart from the recorded
+            // frame position, no resync needed.
+            mCurrentTimeUs = anchor.timeUs;
+            mCurrentPos = anchor.pos;
+        } else {
             int32_t bitrate;
             if (!AMediaFormat_getInt32(mMeta, AMEDIAFORMAT_KEY_BIT_RATE, &bitrate)) {
                 // bitrate is in bits/sec.
@@ -513,8 +605,6 @@ media_status_t MP3Source::read(
                 return AMEDIA_ERROR_UNSUPPORTED;
             }
             seekCBR = true;
-        } else {
-            mCurrentTimeUs = actualSeekTimeUs;
         }
 
         mBasisTimeUs = mCurrentTimeUs;
@@ -588,6 +678,10 @@ media_status_t MP3Source::read(
 
     buffer->set_range(0, frame_size);
 
+    if (mSeeker == NULL) {
+        recordSeekAnchor();
+    }
+
     AMediaFormat *meta = buffer->meta_data();
     AMediaFormat_setInt64(meta, AMEDIAFORMAT_KEY_TIME_US, mCurrentTimeUs);
     AMediaFormat_setInt32(meta, AMEDIAFORMAT_KEY_IS_SYNC_FRAME, 1);
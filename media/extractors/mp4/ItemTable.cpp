@@ -47,7 +47,7 @@ struct ImageItem {
     ImageItem(uint32_t _type, uint32_t _id, bool _hidden) :
             type(_type), itemId(_id), hidden(_hidden),
             rows(0), columns(0), width(0), height(0), rotation(0),
-            offset(0), size(0), nextTileIndex(0) {}
+            offset(0), size(0), propertiesAttached(false), nextTileIndex(0) {}
 
     bool isGrid() const {
         return type == FOURCC("grid");
@@ -82,6 +82,7 @@ struct ImageItem {
     Vector<uint32_t> dimgRefs;
     Vector<uint32_t> exifRefs;
     Vector<uint32_t> xmpRefs;
+    bool propertiesAttached;
     size_t nextTileIndex;
 };
 
@@ -680,6 +681,16 @@ struct AssociationEntry {
     uint16_t index;
 };
 
+// Extent of one property box inside 'ipco'. Properties are indexed up front
+// but only parsed on first attach, since parsing may read payloads (hvcC,
+// av1C, ICC data) from the data source and most properties belong to items
+// the client never accesses (e.g. full-res tiles in thumbnail-only flows).
+struct PropertyExtent {
+    off64_t offset;
+    size_t size;
+    status_t status;    // NO_INIT until the box is parsed on first attach
+};
+
 struct ItemProperty : public RefBase {
     ItemProperty() {}
 
@@ -956,8 +967,9 @@ status_t IpmaBox::parse(off64_t offset, size_t size) {
 }
 
 struct IpcoBox : public Box {
-    IpcoBox(DataSourceHelper *source, Vector<sp<ItemProperty> > *properties) :
-        Box(source, FOURCC("ipco")), mItemProperties(properties) {}
+    IpcoBox(DataSourceHelper *source, Vector<sp<ItemProperty> > *properties,
+            Vector<PropertyExtent> *extents) :
+        Box(source, FOURCC("ipco")), mItemProperties(properties), mExtents(extents) {}
 
     status_t parse(off64_t offset, size_t size);
 protected:
@@ -965,12 +977,14 @@ protected:
 
 private:
     Vector<sp<ItemProperty> > *mItemProperties;
+    Vector<PropertyExtent> *mExtents;
 };
 
 status_t IpcoBox::parse(off64_t offset, size_t size) {
     ALOGV("%s: offset %lld, size %zu", __FUNCTION__, (long long)offset, size);
     // push a placeholder as the index is 1-based
     mItemProperties->push_back(new ItemProperty());
+    mExtents->push_back({ 0, 0, OK });
     return parseChunks(offset, size);
 }
 
@@ -1009,20 +1023,20 @@ status_t IpcoBox::onChunkData(uint32_t type, off64_t offset, size_t size) {
             break;
         }
     }
-    status_t err = itemProperty->parse(offset, size);
-    if (err != OK) {
-        return err;
-    }
+    // Only record the box extent here; the property is parsed on first
+    // attach in ItemTable::attachProperty().
     mItemProperties->push_back(itemProperty);
+    mExtents->push_back({ offset, size, NO_INIT });
     return OK;
 }
 
 struct IprpBox : public Box {
     IprpBox(DataSourceHelper *source,
             Vector<sp<ItemProperty> > *properties,
+            Vector<PropertyExtent> *extents,
             Vector<AssociationEntry> *associations) :
         Box(source, FOURCC("iprp")),
-        mProperties(properties), mAssociations(associations) {}
+        mProperties(properties), mExtents(extents), mAssociations(associations) {}
 
     status_t parse(off64_t offset, size_t size);
 protected:
@@ -1030,6 +1044,7 @@ protected:
 
 private:
     Vector<sp<ItemProperty> > *mProperties;
+    Vector<PropertyExtent> *mExtents;
     Vector<AssociationEntry> *mAssociations;
 };
 
@@ -1047,7 +1062,7 @@ status_t IprpBox::onChunkData(uint32_t type, off64_t offset, size_t size) {
     switch(type) {
         case FOURCC("ipco"):
         {
-            IpcoBox ipcoBox(source(), mProperties);
+            IpcoBox ipcoBox(source(), mProperties, mExtents);
             return ipcoBox.parse(offset, size);
         }
         case FOURCC("ipma"):
@@ -1366,7 +1381,7 @@ status_t ItemTable::parsePitmBox(off64_t offset, size_t size) {
 status_t ItemTable::parseIprpBox(off64_t offset, size_t size) {
     ALOGV("%s: offset %lld, size %zu", __FUNCTION__, (long long)offset, size);
 
-    IprpBox iprpBox(mDataSource, &mItemProperties, &mAssociations);
+    IprpBox iprpBox(mDataSource, &mItemProperties, &mPropertyExtents, &mAssociations);
     status_t err = iprpBox.parse(offset, size);
     if (err != OK) {
         return err;
@@ -1486,9 +1501,9 @@ status_t ItemTable::buildImageItemsIfPossible(uint32_t type) {
         mItemIdToItemMap.add(info.itemId, image);
     }
 
-    for (size_t i = 0; i < mAssociations.size(); i++) {
-        attachProperty(mAssociations[i]);
-    }
+    // Note: property attachment is deferred to attachProperties(), called on
+    // first access of each item. Displayability below only depends on the
+    // hidden flags from 'infe' and 'iref', not on any property.
 
     for (size_t i = 0; i < mItemReferences.size(); i++) {
         mItemReferences[i]->apply(mItemIdToItemMap, mItemIdToMetaMap);
@@ -1521,6 +1536,19 @@ status_t ItemTable::buildImageItemsIfPossible(uint32_t type) {
     return OK;
 }
 
+void ItemTable::attachProperties(ImageItem &image) {
+    if (image.propertiesAttached) {
+        return;
+    }
+    image.propertiesAttached = true;
+
+    for (size_t i = 0; i < mAssociations.size(); i++) {
+        if (mAssociations[i].itemId == image.itemId) {
+            attachProperty(mAssociations[i]);
+        }
+    }
+}
+
 void ItemTable::attachProperty(const AssociationEntry &association) {
     ssize_t itemIndex = mItemIdToItemMap.indexOfKey(association.itemId);
 
@@ -1535,6 +1563,18 @@ void ItemTable::attachProperty(const AssociationEntry &association) {
         return;
     }
 
+    PropertyExtent &extent = mPropertyExtents.editItemAt(propertyIndex);
+    if (extent.status == NO_INIT) {
+        // first attach of this property, materialize it now
+        extent.status = mItemProperties[propertyIndex]->parse(extent.offset, extent.size);
+        if (extent.status != OK) {
+            ALOGW("Ignoring malformed property %d (err %d)", propertyIndex, extent.status);
+        }
+    }
+    if (extent.status != OK) {
+        return;
+    }
+
     ALOGV("attach property %d to item id %d)",
             propertyIndex, association.itemId);
 
@@ -1557,6 +1597,7 @@ AMediaFormat *ItemTable::getImageMeta(const uint32_t imageIndex) {
     const uint32_t itemIndex = mDisplayables[imageIndex];
     ALOGV("image[%u]: item index %u", imageIndex, itemIndex);
 
+    attachProperties(mItemIdToItemMap.editValueAt(itemIndex));
     const ImageItem *image = &mItemIdToItemMap[itemIndex];
 
     ssize_t tileItemIndex = -1;
@@ -1602,7 +1643,8 @@ AMediaFormat *ItemTable::getImageMeta(const uint32_t imageIndex) {
     if (!image->thumbnails.empty()) {
         ssize_t thumbItemIndex = mItemIdToItemMap.indexOfKey(image->thumbnails[0]);
         if (thumbItemIndex >= 0) {
-            const ImageItem &thumbnail = mItemIdToItemMap[thumbItemIndex];
+            ImageItem &thumbnail = mItemIdToItemMap.editValueAt(thumbItemIndex);
+            attachProperties(thumbnail);
             if (thumbnail.hvcc != NULL || thumbnail.av1c != NULL) {
                 AMediaFormat_setInt32(meta,
                         AMEDIAFORMAT_KEY_THUMBNAIL_WIDTH, thumbnail.width);
@@ -1637,6 +1679,7 @@ AMediaFormat *ItemTable::getImageMeta(const uint32_t imageIndex) {
         AMediaFormat_setInt32(meta,
                 AMEDIAFORMAT_KEY_GRID_COLUMNS, image->columns);
         // point image to the first tile for grid size and HVCC
+        attachProperties(mItemIdToItemMap.editValueAt(tileItemIndex));
         image = &mItemIdToItemMap.editValueAt(tileItemIndex);
         AMediaFormat_setInt32(meta,
                 AMEDIAFORMAT_KEY_TILE_WIDTH, image->width);
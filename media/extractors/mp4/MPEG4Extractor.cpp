@@ -20,8 +20,11 @@
 #include <ctype.h>
 #include <inttypes.h>
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -741,6 +744,10 @@ status_t MPEG4Extractor::readMetaData() {
         }
     }
 
+    if (mInitCheck == OK && (err = loadSampleTables()) != OK) {
+        mInitCheck = err;
+    }
+
     if (mInitCheck == OK) {
         if (findTrackByMimePrefix("video/") != NULL) {
             AMediaFormat_setString(mFileMetaData,
@@ -790,6 +797,56 @@ status_t MPEG4Extractor::readMetaData() {
     return mInitCheck;
 }
 
+status_t MPEG4Extractor::loadSampleTables() {
+    std::vector<sp<SampleTable>> tables;
+    for (Track *track = mFirstTrack; track != NULL; track = track->next) {
+        if (track->sampleTable != NULL) {
+            tables.push_back(track->sampleTable);
+        }
+    }
+
+    if (tables.empty()) {
+        return OK;
+    }
+
+    if (tables.size() == 1) {
+        return tables[0]->loadTables();
+    }
+
+    // Each track's tables are independent, so load them concurrently;
+    // multi-track files then open in roughly the time of their largest
+    // track instead of the sum of all tracks. Duplicates in |tables|
+    // (track_b shares track_a's table for 'mpeg' tracks) are fine,
+    // loadTables() is idempotent and serializes on the table's own lock.
+    const size_t numWorkers = std::min(tables.size(), (size_t)4);
+    std::atomic<size_t> nextTable(0);
+    std::atomic<status_t> result(OK);
+
+    std::vector<std::thread> workers;
+    workers.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([&] {
+            for (;;) {
+                size_t index = nextTable.fetch_add(1);
+                if (index >= tables.size() || result.load() != OK) {
+                    break;
+                }
+                status_t err = tables[index]->loadTables();
+                if (err != OK) {
+                    status_t expected = OK;
+                    result.compare_exchange_strong(expected, err);
+                }
+            }
+        });
+    }
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    return result.load();
+}
+
 struct PathAdder {
     PathAdder(Vector<uint32_t> *path, uint32_t chunkType)
         : mPath(path) {
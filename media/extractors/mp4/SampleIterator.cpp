@@ -36,7 +36,13 @@ SampleIterator::SampleIterator(SampleTable *table)
       mTTSSampleIndex(0),
       mTTSSampleTime(0),
       mTTSCount(0),
-      mTTSDuration(0) {
+      mTTSDuration(0),
+      mCacheAge(0) {
+    for (size_t i = 0; i < kNumCachePages; ++i) {
+        mCachePages[i].mOffset = -1;
+        mCachePages[i].mLength = 0;
+        mCachePages[i].mAge = 0;
+    }
     reset();
 }
 
@@ -199,6 +205,69 @@ status_t SampleIterator::findChunkRange(uint32_t sampleIndex) {
     return OK;
 }
 
+// Serves table entry reads out of a small LRU of page-sized runs so that
+// iterating the (never fully materialized) chunk offset and sample size
+// tables does not issue one tiny read per entry against the data source.
+status_t SampleIterator::readAtCached(off64_t offset, void *data, size_t size) {
+    uint8_t *dst = (uint8_t *)data;
+
+    while (size > 0) {
+        off64_t pageOffset = (offset / kCachePageSize) * kCachePageSize;
+
+        CachePage *page = NULL;
+        for (size_t i = 0; i < kNumCachePages; ++i) {
+            if (mCachePages[i].mOffset == pageOffset) {
+                page = &mCachePages[i];
+                break;
+            }
+        }
+
+        if (page == NULL) {
+            // evict the least recently used page
+            page = &mCachePages[0];
+            for (size_t i = 1; i < kNumCachePages; ++i) {
+                if (mCachePages[i].mAge < page->mAge) {
+                    page = &mCachePages[i];
+                }
+            }
+
+            ssize_t n = mTable->mDataSource->readAt(
+                    pageOffset, page->mData, kCachePageSize);
+            if (n <= 0) {
+                page->mOffset = -1;
+                page->mLength = 0;
+                return ERROR_IO;
+            }
+            page->mOffset = pageOffset;
+            page->mLength = (size_t)n;
+        }
+
+        page->mAge = ++mCacheAge;
+
+        size_t pageIndex = offset - pageOffset;
+        if (pageIndex >= page->mLength) {
+            return ERROR_IO;
+        }
+
+        size_t copy = page->mLength - pageIndex;
+        if (copy > size) {
+            copy = size;
+        }
+        memcpy(dst, page->mData + pageIndex, copy);
+
+        dst += copy;
+        offset += copy;
+        size -= copy;
+
+        if (size > 0 && page->mLength < kCachePageSize) {
+            // short page not at a page boundary; nothing further to read
+            return ERROR_IO;
+        }
+    }
+
+    return OK;
+}
+
 status_t SampleIterator::getChunkOffset(uint32_t chunk, off64_t *offset) {
     *offset = 0;
 
@@ -209,10 +278,10 @@ status_t SampleIterator::getChunkOffset(uint32_t chunk, off64_t *offset) {
     if (mTable->mChunkOffsetType == SampleTable::kChunkOffsetType32) {
         uint32_t offset32;
 
-        if (mTable->mDataSource->readAt(
+        if (readAtCached(
                     mTable->mChunkOffsetOffset + 8 + 4 * chunk,
                     &offset32,
-                    sizeof(offset32)) < (ssize_t)sizeof(offset32)) {
+                    sizeof(offset32)) != OK) {
             return ERROR_IO;
         }
 
@@ -221,10 +290,10 @@ status_t SampleIterator::getChunkOffset(uint32_t chunk, off64_t *offset) {
         CHECK_EQ(mTable->mChunkOffsetType, SampleTable::kChunkOffsetType64);
 
         uint64_t offset64;
-        if (mTable->mDataSource->readAt(
+        if (readAtCached(
                     mTable->mChunkOffsetOffset + 8 + 8 * chunk,
                     &offset64,
-                    sizeof(offset64)) < (ssize_t)sizeof(offset64)) {
+                    sizeof(offset64)) != OK) {
             return ERROR_IO;
         }
 
@@ -251,9 +320,9 @@ status_t SampleIterator::getSampleSizeDirect(
         case 32:
         {
             uint32_t x;
-            if (mTable->mDataSource->readAt(
+            if (readAtCached(
                         mTable->mSampleSizeOffset + 12 + 4 * sampleIndex,
-                        &x, sizeof(x)) < (ssize_t)sizeof(x)) {
+                        &x, sizeof(x)) != OK) {
                 return ERROR_IO;
             }
 
@@ -264,9 +333,9 @@ status_t SampleIterator::getSampleSizeDirect(
         case 16:
         {
             uint16_t x;
-            if (mTable->mDataSource->readAt(
+            if (readAtCached(
                         mTable->mSampleSizeOffset + 12 + 2 * sampleIndex,
-                        &x, sizeof(x)) < (ssize_t)sizeof(x)) {
+                        &x, sizeof(x)) != OK) {
                 return ERROR_IO;
             }
 
@@ -277,9 +346,9 @@ status_t SampleIterator::getSampleSizeDirect(
         case 8:
         {
             uint8_t x;
-            if (mTable->mDataSource->readAt(
+            if (readAtCached(
                         mTable->mSampleSizeOffset + 12 + sampleIndex,
-                        &x, sizeof(x)) < (ssize_t)sizeof(x)) {
+                        &x, sizeof(x)) != OK) {
                 return ERROR_IO;
             }
 
@@ -292,9 +361,9 @@ status_t SampleIterator::getSampleSizeDirect(
             CHECK_EQ(mTable->mSampleSizeFieldSize, 4u);
 
             uint8_t x;
-            if (mTable->mDataSource->readAt(
+            if (readAtCached(
                         mTable->mSampleSizeOffset + 12 + sampleIndex / 2,
-                        &x, sizeof(x)) < (ssize_t)sizeof(x)) {
+                        &x, sizeof(x)) != OK) {
                 return ERROR_IO;
             }
 
@@ -126,10 +126,12 @@ SampleTable::SampleTable(DataSourceHelper *source)
       mDefaultSampleSize(0),
       mNumSampleSizes(0),
       mHasTimeToSample(false),
+      mTimeToSampleOffset(-1),
       mTimeToSampleCount(0),
       mTimeToSample(NULL),
       mSampleTimeEntries(NULL),
       mCompositionTimeDeltaEntries(NULL),
+      mCompositionDeltaOffset(-1),
       mNumCompositionTimeDeltaEntries(0),
       mCompositionDeltaLookup(new CompositionDeltaLookup),
       mSyncSampleOffset(-1),
@@ -137,7 +139,8 @@ SampleTable::SampleTable(DataSourceHelper *source)
       mSyncSamples(NULL),
       mLastSyncSampleIndex(0),
       mSampleToChunkEntries(NULL),
-      mTotalSize(0) {
+      mTotalSize(0),
+      mTablesLoaded(false) {
     mSampleIterator = new SampleIterator(this);
 }
 
@@ -284,26 +287,43 @@ status_t SampleTable::setSampleToChunkParams(
         return ERROR_MALFORMED;
     }
 
+    // The table payload is read by loadTables().
+    return OK;
+}
+
+status_t SampleTable::loadSampleToChunkEntries_l() {
+    if (mSampleToChunkEntries == NULL || mNumSampleToChunkOffsets == 0) {
+        return OK;
+    }
+
+    // The on-disk entries have the same 3x32-bit layout as
+    // SampleToChunkEntry, so read the whole table in one go and
+    // byteswap in place; reading entry by entry costs one tiny I/O
+    // per entry and dominated parse time for long recordings.
+    uint64_t readSize = (uint64_t)mNumSampleToChunkOffsets *
+            sizeof(SampleToChunkEntry);
+    if (mDataSource->readAt(
+                mSampleToChunkOffset + 8,
+                mSampleToChunkEntries,
+                (size_t)readSize) < (ssize_t)readSize) {
+        ALOGE("Incomplete data read for sample-to-chunk table.");
+        return ERROR_IO;
+    }
+
     for (uint32_t i = 0; i < mNumSampleToChunkOffsets; ++i) {
-        uint8_t buffer[sizeof(SampleToChunkEntry)];
-
-        if (mDataSource->readAt(
-                    mSampleToChunkOffset + 8 + i * sizeof(SampleToChunkEntry),
-                    buffer,
-                    sizeof(buffer))
-                != (ssize_t)sizeof(buffer)) {
-            return ERROR_IO;
-        }
+        uint32_t startChunk = ntohl(mSampleToChunkEntries[i].startChunk);
         // chunk index is 1 based in the spec.
-        if (U32_AT(buffer) < 1) {
+        if (startChunk < 1) {
             ALOGE("b/23534160");
             return ERROR_OUT_OF_RANGE;
         }
 
         // We want the chunk index to be 0-based.
-        mSampleToChunkEntries[i].startChunk = U32_AT(buffer) - 1;
-        mSampleToChunkEntries[i].samplesPerChunk = U32_AT(&buffer[4]);
-        mSampleToChunkEntries[i].chunkDesc = U32_AT(&buffer[8]);
+        mSampleToChunkEntries[i].startChunk = startChunk - 1;
+        mSampleToChunkEntries[i].samplesPerChunk =
+                ntohl(mSampleToChunkEntries[i].samplesPerChunk);
+        mSampleToChunkEntries[i].chunkDesc =
+                ntohl(mSampleToChunkEntries[i].chunkDesc);
     }
 
     return OK;
@@ -416,8 +436,20 @@ status_t SampleTable::setTimeToSampleParams(
         return ERROR_OUT_OF_RANGE;
     }
 
-    if (mDataSource->readAt(data_offset + 8, mTimeToSample,
-            (size_t)allocSize) < (ssize_t)allocSize) {
+    // The table payload is read by loadTables().
+    mTimeToSampleOffset = data_offset;
+    mHasTimeToSample = true;
+    return OK;
+}
+
+status_t SampleTable::loadTimeToSample_l() {
+    if (!mHasTimeToSample || mTimeToSampleCount == 0) {
+        return OK;
+    }
+
+    size_t readSize = mTimeToSampleCount * 2 * sizeof(uint32_t);
+    if (mDataSource->readAt(mTimeToSampleOffset + 8, mTimeToSample,
+            readSize) < (ssize_t)readSize) {
         ALOGE("Incomplete data read for time-to-sample table.");
         return ERROR_IO;
     }
@@ -426,7 +458,6 @@ status_t SampleTable::setTimeToSampleParams(
         mTimeToSample[i] = ntohl(mTimeToSample[i]);
     }
 
-    mHasTimeToSample = true;
     return OK;
 }
 
@@ -490,15 +521,27 @@ status_t SampleTable::setCompositionTimeToSampleParams(
         return ERROR_OUT_OF_RANGE;
     }
 
-    if (mDataSource->readAt(data_offset + 8, mCompositionTimeDeltaEntries,
-            (size_t)allocSize) < (ssize_t)allocSize) {
+    // The table payload is read by loadTables().
+    mCompositionDeltaOffset = data_offset;
+    return OK;
+}
+
+status_t SampleTable::loadCompositionTimeDeltas_l() {
+    if (mCompositionTimeDeltaEntries == NULL) {
+        return OK;
+    }
+
+    size_t readSize =
+            mNumCompositionTimeDeltaEntries * 2 * sizeof(int32_t);
+    if (mDataSource->readAt(mCompositionDeltaOffset + 8,
+            mCompositionTimeDeltaEntries, readSize) < (ssize_t)readSize) {
         delete[] mCompositionTimeDeltaEntries;
         mCompositionTimeDeltaEntries = NULL;
 
         return ERROR_IO;
     }
 
-    for (size_t i = 0; i < 2 * numEntries; ++i) {
+    for (size_t i = 0; i < 2 * mNumCompositionTimeDeltaEntries; ++i) {
         mCompositionTimeDeltaEntries[i] = ntohl(mCompositionTimeDeltaEntries[i]);
     }
 
@@ -561,14 +604,27 @@ status_t SampleTable::setSyncSampleParams(off64_t data_offset, size_t data_size)
         return ERROR_OUT_OF_RANGE;
     }
 
-    if (mDataSource->readAt(data_offset + 8, mSyncSamples,
-            (size_t)allocSize) != (ssize_t)allocSize) {
+    // The table payload is read by loadTables().
+    mSyncSampleOffset = data_offset;
+    mNumSyncSamples = numSyncSamples;
+
+    return OK;
+}
+
+status_t SampleTable::loadSyncSamples_l() {
+    if (mSyncSampleOffset < 0 || mNumSyncSamples == 0) {
+        return OK;
+    }
+
+    size_t readSize = mNumSyncSamples * sizeof(uint32_t);
+    if (mDataSource->readAt(mSyncSampleOffset + 8, mSyncSamples,
+            readSize) != (ssize_t)readSize) {
         delete[] mSyncSamples;
         mSyncSamples = NULL;
         return ERROR_IO;
     }
 
-    for (size_t i = 0; i < numSyncSamples; ++i) {
+    for (size_t i = 0; i < mNumSyncSamples; ++i) {
         if (mSyncSamples[i] == 0) {
             ALOGE("b/32423862, unexpected zero value in stss");
             continue;
@@ -576,8 +632,24 @@ status_t SampleTable::setSyncSampleParams(off64_t data_offset, size_t data_size)
         mSyncSamples[i] = ntohl(mSyncSamples[i]) - 1;
     }
 
-    mSyncSampleOffset = data_offset;
-    mNumSyncSamples = numSyncSamples;
+    return OK;
+}
+
+status_t SampleTable::loadTables() {
+    Mutex::Autolock autoLock(mLock);
+
+    if (mTablesLoaded) {
+        return OK;
+    }
+    mTablesLoaded = true;
+
+    status_t err;
+    if ((err = loadSampleToChunkEntries_l()) != OK
+            || (err = loadTimeToSample_l()) != OK
+            || (err = loadCompositionTimeDeltas_l()) != OK
+            || (err = loadSyncSamples_l()) != OK) {
+        return err;
+    }
 
     return OK;
 }
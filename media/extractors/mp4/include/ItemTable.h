@@ -39,6 +39,7 @@ struct ItemLoc;
 struct ItemInfo;
 struct ItemProperty;
 struct ItemReference;
+struct PropertyExtent;
 
 /*
  * ItemTable keeps track of all image items (including coded images, grids and
@@ -73,6 +74,11 @@ private:
     Vector<ItemInfo> mItemInfos;
     Vector<AssociationEntry> mAssociations;
     Vector<sp<ItemProperty> > mItemProperties;
+    // Box extents for mItemProperties, parallel to it. Property boxes are
+    // indexed during parsing but only materialized on first attach, so
+    // thumbnail-only clients don't pay for the properties of items they
+    // never access.
+    Vector<PropertyExtent> mPropertyExtents;
     Vector<sp<ItemReference> > mItemReferences;
 
     uint32_t mPrimaryItemId;
@@ -95,6 +101,7 @@ private:
     status_t parseIdatBox(off64_t offset, size_t size);
     status_t parseIrefBox(off64_t offset, size_t size);
 
+    void attachProperties(ImageItem &image);
     void attachProperty(const AssociationEntry &association);
     status_t buildImageItemsIfPossible(uint32_t type);
 
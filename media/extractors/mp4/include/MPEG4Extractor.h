@@ -158,6 +158,7 @@ private:
     KeyedVector<uint32_t, AString> mMetaKeyMap;
 
     status_t readMetaData();
+    status_t loadSampleTables();
     status_t parseChunk(off64_t *offset, int depth);
     status_t parseITunesMetaData(off64_t offset, size_t size);
     status_t parseColorInfo(off64_t offset, size_t size);
@@ -45,6 +45,22 @@ struct SampleIterator {
             uint32_t sampleIndex, size_t *size);
 
 private:
+    enum {
+        kCachePageSize = 4096,
+        kNumCachePages = 4,
+    };
+
+    // One page-sized run of raw stco/co64/stsz box data, decoded on demand.
+    // The chunk offset and sample size tables are never materialized in
+    // full; this small LRU bounds both memory use and the number of tiny
+    // reads issued against the data source by the per-entry accessors.
+    struct CachePage {
+        off64_t mOffset;   // file offset of the page start; -1 if unused
+        size_t mLength;    // valid bytes in mData
+        uint32_t mAge;     // last-use tick, for LRU eviction
+        uint8_t mData[kCachePageSize];
+    };
+
     SampleTable *mTable;
 
     bool mInitialized;
@@ -73,9 +89,13 @@ private:
     uint64_t mCurrentSampleTime;
     uint64_t mCurrentSampleDuration;
 
+    CachePage mCachePages[kNumCachePages];
+    uint32_t mCacheAge;
+
     void reset();
     status_t findChunkRange(uint32_t sampleIndex);
     status_t getChunkOffset(uint32_t chunk, off64_t *offset);
+    status_t readAtCached(off64_t offset, void *data, size_t size);
     status_t findSampleTimeAndDuration(uint32_t sampleIndex, uint64_t *time, uint64_t *duration);
 
     SampleIterator(const SampleIterator &);
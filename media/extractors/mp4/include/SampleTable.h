@@ -54,6 +54,14 @@ public:
 
     status_t setSyncSampleParams(off64_t data_offset, size_t data_size);
 
+    // Reads the bulk stsc/stts/ctts/stss table payloads whose headers and
+    // sizes were validated by the set*Params calls above. The heavy reads
+    // are split out of parsing so the extractor can load the tables of
+    // independent tracks concurrently. Idempotent; only the first call does
+    // any work. Must complete successfully before any of the sample query
+    // methods below are used.
+    status_t loadTables();
+
     ////////////////////////////////////////////////////////////////////////////
 
     uint32_t countChunkOffsets() const;
@@ -123,6 +131,7 @@ private:
     uint32_t mNumSampleSizes;
 
     bool mHasTimeToSample;
+    off64_t mTimeToSampleOffset;
     uint32_t mTimeToSampleCount;
     uint32_t* mTimeToSample;
 
@@ -133,6 +142,7 @@ private:
     SampleTimeEntry *mSampleTimeEntries;
 
     int32_t *mCompositionTimeDeltaEntries;
+    off64_t mCompositionDeltaOffset;
     size_t mNumCompositionTimeDeltaEntries;
     CompositionDeltaLookup *mCompositionDeltaLookup;
 
@@ -153,6 +163,9 @@ private:
     // Approximate size of all tables combined.
     uint64_t mTotalSize;
 
+    // Set once loadTables() has run (whether or not it succeeded).
+    bool mTablesLoaded;
+
     friend struct SampleIterator;
 
     // normally we don't round
@@ -168,6 +181,11 @@ private:
 
     static int CompareIncreasingTime(const void *, const void *);
 
+    status_t loadSampleToChunkEntries_l();
+    status_t loadTimeToSample_l();
+    status_t loadCompositionTimeDeltas_l();
+    status_t loadSyncSamples_l();
+
     void buildSampleEntriesTable();
 
     SampleTable(const SampleTable &);
@@ -346,9 +346,12 @@ status_t MyOggExtractor::findNextPage(
         off64_t startOffset, off64_t *pageOffset) {
     *pageOffset = startOffset;
 
+    // Scan through a block at a time instead of issuing a small read per
+    // candidate position; a seek landing mid-page otherwise costs hundreds
+    // of four-byte reads before the next page boundary is found.
+    uint8_t buffer[4096];
     for (;;) {
-        char signature[4];
-        ssize_t n = mSource->readAt(*pageOffset, &signature, 4);
+        ssize_t n = mSource->readAt(*pageOffset, buffer, sizeof(buffer));
 
         if (n < 4) {
             *pageOffset = 0;
@@ -356,22 +359,21 @@ status_t MyOggExtractor::findNextPage(
             return (n < 0) ? n : (status_t)ERROR_END_OF_STREAM;
         }
 
-        if (!memcmp(signature, "OggS", 4)) {
-            if (*pageOffset > startOffset) {
-                ALOGV("skipped %lld bytes of junk to reach next frame",
-                     (long long)(*pageOffset - startOffset));
-            }
+        for (ssize_t i = 0; i + 4 <= n; ++i) {
+            if (!memcmp(&buffer[i], "OggS", 4)) {
+                *pageOffset += i;
+                if (*pageOffset > startOffset) {
+                    ALOGV("skipped %lld bytes of junk to reach next frame",
+                         (long long)(*pageOffset - startOffset));
+                }
 
-            return OK;
+                return OK;
+            }
         }
 
-        // see how far ahead to skip; avoid some fruitless comparisons
-        unsigned int i;
-        for (i = 1; i < 4 ; i++) {
-            if (signature[i] == 'O')
-                break;
-        }
-        *pageOffset += i;
+        // The signature may straddle the end of the block; rescan its last
+        // three bytes together with the next block.
+        *pageOffset += n - 3;
     }
 }
 
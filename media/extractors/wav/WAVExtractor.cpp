@@ -90,6 +90,7 @@ protected:
 
 private:
     static const size_t kMaxFrameSize;
+    static const size_t kTargetFramesPerBuffer;
 
     DataSourceHelper *mDataSource;
     AMediaFormat *mMeta;
@@ -100,6 +101,7 @@ private:
     uint32_t mBitsPerSample;
     off64_t mOffset;
     size_t mSize;
+    size_t mMaxFrameSize;
     bool mStarted;
     off64_t mCurrentPos;
 
@@ -366,6 +368,12 @@ status_t WAVExtractor::init() {
 
 const size_t WAVSource::kMaxFrameSize = 32768;
 
+// A 32 KiB buffer holds ~8k frames of 16-bit stereo but only ~1k frames of
+// 8-channel float output. Scale buffers up for such content so each read()
+// round trip still moves a useful amount of audio; large buffers use shared
+// memory transfer.
+const size_t WAVSource::kTargetFramesPerBuffer = 4096;
+
 WAVSource::WAVSource(
         DataSourceHelper *dataSource,
         AMediaFormat *meta,
@@ -378,10 +386,18 @@ WAVSource::WAVSource(
       mOutputFloat(outputFloat),
       mOffset(offset),
       mSize(size),
+      mMaxFrameSize(kMaxFrameSize),
       mStarted(false) {
     CHECK(AMediaFormat_getInt32(mMeta, AMEDIAFORMAT_KEY_SAMPLE_RATE, (int32_t*) &mSampleRate));
     CHECK(AMediaFormat_getInt32(mMeta, AMEDIAFORMAT_KEY_CHANNEL_COUNT, (int32_t*) &mNumChannels));
     CHECK(AMediaFormat_getInt32(mMeta, AMEDIAFORMAT_KEY_BITS_PER_SAMPLE, (int32_t*) &mBitsPerSample));
+
+    if (mWaveFormat != WAVE_FORMAT_MSGSM) {
+        const size_t bytesPerOutputFrame = mNumChannels * (mOutputFloat ? 4 : 2);
+        if (bytesPerOutputFrame * kTargetFramesPerBuffer > mMaxFrameSize) {
+            mMaxFrameSize = bytesPerOutputFrame * kTargetFramesPerBuffer;
+        }
+    }
 }
 
 WAVSource::~WAVSource() {
@@ -396,7 +412,7 @@ media_status_t WAVSource::start() {
     CHECK(!mStarted);
 
     // some WAV files may have large audio buffers that use shared memory transfer.
-    if (!mBufferGroup->init(4 /* buffers */, kMaxFrameSize)) {
+    if (!mBufferGroup->init(4 /* buffers */, mMaxFrameSize)) {
         return AMEDIA_ERROR_UNKNOWN;
     }
 
@@ -422,7 +438,7 @@ media_status_t WAVSource::getFormat(AMediaFormat *meta) {
 
     const media_status_t status = AMediaFormat_copy(meta, mMeta);
     if (status == OK) {
-        AMediaFormat_setInt32(meta, AMEDIAFORMAT_KEY_MAX_INPUT_SIZE, kMaxFrameSize);
+        AMediaFormat_setInt32(meta, AMEDIAFORMAT_KEY_MAX_INPUT_SIZE, mMaxFrameSize);
         AMediaFormat_setInt32(meta, AMEDIAFORMAT_KEY_PCM_ENCODING,
                 mOutputFloat ? kAudioEncodingPcmFloat : kAudioEncodingPcm16bit);
     }
@@ -466,7 +482,7 @@ media_status_t WAVSource::read(
     }
 
     // maxBytesToRead may be reduced so that in-place data conversion will fit in buffer size.
-    const size_t bufferSize = std::min(buffer->size(), kMaxFrameSize);
+    const size_t bufferSize = std::min(buffer->size(), mMaxFrameSize);
     size_t maxBytesToRead;
     if (mOutputFloat) { // destination is float at 4 bytes per sample, source may be less.
         maxBytesToRead = (mBitsPerSample / 8) * (bufferSize / 4);
@@ -132,33 +132,42 @@ template<typename T>
 inline status_t EndianOutput::writeHelper(const T* buf, size_t offset, size_t count) {
     assert(offset <= count);
     status_t res = OK;
-    size_t size = sizeof(T);
-    switch(mEndian) {
-        case BIG: {
-            for (size_t i = offset; i < count; ++i) {
-                T tmp = convertToBigEndian<T>(buf[offset + i]);
-                if ((res = mOutput->write(reinterpret_cast<uint8_t*>(&tmp), 0, size))
-                        != OK) {
-                    return res;
+    const size_t size = sizeof(T);
+    // Swap elements into a local block and hand the wrapped Output whole
+    // blocks, rather than making one virtual write call per element. The
+    // per-element conversion loop is branch-free and trivially vectorizable
+    // (an identity copy when the target endianness matches the device).
+    constexpr size_t kBlockElements = 512 / sizeof(T);
+    T block[kBlockElements];
+    size_t i = offset;
+    while (i < count) {
+        size_t numThisBlock = count - i;
+        if (numThisBlock > kBlockElements) {
+            numThisBlock = kBlockElements;
+        }
+        switch(mEndian) {
+            case BIG: {
+                for (size_t j = 0; j < numThisBlock; ++j) {
+                    block[j] = convertToBigEndian<T>(buf[i + j]);
                 }
-                mOffset += size;
+                break;
             }
-            break;
-        }
-        case LITTLE: {
-            for (size_t i = offset; i < count; ++i) {
-                T tmp = convertToLittleEndian<T>(buf[offset + i]);
-                if ((res = mOutput->write(reinterpret_cast<uint8_t*>(&tmp), 0, size))
-                        != OK) {
-                    return res;
+            case LITTLE: {
+                for (size_t j = 0; j < numThisBlock; ++j) {
+                    block[j] = convertToLittleEndian<T>(buf[i + j]);
                 }
-                mOffset += size;
+                break;
+            }
+            default: {
+                return BAD_VALUE;
             }
-            break;
         }
-        default: {
-            return BAD_VALUE;
+        if ((res = mOutput->write(reinterpret_cast<uint8_t*>(block), 0,
+                numThisBlock * size)) != OK) {
+            return res;
         }
+        mOffset += numThisBlock * size;
+        i += numThisBlock;
     }
     return res;
 }
@@ -20,6 +20,9 @@
 
 #include "AAudioFlowGraph.h"
 
+#include <algorithm>
+
+#include <audio_utils/primitives.h>
 #include <flowgraph/ClipToRange.h>
 #include <flowgraph/ManyToMultiConverter.h>
 #include <flowgraph/MonoBlend.h>
@@ -37,6 +40,106 @@
 
 using namespace FLOWGRAPH_OUTER_NAMESPACE::flowgraph;
 
+namespace {
+// Per-sample conversions matching the flowgraph source and sink nodes.
+template <typename T> inline float fusedToFloat(T value);
+template <> inline float fusedToFloat<float>(float value) { return value; }
+template <> inline float fusedToFloat<int16_t>(int16_t value) {
+    return value * (1.0f / (1 << 15));
+}
+template <> inline float fusedToFloat<int32_t>(int32_t value) {
+    return value * (1.0f / (1u << 31));
+}
+
+template <typename T> inline T fusedFromFloat(float value);
+template <> inline float fusedFromFloat<float>(float value) { return value; }
+template <> inline int16_t fusedFromFloat<int16_t>(float value) {
+    return clamp16_from_float(value);
+}
+template <> inline int32_t fusedFromFloat<int32_t>(float value) {
+    return clamp32_from_float(value);
+}
+} // namespace
+
+template <typename T_SOURCE, typename T_SINK, bool WITH_CLIP, bool WITH_RAMP>
+void AAudioFlowGraph::fusedKernel(AAudioFlowGraph *graph,
+        const void *source, void *destination, int32_t numFrames) {
+    const T_SOURCE *in = static_cast<const T_SOURCE *>(source);
+    T_SINK *out = static_cast<T_SINK *>(destination);
+    const int32_t channelCount = graph->mFusedChannelCount;
+
+    if constexpr (WITH_RAMP) {
+        for (auto &ramp : graph->mFusedRamps) {
+            ramp->startSegment();
+        }
+        for (int32_t i = 0; i < numFrames; i++) {
+            for (int32_t channel = 0; channel < channelCount; channel++) {
+                float value = fusedToFloat<T_SOURCE>(*in++);
+                if constexpr (WITH_CLIP) {
+                    value = std::min(kDefaultMaxHeadroom,
+                            std::max(kDefaultMinHeadroom, value));
+                }
+                value *= graph->mFusedRamps[channel]->nextLevel();
+                *out++ = fusedFromFloat<T_SINK>(value);
+            }
+        }
+    } else {
+        const int32_t numSamples = numFrames * channelCount;
+        for (int32_t i = 0; i < numSamples; i++) {
+            float value = fusedToFloat<T_SOURCE>(*in++);
+            if constexpr (WITH_CLIP) {
+                value = std::min(kDefaultMaxHeadroom,
+                        std::max(kDefaultMinHeadroom, value));
+            }
+            *out++ = fusedFromFloat<T_SINK>(value);
+        }
+    }
+}
+
+template <typename T_SOURCE, typename T_SINK>
+AAudioFlowGraph::FusedKernel AAudioFlowGraph::pickFusedKernel(bool clip, bool ramp) {
+    if (clip) {
+        return ramp ? &fusedKernel<T_SOURCE, T_SINK, true, true>
+                    : &fusedKernel<T_SOURCE, T_SINK, true, false>;
+    }
+    return ramp ? &fusedKernel<T_SOURCE, T_SINK, false, true>
+                : &fusedKernel<T_SOURCE, T_SINK, false, false>;
+}
+
+template <typename T_SOURCE>
+AAudioFlowGraph::FusedKernel AAudioFlowGraph::pickFusedKernelForSink(
+        audio_format_t sinkFormat, bool clip, bool ramp) {
+    switch (sinkFormat) {
+        case AUDIO_FORMAT_PCM_FLOAT:
+            return pickFusedKernel<T_SOURCE, float>(clip, ramp);
+        case AUDIO_FORMAT_PCM_16_BIT:
+            return pickFusedKernel<T_SOURCE, int16_t>(clip, ramp);
+        case AUDIO_FORMAT_PCM_32_BIT:
+            return pickFusedKernel<T_SOURCE, int32_t>(clip, ramp);
+        default:
+            return nullptr;
+    }
+}
+
+bool AAudioFlowGraph::compileFusedKernel(audio_format_t sourceFormat,
+        audio_format_t sinkFormat, bool clip, bool ramp) {
+    switch (sourceFormat) {
+        case AUDIO_FORMAT_PCM_FLOAT:
+            mFusedKernel = pickFusedKernelForSink<float>(sinkFormat, clip, ramp);
+            break;
+        case AUDIO_FORMAT_PCM_16_BIT:
+            mFusedKernel = pickFusedKernelForSink<int16_t>(sinkFormat, clip, ramp);
+            break;
+        case AUDIO_FORMAT_PCM_32_BIT:
+            mFusedKernel = pickFusedKernelForSink<int32_t>(sinkFormat, clip, ramp);
+            break;
+        default: // packed 24 bit stays on the node graph
+            mFusedKernel = nullptr;
+            break;
+    }
+    return mFusedKernel != nullptr;
+}
+
 aaudio_result_t AAudioFlowGraph::configure(audio_format_t sourceFormat,
                           int32_t sourceChannelCount,
                           audio_format_t sinkFormat,
@@ -52,6 +155,25 @@ aaudio_result_t AAudioFlowGraph::configure(audio_format_t sourceFormat,
           __func__, sourceFormat, sourceChannelCount, sinkFormat, sinkChannelCount,
           useMonoBlend, audioBalance, isExclusive);
 
+    // Try to compile the graph into a single fused kernel first.
+    // Shapes the kernels do not cover fall back to the node graph below.
+    if (!useMonoBlend && sourceChannelCount == sinkChannelCount) {
+        const bool clip = sourceFormat == AUDIO_FORMAT_PCM_FLOAT
+                && sinkFormat == AUDIO_FORMAT_PCM_FLOAT;
+        if (compileFusedKernel(sourceFormat, sinkFormat, clip, isExclusive)) {
+            mFusedChannelCount = sourceChannelCount;
+            if (isExclusive) {
+                for (int i = 0; i < sinkChannelCount; i++) {
+                    mFusedRamps.emplace_back(std::make_unique<FusedRamp>());
+                    mPanningVolumes.emplace_back(1.0f);
+                }
+                setAudioBalance(audioBalance);
+            }
+            ALOGD("%s() compiled the graph into a fused kernel", __func__);
+            return AAUDIO_OK;
+        }
+    }
+
     switch (sourceFormat) {
         case AUDIO_FORMAT_PCM_FLOAT:
             mSource = std::make_unique<SourceFloat>(sourceChannelCount);
@@ -138,6 +260,10 @@ aaudio_result_t AAudioFlowGraph::configure(audio_format_t sourceFormat,
 }
 
 void AAudioFlowGraph::process(const void *source, void *destination, int32_t numFrames) {
+    if (mFusedKernel != nullptr) {
+        (*mFusedKernel)(this, source, destination, numFrames);
+        return;
+    }
     mSource->setData(source, numFrames);
     mSink->read(destination, numFrames);
 }
@@ -149,6 +275,9 @@ void AAudioFlowGraph::setTargetVolume(float volume) {
     for (int i = 0; i < mVolumeRamps.size(); i++) {
         mVolumeRamps[i]->setTarget(volume * mPanningVolumes[i]);
     }
+    for (int i = 0; i < mFusedRamps.size(); i++) {
+        mFusedRamps[i]->setTarget(volume * mPanningVolumes[i]);
+    }
     mTargetVolume = volume;
 }
 
@@ -162,8 +291,13 @@ void AAudioFlowGraph::setAudioBalance(float audioBalance) {
         mBalance.computeStereoBalance(audioBalance, &leftMultiplier, &rightMultiplier);
         mPanningVolumes[0] = leftMultiplier;
         mPanningVolumes[1] = rightMultiplier;
-        mVolumeRamps[0]->setTarget(mTargetVolume * leftMultiplier);
-        mVolumeRamps[1]->setTarget(mTargetVolume * rightMultiplier);
+        if (mFusedKernel != nullptr) {
+            mFusedRamps[0]->setTarget(mTargetVolume * leftMultiplier);
+            mFusedRamps[1]->setTarget(mTargetVolume * rightMultiplier);
+        } else {
+            mVolumeRamps[0]->setTarget(mTargetVolume * leftMultiplier);
+            mVolumeRamps[1]->setTarget(mTargetVolume * rightMultiplier);
+        }
     }
 }
 
@@ -174,4 +308,7 @@ void AAudioFlowGraph::setRampLengthInFrames(int32_t numFrames) {
     for (auto& ramp : mVolumeRamps) {
         ramp->setLengthInFrames(numFrames);
     }
+    for (auto& ramp : mFusedRamps) {
+        ramp->lengthInFrames = numFrames;
+    }
 }
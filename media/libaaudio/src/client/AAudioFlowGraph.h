@@ -17,9 +17,11 @@
 #ifndef ANDROID_AAUDIO_FLOW_GRAPH_H
 #define ANDROID_AAUDIO_FLOW_GRAPH_H
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 #include <sys/types.h>
+#include <vector>
 #include <system/audio.h>
 
 #include <aaudio/AAudio.h>
@@ -72,6 +74,86 @@ public:
     void setRampLengthInFrames(int32_t numFrames);
 
 private:
+    // ----- Compiled execution plan -----
+    // The graph shape is fixed once configure() returns, so the common chain
+    // source -> [clip] -> [per-channel volume ramps] -> sink with matching
+    // channel counts is compiled into a single kernel instantiated for the
+    // (source, sink) format pair, instead of interpreting the node graph with
+    // a virtual onProcess() hop per node every burst.  Graphs with mono
+    // blend, channel expansion, or packed 24 bit formats fall back to the
+    // node graph.
+    using FusedKernel = void (*)(AAudioFlowGraph *graph,
+            const void *source, void *destination, int32_t numFrames);
+
+    // Per-channel volume ramp state for the fused kernel.
+    // Mirrors the semantics of flowgraph::RampLinear.
+    struct FusedRamp {
+        std::atomic<float> target{1.0f};
+        int32_t  lengthInFrames = 48000 / 100; // 10 msec at 48000 Hz
+        int32_t  remaining = 0;
+        float    scaler = 0.0f;
+        float    levelFrom = 0.0f;
+        float    levelTo = 0.0f;
+        bool     used = false;
+
+        // May safely be called by another thread.
+        void setTarget(float t) {
+            target.store(t);
+            // If the ramp has not been used then start immediately at this level.
+            if (!used) {
+                levelFrom = t;
+                levelTo = t;
+            }
+        }
+
+        float interpolateCurrent() const {
+            return levelTo - (remaining * scaler);
+        }
+
+        // Called once at the start of each process() call.
+        void startSegment() {
+            used = true;
+            const float t = target.load();
+            if (t != levelTo) {
+                // Start new ramp. Continue from previous level.
+                levelFrom = interpolateCurrent();
+                levelTo = t;
+                remaining = lengthInFrames;
+                scaler = (levelTo - levelFrom) / lengthInFrames;
+            }
+        }
+
+        // Called once per frame.
+        float nextLevel() {
+            if (remaining > 0) { // Ramping? This doesn't happen very often.
+                const float level = interpolateCurrent();
+                remaining--;
+                return level;
+            }
+            return levelTo;
+        }
+    };
+
+    template <typename T_SOURCE, typename T_SINK, bool WITH_CLIP, bool WITH_RAMP>
+    static void fusedKernel(AAudioFlowGraph *graph,
+            const void *source, void *destination, int32_t numFrames);
+
+    template <typename T_SOURCE, typename T_SINK>
+    static FusedKernel pickFusedKernel(bool clip, bool ramp);
+
+    template <typename T_SOURCE>
+    static FusedKernel pickFusedKernelForSink(audio_format_t sinkFormat, bool clip, bool ramp);
+
+    // Select and install the fused kernel for this shape, or return false
+    // if the format pair is not one of the pre-instantiated kernels.
+    bool compileFusedKernel(audio_format_t sourceFormat, audio_format_t sinkFormat,
+            bool clip, bool ramp);
+
+    FusedKernel mFusedKernel = nullptr;
+    int32_t mFusedChannelCount = 0;
+    std::vector<std::unique_ptr<FusedRamp>> mFusedRamps;
+    // ----- end compiled execution plan -----
+
     std::unique_ptr<FLOWGRAPH_OUTER_NAMESPACE::flowgraph::FlowGraphSourceBuffered> mSource;
     std::unique_ptr<FLOWGRAPH_OUTER_NAMESPACE::flowgraph::MonoBlend> mMonoBlend;
     std::unique_ptr<FLOWGRAPH_OUTER_NAMESPACE::flowgraph::ClipToRange> mClipper;
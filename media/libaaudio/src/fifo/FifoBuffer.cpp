@@ -174,6 +174,45 @@ fifo_frames_t FifoBuffer::write(const void *buffer, fifo_frames_t numFrames) {
     return framesWritten;
 }
 
+fifo_frames_t FifoBuffer::write(const void * const *sources,
+                                const fifo_frames_t *framesPerChunk,
+                                int32_t chunkCount) {
+    WrappingBuffer wrappingBuffer;
+    fifo_frames_t framesWritten = 0;
+
+    getEmptyRoomAvailable(&wrappingBuffer);
+
+    // Copy every chunk, then advance the write counter once for the burst.
+    int partIndex = 0;
+    uint8_t *destination = (uint8_t *) wrappingBuffer.data[0];
+    fifo_frames_t partFramesLeft = wrappingBuffer.numFrames[0];
+    for (int32_t chunk = 0; chunk < chunkCount; chunk++) {
+        const uint8_t *source = (const uint8_t *) sources[chunk];
+        fifo_frames_t chunkFramesLeft = framesPerChunk[chunk];
+        while (chunkFramesLeft > 0) {
+            if (partFramesLeft <= 0) {
+                // Move on to the wrapped part of the FIFO, if any.
+                if (++partIndex >= WrappingBuffer::SIZE) break;
+                destination = (uint8_t *) wrappingBuffer.data[partIndex];
+                partFramesLeft = wrappingBuffer.numFrames[partIndex];
+                if (partFramesLeft <= 0) break;
+            }
+            fifo_frames_t framesToWrite = std::min(chunkFramesLeft, partFramesLeft);
+            int32_t numBytes = convertFramesToBytes(framesToWrite);
+            memcpy(destination, source, numBytes);
+
+            destination += numBytes;
+            source += numBytes;
+            partFramesLeft -= framesToWrite;
+            chunkFramesLeft -= framesToWrite;
+            framesWritten += framesToWrite;
+        }
+        if (chunkFramesLeft > 0) break; // FIFO full
+    }
+    mFifo->advanceWriteIndex(framesWritten);
+    return framesWritten;
+}
+
 fifo_frames_t FifoBuffer::getThreshold() {
     return mFifo->getThreshold();
 }
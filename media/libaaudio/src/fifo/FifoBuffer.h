@@ -48,6 +48,22 @@ public:
 
     fifo_frames_t write(const void *source, fifo_frames_t framesToWrite);
 
+    /**
+     * Write a burst assembled from several source chunks, advancing the
+     * write counter once after the whole burst is in place.  This keeps the
+     * counter's cache line quiet while the burst is gathered, instead of
+     * publishing it (and invalidating the reader's copy) once per chunk.
+     *
+     * @param sources array of chunk addresses
+     * @param framesPerChunk number of frames in each chunk
+     * @param chunkCount number of chunks
+     * @return total frames written, may be less than the sum of the chunks
+     *         if the FIFO fills up
+     */
+    fifo_frames_t write(const void * const *sources,
+                        const fifo_frames_t *framesPerChunk,
+                        int32_t chunkCount);
+
     fifo_frames_t getThreshold();
 
     void setThreshold(fifo_frames_t threshold);
@@ -53,8 +53,11 @@ public:
     }
 
 private:
-    std::atomic<fifo_counter_t> mReadCounter;
-    std::atomic<fifo_counter_t> mWriteCounter;
+    // Keep each counter on its own cache line, away from the other counter
+    // and from the read-mostly fields in the base class, so the reader's and
+    // writer's updates do not invalidate each other's lines.
+    alignas(64) std::atomic<fifo_counter_t> mReadCounter;
+    alignas(64) std::atomic<fifo_counter_t> mWriteCounter;
 };
 
 }  // namespace android
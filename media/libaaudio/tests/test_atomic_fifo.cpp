@@ -15,6 +15,7 @@
  */
 
 #include <iostream>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <stdlib.h>
@@ -208,6 +209,47 @@ public:
         ASSERT_EQ(framesToWrite, actual);
     }
 
+    // Write data as a burst of several chunks but do not overflow.
+    void writeChunkedDataFrames(fifo_frames_t numFrames, int chunkCount) {
+        fifo_frames_t framesAvailable =
+                mFifoBuffer.getEmptyFramesAvailable();
+        fifo_frames_t framesToWrite = std::min(framesAvailable, numFrames);
+        for (int i = 0; i < framesToWrite; i++) {
+            mData[i] = mNextWriteIndex++;
+        }
+        // Split the data into nearly equal chunks, the last taking the remainder.
+        std::vector<const void *> sources;
+        std::vector<fifo_frames_t> framesPerChunk;
+        const fifo_frames_t chunkFrames = framesToWrite / chunkCount;
+        fifo_frames_t framesLeft = framesToWrite;
+        for (int chunk = 0; chunk < chunkCount; chunk++) {
+            const fifo_frames_t numChunkFrames =
+                    (chunk == chunkCount - 1) ? framesLeft : chunkFrames;
+            sources.push_back(&mData[framesToWrite - framesLeft]);
+            framesPerChunk.push_back(numChunkFrames);
+            framesLeft -= numChunkFrames;
+        }
+        const fifo_counter_t writeCounterBefore = mFifoBuffer.getWriteCounter();
+        fifo_frames_t actual = mFifoBuffer.write(sources.data(), framesPerChunk.data(),
+                                                 chunkCount);
+        ASSERT_EQ(framesToWrite, actual);
+        ASSERT_EQ(writeCounterBefore + framesToWrite, mFifoBuffer.getWriteCounter());
+    }
+
+    // Batched writes must match frame-at-a-time reads, including wrap-around.
+    void checkChunkedWriteRead() {
+        constexpr int frames1 = 43;
+        constexpr int frames2 = 15;
+
+        writeChunkedDataFrames(frames1, 3);
+        verifyRequestedData(frames1);
+
+        writeChunkedDataFrames(frames2, 4); // wraps the end of the buffer
+        verifyRequestedData(frames2);
+
+        verifyStorageIntegrity();
+    }
+
     // Read whatever data is available, Do not underflow.
     void verifyMultipleDataFrames(fifo_frames_t numFrames) {
         fifo_frames_t framesAvailable =
@@ -351,6 +393,12 @@ TEST(test_fifo_buffer, fifo_wrapping_write_read) {
     tester.checkWrappingWriteRead();
 }
 
+TEST(test_fifo_buffer, fifo_chunked_write_read) {
+    constexpr int capacity = 51; // arbitrary
+    TestFifoBuffer tester(capacity);
+    tester.checkChunkedWriteRead();
+}
+
 TEST(test_fifo_buffer, fifo_read_write_small_large) {
     constexpr int capacity = 51; // arbitrary
     TestFifoBuffer tester(capacity);
@@ -1070,7 +1070,14 @@ status_t AudioRecord::createRecord_l(const Modulo<uint32_t> &epoch)
     // update proxy
     mProxy = new AudioRecordClientProxy(cblk, buffers, mFrameCount, mServerFrameSize);
     mProxy->setEpoch(epoch);
-    mProxy->setMinimum(mNotificationFramesAct);
+    // The server holds the futex wake until this many frames have
+    // accumulated.  Batch wakeups to the notification period for callback
+    // clients (they only consume per notification period anyway) and for
+    // clients that explicitly negotiated a notification size; clients that
+    // left the period to the server and read synchronously keep the
+    // wake-per-server-pass behavior (minimum 0 means wake on any data).
+    const bool batchWakeups = (mTransfer == TRANSFER_CALLBACK) || (mNotificationFramesReq > 0);
+    mProxy->setMinimum(batchWakeups ? mNotificationFramesAct : 0);
 
     mDeathNotifier = new DeathNotifier(this);
     IInterface::asBinder(mAudioRecord)->linkToDeath(mDeathNotifier, this);
@@ -31,6 +31,9 @@
 #include <media/PolicyAidlConversion.h>
 #include <media/TypeConverter.h>
 #include <math.h>
+#include <utils/Timers.h>
+
+#include <vector>
 
 #include <system/audio.h>
 #include <android/media/GetInputForAttrResponse.h>
@@ -60,6 +63,11 @@ using media::audio::common::AudioStreamType;
 using media::audio::common::AudioUsage;
 using media::audio::common::Int;
 
+namespace {
+// defined with the offload support cache below
+void clearOffloadSupportCache();
+}  // namespace
+
 // client singleton for AudioFlinger binder interface
 Mutex AudioSystem::gLock;
 Mutex AudioSystem::gLockErrorCallbacks;
@@ -337,11 +345,13 @@ AudioSystem::getOutputSamplingRate(uint32_t* samplingRate, audio_stream_type_t s
 
 status_t AudioSystem::getSamplingRate(audio_io_handle_t ioHandle,
                                       uint32_t* samplingRate) {
-    const sp<IAudioFlinger>& af = AudioSystem::get_audio_flinger();
-    if (af == 0) return PERMISSION_DENIED;
-    sp<AudioIoDescriptor> desc = getIoDescriptor(ioHandle);
+    const sp<AudioFlingerClient> afc = getAudioFlingerClient();
+    if (afc == 0) return PERMISSION_DENIED;
+    sp<AudioIoDescriptor> desc = afc->getIoDescriptor(ioHandle);
     if (desc == 0) {
-        *samplingRate = af->sampleRate(ioHandle);
+        status_t status = afc->getIoParameters(ioHandle, samplingRate,
+                nullptr /*frameCount*/, nullptr /*frameCountHAL*/, nullptr /*latency*/);
+        if (status != NO_ERROR) return status;
     } else {
         *samplingRate = desc->getSamplingRate();
     }
@@ -372,11 +382,13 @@ status_t AudioSystem::getOutputFrameCount(size_t* frameCount, audio_stream_type_
 
 status_t AudioSystem::getFrameCount(audio_io_handle_t ioHandle,
                                     size_t* frameCount) {
-    const sp<IAudioFlinger>& af = AudioSystem::get_audio_flinger();
-    if (af == 0) return PERMISSION_DENIED;
-    sp<AudioIoDescriptor> desc = getIoDescriptor(ioHandle);
+    const sp<AudioFlingerClient> afc = getAudioFlingerClient();
+    if (afc == 0) return PERMISSION_DENIED;
+    sp<AudioIoDescriptor> desc = afc->getIoDescriptor(ioHandle);
     if (desc == 0) {
-        *frameCount = af->frameCount(ioHandle);
+        status_t status = afc->getIoParameters(ioHandle, nullptr /*samplingRate*/,
+                frameCount, nullptr /*frameCountHAL*/, nullptr /*latency*/);
+        if (status != NO_ERROR) return status;
     } else {
         *frameCount = desc->getFrameCount();
     }
@@ -407,11 +419,13 @@ status_t AudioSystem::getOutputLatency(uint32_t* latency, audio_stream_type_t st
 
 status_t AudioSystem::getLatency(audio_io_handle_t output,
                                  uint32_t* latency) {
-    const sp<IAudioFlinger>& af = AudioSystem::get_audio_flinger();
-    if (af == 0) return PERMISSION_DENIED;
-    sp<AudioIoDescriptor> outputDesc = getIoDescriptor(output);
+    const sp<AudioFlingerClient> afc = getAudioFlingerClient();
+    if (afc == 0) return PERMISSION_DENIED;
+    sp<AudioIoDescriptor> outputDesc = afc->getIoDescriptor(output);
     if (outputDesc == 0) {
-        *latency = af->latency(output);
+        status_t status = afc->getIoParameters(output, nullptr /*samplingRate*/,
+                nullptr /*frameCount*/, nullptr /*frameCountHAL*/, latency);
+        if (status != NO_ERROR) return status;
     } else {
         *latency = outputDesc->getLatency();
     }
@@ -495,11 +509,13 @@ status_t AudioSystem::audioPolicyReady() {
 
 status_t AudioSystem::getFrameCountHAL(audio_io_handle_t ioHandle,
                                        size_t* frameCount) {
-    const sp<IAudioFlinger>& af = AudioSystem::get_audio_flinger();
-    if (af == 0) return PERMISSION_DENIED;
-    sp<AudioIoDescriptor> desc = getIoDescriptor(ioHandle);
+    const sp<AudioFlingerClient> afc = getAudioFlingerClient();
+    if (afc == 0) return PERMISSION_DENIED;
+    sp<AudioIoDescriptor> desc = afc->getIoDescriptor(ioHandle);
     if (desc == 0) {
-        *frameCount = af->frameCountHAL(ioHandle);
+        status_t status = afc->getIoParameters(ioHandle, nullptr /*samplingRate*/,
+                nullptr /*frameCount*/, frameCount, nullptr /*latency*/);
+        if (status != NO_ERROR) return status;
     } else {
         *frameCount = desc->getFrameCountHAL();
     }
@@ -519,12 +535,65 @@ status_t AudioSystem::getFrameCountHAL(audio_io_handle_t ioHandle,
 void AudioSystem::AudioFlingerClient::clearIoCache() {
     Mutex::Autolock _l(mLock);
     mIoDescriptors.clear();
+    mIoParameters.clear();
+    mIoParametersGeneration++;
     mInBuffSize = 0;
     mInSamplingRate = 0;
     mInFormat = AUDIO_FORMAT_DEFAULT;
     mInChannelMask = AUDIO_CHANNEL_NONE;
 }
 
+void AudioSystem::AudioFlingerClient::invalidateIoParameters_l(audio_io_handle_t ioHandle) {
+    mIoParameters.erase(ioHandle);
+    mIoParametersGeneration++;
+}
+
+status_t AudioSystem::AudioFlingerClient::getIoParameters(
+        audio_io_handle_t ioHandle, uint32_t* samplingRate, size_t* frameCount,
+        size_t* frameCountHAL, uint32_t* latency) {
+    const sp<IAudioFlinger>& af = AudioSystem::get_audio_flinger();
+    if (af == 0) {
+        return PERMISSION_DENIED;
+    }
+    IoParameters params;
+    int startGeneration;
+    bool cached = false;
+    {
+        Mutex::Autolock _l(mLock);
+        startGeneration = mIoParametersGeneration;
+        auto it = mIoParameters.find(ioHandle);
+        if (it != mIoParameters.end()) {
+            params = it->second;
+            cached = true;
+        }
+    }
+    if (!cached) {
+        // Query all the parameters once, outside mLock because these are
+        // synchronous binder calls. Later queries for this handle are
+        // then served from the cache.
+        params.samplingRate = af->sampleRate(ioHandle);
+        params.frameCount = af->frameCount(ioHandle);
+        params.frameCountHAL = af->frameCountHAL(ioHandle);
+        params.latency = af->latency(ioHandle);
+        if (params.samplingRate == 0 || params.frameCount == 0 || params.frameCountHAL == 0) {
+            ALOGE("%s failed for ioHandle %d", __func__, ioHandle);
+            return BAD_VALUE;
+        }
+        Mutex::Autolock _l(mLock);
+        // Only cache the values if no ioConfigChanged() event invalidated this
+        // handle while we were querying, otherwise we could insert stale values
+        // that would never be invalidated again.
+        if (startGeneration == mIoParametersGeneration) {
+            mIoParameters[ioHandle] = params;
+        }
+    }
+    if (samplingRate != nullptr) *samplingRate = params.samplingRate;
+    if (frameCount != nullptr) *frameCount = params.frameCount;
+    if (frameCountHAL != nullptr) *frameCountHAL = params.frameCountHAL;
+    if (latency != nullptr) *latency = params.latency;
+    return NO_ERROR;
+}
+
 void AudioSystem::AudioFlingerClient::binderDied(const wp<IBinder>& who __unused) {
     {
         Mutex::Autolock _l(AudioSystem::gLock);
@@ -556,6 +625,11 @@ Status AudioSystem::AudioFlingerClient::ioConfigChanged(
     std::vector<sp<AudioDeviceCallback>> callbacksToCall;
     {
         Mutex::Autolock _l(mLock);
+
+        // The event may change parameters for this io handle, drop any lazily
+        // cached copy.
+        invalidateIoParameters_l(ioDesc->getIoHandle());
+
         auto callbacks = std::map<audio_port_handle_t, wp<AudioDeviceCallback>>();
 
         switch (event) {
@@ -882,6 +956,7 @@ const sp<IAudioPolicyService> AudioSystem::get_audio_policy_service() {
 }
 
 void AudioSystem::clearAudioPolicyService() {
+    clearOffloadSupportCache();
     Mutex::Autolock _l(gLockAPS);
     gAudioPolicyService.clear();
 }
@@ -1419,6 +1494,23 @@ status_t AudioSystem::isStreamActive(audio_stream_type_t stream, bool* state, ui
     return OK;
 }
 
+status_t AudioSystem::getActiveStreamTypes(uint32_t inPastMs,
+                                           std::vector<audio_stream_type_t>* streams) {
+    const sp<IAudioPolicyService>& aps = AudioSystem::get_audio_policy_service();
+    if (aps == 0) return PERMISSION_DENIED;
+    if (streams == NULL) return BAD_VALUE;
+
+    int32_t inPastMsAidl = VALUE_OR_RETURN_STATUS(convertIntegral<int32_t>(inPastMs));
+    std::vector<AudioStreamType> retAidl;
+    RETURN_STATUS_IF_ERROR(statusTFromBinderStatus(
+            aps->getActiveStreamTypes(inPastMsAidl, &retAidl)));
+    *streams = VALUE_OR_RETURN_STATUS(
+            convertContainer<std::vector<audio_stream_type_t>>(
+                    retAidl,
+                    aidl2legacy_AudioStreamType_audio_stream_type_t));
+    return OK;
+}
+
 status_t AudioSystem::isStreamActiveRemotely(audio_stream_type_t stream, bool* state,
                                              uint32_t inPastMs) {
     const sp<IAudioPolicyService>& aps = AudioSystem::get_audio_policy_service();
@@ -1496,8 +1588,50 @@ status_t AudioSystem::setAllowedCapturePolicy(uid_t uid, audio_flags_mask_t capt
     return statusTFromBinderStatus(aps->setAllowedCapturePolicy(uidAidl, capturePolicyAidl));
 }
 
+namespace {
+
+// Offload support queries go to the policy service once per track start, and
+// apps negotiating an offloaded sink typically repeat the same query several
+// times in a row. Remember recent answers per offload info. Entries are
+// dropped when the port or patch lists change (routing may change the
+// answer), when the policy service connection is reset, and after a short
+// TTL as a safety net for processes that do not receive port callbacks.
+constexpr size_t kOffloadSupportCacheMaxEntries = 8;
+constexpr nsecs_t kOffloadSupportCacheTtlNs = seconds(10);
+
+struct OffloadSupportCacheEntry {
+    audio_offload_info_t info;
+    audio_offload_mode_t mode;
+    nsecs_t updateTimeNs;
+};
+
+Mutex gOffloadSupportCacheLock;
+std::vector<OffloadSupportCacheEntry> gOffloadSupportCache;
+
+void clearOffloadSupportCache() {
+    Mutex::Autolock _l(gOffloadSupportCacheLock);
+    gOffloadSupportCache.clear();
+}
+
+}  // namespace
+
 audio_offload_mode_t AudioSystem::getOffloadSupport(const audio_offload_info_t& info) {
     ALOGV("%s", __func__);
+    const nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
+    {
+        Mutex::Autolock _l(gOffloadSupportCacheLock);
+        for (auto it = gOffloadSupportCache.begin(); it != gOffloadSupportCache.end();) {
+            if (now - it->updateTimeNs > kOffloadSupportCacheTtlNs) {
+                it = gOffloadSupportCache.erase(it);
+                continue;
+            }
+            if (memcmp(&it->info, &info, sizeof(info)) == 0) {
+                return it->mode;
+            }
+            ++it;
+        }
+    }
+
     const sp<IAudioPolicyService>& aps = AudioSystem::get_audio_policy_service();
     if (aps == 0) return AUDIO_OFFLOAD_NOT_SUPPORTED;
 
@@ -1510,6 +1644,14 @@ audio_offload_mode_t AudioSystem::getOffloadSupport(const audio_offload_info_t&
         return aidl2legacy_AudioOffloadMode_audio_offload_mode_t(retAidl);
     }();
 
+    if (result.ok()) {
+        Mutex::Autolock _l(gOffloadSupportCacheLock);
+        if (gOffloadSupportCache.size() >= kOffloadSupportCacheMaxEntries) {
+            gOffloadSupportCache.erase(gOffloadSupportCache.begin());
+        }
+        gOffloadSupportCache.push_back({info, result.value(), now});
+    }
+
     return result.value_or(static_cast<audio_offload_mode_t>(0));
 }
 
@@ -2565,6 +2707,7 @@ int AudioSystem::AudioPolicyServiceClient::removeAudioPortCallback(
 
 
 Status AudioSystem::AudioPolicyServiceClient::onAudioPortListUpdate() {
+    clearOffloadSupportCache();
     Mutex::Autolock _l(mLock);
     for (size_t i = 0; i < mAudioPortCallbacks.size(); i++) {
         mAudioPortCallbacks[i]->onAudioPortListUpdate();
@@ -2573,6 +2716,7 @@ Status AudioSystem::AudioPolicyServiceClient::onAudioPortListUpdate() {
 }
 
 Status AudioSystem::AudioPolicyServiceClient::onAudioPatchListUpdate() {
+    clearOffloadSupportCache();
     Mutex::Autolock _l(mLock);
     for (size_t i = 0; i < mAudioPortCallbacks.size(); i++) {
         mAudioPortCallbacks[i]->onAudioPatchListUpdate();
@@ -2260,12 +2260,13 @@ status_t AudioTrack::obtainBuffer(Buffer* audioBuffer, int32_t waitCount, size_t
 }
 
 status_t AudioTrack::obtainBuffer(Buffer* audioBuffer, const struct timespec *requested,
-        struct timespec *elapsed, size_t *nonContig)
+        struct timespec *elapsed, size_t *nonContig, Buffer* audioBuffer2)
 {
     // previous and new IAudioTrack sequence numbers are used to detect track re-creation
     uint32_t oldSequence = 0;
 
     Proxy::Buffer buffer;
+    Proxy::Buffer buffer2 = { 0, NULL, 0 };
     status_t status = NO_ERROR;
 
     static const int32_t kMaxTries = 5;
@@ -2321,13 +2322,20 @@ status_t AudioTrack::obtainBuffer(Buffer* audioBuffer, const struct timespec *re
 
         buffer.mFrameCount = audioBuffer->frameCount;
         // FIXME starts the requested timeout and elapsed over from scratch
-        status = proxy->obtainBuffer(&buffer, requested, elapsed);
+        status = proxy->obtainBuffer(&buffer, requested, elapsed,
+                audioBuffer2 != NULL ? &buffer2 : NULL);
     } while (((status == DEAD_OBJECT) || (status == NOT_ENOUGH_DATA)) && (tryCounter-- > 0));
 
     audioBuffer->frameCount = buffer.mFrameCount;
     audioBuffer->mSize = buffer.mFrameCount * mFrameSize;
     audioBuffer->raw = buffer.mRaw;
     audioBuffer->sequence = oldSequence;
+    if (audioBuffer2 != NULL) {
+        audioBuffer2->frameCount = buffer2.mFrameCount;
+        audioBuffer2->mSize = buffer2.mFrameCount * mFrameSize;
+        audioBuffer2->raw = buffer2.mRaw;
+        audioBuffer2->sequence = oldSequence;
+    }
     if (nonContig != NULL) {
         *nonContig = buffer.mNonContig;
     }
@@ -2405,12 +2413,14 @@ ssize_t AudioTrack::write(const void* buffer, size_t userSize, bool blocking)
 
     size_t written = 0;
     Buffer audioBuffer;
+    Buffer audioBuffer2;
 
     while (userSize >= mFrameSize) {
         audioBuffer.frameCount = userSize / mFrameSize;
 
         status_t err = obtainBuffer(&audioBuffer,
-                blocking ? &ClientProxy::kForever : &ClientProxy::kNonBlocking);
+                blocking ? &ClientProxy::kForever : &ClientProxy::kNonBlocking,
+                NULL /*elapsed*/, NULL /*nonContig*/, &audioBuffer2);
         if (err < 0) {
             if (written > 0) {
                 break;
@@ -2427,6 +2437,18 @@ ssize_t AudioTrack::write(const void* buffer, size_t userSize, bool blocking)
         userSize -= toWrite;
         written += toWrite;
 
+        // If the available region wrapped around the end of the track buffer, fill the
+        // second part as well and release both with a single step of the ring buffer
+        // index, instead of a second obtain/release iteration.
+        size_t toWrite2 = audioBuffer2.size();
+        if (toWrite2 > 0) {
+            memcpy(audioBuffer2.raw, buffer, toWrite2);
+            buffer = ((const char *) buffer) + toWrite2;
+            userSize -= toWrite2;
+            written += toWrite2;
+            audioBuffer.mSize += toWrite2;
+        }
+
         releaseBuffer(&audioBuffer);
     }
 
@@ -3243,11 +3265,40 @@ status_t AudioTrack::getTimestamp_l(AudioTimestamp& timestamp)
 
     status_t status;
     if (isOffloadedOrDirect_l()) {
-        // use Binder to get timestamp
-        media::AudioTimestampInternal ts;
-        mAudioTrack->getTimestamp(&ts, &status);
-        if (status == OK) {
-            timestamp = VALUE_OR_FATAL(aidl2legacy_AudioTimestampInternal_AudioTimestamp(ts));
+        // Prefer the timestamp the playback thread publishes into the shared cblk
+        // (single-writer state queue, lock-free on both sides) over a binder
+        // round-trip: A/V sync clients call getTimestamp() every vsync and the
+        // cumulative binder traffic is measurable system-wide.  The shared copy is
+        // refreshed every thread loop iteration while the track is active, so
+        // binder remains only as a cold fallback when the shared timestamp is
+        // absent or stale (thread entering standby, drain in progress, or before
+        // the first server update), where the server must query the HAL directly.
+        static constexpr int64_t kMaxSharedTimestampAgeNs = 300000000; // 300 ms
+        bool sharedValid = false;
+        if (mState == STATE_ACTIVE) {   // drain/stopping states need the server's view
+            ExtendedTimestamp ets;
+            if (mProxy->getTimestamp(&ets) == OK
+                    && ets.mTimeNs[ExtendedTimestamp::LOCATION_KERNEL] > 0
+                    && ets.mPosition[ExtendedTimestamp::LOCATION_KERNEL] > 0) {
+                const int64_t ageNs = systemTime()
+                        - ets.mTimeNs[ExtendedTimestamp::LOCATION_KERNEL];
+                if (ageNs >= 0 && ageNs <= kMaxSharedTimestampAgeNs) {
+                    ExtendedTimestamp::Location location;
+                    if (ets.getBestTimestamp(&timestamp, &location) == OK
+                            && location == ExtendedTimestamp::LOCATION_KERNEL) {
+                        sharedValid = true;
+                        status = OK;
+                    }
+                }
+            }
+        }
+        if (!sharedValid) {
+            // use Binder to get timestamp
+            media::AudioTimestampInternal ts;
+            mAudioTrack->getTimestamp(&ts, &status);
+            if (status == OK) {
+                timestamp = VALUE_OR_FATAL(aidl2legacy_AudioTimestampInternal_AudioTimestamp(ts));
+            }
         }
     } else {
         // read timestamp from shared memory
@@ -148,7 +148,7 @@ uint32_t ClientProxy::setBufferSizeInFrames(uint32_t size)
 
 __attribute__((no_sanitize("integer")))
 status_t ClientProxy::obtainBuffer(Buffer* buffer, const struct timespec *requested,
-        struct timespec *elapsed)
+        struct timespec *elapsed, Buffer* part2)
 {
     LOG_ALWAYS_FATAL_IF(buffer == NULL || buffer->mFrameCount == 0,
             "%s: null or zero frame buffer, buffer:%p", __func__, buffer);
@@ -249,6 +249,7 @@ status_t ClientProxy::obtainBuffer(Buffer* buffer, const struct timespec *reques
             avail = 0;
         } else if (avail > 0) {
             // 'avail' may be non-contiguous, so return only the first contiguous chunk
+            const size_t requestedFrames = buffer->mFrameCount;
             size_t part1;
             if (mIsOut) {
                 rear &= mFrameCountP2 - 1;
@@ -260,14 +261,26 @@ status_t ClientProxy::obtainBuffer(Buffer* buffer, const struct timespec *reques
             if (part1 > (size_t)avail) {
                 part1 = avail;
             }
-            if (part1 > buffer->mFrameCount) {
-                part1 = buffer->mFrameCount;
+            if (part1 > requestedFrames) {
+                part1 = requestedFrames;
+            }
+            // If the caller asked for the wrapped part as well, and part1 was limited by
+            // the end of the ring buffer, then the rest of the available region wraps
+            // around to the start of the buffer.
+            size_t part2Frames = 0;
+            if (part2 != NULL && part1 == mFrameCountP2 - (size_t)(mIsOut ? rear : front)) {
+                part2Frames = std::min((size_t)avail, requestedFrames) - part1;
             }
             buffer->mFrameCount = part1;
             buffer->mRaw = part1 > 0 ?
                     &((char *) mBuffers)[(mIsOut ? rear : front) * mFrameSize] : NULL;
-            buffer->mNonContig = avail - part1;
-            mUnreleased = part1;
+            buffer->mNonContig = avail - part1 - part2Frames;
+            if (part2 != NULL) {
+                part2->mFrameCount = part2Frames;
+                part2->mRaw = part2Frames > 0 ? mBuffers : NULL;
+                part2->mNonContig = 0;
+            }
+            mUnreleased = part1 + part2Frames;
             status = NO_ERROR;
             break;
         }
@@ -359,6 +372,11 @@ end:
         buffer->mRaw = NULL;
         buffer->mNonContig = 0;
         mUnreleased = 0;
+        if (part2 != NULL) {
+            part2->mFrameCount = 0;
+            part2->mRaw = NULL;
+            part2->mNonContig = 0;
+        }
     }
     if (elapsed != NULL) {
         *elapsed = total;
@@ -934,8 +952,12 @@ void ServerProxy::releaseBuffer(Buffer* buffer)
     } else if (minimum > half) {
         minimum = half;
     }
-    // FIXME AudioRecord wakeup needs to be optimized; it currently wakes up client every time
-    if (!mIsOut || (mAvailToClient + stepCount >= minimum)) {
+    // This applies to capture as well: a recording client that negotiated a
+    // multi-period notification size (published through setMinimum()) is not
+    // woken until that many frames have accumulated, instead of once per
+    // server pass.  The cap at half the buffer above bounds the added
+    // latency and guarantees a wake before the buffer can overrun.
+    if (mAvailToClient + stepCount >= minimum) {
         ALOGV("mAvailToClient=%zu stepCount=%zu minimum=%zu", mAvailToClient, stepCount, minimum);
         int32_t old = android_atomic_or(CBLK_FUTEX_WAKE, &cblk->mFutex);
         if (!(old & CBLK_FUTEX_WAKE)) {
@@ -17,8 +17,10 @@
 //#define LOG_NDEBUG 0
 #define LOG_TAG "ToneGenerator"
 
+#include <algorithm>
 #include <inttypes.h>
 #include <utility>
+#include <vector>
 
 #include <math.h>
 #include <utils/Log.h>
@@ -1256,7 +1258,7 @@ void ToneGenerator::stopTone() {
         ALOGV("waiting cond");
         status_t lStatus = mWaitCbkCond.waitRelative(mLock, seconds(3));
         if (lStatus == NO_ERROR) {
-            // If the tone was restarted exit now before calling clearWaveGens();
+            // If the tone was restarted exit now.
             if (mState != TONE_INIT) {
                 mLock.unlock();
                 return;
@@ -1267,7 +1269,7 @@ void ToneGenerator::stopTone() {
             mState = TONE_IDLE;
             mpAudioTrack->stop();
         }
-        clearWaveGens();
+        // Wave generators are deliberately kept across tones; see prepareWave().
     }
 
     mLock.unlock();
@@ -1603,13 +1605,18 @@ audioCallback_EndLoop:
 ////////////////////////////////////////////////////////////////////////////////
 bool ToneGenerator::prepareWave() {
     unsigned int segmentIdx = 0;
+    std::vector<unsigned int> lFreqsSeen;  // frequencies already handled for this tone
 
     if (mpNewToneDesc == NULL) {
         return false;
     }
 
-    // Remove existing wave generators if any
-    clearWaveGens();
+    // Wave generators from previous tones are kept in mWaveGens and reused:
+    // the sampling rate is fixed for the life of this ToneGenerator, so only
+    // the gain (which depends on the wave count of the new tone) needs
+    // refreshing below.  This keeps back-to-back tone starts free of
+    // generator construction.  The cache is bounded by the set of distinct
+    // frequencies played, and is released in the destructor.
 
     mpToneDesc = mpNewToneDesc;
 
@@ -1637,7 +1644,14 @@ bool ToneGenerator::prepareWave() {
                                 frequency,
                                 TONEGEN_GAIN/lNumWaves);
                 mWaveGens.add(frequency, lpWaveGen);
+            } else if (std::find(lFreqsSeen.begin(), lFreqsSeen.end(), frequency)
+                    == lFreqsSeen.end()) {
+                // Reused from a previous tone: refresh the gain for the wave
+                // count of this tone.  As with creation above, only the first
+                // segment containing the frequency determines the gain.
+                mWaveGens.valueFor(frequency)->setVolume(TONEGEN_GAIN/lNumWaves);
             }
+            lFreqsSeen.push_back(frequency);
             frequency = mpNewToneDesc->segments[segmentIdx].waveFreq[++freqIdx];
         }
         segmentIdx++;
@@ -1768,10 +1782,7 @@ ToneGenerator::WaveGenerator::WaveGenerator(uint32_t samplingRate,
     mS1 = 0;
     mS2 = mS2_0;
 
-    mAmplitude_Q15 = (int16_t)(32767. * 32767. * volume / GEN_AMP);
-    // take some margin for amplitude fluctuation
-    if (mAmplitude_Q15 > 32500)
-        mAmplitude_Q15 = 32500;
+    setVolume(volume);
 
     d0 = 32768.0 * cos(2 * M_PI * F_div_Fs);  // Q14*2*cos()
     if (d0 > 32767)
@@ -1798,6 +1809,28 @@ ToneGenerator::WaveGenerator::WaveGenerator(uint32_t samplingRate,
 ToneGenerator::WaveGenerator::~WaveGenerator() {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//
+//    Method:        WaveGenerator::setVolume()
+//
+//    Description:    Updates the Q15 amplitude from a new volume, leaving the
+//        oscillator coefficients untouched so a generator can be reused
+//        across tones with different wave counts.
+//
+//    Input:
+//        volume:          volume (0.0 to 1.0)
+//
+//    Output:
+//        none
+//
+////////////////////////////////////////////////////////////////////////////////
+void ToneGenerator::WaveGenerator::setVolume(float volume) {
+    mAmplitude_Q15 = (int16_t)(32767. * 32767. * volume / GEN_AMP);
+    // take some margin for amplitude fluctuation
+    if (mAmplitude_Q15 > 32500)
+        mAmplitude_Q15 = 32500;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 //    Method:        WaveGenerator::getSamples()
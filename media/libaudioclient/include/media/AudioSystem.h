@@ -125,6 +125,11 @@ public:
     // returns true in *state if tracks are active on the specified stream or have been active
     // in the past inPastMs milliseconds
     static status_t isStreamActive(audio_stream_type_t stream, bool *state, uint32_t inPastMs);
+    // returns in *streams every public stream type for which isStreamActive() would return
+    // true, in a single query. Intended for periodic activity monitors that would otherwise
+    // issue one isStreamActive() call per stream type.
+    static status_t getActiveStreamTypes(uint32_t inPastMs,
+            std::vector<audio_stream_type_t>* streams);
     // returns true in *state if tracks are active for what qualifies as remote playback
     // on the specified stream or have been active in the past inPastMs milliseconds. Remote
     // playback isn't mutually exclusive with local playback.
@@ -698,6 +703,13 @@ private:
                                     audio_channel_mask_t channelMask, size_t* buffSize);
         sp<AudioIoDescriptor> getIoDescriptor(audio_io_handle_t ioHandle);
 
+        // Fetch stream parameters for an io handle that has no cached descriptor,
+        // typically one opened before this client registered with AudioFlinger.
+        // The result is cached until an ioConfigChanged() event invalidates it.
+        // Output pointers may be null for values the caller does not need.
+        status_t getIoParameters(audio_io_handle_t ioHandle, uint32_t* samplingRate,
+                                 size_t* frameCount, size_t* frameCountHAL, uint32_t* latency);
+
         // DeathRecipient
         virtual void binderDied(const wp<IBinder>& who);
 
@@ -742,6 +754,20 @@ private:
         audio_format_t                      mInFormat;
         audio_channel_mask_t                mInChannelMask;
         sp<AudioIoDescriptor> getIoDescriptor_l(audio_io_handle_t ioHandle);
+
+        // lazily cached parameters for io handles with no descriptor,
+        // see getIoParameters()
+        struct IoParameters {
+            uint32_t samplingRate;
+            size_t   frameCount;
+            size_t   frameCountHAL;
+            uint32_t latency;
+        };
+        std::map<audio_io_handle_t, IoParameters> mIoParameters GUARDED_BY(mLock);
+        // bumped by every invalidation so that a fetch racing with an
+        // ioConfigChanged() event does not insert stale values
+        int                                 mIoParametersGeneration GUARDED_BY(mLock) = 0;
+        void invalidateIoParameters_l(audio_io_handle_t ioHandle);
     };
 
     class AudioPolicyServiceClient: public IBinder::DeathRecipient,
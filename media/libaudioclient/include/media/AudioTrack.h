@@ -972,12 +972,15 @@ private:
      * if the client were to release the first frames and then call obtainBuffer() again.
      * This value is only a prediction, and needs to be confirmed.
      * It will be set to zero for an error return.
-     * FIXME We could pass an array of Buffers instead of only one Buffer to obtainBuffer(),
-     * in case the requested amount of frames is in two or more non-contiguous regions.
+     * If audioBuffer2 is non-NULL and the requested region wraps around the end of the
+     * track buffer, the wrapped part is returned there as well.  Both parts may then be
+     * filled and released with a single releaseBuffer() of the combined size, so the
+     * server observes the whole write as one step of the ring buffer index.
      * FIXME requested and elapsed are both relative times.  Consider changing to absolute time.
      */
             status_t    obtainBuffer(Buffer* audioBuffer, const struct timespec *requested,
-                                     struct timespec *elapsed = NULL, size_t *nonContig = NULL);
+                                     struct timespec *elapsed = NULL, size_t *nonContig = NULL,
+                                     Buffer* audioBuffer2 = NULL);
 public:
 
     /* Public API for TRANSFER_OBTAIN mode.
@@ -339,6 +339,11 @@ private:
                 float volume);
         ~WaveGenerator();
 
+        // Updates the generator gain, so an instance can be reused with a
+        // different wave count without recomputing the oscillator
+        // coefficients (which cost libm calls on the tone start path).
+        void setVolume(float volume);
+
         void getSamples(int16_t *outBuffer, unsigned int count,
                 unsigned int command);
 
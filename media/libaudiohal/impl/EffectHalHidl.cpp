@@ -202,18 +202,31 @@ status_t EffectHalHidl::setProcessBuffers() {
 
 status_t EffectHalHidl::command(uint32_t cmdCode, uint32_t cmdSize, void *pCmdData,
         uint32_t *replySize, void *pReplyData) {
-    TIME_CHECK();
-
     if (mEffect == 0) return NO_INIT;
 
     // Special cases.
     if (cmdCode == EFFECT_CMD_SET_CONFIG || cmdCode == EFFECT_CMD_SET_CONFIG_REVERSE) {
+        TIME_CHECK();
         return setConfigImpl(cmdCode, cmdSize, pCmdData, replySize, pReplyData);
     } else if (cmdCode == EFFECT_CMD_GET_CONFIG || cmdCode == EFFECT_CMD_GET_CONFIG_REVERSE) {
+        TIME_CHECK();
         return getConfigImpl(cmdCode, replySize, pReplyData);
     }
 
-    // Common case.
+    if (cmdCode == EFFECT_CMD_SET_PARAM || cmdCode == EFFECT_CMD_SET_PARAM_DEFERRED
+            || cmdCode == EFFECT_CMD_SET_PARAM_COMMIT) {
+        // Parameter automation can arrive at high rates (e.g. per-band EQ
+        // sweeps); keep the instrumentation off this path, as for process()
+        // (b/238654698).
+        return commandImpl(cmdCode, cmdSize, pCmdData, replySize, pReplyData);
+    }
+
+    TIME_CHECK();
+    return commandImpl(cmdCode, cmdSize, pCmdData, replySize, pReplyData);
+}
+
+status_t EffectHalHidl::commandImpl(uint32_t cmdCode, uint32_t cmdSize, void *pCmdData,
+        uint32_t *replySize, void *pReplyData) {
     hidl_vec<uint8_t> hidlData;
     if (pCmdData != nullptr && cmdSize > 0) {
         hidlData.setToExternal(reinterpret_cast<uint8_t*>(pCmdData), cmdSize);
@@ -90,6 +90,8 @@ class EffectHalHidl : public EffectHalInterface, public EffectConversionHelperHi
     // The destructor automatically releases the effect.
     virtual ~EffectHalHidl();
 
+    status_t commandImpl(uint32_t cmdCode, uint32_t cmdSize, void *pCmdData,
+            uint32_t *replySize, void *pReplyData);
     status_t getConfigImpl(uint32_t cmdCode, uint32_t *replySize, void *pReplyData);
     status_t prepareForProcessing();
     bool needToResetBuffers();
@@ -417,7 +417,17 @@ status_t StreamOutHalHidl::getLatency(uint32_t *latency) {
 status_t StreamOutHalHidl::setVolume(float left, float right) {
     TIME_CHECK();
     if (mStream == 0) return NO_INIT;
-    return processReturn("setVolume", mStream->setVolume(left, right));
+    if (mLastVolumeValid && left == mLastVolumeLeft && right == mLastVolumeRight) {
+        // The HAL stream already has this volume, skip the round-trip.
+        return OK;
+    }
+    status_t status = processReturn("setVolume", mStream->setVolume(left, right));
+    if (status == OK) {
+        mLastVolumeValid = true;
+        mLastVolumeLeft = left;
+        mLastVolumeRight = right;
+    }
+    return status;
 }
 
 #if MAJOR_VERSION == 2
@@ -664,9 +674,22 @@ status_t StreamOutHalHidl::drain(bool earlyNotify) {
 status_t StreamOutHalHidl::flush() {
     TIME_CHECK();
     if (mStream == 0) return NO_INIT;
+    invalidateLastPushedState();
     return processReturn("pause", mStream->flush());
 }
 
+status_t StreamOutHalHidl::standby() {
+    invalidateLastPushedState();
+    return StreamHalHidl::standby();
+}
+
+void StreamOutHalHidl::invalidateLastPushedState() {
+    mLastVolumeValid = false;
+#if MAJOR_VERSION >= 4
+    mLastSourceMetadataValid = false;
+#endif
+}
+
 status_t StreamOutHalHidl::getPresentationPosition(uint64_t *frames, struct timespec *timestamp) {
     // TIME_CHECK();  // TODO(b/238654698) reenable only when optimized.
     if (mStream == 0) return NO_INIT;
@@ -713,7 +736,18 @@ status_t StreamOutHalHidl::updateSourceMetadata(
             status != OK) {
         return status;
     }
-    return processReturn("updateSourceMetadata", mStream->updateSourceMetadata(hidlMetadata));
+    if (mLastSourceMetadataValid && hidlMetadata == mLastSourceMetadata) {
+        // Callers notify on any active track set change, which often produces
+        // the same metadata content; skip the round-trip in that case.
+        return OK;
+    }
+    status_t status = processReturn(
+            "updateSourceMetadata", mStream->updateSourceMetadata(hidlMetadata));
+    if (status == OK) {
+        mLastSourceMetadata = std::move(hidlMetadata);
+        mLastSourceMetadataValid = true;
+    }
+    return status;
 }
 #endif
 
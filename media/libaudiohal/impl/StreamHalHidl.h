@@ -162,6 +162,9 @@ class StreamOutHalHidl : public StreamOutHalInterface, public StreamHalHidl {
     // Notifies to the audio driver to flush the queued data.
     virtual status_t flush();
 
+    // Put the audio hardware output into standby mode.
+    status_t standby() override;
+
     // Return a recent count of the number of audio frames presented to an external observer.
     virtual status_t getPresentationPosition(uint64_t *frames, struct timespec *timestamp);
 
@@ -222,6 +225,24 @@ class StreamOutHalHidl : public StreamOutHalInterface, public StreamHalHidl {
     std::atomic<pid_t> mWriterClient;
     EventFlag* mEfGroup;
 
+    // Last state pushed to the HAL stream, used to elide HwBinder round-trips
+    // carrying values the HAL already has. Device switches in particular
+    // trigger bursts of volume/metadata updates that mostly repeat the current
+    // state. Invalidated on standby and flush since HAL implementations may
+    // reset their stream state then.
+    bool mLastVolumeValid = false;
+    float mLastVolumeLeft = 0.f;
+    float mLastVolumeRight = 0.f;
+#if MAJOR_VERSION == 4
+    ::android::hardware::audio::CORE_TYPES_CPP_VERSION::SourceMetadata mLastSourceMetadata;
+#elif MAJOR_VERSION >= 5
+    ::android::hardware::audio::common::COMMON_TYPES_CPP_VERSION::SourceMetadata
+            mLastSourceMetadata;
+#endif
+#if MAJOR_VERSION >= 4
+    bool mLastSourceMetadataValid = false;
+#endif
+
     // Can not be constructed directly by clients.
     StreamOutHalHidl(const sp<::android::hardware::audio::CPP_VERSION::IStreamOut>& stream);
 
@@ -232,6 +253,7 @@ class StreamOutHalHidl : public StreamOutHalInterface, public StreamHalHidl {
             WriteCommand cmd, const char* cmdName,
             const uint8_t* data, size_t dataSize, WriterCallback callback);
     status_t prepareForWriting(size_t bufferSize);
+    void invalidateLastPushedState();
 };
 
 class StreamInHalHidl : public StreamInHalInterface, public StreamHalHidl {
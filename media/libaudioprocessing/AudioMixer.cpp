@@ -144,6 +144,7 @@ void AudioMixer::Track::unprepareForDownmix() {
     }
 
     mDownmixRequiresFormat = AUDIO_FORMAT_INVALID;
+    mDownmixerFusesReformat = false;
     if (mDownmixerBufferProvider.get() != nullptr) {
         // this track had previously been configured with a downmixer, delete it
         mDownmixerBufferProvider.reset(nullptr);
@@ -193,6 +194,21 @@ status_t AudioMixer::Track::prepareForDownmix()
             && mMixerChannelMask == AUDIO_CHANNEL_OUT_STEREO
             && audio_channel_mask_get_representation(channelMask)
                     == AUDIO_CHANNEL_REPRESENTATION_POSITION) {
+        // For int16 tracks, fuse the reformat into the downmix so the input
+        // is walked once; prepareForReformat() then skips the separate
+        // reformat stage via mDownmixerFusesReformat.
+        if (mFormat == AUDIO_FORMAT_PCM_16_BIT) {
+            mDownmixerBufferProvider.reset(new ReformatChannelMixBufferProvider(channelMask,
+                    mFormat, mMixerChannelMask, mMixerInFormat, kCopyBufferFrameCount));
+            if (static_cast<ReformatChannelMixBufferProvider *>(mDownmixerBufferProvider.get())
+                    ->isValid()) {
+                mDownmixRequiresFormat = mFormat;
+                mDownmixerFusesReformat = true;
+                reconfigureBufferProviders();
+                ALOGD("%s: using fused ReformatChannelMix", __func__);
+                return NO_ERROR;
+            }
+        }
         mDownmixerBufferProvider.reset(new ChannelMixBufferProvider(channelMask,
                 mMixerChannelMask, mMixerInFormat, kCopyBufferFrameCount));
         if (static_cast<ChannelMixBufferProvider *>(mDownmixerBufferProvider.get())
@@ -255,7 +271,8 @@ status_t AudioMixer::Track::prepareForReformat()
                 kCopyBufferFrameCount));
         requiresReconfigure = true;
     }
-    if (targetFormat != mMixerInFormat) {
+    if (targetFormat != mMixerInFormat && !mDownmixerFusesReformat) {
+        // (a fused downmixer already emits mMixerInFormat)
         mPostDownmixReformatBufferProvider.reset(new ReformatBufferProvider(
                 audio_channel_count_from_out_mask(mMixerChannelMask),
                 targetFormat,
@@ -52,6 +52,12 @@
 // TODO: remove BLOCKSIZE unit of processing - it isn't needed anymore.
 static constexpr int BLOCKSIZE = 16;
 
+// process__genericNoResampling() skips the mix hook for regions of digital
+// silence.  After audible data is seen on a track, this many blocks are mixed
+// without scanning so audible tracks do not keep paying for the scan
+// (64 blocks of 16 frames is about 21 ms at 48 kHz).
+static constexpr uint16_t kSilenceScanHoldoff = 64;
+
 namespace android {
 
 // ----------------------------------------------------------------------------
@@ -599,6 +605,17 @@ std::string AudioMixerBase::trackNames() const
     return ss.str();
 }
 
+std::string AudioMixerBase::processHookCounts() const
+{
+    std::stringstream ss;
+    ss << "specialized one-track " << mHookCounts[HOOKTYPE_ONETRACK_SPECIALIZED]
+       << ", generic " << mHookCounts[HOOKTYPE_GENERIC_NORESAMPLING]
+       << ", generic resampling " << mHookCounts[HOOKTYPE_GENERIC_RESAMPLING]
+       << ", validate " << mHookCounts[HOOKTYPE_VALIDATE]
+       << ", nop " << mHookCounts[HOOKTYPE_NOP];
+    return ss.str();
+}
+
 void AudioMixerBase::process__validate()
 {
     // TODO: fix all16BitsStereNoResample logic to
@@ -687,6 +704,7 @@ void AudioMixerBase::process__validate()
 
     // select the processing hooks
     mHook = &AudioMixerBase::process__nop;
+    mHookType = HOOKTYPE_NOP;
     if (mEnabled.size() > 0) {
         if (resampling) {
             if (mOutputTemp.get() == nullptr) {
@@ -696,9 +714,11 @@ void AudioMixerBase::process__validate()
                 mResampleTemp.reset(new int32_t[MAX_NUM_CHANNELS * mFrameCount]);
             }
             mHook = &AudioMixerBase::process__genericResampling;
+            mHookType = HOOKTYPE_GENERIC_RESAMPLING;
         } else {
             // we keep temp arrays around.
             mHook = &AudioMixerBase::process__genericNoResampling;
+            mHookType = HOOKTYPE_GENERIC_NORESAMPLING;
             if (all16BitsStereoNoResample && !volumeRamp) {
                 if (mEnabled.size() == 1) {
                     const std::shared_ptr<TrackBase> &t = mTracks[mEnabled[0]];
@@ -711,6 +731,7 @@ void AudioMixerBase::process__validate()
                         mHook = getProcessHook(PROCESSTYPE_NORESAMPLEONETRACK,
                                 t->mMixerChannelCount, t->mMixerInFormat, t->mMixerFormat,
                                 t->useStereoVolume());
+                        mHookType = HOOKTYPE_ONETRACK_SPECIALIZED;
                     }
                 }
             }
@@ -739,6 +760,7 @@ void AudioMixerBase::process__validate()
         }
         if (allMuted) {
             mHook = &AudioMixerBase::process__nop;
+            mHookType = HOOKTYPE_NOP;
         } else if (all16BitsStereoNoResample) {
             if (mEnabled.size() == 1) {
                 //const int i = 31 - __builtin_clz(enabledTracks);
@@ -747,6 +769,7 @@ void AudioMixerBase::process__validate()
                 mHook = getProcessHook(PROCESSTYPE_NORESAMPLEONETRACK,
                         t->mMixerChannelCount, t->mMixerInFormat, t->mMixerFormat,
                         t->useStereoVolume());
+                mHookType = HOOKTYPE_ONETRACK_SPECIALIZED;
             }
         }
     }
@@ -1073,6 +1096,26 @@ void AudioMixerBase::process__nop()
 }
 
 // generic code without resampling
+// Returns true if the region holds only digital silence.  All-zero bits is
+// silence for both int16_t and float buffers; -0.f is treated as audible,
+// which is merely conservative.  The word-wise loop vectorizes.
+static bool isSilentRegion(const void *data, size_t bytes)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (bytes > 0 && ((uintptr_t)p & (sizeof(uint64_t) - 1)) != 0) {
+        if (*p++ != 0) return false;
+        --bytes;
+    }
+    const uint64_t *w = (const uint64_t *)p;
+    for (; bytes >= sizeof(uint64_t); bytes -= sizeof(uint64_t)) {
+        if (*w++ != 0) return false;
+    }
+    for (p = (const uint8_t *)w; bytes > 0; --bytes) {
+        if (*p++ != 0) return false;
+    }
+    return true;
+}
+
 void AudioMixerBase::process__genericNoResampling()
 {
     ALOGVV("process__genericNoResampling\n");
@@ -1111,9 +1154,36 @@ void AudioMixerBase::process__genericNoResampling()
                     }
                     size_t inFrames = (t->frameCount > outFrames)?outFrames:t->frameCount;
                     if (inFrames > 0) {
-                        (t.get()->*t->hook)(
-                                outTemp + (frameCount - outFrames) * t->mMixerChannelCount,
-                                inFrames, mResampleTemp.get() /* naked ptr */, aux);
+                        // Apps frequently keep playing digital silence (muted
+                        // ads, idle background players); such regions add
+                        // nothing to outTemp, so skip the mix hook for them
+                        // and just advance past the input.  Not done while a
+                        // volume ramp is active, as the hook also advances
+                        // the ramp state.
+                        bool silent = false;
+                        if (!t->needsRamp()) {
+                            if (t->mSilenceHoldoff > 0) {
+                                --t->mSilenceHoldoff;
+                            } else {
+                                const size_t inChannels =
+                                        (t->needs & NEEDS_CHANNEL_COUNT__MASK)
+                                                == NEEDS_CHANNEL_1
+                                        ? 1 : t->mMixerChannelCount;
+                                const size_t bytes = inFrames * inChannels
+                                        * audio_bytes_per_sample(t->mMixerInFormat);
+                                silent = isSilentRegion(t->mIn, bytes);
+                                if (silent) {
+                                    t->mIn = (const uint8_t *)t->mIn + bytes;
+                                } else {
+                                    t->mSilenceHoldoff = kSilenceScanHoldoff;
+                                }
+                            }
+                        }
+                        if (!silent) {
+                            (t.get()->*t->hook)(
+                                    outTemp + (frameCount - outFrames) * t->mMixerChannelCount,
+                                    inFrames, mResampleTemp.get() /* naked ptr */, aux);
+                        }
                         t->frameCount -= inFrames;
                         outFrames -= inFrames;
                         if (CC_UNLIKELY(aux != NULL)) {
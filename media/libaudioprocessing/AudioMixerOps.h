@@ -21,6 +21,9 @@
 #include <audio_utils/primitives.h>
 #include <system/audio.h>
 
+#include "AudioMixerRampOps.h"
+#include "AudioMixerVectorOps.h"
+
 namespace android {
 
 // Hack to make static_assert work in a constexpr
@@ -481,6 +484,26 @@ inline void volumeRampMulti(TO* out, size_t frameCount,
             vola[0] += volainc;
         } while (--frameCount);
     } else {
+        // Fused SIMD ramp kernels for the dominant interleaved stereo float
+        // configurations; see AudioMixerRampOps.h.  Semantically identical to
+        // the generic loop below, including the final contents of vol[].
+        if constexpr (NCHAN == 2
+                && std::is_same_v<TO, float> && std::is_same_v<TI, float>
+                && std::is_same_v<TV, float>) {
+            if constexpr (MIXTYPE == MIXTYPE_MULTI
+                    || MIXTYPE == MIXTYPE_MULTI_STEREOVOL) {
+                if (volumeRampStereoFloat<true /* ACCUMULATE */>(
+                        out, frameCount, in, vol, volinc)) {
+                    return;
+                }
+            } else if constexpr (MIXTYPE == MIXTYPE_MULTI_SAVEONLY
+                    || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_STEREOVOL) {
+                if (volumeRampStereoFloat<false /* ACCUMULATE */>(
+                        out, frameCount, in, vol, volinc)) {
+                    return;
+                }
+            }
+        }
         do {
             if constexpr (MIXTYPE == MIXTYPE_MULTI) {
                 static_assert(NCHAN <= 2);
@@ -568,6 +591,36 @@ inline void volumeMulti(TO* out, size_t frameCount,
             *aux++ += MixMul<TA, TA, TAV>(auxaccum, vola);
         } while (--frameCount);
     } else {
+        // Vectorized constant-volume kernels for the dominant interleaved
+        // stereo float configurations; see AudioMixerVectorOps.h.
+        // Semantically identical to the generic loop below.
+        if constexpr (NCHAN == 2
+                && std::is_same_v<TO, float> && std::is_same_v<TI, float>
+                && std::is_same_v<TV, float>) {
+            if constexpr (MIXTYPE == MIXTYPE_MULTI
+                    || MIXTYPE == MIXTYPE_MULTI_STEREOVOL) {
+                if (volumeStereoFloat<true /* ACCUMULATE */>(
+                        out, frameCount, in, vol[0], vol[1])) {
+                    return;
+                }
+            } else if constexpr (MIXTYPE == MIXTYPE_MULTI_SAVEONLY
+                    || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_STEREOVOL) {
+                if (volumeStereoFloat<false /* ACCUMULATE */>(
+                        out, frameCount, in, vol[0], vol[1])) {
+                    return;
+                }
+            } else if constexpr (MIXTYPE == MIXTYPE_MULTI_MONOVOL) {
+                if (volumeStereoFloat<true /* ACCUMULATE */>(
+                        out, frameCount, in, vol[0], vol[0])) {
+                    return;
+                }
+            } else if constexpr (MIXTYPE == MIXTYPE_MULTI_SAVEONLY_MONOVOL) {
+                if (volumeStereoFloat<false /* ACCUMULATE */>(
+                        out, frameCount, in, vol[0], vol[0])) {
+                    return;
+                }
+            }
+        }
         do {
             // ALOGD("Mixtype:%d NCHAN:%d", MIXTYPE, NCHAN);
             if constexpr (MIXTYPE == MIXTYPE_MULTI) {
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_MIXER_RAMP_OPS_H
+#define ANDROID_AUDIO_MIXER_RAMP_OPS_H
+
+#include <stddef.h>
+
+#include "AudioMixerVectorOps.h"
+
+#if defined(__ARM_NEON__) || defined(__aarch64__)
+#define USE_AUDIO_MIXER_RAMP_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define USE_AUDIO_MIXER_RAMP_SSE
+#include <emmintrin.h>
+#endif
+
+// Explicit SIMD kernels for the volume-ramp inner loops of AudioMixerOps.h.
+//
+// The generic volumeRampMulti() loop updates the volume array every frame,
+// which creates a loop-carried dependency the compiler will not vectorize;
+// on little cores the ramp branch of an 8-track fast mixer scenario can
+// dominate the mixing budget.  These kernels precompute four frames' worth
+// of sequentially-stepped volumes per iteration (the same additions the
+// scalar loop performs, in the same order, so the final volume state is
+// bit-identical) and fuse the ramp multiply with the accumulate, making a
+// ramping track cost about the same as a steady-state one.
+//
+// Only the dominant configuration is specialized: interleaved stereo float
+// in/out with float volumes, with and without accumulation.  Each kernel
+// returns true if it handled the buffer, false if the caller must fall back
+// to the generic loop (i.e. no SIMD support was compiled in).
+
+namespace android {
+
+#if defined(USE_AUDIO_MIXER_RAMP_SSE) && defined(USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH)
+
+// Wide variant of the ramp kernel below, selected at runtime on AVX2 parts.
+// Volumes are still stepped sequentially in scalar (and no FMA contraction is
+// used), so the output and the final vol state stay bit-identical to the
+// generic loop.  Consumes 8-frame blocks, advancing the caller's state; the
+// caller finishes with narrower vectors and scalar.
+template <bool ACCUMULATE>
+__attribute__((target("avx2")))
+inline void volumeRampStereoFloatAvx2(float*& out, const float*& in, size_t& frameCount,
+        float& vl, float& vr, float il, float ir)
+{
+    while (frameCount >= 8) {
+        float v03[8], v47[8];
+        float l = vl;
+        float r = vr;
+        for (int i = 0; i < 4; i++) {
+            v03[2 * i] = l;
+            v03[2 * i + 1] = r;
+            l += il;
+            r += ir;
+        }
+        for (int i = 0; i < 4; i++) {
+            v47[2 * i] = l;
+            v47[2 * i + 1] = r;
+            l += il;
+            r += ir;
+        }
+        __m256 x03 = _mm256_mul_ps(_mm256_loadu_ps(in), _mm256_loadu_ps(v03));
+        __m256 x47 = _mm256_mul_ps(_mm256_loadu_ps(in + 8), _mm256_loadu_ps(v47));
+        if constexpr (ACCUMULATE) {
+            x03 = _mm256_add_ps(_mm256_loadu_ps(out), x03);
+            x47 = _mm256_add_ps(_mm256_loadu_ps(out + 8), x47);
+        }
+        _mm256_storeu_ps(out, x03);
+        _mm256_storeu_ps(out + 8, x47);
+        vl = l;
+        vr = r;
+        in += 16;
+        out += 16;
+        frameCount -= 8;
+    }
+}
+
+#endif // USE_AUDIO_MIXER_RAMP_SSE && USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH
+
+// out[2i+c] (+)= in[2i+c] * vol[c], vol[c] += volinc[c] per frame.
+// On return vol[] holds the post-ramp volumes, as with the scalar loop.
+template <bool ACCUMULATE>
+inline bool volumeRampStereoFloat(float* out, size_t frameCount,
+        const float* in, float* vol, const float* volinc)
+{
+#if defined(USE_AUDIO_MIXER_RAMP_NEON) || defined(USE_AUDIO_MIXER_RAMP_SSE)
+    float vl = vol[0];
+    float vr = vol[1];
+    const float il = volinc[0];
+    const float ir = volinc[1];
+#if defined(USE_AUDIO_MIXER_RAMP_SSE) && defined(USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH)
+    if (audioMixerHasAvx2()) {
+        volumeRampStereoFloatAvx2<ACCUMULATE>(out, in, frameCount, vl, vr, il, ir);
+    }
+#endif
+    while (frameCount >= 4) {
+        // Sequential per-frame steps to match the scalar loop's rounding.
+        const float vl0 = vl,       vr0 = vr;
+        const float vl1 = vl0 + il, vr1 = vr0 + ir;
+        const float vl2 = vl1 + il, vr2 = vr1 + ir;
+        const float vl3 = vl2 + il, vr3 = vr2 + ir;
+        const float v01[4] = { vl0, vr0, vl1, vr1 };
+        const float v23[4] = { vl2, vr2, vl3, vr3 };
+#if defined(USE_AUDIO_MIXER_RAMP_NEON)
+        const float32x4_t x01 = vmulq_f32(vld1q_f32(in),     vld1q_f32(v01));
+        const float32x4_t x23 = vmulq_f32(vld1q_f32(in + 4), vld1q_f32(v23));
+        if constexpr (ACCUMULATE) {
+            vst1q_f32(out,     vaddq_f32(vld1q_f32(out),     x01));
+            vst1q_f32(out + 4, vaddq_f32(vld1q_f32(out + 4), x23));
+        } else {
+            vst1q_f32(out,     x01);
+            vst1q_f32(out + 4, x23);
+        }
+#else // USE_AUDIO_MIXER_RAMP_SSE
+        const __m128 x01 = _mm_mul_ps(_mm_loadu_ps(in),     _mm_loadu_ps(v01));
+        const __m128 x23 = _mm_mul_ps(_mm_loadu_ps(in + 4), _mm_loadu_ps(v23));
+        if constexpr (ACCUMULATE) {
+            _mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     x01));
+            _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), x23));
+        } else {
+            _mm_storeu_ps(out,     x01);
+            _mm_storeu_ps(out + 4, x23);
+        }
+#endif
+        vl = vl3 + il;
+        vr = vr3 + ir;
+        in += 8;
+        out += 8;
+        frameCount -= 4;
+    }
+    while (frameCount-- > 0) {
+        if constexpr (ACCUMULATE) {
+            *out++ += *in++ * vl;
+            *out++ += *in++ * vr;
+        } else {
+            *out++ = *in++ * vl;
+            *out++ = *in++ * vr;
+        }
+        vl += il;
+        vr += ir;
+    }
+    vol[0] = vl;
+    vol[1] = vr;
+    return true;
+#else
+    (void)out; (void)frameCount; (void)in; (void)vol; (void)volinc;
+    return false;
+#endif
+}
+
+}   // namespace android
+
+#endif  // ANDROID_AUDIO_MIXER_RAMP_OPS_H
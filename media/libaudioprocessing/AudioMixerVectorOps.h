@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_MIXER_VECTOR_OPS_H
+#define ANDROID_AUDIO_MIXER_VECTOR_OPS_H
+
+#include <stddef.h>
+
+#if defined(__ARM_NEON__) || defined(__aarch64__)
+#define USE_AUDIO_MIXER_VECTOR_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define USE_AUDIO_MIXER_VECTOR_SSE
+#include <emmintrin.h>
+#if defined(__clang__) || defined(__GNUC__)
+// The x86 baseline for Android is SSE2 (SSE4.2 on 64 bit), but most deployed
+// x86 devices have AVX2.  Wider kernels are compiled with a per-function
+// target attribute and selected at runtime, so the library still runs on
+// baseline parts.
+#define USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+#endif
+
+// Explicit SIMD kernels for the constant-volume inner loops of
+// AudioMixerOps.h (the volumeMulti() family), complementing the ramp
+// kernels in AudioMixerRampOps.h.
+//
+// Only the dominant configuration is specialized: interleaved stereo float
+// in/out with float volumes, with and without accumulation, which is what
+// AudioMixerBase uses for the mixer's internal float format.  The kernels
+// use multiplies and adds only (no FMA contraction), so results are
+// bit-identical to the generic scalar loop on every path.  Each kernel
+// returns true if it handled the buffer, false if the caller must fall
+// back to the generic loop (i.e. no SIMD support was compiled in).
+
+namespace android {
+
+#ifdef USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH
+
+// One-time CPU feature probe; the libgcc/compiler-rt feature word is
+// initialized before main so this is just a cached flag test.
+inline bool audioMixerHasAvx2() {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+
+// Consumes as many 8-frame blocks as possible, advancing the caller's
+// pointers and count; the caller finishes with narrower vectors and scalar.
+template <bool ACCUMULATE>
+__attribute__((target("avx2")))
+inline void volumeStereoFloatAvx2(float*& out, const float*& in, size_t& frameCount,
+        float vl, float vr)
+{
+    const __m256 v = _mm256_setr_ps(vl, vr, vl, vr, vl, vr, vl, vr);
+    while (frameCount >= 8) {
+        __m256 x03 = _mm256_mul_ps(_mm256_loadu_ps(in), v);
+        __m256 x47 = _mm256_mul_ps(_mm256_loadu_ps(in + 8), v);
+        if constexpr (ACCUMULATE) {
+            x03 = _mm256_add_ps(_mm256_loadu_ps(out), x03);
+            x47 = _mm256_add_ps(_mm256_loadu_ps(out + 8), x47);
+        }
+        _mm256_storeu_ps(out, x03);
+        _mm256_storeu_ps(out + 8, x47);
+        in += 16;
+        out += 16;
+        frameCount -= 8;
+    }
+}
+
+#endif // USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH
+
+// out[2i+c] (+)= in[2i+c] * vol[c] at constant per-channel volume.
+template <bool ACCUMULATE>
+inline bool volumeStereoFloat(float* out, size_t frameCount, const float* in,
+        float vl, float vr)
+{
+#if defined(USE_AUDIO_MIXER_VECTOR_NEON) || defined(USE_AUDIO_MIXER_VECTOR_SSE)
+#if defined(USE_AUDIO_MIXER_VECTOR_NEON)
+    const float32x4_t v = { vl, vr, vl, vr };
+    while (frameCount >= 4) {
+        float32x4_t x01 = vmulq_f32(vld1q_f32(in), v);
+        float32x4_t x23 = vmulq_f32(vld1q_f32(in + 4), v);
+        if constexpr (ACCUMULATE) {
+            x01 = vaddq_f32(vld1q_f32(out), x01);
+            x23 = vaddq_f32(vld1q_f32(out + 4), x23);
+        }
+        vst1q_f32(out, x01);
+        vst1q_f32(out + 4, x23);
+        in += 8;
+        out += 8;
+        frameCount -= 4;
+    }
+#else // USE_AUDIO_MIXER_VECTOR_SSE
+#ifdef USE_AUDIO_MIXER_VECTOR_AVX2_DISPATCH
+    if (audioMixerHasAvx2()) {
+        volumeStereoFloatAvx2<ACCUMULATE>(out, in, frameCount, vl, vr);
+    }
+#endif
+    const __m128 v = _mm_setr_ps(vl, vr, vl, vr);
+    while (frameCount >= 4) {
+        __m128 x01 = _mm_mul_ps(_mm_loadu_ps(in), v);
+        __m128 x23 = _mm_mul_ps(_mm_loadu_ps(in + 4), v);
+        if constexpr (ACCUMULATE) {
+            x01 = _mm_add_ps(_mm_loadu_ps(out), x01);
+            x23 = _mm_add_ps(_mm_loadu_ps(out + 4), x23);
+        }
+        _mm_storeu_ps(out, x01);
+        _mm_storeu_ps(out + 4, x23);
+        in += 8;
+        out += 8;
+        frameCount -= 4;
+    }
+#endif
+    while (frameCount-- > 0) {
+        if constexpr (ACCUMULATE) {
+            *out++ += *in++ * vl;
+            *out++ += *in++ * vr;
+        } else {
+            *out++ = *in++ * vl;
+            *out++ = *in++ * vr;
+        }
+    }
+    return true;
+#else
+    (void)out; (void)frameCount; (void)in; (void)vl; (void)vr;
+    return false;
+#endif
+}
+
+}   // namespace android
+
+#endif  // ANDROID_AUDIO_MIXER_VECTOR_OPS_H
@@ -181,8 +181,7 @@ template<typename TC, typename TI, typename TO>
 AudioResamplerDyn<TC, TI, TO>::AudioResamplerDyn(
         int inChannelCount, int32_t sampleRate, src_quality quality)
     : AudioResampler(inChannelCount, sampleRate, quality),
-      mResampleFunc(0), mFilterSampleRate(0), mFilterQuality(DEFAULT_QUALITY),
-    mCoefBuffer(NULL)
+      mResampleFunc(0), mFilterSampleRate(0), mFilterQuality(DEFAULT_QUALITY)
 {
     mVolumeSimd[0] = mVolumeSimd[1] = 0;
     // The AudioResampler base class assumes we are always ready for 1:1 resampling.
@@ -207,7 +206,6 @@ AudioResamplerDyn<TC, TI, TO>::AudioResamplerDyn(
 template<typename TC, typename TI, typename TO>
 AudioResamplerDyn<TC, TI, TO>::~AudioResamplerDyn()
 {
-    free(mCoefBuffer);
 }
 
 template<typename TC, typename TI, typename TO>
@@ -263,24 +261,50 @@ void AudioResamplerDyn<TC, TI, TO>::createKaiserFir(Constants &c,
     const int phases = c.mL;
     const int halfLength = c.mHalfNumCoefs;
 
-    // create buffer
-    TC *coefs = nullptr;
-    int ret = posix_memalign(
-            reinterpret_cast<void **>(&coefs),
-            CACHE_LINE_SIZE /* alignment */,
-            (phases + 1) * halfLength * sizeof(TC));
-    LOG_ALWAYS_FATAL_IF(ret != 0, "Cannot allocate buffer memory, ret %d", ret);
-    c.mFirCoefs = coefs;
-    free(mCoefBuffer);
-    mCoefBuffer = coefs;
-
     // square the computed minimum passband value (extra safety).
     double attenuation =
             computeWindowedSincMinimumPassbandValue(stopBandAtten);
     attenuation *= attenuation;
 
-    // design filter
-    firKaiserGen(coefs, phases, halfLength, stopBandAtten, fcr, attenuation);
+    // look up the process-wide cache before designing: identical parameters
+    // produce identical tables, so concurrent tracks resampling between the
+    // same rates share one immutable copy instead of generating duplicates.
+    const FilterKey key(phases, halfLength, stopBandAtten, fcr);
+    std::shared_ptr<TC> coefs;
+    {
+        std::lock_guard<std::mutex> _l(sCoefCacheLock);
+        auto it = sCoefCache.find(key);
+        if (it != sCoefCache.end()) {
+            coefs = it->second;
+        }
+    }
+    if (coefs == nullptr) {
+        // create buffer
+        TC *rawCoefs = nullptr;
+        int ret = posix_memalign(
+                reinterpret_cast<void **>(&rawCoefs),
+                CACHE_LINE_SIZE /* alignment */,
+                (phases + 1) * halfLength * sizeof(TC));
+        LOG_ALWAYS_FATAL_IF(ret != 0, "Cannot allocate buffer memory, ret %d", ret);
+        coefs = std::shared_ptr<TC>(rawCoefs, free);
+
+        // design filter
+        firKaiserGen(rawCoefs, phases, halfLength, stopBandAtten, fcr, attenuation);
+
+        std::lock_guard<std::mutex> _l(sCoefCacheLock);
+        auto it = sCoefCache.find(key);
+        if (it != sCoefCache.end()) {
+            // a racing thread designed the same filter first; share its table
+            coefs = it->second;
+        } else {
+            if (sCoefCache.size() >= kMaxCachedFilters) {
+                sCoefCache.erase(sCoefCache.begin());
+            }
+            sCoefCache.emplace(key, coefs);
+        }
+    }
+    c.mFirCoefs = coefs.get();
+    mCoefBuffer = std::move(coefs);
 
     // update the design criteria
     mNormalizedCutoffFrequency = fcr;
@@ -306,7 +330,7 @@ void AudioResamplerDyn<TC, TI, TO>::createKaiserFir(Constants &c,
 
     const int32_t passSteps = 1000;
 
-    testFir(coefs, c.mL, c.mHalfNumCoefs, fp, fs, passSteps, passSteps * c.mL /*stopSteps*/,
+    testFir(c.mFirCoefs, c.mL, c.mHalfNumCoefs, fp, fs, passSteps, passSteps * c.mL /*stopSteps*/,
             passMin, passMax, passRipple, stopMax, stopRipple);
     ALOGD("passband(%lf, %lf): %.8lf %.8lf %.8lf\n", 0., fp, passMin, passMax, passRipple);
     ALOGD("stopband(%lf, %lf): %.8lf %.3lf\n", fs, 0.5, stopMax, stopRipple);
@@ -761,6 +785,13 @@ resample_exit:
     return outputIndex / OUTPUT_CHANNELS;
 }
 
+template<typename TC, typename TI, typename TO>
+std::mutex AudioResamplerDyn<TC, TI, TO>::sCoefCacheLock;
+
+template<typename TC, typename TI, typename TO>
+std::map<typename AudioResamplerDyn<TC, TI, TO>::FilterKey, std::shared_ptr<TC>>
+        AudioResamplerDyn<TC, TI, TO>::sCoefCache;
+
 /* instantiate templates used by AudioResampler::create */
 template class AudioResamplerDyn<float, float, float>;
 template class AudioResamplerDyn<int16_t, int16_t, int32_t>;
@@ -21,6 +21,11 @@
 #include <sys/types.h>
 #include <android/log.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
 #include <media/AudioResampler.h>
 
 namespace android {
@@ -152,6 +157,18 @@ private:
 
     void createKaiserFir(Constants &c, double stopBandAtten, double fcr);
 
+    // Process-wide immutable cache of generated polyphase filter banks, keyed
+    // by the complete set of design parameters so identical filters are
+    // generated once and then shared across resampler instances (one cache per
+    // template instantiation).  Entries are held by shared_ptr: evicting one
+    // only drops the cache's reference, instances still using the table keep
+    // it alive through mCoefBuffer.
+    using FilterKey = std::tuple<int /*phases*/, int /*halfNumCoefs*/,
+            double /*stopBandAtten*/, double /*fcr*/>;
+    static constexpr size_t kMaxCachedFilters = 32;
+    static std::mutex sCoefCacheLock;
+    static std::map<FilterKey, std::shared_ptr<TC>> sCoefCache;
+
     template<int CHANNELS, bool LOCKED, int STRIDE>
     size_t resample(TO* out, size_t outFrameCount, AudioBufferProvider* provider);
 
@@ -166,7 +183,9 @@ private:
      resample_ABP_t mResampleFunc;     // called function for resampling
             int32_t mFilterSampleRate; // designed filter sample rate.
         src_quality mFilterQuality;    // designed filter quality.
-              void* mCoefBuffer;       // if a filter is created, this is not null
+    std::shared_ptr<TC> mCoefBuffer;   // shared ownership of the storage behind
+                                       // mConstants.mFirCoefs; not null once a
+                                       // filter has been created
 
     // Property selected design parameters.
               // This will enable fixed high quality resampling.
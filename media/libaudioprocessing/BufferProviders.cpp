@@ -387,6 +387,46 @@ void ChannelMixBufferProvider::copyFrames(void *dst, const void *src, size_t fra
             frames, false /* accumulate */);
 }
 
+ReformatChannelMixBufferProvider::ReformatChannelMixBufferProvider(
+        audio_channel_mask_t inputChannelMask, audio_format_t inputFormat,
+        audio_channel_mask_t outputChannelMask, audio_format_t outputFormat,
+        size_t bufferFrameCount) :
+        CopyBufferProvider(
+                audio_bytes_per_sample(inputFormat)
+                    * audio_channel_count_from_out_mask(inputChannelMask),
+                audio_bytes_per_sample(outputFormat)
+                    * audio_channel_count_from_out_mask(outputChannelMask),
+                bufferFrameCount),
+        mInputChannelCount(audio_channel_count_from_out_mask(inputChannelMask))
+{
+    ALOGV("ReformatChannelMixBufferProvider(%p)(%#x, %#x, %#x, %#x)",
+            this, inputFormat, inputChannelMask, outputFormat, outputChannelMask);
+    if (inputFormat == AUDIO_FORMAT_PCM_16_BIT
+            && outputChannelMask == AUDIO_CHANNEL_OUT_STEREO
+            && outputFormat == AUDIO_FORMAT_PCM_FLOAT) {
+        mIsValid = mChannelMix.setInputChannelMask(inputChannelMask);
+    }
+}
+
+void ReformatChannelMixBufferProvider::copyFrames(void *dst, const void *src, size_t frames)
+{
+    // Reformat and remix in chunks small enough that the float staging data
+    // stays in L1 between the two stages, instead of materializing a full
+    // float copy of the buffer in a separate provider pass.
+    float buffer[kConversionSampleCount];
+    const int16_t *in = static_cast<const int16_t *>(src);
+    float *out = static_cast<float *>(dst);
+    const size_t chunkFrames = kConversionSampleCount / mInputChannelCount;
+    while (frames > 0) {
+        const size_t process = std::min(frames, chunkFrames);
+        memcpy_to_float_from_i16(buffer, in, process * mInputChannelCount);
+        mChannelMix.process(buffer, out, process, false /* accumulate */);
+        in += process * mInputChannelCount;
+        out += process * 2; // stereo output
+        frames -= process;
+    }
+}
+
 ReformatBufferProvider::ReformatBufferProvider(int32_t channelCount,
         audio_format_t inputFormat, audio_format_t outputFormat,
         size_t bufferFrameCount) :
@@ -25,6 +25,8 @@
 #include <media/RecordBufferConverter.h>
 #include <utils/Log.h>
 
+#include "RecordConvertOps.h"
+
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(x) (sizeof(x)/sizeof((x)[0]))
 #endif
@@ -37,6 +39,24 @@ static inline T max(const T& a, const T& b)
 
 namespace android {
 
+// Drop-in for memcpy_by_audio_format() on the capture hot path, taking the
+// vectorized kernels from RecordConvertOps.h for the dominant conversions
+// (16 bit <-> float); all other format pairs use the generic scalar copy.
+static void convert_by_audio_format(void *dst, audio_format_t dstFormat,
+        const void *src, audio_format_t srcFormat, size_t count)
+{
+    if (dstFormat == AUDIO_FORMAT_PCM_FLOAT && srcFormat == AUDIO_FORMAT_PCM_16_BIT) {
+        if (convertFloatFromI16((float *)dst, (const int16_t *)src, count)) {
+            return;
+        }
+    } else if (dstFormat == AUDIO_FORMAT_PCM_16_BIT && srcFormat == AUDIO_FORMAT_PCM_FLOAT) {
+        if (convertI16FromFloat((int16_t *)dst, (const float *)src, count)) {
+            return;
+        }
+    }
+    memcpy_by_audio_format(dst, dstFormat, src, srcFormat, count);
+}
+
 RecordBufferConverter::RecordBufferConverter(
         audio_channel_mask_t srcChannelMask, audio_format_t srcFormat,
         uint32_t srcSampleRate,
@@ -241,7 +261,7 @@ void RecordBufferConverter::convertNoResampler(
                     (const float *)src, frames);
         }
         if (mBuf != NULL) {
-            memcpy_by_audio_format(dst, mDstFormat, mBuf, AUDIO_FORMAT_PCM_FLOAT,
+            convert_by_audio_format(dst, mDstFormat, mBuf, AUDIO_FORMAT_PCM_FLOAT,
                     frames * mDstChannelCount);
         }
         return;
@@ -257,7 +277,7 @@ void RecordBufferConverter::convertNoResampler(
     }
     // convert to destination buffer
     const void *convertBuf = mBuf != NULL ? mBuf : src;
-    memcpy_by_audio_format(dst, mDstFormat, convertBuf, mSrcFormat,
+    convert_by_audio_format(dst, mDstFormat, convertBuf, mSrcFormat,
             frames * mDstChannelCount);
 }
 
@@ -282,7 +302,7 @@ void RecordBufferConverter::convertResampler(
         }
         // convert to destination format (in place, OK as float is larger than other types)
         if (mDstFormat != AUDIO_FORMAT_PCM_FLOAT) {
-            memcpy_by_audio_format(src, mDstFormat, src, AUDIO_FORMAT_PCM_FLOAT,
+            convert_by_audio_format(src, mDstFormat, src, AUDIO_FORMAT_PCM_FLOAT,
                     frames * mSrcChannelCount);
         }
         // channel convert and save to dst
@@ -291,7 +311,7 @@ void RecordBufferConverter::convertResampler(
         return;
     }
     // convert to destination format and save to dst
-    memcpy_by_audio_format(dst, mDstFormat, src, AUDIO_FORMAT_PCM_FLOAT,
+    convert_by_audio_format(dst, mDstFormat, src, AUDIO_FORMAT_PCM_FLOAT,
             frames * mDstChannelCount);
 }
 
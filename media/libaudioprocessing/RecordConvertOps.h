@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_RECORD_CONVERT_OPS_H
+#define ANDROID_RECORD_CONVERT_OPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <audio_utils/primitives.h>
+
+#if defined(__ARM_NEON__) || defined(__aarch64__)
+#define USE_RECORD_CONVERT_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define USE_RECORD_CONVERT_SSE
+#include <emmintrin.h>
+#endif
+
+// Explicit SIMD kernels for the bulk sample format conversions on the
+// capture path (RecordBufferConverter), where high channel count devices
+// (6 and 8 mic arrays) convert entire interleaved buffers between 16 bit
+// PCM and float every cycle.  Format conversion of an interleaved stream
+// does not depend on the channel count, so a single kernel per format
+// pair covers all masks.
+//
+// The kernels are sample exact with the libaudioutils scalar primitives:
+// i16 -> float is an exact multiply by 2^-15, and the float -> i16 NEON
+// kernel vectorizes the clamp16_from_float() offset trick itself (round
+// to nearest even through the float add, clamp through the integer view
+// of the sum).  Each kernel returns true if it handled the buffer, false
+// if the caller must fall back to memcpy_by_audio_format() (no SIMD
+// support compiled in).
+
+namespace android {
+
+// dst[i] = float_from_i16(src[i])
+inline bool convertFloatFromI16(float *dst, const int16_t *src, size_t count)
+{
+#if defined(USE_RECORD_CONVERT_NEON)
+    const float scale = 1.f / (1 << 15);
+    while (count >= 8) {
+        const int16x8_t s = vld1q_s16(src);
+        vst1q_f32(dst,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale));
+        vst1q_f32(dst + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), scale));
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#elif defined(USE_RECORD_CONVERT_SSE)
+    const __m128 scale = _mm_set1_ps(1.f / (1 << 15));
+    while (count >= 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)src);
+        // sign extend by shifting the 16 bit samples into the high halves
+        // of 32 bit lanes and arithmetic shifting back down.
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_ps(dst,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#else
+    (void)dst; (void)src; (void)count;
+    return false;
+#endif
+#if defined(USE_RECORD_CONVERT_NEON) || defined(USE_RECORD_CONVERT_SSE)
+    while (count-- > 0) {
+        *dst++ = float_from_i16(*src++);
+    }
+    return true;
+#endif
+}
+
+// dst[i] = clamp16_from_float(src[i])
+//
+// Safe for in-place narrowing (dst aliasing src) as the store index
+// never passes the load index.
+inline bool convertI16FromFloat(int16_t *dst, const float *src, size_t count)
+{
+#if defined(USE_RECORD_CONVERT_NEON)
+    // Vector form of the clamp16_from_float() implementation: adding the
+    // offset places [-1.0, 1.0) in the 16 lsbs of the significand with the
+    // hardware rounding the discarded bits to nearest even, and the sum
+    // viewed as an integer is an ordered set so the clamp is integral.
+    const float32x4_t offset = vdupq_n_f32(3 * (1 << (22 - 15)));       /* 384.f */
+    const int32x4_t limneg = vdupq_n_s32((0x10f << 22) /*zero*/ - 32768);
+    const int32x4_t limpos = vdupq_n_s32((0x10f << 22) /*zero*/ + 32767);
+    while (count >= 8) {
+        int32x4_t u03 = vreinterpretq_s32_f32(vaddq_f32(vld1q_f32(src), offset));
+        int32x4_t u47 = vreinterpretq_s32_f32(vaddq_f32(vld1q_f32(src + 4), offset));
+        u03 = vbslq_s32(vcltq_s32(u03, limneg), vdupq_n_s32(-32768), u03);
+        u03 = vbslq_s32(vcgtq_s32(u03, limpos), vdupq_n_s32(32767), u03);
+        u47 = vbslq_s32(vcltq_s32(u47, limneg), vdupq_n_s32(-32768), u47);
+        u47 = vbslq_s32(vcgtq_s32(u47, limpos), vdupq_n_s32(32767), u47);
+        // truncating narrow returns the lower 16 bits, the sample value.
+        vst1q_s16(dst, vcombine_s16(vmovn_s32(u03), vmovn_s32(u47)));
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#elif defined(USE_RECORD_CONVERT_SSE)
+    // cvtps uses the current rounding mode, round to nearest even by
+    // default, and packs saturates to the int16_t range, matching
+    // clamp16_from_float() for all finite inputs.
+    const __m128 scale = _mm_set1_ps(1 << 15);
+    while (count >= 8) {
+        const __m128i i03 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src), scale));
+        const __m128i i47 = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + 4), scale));
+        _mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(i03, i47));
+        src += 8;
+        dst += 8;
+        count -= 8;
+    }
+#else
+    (void)dst; (void)src; (void)count;
+    return false;
+#endif
+#if defined(USE_RECORD_CONVERT_NEON) || defined(USE_RECORD_CONVERT_SSE)
+    while (count-- > 0) {
+        *dst++ = clamp16_from_float(*src++);
+    }
+    return true;
+#endif
+}
+
+}   // namespace android
+
+#endif  // ANDROID_RECORD_CONVERT_OPS_H
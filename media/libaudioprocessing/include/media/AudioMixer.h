@@ -131,6 +131,9 @@ private:
         audio_format_t mDownmixRequiresFormat;  // required downmixer format
                                                 // AUDIO_FORMAT_PCM_16_BIT if 16 bit necessary
                                                 // AUDIO_FORMAT_INVALID if no required format
+        bool mDownmixerFusesReformat = false;   // the downmixer consumes the track format
+                                                // and emits mMixerInFormat directly, so no
+                                                // reformat stages are needed around it
 
         AudioPlaybackRate    mPlaybackRate;
 
@@ -126,6 +126,7 @@ public:
     virtual void setParameter(int name, int target, int param, void *value);
 
     void        process() {
+        ++mHookCounts[mHookType];
         preProcess();
         (this->*mHook)();
         postProcess();
@@ -135,6 +136,11 @@ public:
 
     std::string trackNames() const;
 
+    // Returns invocation counts per process hook category, formatted for
+    // dumpsys; shows how often mixes fall off the specialized one-track
+    // path into the generic hooks.
+    std::string processHookCounts() const;
+
   protected:
     // Set kUseNewMixer to true to use the new mixer engine always. Otherwise the
     // original code will be used for stereo sinks, the new mixer for everything else.
@@ -184,6 +190,18 @@ public:
         PROCESSTYPE_NORESAMPLEONETRACK, // others set elsewhere
     };
 
+    // process hook categories for the invocation counters reported by
+    // processHookCounts(); mHookType is kept in sync with every mHook
+    // assignment.
+    enum {
+        HOOKTYPE_NOP,
+        HOOKTYPE_VALIDATE,
+        HOOKTYPE_GENERIC_NORESAMPLING,
+        HOOKTYPE_GENERIC_RESAMPLING,
+        HOOKTYPE_ONETRACK_SPECIALIZED,
+        HOOKTYPE_COUNT
+    };
+
     enum {
         TRACKTYPE_NOP,
         TRACKTYPE_RESAMPLE,
@@ -267,6 +285,11 @@ public:
         hook_t      hook;
         const void  *mIn;             // current location in buffer
 
+        // Silence skip in process__genericNoResampling(): number of blocks
+        // still to be mixed without scanning for silence after audible
+        // data was last seen on this track.
+        uint16_t    mSilenceHoldoff = 0;
+
         std::unique_ptr<AudioResampler> mResampler;
         uint32_t    sampleRate;
         int32_t*    mainBuffer;
@@ -325,6 +348,7 @@ public:
     // Called when track info changes and a new process hook should be determined.
     void invalidate() {
         mHook = &AudioMixerBase::process__validate;
+        mHookType = HOOKTYPE_VALIDATE;
     }
 
     void process__validate();
@@ -348,6 +372,8 @@ public:
     const size_t mFrameCount;
 
     process_hook_t mHook = &AudioMixerBase::process__nop;   // one of process__*, never nullptr
+    int mHookType = HOOKTYPE_NOP;                           // category of mHook
+    uint64_t mHookCounts[HOOKTYPE_COUNT] = {};              // process() calls per category
 
     // the size of the type (int32_t) should be the largest of all types supported
     // by the mixer.
@@ -147,6 +147,30 @@ protected:
     bool mIsValid = false;
 };
 
+// ReformatChannelMixBufferProvider derives from CopyBufferProvider to fuse the
+// int16 -> float reformat with the built-in stereo ChannelMix downmix in one
+// chunked pass over the input, so a multichannel int16 track is walked once
+// instead of through two chained providers with a second intermediate buffer.
+class ReformatChannelMixBufferProvider : public CopyBufferProvider {
+public:
+    ReformatChannelMixBufferProvider(audio_channel_mask_t inputChannelMask,
+            audio_format_t inputFormat,
+            audio_channel_mask_t outputChannelMask, audio_format_t outputFormat,
+            size_t bufferFrameCount);
+
+    void copyFrames(void *dst, const void *src, size_t frames) override;
+
+    bool isValid() const { return mIsValid; }
+
+protected:
+    // conversion chunk size in samples; chosen so the float staging buffer
+    // stays within L1 while both fused stages run over it
+    static constexpr size_t kConversionSampleCount = 1024;
+    const size_t mInputChannelCount;
+    audio_utils::channels::ChannelMix mChannelMix;
+    bool mIsValid = false;
+};
+
 // RemixBufferProvider derives from CopyBufferProvider to perform an
 // upmix or downmix to the proper channel count and mask.
 class RemixBufferProvider : public CopyBufferProvider {
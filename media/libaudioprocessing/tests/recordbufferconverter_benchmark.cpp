@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include <media/RecordBufferConverter.h>
+#include <benchmark/benchmark.h>
+
+#include "test_utils.h"
+
+using namespace android;
+
+// Benchmarks the non-resampling RecordThread capture conversions
+// (convertNoResampler): format conversion alone when the masks match, and
+// index remix plus format conversion when they differ.  Items processed is
+// set to frames so the per-frame cost of the capture path is reported and
+// tracked across changes.
+
+static audio_channel_mask_t indexMaskFromCount(int count) {
+    return audio_channel_mask_from_representation_and_bits(
+            AUDIO_CHANNEL_REPRESENTATION_INDEX, (1 << count) - 1);
+}
+
+template <int SRCCHAN, int DSTCHAN, audio_format_t SRCFMT, audio_format_t DSTFMT>
+static void BM_RecordConvert(benchmark::State& state) {
+    constexpr size_t FRAME_COUNT = 512;
+    const size_t srcFrameSize = SRCCHAN * audio_bytes_per_sample(SRCFMT);
+
+    std::vector<uint8_t> src(FRAME_COUNT * srcFrameSize);
+    std::vector<uint8_t> dst(FRAME_COUNT * DSTCHAN * audio_bytes_per_sample(DSTFMT));
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = i & 0x7f; // deterministic, small as float, nonzero as pcm16
+    }
+
+    RecordBufferConverter converter(
+            indexMaskFromCount(SRCCHAN), SRCFMT, 48000,
+            indexMaskFromCount(DSTCHAN), DSTFMT, 48000);
+    TestProvider provider(src.data(), FRAME_COUNT, srcFrameSize, std::vector<int>());
+
+    while (state.KeepRunning()) {
+        provider.reset();
+        benchmark::DoNotOptimize(dst.data());
+        converter.convert(dst.data(), &provider, FRAME_COUNT);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+}
+
+// format conversion only (channel masks match)
+BENCHMARK_TEMPLATE(BM_RecordConvert, 6, 6, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_FLOAT);
+BENCHMARK_TEMPLATE(BM_RecordConvert, 6, 6, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_16_BIT);
+BENCHMARK_TEMPLATE(BM_RecordConvert, 8, 8, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_FLOAT);
+BENCHMARK_TEMPLATE(BM_RecordConvert, 8, 8, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_16_BIT);
+
+// index remix plus format conversion
+BENCHMARK_TEMPLATE(BM_RecordConvert, 6, 2, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_FLOAT);
+BENCHMARK_TEMPLATE(BM_RecordConvert, 8, 2, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_FLOAT);
+BENCHMARK_TEMPLATE(BM_RecordConvert, 8, 2, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_16_BIT);
+
+// pass-through baselines for reference
+BENCHMARK_TEMPLATE(BM_RecordConvert, 8, 8, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_16_BIT);
+BENCHMARK_TEMPLATE(BM_RecordConvert, 8, 8, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_FLOAT);
+
+BENCHMARK_MAIN();
@@ -43,7 +43,7 @@ struct PageCache {
     void releasePage(Page *page);
 
     void appendPage(Page *page);
-    size_t releaseFromStart(size_t maxBytes);
+    size_t releaseFromStart(size_t maxBytes, off64_t absoluteOffset);
 
     size_t totalSize() const {
         return mTotalSize;
@@ -51,26 +51,54 @@ struct PageCache {
 
     void copy(size_t from, void *data, size_t size);
 
+    // Pages evicted from the contiguous window are kept around in spans,
+    // LRU-evicted within this byte budget, so that a seek back into a range
+    // we already downloaded is served from memory instead of the network.
+    void setRetainedBudget(size_t bytes);
+
+    // If [offset, offset + size) lies entirely within a retained span,
+    // copies the data out and returns size, else returns -1.
+    ssize_t copyRetained(off64_t offset, void *data, size_t size);
+
 private:
+    struct RetainedSpan {
+        off64_t mOffset;
+        size_t mLength;
+        int64_t mLastUseUs;
+        List<Page *> mPages;
+    };
+
     size_t mPageSize;
     size_t mTotalSize;
 
     List<Page *> mActivePages;
     List<Page *> mFreePages;
 
+    List<RetainedSpan> mRetainedSpans;
+    size_t mRetainedSize;
+    size_t mRetainedBudget;
+
     void freePages(List<Page *> *list);
+    void addRetainedSpan(off64_t absoluteOffset, List<Page *> *pages, size_t length);
+    void evictRetainedLRU();
 
     DISALLOW_EVIL_CONSTRUCTORS(PageCache);
 };
 
 PageCache::PageCache(size_t pageSize)
     : mPageSize(pageSize),
-      mTotalSize(0) {
+      mTotalSize(0),
+      mRetainedSize(0),
+      mRetainedBudget(0) {
 }
 
 PageCache::~PageCache() {
     freePages(&mActivePages);
     freePages(&mFreePages);
+    for (List<RetainedSpan>::iterator it = mRetainedSpans.begin();
+            it != mRetainedSpans.end(); ++it) {
+        freePages(&it->mPages);
+    }
 }
 
 void PageCache::freePages(List<Page *> *list) {
@@ -112,8 +140,9 @@ void PageCache::appendPage(Page *page) {
     mActivePages.push_back(page);
 }
 
-size_t PageCache::releaseFromStart(size_t maxBytes) {
+size_t PageCache::releaseFromStart(size_t maxBytes, off64_t absoluteOffset) {
     size_t bytesReleased = 0;
+    List<Page *> released;
 
     while (maxBytes > 0 && !mActivePages.empty()) {
         List<Page *>::iterator it = mActivePages.begin();
@@ -129,13 +158,105 @@ size_t PageCache::releaseFromStart(size_t maxBytes) {
         maxBytes -= page->mSize;
         bytesReleased += page->mSize;
 
-        releasePage(page);
+        released.push_back(page);
     }
 
     mTotalSize -= bytesReleased;
+    addRetainedSpan(absoluteOffset, &released, bytesReleased);
     return bytesReleased;
 }
 
+void PageCache::setRetainedBudget(size_t bytes) {
+    mRetainedBudget = bytes;
+}
+
+void PageCache::addRetainedSpan(
+        off64_t absoluteOffset, List<Page *> *pages, size_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    if (mRetainedBudget == 0 || length > mRetainedBudget) {
+        // Retention disabled, or this span alone overflows the budget.
+        while (!pages->empty()) {
+            releasePage(*pages->begin());
+            pages->erase(pages->begin());
+        }
+        return;
+    }
+
+    RetainedSpan span;
+    span.mOffset = absoluteOffset;
+    span.mLength = length;
+    span.mLastUseUs = ALooper::GetNowUs();
+    span.mPages = *pages;
+    pages->clear();
+
+    mRetainedSpans.push_back(span);
+    mRetainedSize += length;
+
+    while (mRetainedSize > mRetainedBudget) {
+        evictRetainedLRU();
+    }
+}
+
+void PageCache::evictRetainedLRU() {
+    CHECK(!mRetainedSpans.empty());
+
+    List<RetainedSpan>::iterator lru = mRetainedSpans.begin();
+    for (List<RetainedSpan>::iterator it = mRetainedSpans.begin();
+            it != mRetainedSpans.end(); ++it) {
+        if (it->mLastUseUs < lru->mLastUseUs) {
+            lru = it;
+        }
+    }
+
+    mRetainedSize -= lru->mLength;
+    while (!lru->mPages.empty()) {
+        releasePage(*lru->mPages.begin());
+        lru->mPages.erase(lru->mPages.begin());
+    }
+    mRetainedSpans.erase(lru);
+}
+
+ssize_t PageCache::copyRetained(off64_t offset, void *data, size_t size) {
+    if (size == 0) {
+        return -1;
+    }
+
+    for (List<RetainedSpan>::iterator it = mRetainedSpans.begin();
+            it != mRetainedSpans.end(); ++it) {
+        if (offset < it->mOffset
+                || offset + size > it->mOffset + (off64_t)it->mLength) {
+            continue;
+        }
+
+        it->mLastUseUs = ALooper::GetNowUs();
+
+        size_t from = offset - it->mOffset;
+        uint8_t *dst = (uint8_t *)data;
+        for (List<Page *>::iterator page = it->mPages.begin();
+                size > 0; ++page) {
+            if (from >= (*page)->mSize) {
+                from -= (*page)->mSize;
+                continue;
+            }
+            size_t copy = (*page)->mSize - from;
+            if (copy > size) {
+                copy = size;
+            }
+            memcpy(dst, (const uint8_t *)(*page)->mData + from, copy);
+            dst += copy;
+            size -= copy;
+            from = 0;
+        }
+
+        return dst - (uint8_t *)data;
+    }
+
+    return -1;
+}
+
 void PageCache::copy(size_t from, void *data, size_t size) {
     ALOGV("copy from %zu size %zu", from, size);
 
@@ -214,6 +335,10 @@ NuCachedSource2::NuCachedSource2(
         mKeepAliveIntervalUs = 0;
     }
 
+    // Allow scrubbing to revisit up to half a window's worth of evicted
+    // data without going back to the network.
+    mCache->setRetainedBudget(mHighwaterThresholdBytes / 2);
+
     mLooper->setName("NuCachedSource2");
     mLooper->registerHandler(mReflector);
 
@@ -508,7 +633,7 @@ void NuCachedSource2::restartPrefetcherIfNecessary_l(
         maxBytes -= kGrayArea;
     }
 
-    size_t actualBytes = mCache->releaseFromStart(maxBytes);
+    size_t actualBytes = mCache->releaseFromStart(maxBytes, mCacheOffset);
     mCacheOffset += actualBytes;
 
     ALOGI("restarting prefetcher, totalSize = %zu", mCache->totalSize());
@@ -537,6 +662,14 @@ ssize_t NuCachedSource2::readAt(off64_t offset, void *data, size_t size) {
         return size;
     }
 
+    // Not in the window; see if a span retained from before a seek covers it.
+    ssize_t retained = mCache->copyRetained(offset, data, size);
+    if (retained >= 0) {
+        mLastAccessPos = offset + retained;
+
+        return retained;
+    }
+
     sp<AMessage> msg = new AMessage(kWhatRead, mReflector);
     msg->setInt64("offset", offset);
     msg->setPointer("data", data);
@@ -622,6 +755,13 @@ ssize_t NuCachedSource2::readInternal(off64_t offset, void *data, size_t size) {
 
     if (offset < mCacheOffset
             || offset >= (off64_t)(mCacheOffset + mCache->totalSize())) {
+        // Serving the read from a retained span avoids restarting the
+        // fetch window (and the network transfer) entirely.
+        ssize_t retained = mCache->copyRetained(offset, data, size);
+        if (retained >= 0) {
+            return retained;
+        }
+
         static const off64_t kPadding = 256 * 1024;
 
         // In the presence of multiple decoded streams, once of them will
@@ -672,10 +812,11 @@ status_t NuCachedSource2::seekInternal_l(off64_t offset) {
 
     ALOGI("new range: offset= %lld", (long long)offset);
 
+    off64_t oldCacheOffset = mCacheOffset;
     mCacheOffset = offset;
 
     size_t totalSize = mCache->totalSize();
-    CHECK_EQ(mCache->releaseFromStart(totalSize), totalSize);
+    CHECK_EQ(mCache->releaseFromStart(totalSize, oldCacheOffset), totalSize);
 
     mNumRetriesLeft = kMaxNumRetries;
     mFetching = true;
@@ -70,6 +70,8 @@ void ChannelBuffer::initBuffers(unsigned int blockSize, unsigned int overlapSize
     //module vectors
     mPreEqFactorVector.resize(halfFftSize, 1.0);
     mPostEqFactorVector.resize(halfFftSize, 1.0);
+    mPreEqNeutral = true;
+    mPostEqNeutral = true;
 
     mPreEqBands.resize(dpBase.getPreEqBandCount());
     mMbcBands.resize(dpBase.getMbcBandCount());
@@ -152,6 +154,12 @@ void DPFrequency::configure(size_t blockSize, size_t overlapSize,
     mHalfFFTSize = 1 + mBlockSize / 2; //including Nyquist bin
     mOverlapSize = std::min(overlapSize, mBlockSize/2);
 
+    //the input is real, so only the half spectrum needs to be produced. The
+    //inverse transform consumes exactly the half spectrum, and all the bin
+    //processing below operates on the first half only, so without this flag
+    //the forward transform mirrored the conjugate half for nothing.
+    mFftServer.SetFlag(Eigen::FFT<float>::HalfSpectrum);
+
     int channelcount = getChannelCount();
     mSamplingRate = samplingRate;
     mChannelBuffers.resize(channelcount);
@@ -243,6 +251,11 @@ void DPFrequency::updateParameters(ChannelBuffer &cb, int channelIndex) {
                     cb.mPreEqFactorVector[k] = inputGainFactor;
                 }
             }
+            //remember whether the whole stage is a no-op so the per-bin pass
+            //can be skipped while the parameters stay unchanged.
+            cb.mPreEqNeutral = std::all_of(cb.mPreEqFactorVector.begin(),
+                    cb.mPreEqFactorVector.end(),
+                    [](float f) { return compareEquality(f, 1.0f); });
         }
     } //inputGain and preEq
 
@@ -287,6 +300,10 @@ void DPFrequency::updateParameters(ChannelBuffer &cb, int channelIndex) {
                         cb.mPostEqFactorVector[k] = factor;
                     }
                 }
+                //see the preEq neutrality note above.
+                cb.mPostEqNeutral = std::all_of(cb.mPostEqFactorVector.begin(),
+                        cb.mPostEqFactorVector.end(),
+                        [](float f) { return compareEquality(f, 1.0f); });
             }
         } //enabled
     }
@@ -489,11 +506,13 @@ size_t DPFrequency::processFirstStages(ChannelBuffer &cb) {
     mFftServer.fwd(cb.complexTemp, eWin);
 
     size_t cSize = cb.complexTemp.size();
-    size_t maxBin = std::min(cSize/2, mHalfFFTSize);
+    size_t maxBin = std::min(cSize, mHalfFFTSize);
 
-    //== EqPre (always runs)
-    for (size_t k = 0; k < maxBin; k++) {
-        cb.complexTemp[k] *= cb.mPreEqFactorVector[k];
+    //== EqPre (skipped when input gain and all bands are neutral)
+    if (!cb.mPreEqNeutral) {
+        for (size_t k = 0; k < maxBin; k++) {
+            cb.complexTemp[k] *= cb.mPreEqFactorVector[k];
+        }
     }
 
     //== MBC
@@ -510,9 +529,8 @@ size_t DPFrequency::processFirstStages(ChannelBuffer &cb) {
                 fEnergySum += std::norm(cb.complexTemp[k]) * preGainSquared; //mag squared
             }
 
-            //Eigen FFT is full spectrum, even if the source was real data.
-            // Each half spectrum has half the energy. This is taken into account with the * 2
-            // factor in the energy computations.
+            //The half spectrum of the real input has half the energy. This is taken into
+            // account with the * 2 factor in the energy computations.
             // energy = sqrt(sum_components_squared) number_points
             // in here, the fEnergySum is duplicated to account for the second half spectrum,
             // and the windowRms is used to normalize by the expected energy reduction
@@ -575,8 +593,8 @@ size_t DPFrequency::processFirstStages(ChannelBuffer &cb) {
 
     } //end MBC
 
-    //== EqPost
-    if (cb.mPostEqInUse && cb.mPostEqEnabled) {
+    //== EqPost (skipped when all bands are neutral)
+    if (cb.mPostEqInUse && cb.mPostEqEnabled && !cb.mPostEqNeutral) {
         for (size_t k = 0; k < maxBin; k++) {
             cb.complexTemp[k] *= cb.mPostEqFactorVector[k];
         }
@@ -657,7 +675,7 @@ size_t DPFrequency::processLastStages(ChannelBuffer &cb) {
     //apply to all if != 1.0
     if (!compareEquality(outputGainFactor, 1.0f)) {
         size_t cSize = cb.complexTemp.size();
-        size_t maxBin = std::min(cSize/2, mHalfFFTSize);
+        size_t maxBin = std::min(cSize, mHalfFFTSize);
         for (size_t k = 0; k < maxBin; k++) {
             cb.complexTemp[k] *= outputGainFactor;
         }
@@ -98,6 +98,8 @@ public:
     LimiterParams mLimiterParams;
     FloatVec mPreEqFactorVector; // temp pre-computed vector to shape spectrum at preEQ stage
     FloatVec mPostEqFactorVector; // temp pre-computed vector to shape spectrum at postEQ stage
+    bool mPreEqNeutral; // true if every preEQ factor is unity, so the bin pass can be skipped
+    bool mPostEqNeutral; // true if every postEQ factor is unity, so the bin pass can be skipped
 
     void initBuffers(unsigned int blockSize, unsigned int overlapSize, unsigned int halfFftSize,
             unsigned int samplingRate, DPBase &dpBase);
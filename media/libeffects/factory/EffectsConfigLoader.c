@@ -167,7 +167,9 @@ int loadLibrary(cnode *root, const char *name)
         goto error;
     }
 
-    hdl = dlopen(path, RTLD_NOW);
+    // RTLD_LAZY: only the library info symbol is needed at scan time, the rest
+    // of the library is resolved when an effect is first instantiated.
+    hdl = dlopen(path, RTLD_LAZY);
     if (hdl == NULL) {
         ALOGW("loadLibrary() failed to open %s", path);
         goto error;
@@ -71,8 +71,11 @@ bool loadLibrary(const char* relativePath, lib_entry_t* libEntry) noexcept {
     const char* path = absolutePath.c_str();
     libEntry->path = strdup(path);
 
-    // Make sure the lib is closed on early return
-    std::unique_ptr<void, decltype(dlclose)*> libHandle(dlopen(path, RTLD_NOW),
+    // Make sure the lib is closed on early return.
+    // RTLD_LAZY: only the library info symbol is needed at scan time; defer
+    // resolving the rest of each effect library to its first instantiation
+    // instead of relocating every effect at audioserver start.
+    std::unique_ptr<void, decltype(dlclose)*> libHandle(dlopen(path, RTLD_LAZY),
                                                        dlclose);
     if (libHandle == nullptr) {
         ALOGE("Could not dlopen library %s: %s", path, dlerror());
@@ -351,7 +351,9 @@ float* HapticGenerator_runProcessingChain(
         float* buf1, float* buf2, size_t frameCount) {
     float *in = buf1;
     float *out = buf2;
-    for (const auto processingFunc : processingChain) {
+    // Iterate by reference: copying the std::function would copy its captured
+    // shared_ptr (two atomic operations) for every stage of every block.
+    for (const auto& processingFunc : processingChain) {
         processingFunc(out, in, frameCount);
         std::swap(in, out);
     }
@@ -79,6 +79,12 @@ void Ramp::process(float *out, const float *in, size_t frameCount) {
 
 // Implementation of SlowEnvelope
 
+// Update period of the envelope normalization gain, in frames. The envelope is
+// the output of a 5 Hz low pass filter, so even at the lowest supported sample
+// rates a gain held over a few frames is still oversampled by three decades
+// relative to the envelope bandwidth.
+static constexpr size_t kGainUpdatePeriodFrames = 8;
+
 SlowEnvelope::SlowEnvelope(
         float cornerFrequency,
         float sampleRate,
@@ -86,6 +92,7 @@ SlowEnvelope::SlowEnvelope(
         float envOffset,
         size_t channelCount)
         : mLpf(createLPF(cornerFrequency, sampleRate, channelCount)),
+          mGain(channelCount, 1.0f),
           mNormalizationPower(normalizationPower),
           mEnvOffset(envOffset),
           mChannelCount(channelCount) {}
@@ -100,8 +107,19 @@ void SlowEnvelope::process(float* out, const float* in, size_t frameCount) {
         mLpfInBuffer[i] = fabs(in[i]);
     }
     mLpf->process(mLpfOutBuffer.data(), mLpfInBuffer.data(), frameCount);
-    for (size_t i = 0; i < sampleCount; ++i) {
-        out[i] = in[i] * pow(mLpfOutBuffer[i] + mEnvOffset, mNormalizationPower);
+    // The envelope varies too slowly to warrant a transcendental per sample:
+    // evaluate the pow() normalization once every kGainUpdatePeriodFrames
+    // frames per channel and hold the gain in between.
+    for (size_t frame = 0; frame < frameCount; ++frame) {
+        const size_t base = frame * mChannelCount;
+        if (frame % kGainUpdatePeriodFrames == 0) {
+            for (size_t c = 0; c < mChannelCount; ++c) {
+                mGain[c] = pow(mLpfOutBuffer[base + c] + mEnvOffset, mNormalizationPower);
+            }
+        }
+        for (size_t c = 0; c < mChannelCount; ++c) {
+            out[base + c] = in[base + c] * mGain[c];
+        }
     }
 }
 
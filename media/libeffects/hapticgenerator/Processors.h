@@ -57,9 +57,10 @@ private:
     const std::shared_ptr<HapticBiquadFilter> mLpf;
     std::vector<float> mLpfInBuffer;
     std::vector<float> mLpfOutBuffer;
+    std::vector<float> mGain;  // per-channel normalization gain, held between updates
     float mNormalizationPower;
     const float mEnvOffset;
-    const float mChannelCount;
+    const size_t mChannelCount;
 };
 
 
@@ -1380,10 +1380,11 @@ int32_t EqualizerGetBandLevel(EffectContext* pContext, int32_t band) {
 }
 
 //----------------------------------------------------------------------------
-// EqualizerSetBandLevel()
+// EqualizerStoreBandLevel()
 //----------------------------------------------------------------------------
 // Purpose:
-//  Sets gain value for the given band.
+//  Stores the rounded gain value for the given band without applying it to
+//  the engine, so that several bands can be changed in one reconfiguration.
 //
 // Inputs:
 //  band:       band number
@@ -1393,16 +1394,34 @@ int32_t EqualizerGetBandLevel(EffectContext* pContext, int32_t band) {
 // Outputs:
 //
 //---------------------------------------------------------------------------
-void EqualizerSetBandLevel(EffectContext* pContext, int band, short Gain) {
+void EqualizerStoreBandLevel(EffectContext* pContext, int band, short Gain) {
     int gainRounded;
     if (Gain > 0) {
         gainRounded = (int)((Gain + 50) / 100);
     } else {
         gainRounded = (int)((Gain - 50) / 100);
     }
-    // ALOGV("\tEqualizerSetBandLevel(%d)->(%d)", Gain, gainRounded);
+    // ALOGV("\tEqualizerStoreBandLevel(%d)->(%d)", Gain, gainRounded);
     pContext->pBundledContext->bandGaindB[band] = gainRounded;
     pContext->pBundledContext->CurPreset = PRESET_CUSTOM;
+}
+
+//----------------------------------------------------------------------------
+// EqualizerSetBandLevel()
+//----------------------------------------------------------------------------
+// Purpose:
+//  Sets gain value for the given band.
+//
+// Inputs:
+//  band:       band number
+//  Gain:       Gain to be applied in millibels
+//  pContext:   effect engine context
+//
+// Outputs:
+//
+//---------------------------------------------------------------------------
+void EqualizerSetBandLevel(EffectContext* pContext, int band, short Gain) {
+    EqualizerStoreBandLevel(pContext, band, Gain);
 
     EqualizerUpdateActiveParams(pContext);
     LvmEffect_limitLevel(pContext);
@@ -2467,8 +2486,14 @@ int Equalizer_setParameter(EffectContext* pContext, uint32_t paramSize, void* pP
                     break;
                 }
                 for (int i = 0; i < FIVEBAND_NUMBANDS; i++) {
-                    EqualizerSetBandLevel(pContext, i, (int)p[2 + i]);
+                    EqualizerStoreBandLevel(pContext, i, (int)p[2 + i]);
                 }
+                // Apply all the band gains to the engine in one pass. Setting
+                // the bands through EqualizerSetBandLevel would rebuild the
+                // whole five-band cascade and re-run the headroom limiter once
+                // per band.
+                EqualizerUpdateActiveParams(pContext);
+                LvmEffect_limitLevel(pContext);
             }
         } break;
 
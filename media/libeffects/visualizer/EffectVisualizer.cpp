@@ -25,6 +25,7 @@
 #include <time.h>
 
 #include <algorithm> // max
+#include <atomic>
 #include <new>
 
 #include <log/log.h>
@@ -88,7 +89,10 @@ struct BufferStats {
 struct VisualizerContext {
     const struct effect_interface_s *mItfe;
     effect_config_t mConfig;
-    uint32_t mCaptureIdx;
+    // Write position in mCaptureBuf. Written only by the process thread and read
+    // by the command thread on VISUALIZER_CMD_CAPTURE, so it is published with
+    // release/acquire ordering instead of a lock.
+    std::atomic<uint32_t> mCaptureIdx;
     uint32_t mCaptureSize;
     uint32_t mScalingMode;
     uint8_t mState;
@@ -430,7 +434,7 @@ int Visualizer_process(
     uint32_t captIdx;
     uint32_t inIdx;
     uint8_t *buf = pContext->mCaptureBuf;
-    for (inIdx = 0, captIdx = pContext->mCaptureIdx;
+    for (inIdx = 0, captIdx = pContext->mCaptureIdx.load(std::memory_order_relaxed);
          inIdx < sampleLen;
          captIdx++) {
         if (captIdx >= CAPTURE_BUF_SIZE) captIdx = 0; // wrap
@@ -448,9 +452,9 @@ int Visualizer_process(
 #endif // BUILD_FLOAT
     }
 
-    // XXX the following two should really be atomic, though it probably doesn't
-    // matter much for visualization purposes
-    pContext->mCaptureIdx = captIdx;
+    // Publish the new write position after the samples above have been stored,
+    // so the command thread copying the ring sees the bytes behind the index.
+    pContext->mCaptureIdx.store(captIdx, std::memory_order_release);
     // update last buffer update time stamp
     if (clock_gettime(CLOCK_MONOTONIC, &pContext->mBufferUpdateTime) < 0) {
         pContext->mBufferUpdateTime.tv_sec = 0;
@@ -636,10 +640,14 @@ int Visualizer_command(effect_handle_t self, uint32_t cmdCode, uint32_t cmdSize,
         }
         if (pContext->mState == VISUALIZER_STATE_ACTIVE) {
             const uint32_t deltaMs = Visualizer_getDeltaTimeMsFromUpdatedTime(pContext);
+            // Snapshot the write position once; the acquire pairs with the release
+            // store in Visualizer_process() so the ring contents behind the index
+            // are visible to the copies below.
+            const uint32_t captureIdx = pContext->mCaptureIdx.load(std::memory_order_acquire);
 
             // if audio framework has stopped playing audio although the effect is still
             // active we must clear the capture buffer to return silence
-            if ((pContext->mLastCaptureIdx == pContext->mCaptureIdx) &&
+            if ((pContext->mLastCaptureIdx == captureIdx) &&
                     (pContext->mBufferUpdateTime.tv_sec != 0) &&
                     (deltaMs > MAX_STALL_TIME_MS)) {
                     ALOGV("capture going to idle");
@@ -662,8 +670,8 @@ int Visualizer_command(effect_handle_t self, uint32_t cmdCode, uint32_t cmdSize,
                 }
 
                 int32_t capturePoint;
-                //capturePoint = (int32_t)pContext->mCaptureIdx - deltaSmpl;
-                __builtin_sub_overflow((int32_t)pContext->mCaptureIdx, deltaSmpl, &capturePoint);
+                //capturePoint = (int32_t)captureIdx - deltaSmpl;
+                __builtin_sub_overflow((int32_t)captureIdx, deltaSmpl, &capturePoint);
                 // a negative capturePoint means we wrap the buffer.
                 if (capturePoint < 0) {
                     uint32_t size = -capturePoint;
@@ -682,7 +690,7 @@ int Visualizer_command(effect_handle_t self, uint32_t cmdCode, uint32_t cmdSize,
                        captureSize);
             }
 
-            pContext->mLastCaptureIdx = pContext->mCaptureIdx;
+            pContext->mLastCaptureIdx = captureIdx;
         } else {
             memset(pReplyData, 0x80, captureSize);
         }
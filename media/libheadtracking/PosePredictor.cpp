@@ -229,17 +229,17 @@ std::string PosePredictor::toString(size_t index) const {
     return ss;
 }
 
-std::shared_ptr<PredictorBase> PosePredictor::getCurrentPredictor() const {
+PredictorBase* PosePredictor::getCurrentPredictor() const {
     // we don't use a map here, we look up directly
     switch (mCurrentType) {
     default:
     case android::media::PosePredictorType::LAST:
-        return mPredictors[0];
+        return mPredictors[0].get();
     case android::media::PosePredictorType::TWIST:
-        return mPredictors[1];
+        return mPredictors[1].get();
     case android::media::PosePredictorType::AUTO: // shouldn't occur here.
     case android::media::PosePredictorType::LEAST_SQUARES:
-        return mPredictors[2];
+        return mPredictors[2].get();
     }
 }
 
@@ -208,8 +208,11 @@ private:
     int64_t mResets{};
     int64_t mLastTimestampNs{};
 
-    // Returns current predictor
-    std::shared_ptr<PredictorBase> getCurrentPredictor() const;
+    // Returns current predictor.
+    // Returned as a raw pointer: the pointee is owned by mPredictors for the lifetime
+    // of this object, and a shared_ptr return would cost two atomic reference count
+    // operations on every predict() call.
+    PredictorBase* getCurrentPredictor() const;
 };
 
 }  // namespace android::media
@@ -45,6 +45,11 @@ using android::base::StringAppendF;
 // Note: Instead of a fixed number, the SensorEventQueue's fd could be used instead.
 constexpr int kIdent = 19;
 
+// Maximum number of sensor events consumed from the queue per looper wakeup.
+// Sized for a few sensors delivering together; any excess simply triggers
+// another wakeup since the queue fd stays readable.
+constexpr size_t kEventBatchSize = 16;
+
 static inline Looper* ALooper_to_Looper(ALooper* alooper) {
     return reinterpret_cast<Looper*>(alooper);
 }
@@ -293,25 +298,26 @@ class SensorPoseProviderImpl : public SensorPoseProvider {
                     continue;
             }
 
-            // Process an event.
-            ASensorEvent event;
-            ssize_t actual = mQueue->read(&event, 1);
+            // Drain all pending events in one batch, so a single wakeup of this
+            // thread costs one read()/sendAck() syscall pair instead of one
+            // poll()/read() pair per event when several sensors (or a batching
+            // sensor HAL) deliver together.
+            ASensorEvent events[kEventBatchSize];
+            ssize_t actual = mQueue->read(events, kEventBatchSize);
             if (actual > 0) {
-                mQueue->sendAck(&event, actual);
+                mQueue->sendAck(events, actual);
             }
-            ssize_t size = mQueue->filterEvents(&event, actual);
+            ssize_t size = mQueue->filterEvents(events, actual);
 
-            if (size < 0 || size > 1) {
+            if (size < 0 || size > actual) {
                 ALOGE("%s: Unexpected return value from SensorEventQueue::filterEvents: %zd",
                         __func__, size);
                 break;
             }
-            if (size == 0) {
-                // No events.
-                continue;
-            }
 
-            handleEvent(event);
+            for (ssize_t i = 0; i < size; ++i) {
+                handleEvent(events[i]);
+            }
         }
         ALOGD("%s: Exiting sensor event loop", __func__);
     }
@@ -316,6 +316,7 @@ HeifDecoderImpl::HeifDecoderImpl() :
     mHasVideo(false),
     mSequenceLength(0),
     mAvailableLines(0),
+    mAvailableLinesSnapshot(0),
     mNumSlices(1),
     mSliceHeight(0),
     mAsyncDecodeDone(false) {
@@ -528,7 +529,7 @@ bool HeifDecoderImpl::decodeAsync() {
                 mScanlineReady.signal();
                 break;
             }
-            mFrameMemory = frameMemory;
+            mAsyncFrameMemory = frameMemory;
             mAvailableLines = bottom;
             ALOGV("decodeAsync(): available lines %zu", mAvailableLines);
             mScanlineReady.signal();
@@ -581,7 +582,9 @@ bool HeifDecoderImpl::decode(HeifFrameInfo* frameInfo) {
                 initFrameInfo(frameInfo, videoFrame);
             }
             mFrameMemory = frameMemory;
+            mAsyncFrameMemory = frameMemory;
             mAvailableLines = mSliceHeight;
+            mAvailableLinesSnapshot = mSliceHeight;
             mThread = new DecodeThread(this);
             if (mThread->run("HeifDecode", ANDROID_PRIORITY_FOREGROUND) == OK) {
                 mFrameDecoded = true;
@@ -592,7 +595,9 @@ bool HeifDecoderImpl::decode(HeifFrameInfo* frameInfo) {
             mNumSlices = 1;
             mSliceHeight = 0;
             mAvailableLines = 0;
+            mAvailableLinesSnapshot = 0;
             mFrameMemory.clear();
+            mAsyncFrameMemory.clear();
         }
     }
 
@@ -711,12 +716,19 @@ bool HeifDecoderImpl::getScanline(uint8_t* dst) {
     }
 
     if (mNumSlices > 1) {
-        Mutex::Autolock autolock(mLock);
+        // Only take the lock when we've consumed everything published so far;
+        // lines below the snapshot are immutable, so the common path copies
+        // them without contending with the decode thread.
+        if (mCurScanline >= mAvailableLinesSnapshot) {
+            Mutex::Autolock autolock(mLock);
 
-        while (!mAsyncDecodeDone && mCurScanline >= mAvailableLines) {
-            mScanlineReady.wait(mLock);
+            while (!mAsyncDecodeDone && mCurScanline >= mAvailableLines) {
+                mScanlineReady.wait(mLock);
+            }
+            mAvailableLinesSnapshot = mAvailableLines;
+            mFrameMemory = mAsyncFrameMemory;
         }
-        return (mCurScanline < mAvailableLines) ? getScanlineInner(dst) : false;
+        return (mCurScanline < mAvailableLinesSnapshot) ? getScanlineInner(dst) : false;
     }
 
     return getScanlineInner(dst);
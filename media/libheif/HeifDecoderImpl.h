@@ -76,7 +76,15 @@ private:
     Mutex mLock;
     Condition mScanlineReady;
     sp<DecodeThread> mThread;
+    // Frame memory last published by the decode thread, guarded by mLock.
+    // The reader refreshes mFrameMemory from it under the lock, so the
+    // per-scanline path never races with the decode thread's publication.
+    sp<IMemory> mAsyncFrameMemory;
     size_t mAvailableLines;
+    // Reader-side snapshot of mAvailableLines. Published lines never change
+    // once signalled, so the reader only takes mLock when mCurScanline
+    // catches up with the snapshot instead of once per scanline.
+    size_t mAvailableLinesSnapshot;
     size_t mNumSlices;
     uint32_t mSliceHeight;
     bool mAsyncDecodeDone;
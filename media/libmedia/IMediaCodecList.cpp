@@ -23,6 +23,9 @@
 #include <media/MediaCodecInfo.h>
 
 #include <utils/Errors.h>  // for status_t
+#include <utils/Mutex.h>
+
+#include <vector>
 
 namespace android {
 
@@ -43,23 +46,51 @@ public:
     {
     }
 
+    // The codec list served by the remote side is immutable for the lifetime
+    // of the service, so replies are cached here. This way repeated queries -
+    // every codec creation walks the list - parcel each codec info across the
+    // binder at most once per process instead of on every call.
+
     virtual size_t countCodecs() const
     {
+        {
+            Mutex::Autolock _l(mLock);
+            if (mCodecCount >= 0) {
+                return static_cast<size_t>(mCodecCount);
+            }
+        }
         Parcel data, reply;
         data.writeInterfaceToken(IMediaCodecList::getInterfaceDescriptor());
         remote()->transact(COUNT_CODECS, data, &reply);
-        return static_cast<size_t>(reply.readInt32());
+        int32_t count = reply.readInt32();
+        Mutex::Autolock _l(mLock);
+        mCodecCount = count;
+        return static_cast<size_t>(count);
     }
 
     virtual sp<MediaCodecInfo> getCodecInfo(size_t index) const
     {
+        {
+            Mutex::Autolock _l(mLock);
+            if (index < mCodecInfoCache.size() && mCodecInfoCache[index] != NULL) {
+                return mCodecInfoCache[index];
+            }
+        }
         Parcel data, reply;
         data.writeInterfaceToken(IMediaCodecList::getInterfaceDescriptor());
         data.writeInt32(index);
         remote()->transact(GET_CODEC_INFO, data, &reply);
         status_t err = reply.readInt32();
         if (err == OK) {
-            return MediaCodecInfo::FromParcel(reply);
+            sp<MediaCodecInfo> info = MediaCodecInfo::FromParcel(reply);
+            if (info != NULL) {
+                Mutex::Autolock _l(mLock);
+                if (index >= mCodecInfoCache.size()) {
+                    mCodecInfoCache.resize(index + 1);
+                }
+                mCodecInfoCache[index] = info;
+            }
+            return info;
         } else {
             return NULL;
         }
@@ -67,12 +98,23 @@ public:
 
     virtual const sp<AMessage> getGlobalSettings() const
     {
+        {
+            Mutex::Autolock _l(mLock);
+            if (mGlobalSettings != NULL) {
+                return mGlobalSettings;
+            }
+        }
         Parcel data, reply;
         data.writeInterfaceToken(IMediaCodecList::getInterfaceDescriptor());
         remote()->transact(GET_GLOBAL_SETTINGS, data, &reply);
         status_t err = reply.readInt32();
         if (err == OK) {
-            return AMessage::FromParcel(reply);
+            sp<AMessage> settings = AMessage::FromParcel(reply);
+            if (settings != NULL) {
+                Mutex::Autolock _l(mLock);
+                mGlobalSettings = settings;
+            }
+            return settings;
         } else {
             return NULL;
         }
@@ -102,6 +144,12 @@ public:
         remote()->transact(FIND_CODEC_BY_NAME, data, &reply);
         return static_cast<ssize_t>(reply.readInt32());
     }
+
+private:
+    mutable Mutex mLock;
+    mutable int32_t mCodecCount = -1;
+    mutable std::vector<sp<MediaCodecInfo>> mCodecInfoCache;
+    mutable sp<AMessage> mGlobalSettings;
 };
 
 IMPLEMENT_META_INTERFACE(MediaCodecList, "android.media.IMediaCodecList");
@@ -366,11 +366,17 @@ status_t BnMediaSource::onTransact(
                 size_t offset = buf->range_offset();
                 if (length >= (supportNonblockingRead() && buf->mMemory != nullptr ?
                         kTransferSharedAsSharedThreshold : kTransferInlineAsSharedThreshold)) {
-                    if (buf->mMemory != nullptr) {
+                    if (buf->mMemory != nullptr && supportNonblockingRead()) {
                         ALOGV("Use shared memory: %zu", length);
                         transferBuf = buf;
                     } else {
-                        ALOGV("Large buffer %zu without IMemory!", length);
+                        // A blocking source may need its own shared buffer back
+                        // before it can produce the next sample, so sending it
+                        // as-is would end the batch after a single buffer. Copy
+                        // the sample into one of our shared buffers instead and
+                        // keep batching as long as the group has spares.
+                        ALOGV_IF(buf->mMemory == nullptr,
+                                "Large buffer %zu without IMemory!", length);
                         ret = mGroup->acquire_buffer(
                                 (MediaBufferBase **)&transferBuf, false /* nonBlocking */, length);
                         if (ret != OK
@@ -382,8 +388,16 @@ status_t BnMediaSource::onTransact(
                                 transferBuf->release();
                                 transferBuf = nullptr;
                             }
-                            // Current buffer transmit inline; no more additional buffers.
+                            if (buf->mMemory != nullptr) {
+                                // Send the source's own shared buffer after all;
+                                // no more additional buffers.
+                                transferBuf = buf;
+                            }
+                            // Otherwise current buffer transmits inline; no more
+                            // additional buffers either way. The sample is still
+                            // delivered, so don't surface the acquire failure.
                             maxNumBuffers = 0;
+                            ret = NO_ERROR;
                         } else {
                             memcpy(transferBuf->data(), (uint8_t*)buf->data() + offset, length);
                             offset = 0;
@@ -89,6 +89,21 @@ public:
         return false;
     }
 
+    /**
+     * Take a reference to |buffer| instead of copying its content, so that
+     * asC2Buffer() returns |buffer| itself. Implementations that cannot hand
+     * the wrapped buffer to the component return false, in which case the
+     * caller should fall back to copy().
+     *
+     * \param   buffer  C2Buffer object to wrap.
+     * \return  true    if the buffer was wrapped
+     *          false   otherwise.
+     */
+    virtual bool wrap(const std::shared_ptr<C2Buffer> &buffer) {
+        (void)buffer;
+        return false;
+    }
+
 private:
     MediaCodecBuffer() = delete;
 
@@ -886,7 +886,8 @@ public:
     // Iteration of props within item
     class iterator {
     public:
-        explicit iterator(const std::map<std::string, Prop>::const_iterator &_it) : it(_it) { }
+        explicit iterator(
+                const std::map<std::string, Prop, std::less<>>::const_iterator &_it) : it(_it) { }
         iterator &operator++() {
             ++it;
             return *this;
@@ -899,7 +900,7 @@ public:
         }
 
     private:
-        std::map<std::string, Prop>::const_iterator it;
+        std::map<std::string, Prop, std::less<>>::const_iterator it;
     };
 
     iterator begin() const {
@@ -1194,9 +1195,9 @@ private:
     }
 
     Prop &findOrAllocateProp(const char *key) {
-        auto it = mProps.find(key);
-        if (it != mProps.end()) return it->second;
-        Prop &prop = mProps[key];
+        auto it = mProps.lower_bound(key);
+        if (it != mProps.end() && it->first == key) return it->second;
+        Prop &prop = mProps.emplace_hint(it, key, Prop())->second;
         prop.setName(key);
         return prop;
     }
@@ -1208,7 +1209,10 @@ private:
     int64_t       mPkgVersionCode = 0;
     std::string   mKey;
     nsecs_t       mTimestamp = 0;
-    std::map<std::string, Prop> mProps;
+    // The transparent comparator lets findProp and findOrAllocateProp search
+    // with the caller's const char * key directly, instead of constructing a
+    // temporary std::string on every get/set/add.
+    std::map<std::string, Prop, std::less<>> mProps;
 };
 
 } // namespace mediametrics
@@ -27,6 +27,8 @@
 #include <utils/Errors.h>
 #include <utils/misc.h>
 
+#include <thread>
+
 #include "MediaPlayerFactory.h"
 
 #include "TestPlayerStub.h"
@@ -37,6 +39,11 @@ namespace android {
 Mutex MediaPlayerFactory::sLock;
 MediaPlayerFactory::tFactoryMap MediaPlayerFactory::sFactoryMap;
 bool MediaPlayerFactory::sInitComplete = false;
+sp<MediaPlayerBase> MediaPlayerFactory::sPrewarmedPlayer;
+
+static bool prewarmEnabled() {
+    return property_get_bool("media.nuplayer.prewarm", false);
+}
 
 status_t MediaPlayerFactory::registerFactory_l(IFactory* factory,
                                                player_type type) {
@@ -124,6 +131,26 @@ player_type MediaPlayerFactory::getPlayerType(const sp<IMediaPlayer>& client,
 
 #undef GET_PLAYER_TYPE_IMPL
 
+void MediaPlayerFactory::prewarmPlayer() {
+    if (!prewarmEnabled()) {
+        return;
+    }
+
+    // Construct outside of sLock; the looper threads start in the
+    // constructor and this may be called from the request path's refill
+    // thread.  The pid is a placeholder until the player is handed out.
+    sp<MediaPlayerBase> p = new NuPlayerDriver(getpid());
+    if (p->initCheck() != NO_ERROR) {
+        ALOGW("prewarmPlayer: initCheck failed, not parking player");
+        return;
+    }
+
+    Mutex::Autolock lock_(&sLock);
+    if (sPrewarmedPlayer == NULL) {
+        sPrewarmedPlayer = p;
+    }
+}
+
 sp<MediaPlayerBase> MediaPlayerFactory::createPlayer(
         player_type playerType,
         const sp<MediaPlayerBase::Listener> &listener,
@@ -139,6 +166,20 @@ sp<MediaPlayerBase> MediaPlayerFactory::createPlayer(
         return p;
     }
 
+    if (playerType == NU_PLAYER && sPrewarmedPlayer != NULL) {
+        p = sPrewarmedPlayer;
+        sPrewarmedPlayer.clear();
+        if (static_cast<NuPlayerDriver *>(p.get())->setClientPid(pid) == OK) {
+            ALOGV("handing out prewarmed NuPlayer");
+            p->setNotifyCallback(listener);
+            // Refill the parked slot off the request path.
+            std::thread(&MediaPlayerFactory::prewarmPlayer).detach();
+            return p;
+        }
+        // Unexpected state; fall through and construct a fresh player.
+        p.clear();
+    }
+
     factory = sFactoryMap.valueFor(playerType);
     CHECK(NULL != factory);
     p = factory->createPlayer(pid);
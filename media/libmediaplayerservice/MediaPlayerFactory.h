@@ -70,6 +70,13 @@ class MediaPlayerFactory {
 
     static void registerBuiltinFactories();
 
+    /* Park one NuPlayer instance with its looper threads already running so
+     * the next createPlayer(NU_PLAYER) skips cold construction.  No-op
+     * unless the "media.nuplayer.prewarm" property is set; the pool refills
+     * itself off the request path after each handout.
+     */
+    static void prewarmPlayer();
+
   private:
     typedef KeyedVector<player_type, IFactory*> tFactoryMap;
 
@@ -81,6 +88,7 @@ class MediaPlayerFactory {
     static Mutex       sLock;
     static tFactoryMap sFactoryMap;
     static bool        sInitComplete;
+    static sp<MediaPlayerBase> sPrewarmedPlayer;
 
     DISALLOW_EVIL_CONSTRUCTORS(MediaPlayerFactory);
 };
@@ -451,6 +451,10 @@ MediaPlayerService::MediaPlayerService()
     mNextConnId = 1;
 
     MediaPlayerFactory::registerBuiltinFactories();
+
+    // Park a prewarmed player (property-gated no-op by default) so the first
+    // setDataSource() doesn't pay cold player construction.
+    MediaPlayerFactory::prewarmPlayer();
 }
 
 MediaPlayerService::~MediaPlayerService()
@@ -52,6 +52,11 @@ static const int kInitialMarkMs        = 5000;  // 5secs
 //static const int kPausePlaybackMarkMs  = 2000;  // 2secs
 static const int kResumePlaybackMarkMs = 15000;  // 15secs
 
+// Cap on the bytes queued ahead of the decoders across audio and video.
+// The duration marks alone let high-bitrate content queue far more memory
+// than low-bitrate content for the same readahead time.
+static const int64_t kDefaultReadAheadBudgetBytes = 16 * 1024 * 1024;
+
 NuPlayer::GenericSource::GenericSource(
         const sp<AMessage> &notify,
         bool uidValid,
@@ -83,6 +88,8 @@ NuPlayer::GenericSource::GenericSource(
 
     mBufferingSettings.mInitialMarkMs = kInitialMarkMs;
     mBufferingSettings.mResumePlaybackMarkMs = kResumePlaybackMarkMs;
+    mReadAheadBudgetBytes = property_get_int64(
+            "media.stagefright.readahead-bytes", kDefaultReadAheadBudgetBytes);
     resetDataSource();
 }
 
@@ -877,7 +884,8 @@ status_t NuPlayer::GenericSource::dequeueAccessUnit(
         int64_t restartBufferingMarkUs =
              mBufferingSettings.mResumePlaybackMarkMs * 1000LL / 2;
         if (finalResult == OK) {
-            if (durationUs < restartBufferingMarkUs) {
+            if (durationUs < restartBufferingMarkUs
+                    && getQueuedBufferSizeBytes() < mReadAheadBudgetBytes) {
                 postReadBuffer(audio? MEDIA_TRACK_TYPE_AUDIO : MEDIA_TRACK_TYPE_VIDEO);
             }
             if (track->mPackets->getAvailableBufferCount(&finalResult) < 2
@@ -1304,6 +1312,18 @@ int32_t NuPlayer::GenericSource::getDataGeneration(media_track_type type) const
     return generation;
 }
 
+// called with mLock held
+int64_t NuPlayer::GenericSource::getQueuedBufferSizeBytes() {
+    int64_t totalBytes = 0;
+    if (mAudioTrack.mSource != NULL) {
+        totalBytes += mAudioTrack.mPackets->getBufferedSizeBytes();
+    }
+    if (mVideoTrack.mSource != NULL) {
+        totalBytes += mVideoTrack.mPackets->getBufferedSizeBytes();
+    }
+    return totalBytes;
+}
+
 void NuPlayer::GenericSource::postReadBuffer(media_track_type trackType) {
     if ((mPendingReadBufferTypes & (1 << trackType)) == 0) {
         mPendingReadBufferTypes |= (1 << trackType);
@@ -1467,14 +1487,18 @@ void NuPlayer::GenericSource::readBuffer(
         // mBufferingSettings.mResumePlaybackMarkMs
         int64_t markUs = (mPreparing ? mBufferingSettings.mInitialMarkMs
             : mBufferingSettings.mResumePlaybackMarkMs) * 1000LL;
-        if (finalResult == ERROR_END_OF_STREAM || durationUs >= markUs) {
+        // high-bitrate content hits the byte budget before the duration
+        // mark; treat that as sufficient so memory use stays bounded
+        bool byteBudgetFull = getQueuedBufferSizeBytes() >= mReadAheadBudgetBytes;
+        if (finalResult == ERROR_END_OF_STREAM || durationUs >= markUs || byteBudgetFull) {
             if (mPreparing || mSentPauseOnBuffering) {
                 Track *counterTrack =
                     (trackType == MEDIA_TRACK_TYPE_VIDEO ? &mAudioTrack : &mVideoTrack);
                 if (counterTrack->mSource != NULL) {
                     durationUs = counterTrack->mPackets->getBufferedDurationUs(&finalResult);
                 }
-                if (finalResult == ERROR_END_OF_STREAM || durationUs >= markUs) {
+                if (finalResult == ERROR_END_OF_STREAM || durationUs >= markUs
+                        || byteBudgetFull) {
                     if (mPreparing) {
                         notifyPrepared();
                         mPreparing = false;
@@ -221,6 +221,12 @@ void NuPlayer::setUID(uid_t uid) {
     mUID = uid;
 }
 
+void NuPlayer::setClientPid(pid_t pid) {
+    // The pid is only consumed when decoders are instantiated, so a
+    // prewarmed player may be reassigned before setDataSource*().
+    mPID = pid;
+}
+
 void NuPlayer::init(const wp<NuPlayerDriver> &driver) {
     mDriver = driver;
 
@@ -74,6 +74,7 @@ NuPlayer::Decoder::Decoder(
       mNumFramesTotal(0LL),
       mNumInputFramesDropped(0LL),
       mNumOutputFramesDropped(0LL),
+      mNumDecodeOnlyFrames(0LL),
       mVideoWidth(0),
       mVideoHeight(0),
       mIsAudio(true),
@@ -111,6 +112,7 @@ sp<AMessage> NuPlayer::Decoder::getStats() {
     mStats->setInt64("frames-total", mNumFramesTotal);
     mStats->setInt64("frames-dropped-input", mNumInputFramesDropped);
     mStats->setInt64("frames-dropped-output", mNumOutputFramesDropped);
+    mStats->setInt64("frames-decode-only", mNumDecodeOnlyFrames);
     mStats->setFloat("frame-rate-total", mFrameRateTotal);
 
     // make our own copy, so we aren't victim to any later changes.
@@ -217,6 +219,21 @@ void NuPlayer::Decoder::onMessageReceived(const sp<AMessage> &msg) {
             break;
         }
 
+        case kWhatFrameRendered:
+        {
+            sp<AMessage> data;
+            if (mRenderer != NULL && msg->findMessage("data", &data)) {
+                int64_t systemNano;
+                for (size_t i = 0;
+                        data->findInt64(
+                                AStringPrintf("%zu-system-nano", i).c_str(), &systemNano);
+                        ++i) {
+                    mRenderer->onFrameRendered(systemNano);
+                }
+            }
+            break;
+        }
+
         case kWhatAudioOutputFormatChanged:
         {
             if (!isStaleReply(msg)) {
@@ -381,6 +398,13 @@ void NuPlayer::Decoder::onConfigure(const sp<AMessage> &format) {
     sp<AMessage> reply = new AMessage(kWhatCodecNotify, this);
     mCodec->setCallback(reply);
 
+    if (!mIsAudio && mSurface != NULL) {
+        // Request actual presentation times from the codec so the renderer's
+        // frame scheduler can track the display instead of running open loop.
+        sp<AMessage> renderedNotify = new AMessage(kWhatFrameRendered, this);
+        mCodec->setOnFrameRenderedNotification(renderedNotify);
+    }
+
     err = mCodec->start();
     if (err != OK) {
         ALOGE("Failed to start [%s] decoder (err=%d)", mComponentName.c_str(), err);
@@ -1061,6 +1085,14 @@ bool NuPlayer::Decoder::onInputBufferFetched(const sp<AMessage> &msg) {
             flags |= MediaCodec::BUFFER_FLAG_EOS;
         } else if (buffer->meta()->findInt32("csd", &csd) && csd) {
             flags |= MediaCodec::BUFFER_FLAG_CODECCONFIG;
+        } else if (!mIsAudio && mSkipRenderingUntilMediaTimeUs >= 0
+                && timeUs < mSkipRenderingUntilMediaTimeUs) {
+            // This frame precedes the seek target and would be dropped after
+            // decode anyway; tell the codec it needn't produce output for it.
+            // Decoders that ignore the hint are still caught by the
+            // post-decode drop above.
+            flags |= MediaCodec::BUFFER_FLAG_DECODE_ONLY;
+            ++mNumDecodeOnlyFrames;
         }
 
         if (buffer->meta()->findInt32("cvo", (int32_t*)&cvo)) {
@@ -39,6 +39,13 @@ namespace android {
 static const size_t kAggregateBufferSizeBytes = 24 * 1024;
 static const size_t kMaxCachedBytes = 200000;
 
+// Target duration of one aggregated buffer when the stream bitrate is known.
+// Aggregation trades sink wakeups for latency; with a fixed byte size a
+// low-bitrate stream spends several seconds of content filling one buffer.
+// 24 KB corresponds to roughly this much E-AC3 at 768 kbps.
+static const int64_t kAggregateDurationUs = 250000;
+static const size_t kMinAggregateBufferSizeBytes = 4 * 1024;
+
 NuPlayer::DecoderPassThrough::DecoderPassThrough(
         const sp<AMessage> &notify,
         const sp<Source> &source,
@@ -51,6 +58,7 @@ NuPlayer::DecoderPassThrough::DecoderPassThrough(
       mPendingAudioErr(OK),
       mPendingBuffersToDrain(0),
       mCachedBytes(0),
+      mAggregateBufferSizeBytes(kAggregateBufferSizeBytes),
       mComponentName("pass through decoder") {
     ALOGW_IF(renderer == NULL, "expect a non-NULL renderer");
 }
@@ -70,6 +78,23 @@ void NuPlayer::DecoderPassThrough::onConfigure(const sp<AMessage> &format) {
     int32_t hasVideo = 0;
     format->findInt32("has-video", &hasVideo);
 
+    // Size aggregation for the negotiated format: hold roughly
+    // kAggregateDurationUs of content per aggregated buffer instead of a
+    // fixed byte count. Without a bitrate in the format keep the legacy size.
+    mAggregateBufferSizeBytes = kAggregateBufferSizeBytes;
+    int32_t bitrate = 0;
+    if (format->findInt32("bitrate", &bitrate) && bitrate > 0) {
+        size_t bytes = (size_t)((int64_t)bitrate / 8 * kAggregateDurationUs / 1000000);
+        if (bytes < kMinAggregateBufferSizeBytes) {
+            bytes = kMinAggregateBufferSizeBytes;
+        } else if (bytes > kAggregateBufferSizeBytes) {
+            bytes = kAggregateBufferSizeBytes;
+        }
+        mAggregateBufferSizeBytes = bytes;
+        ALOGV("[%s] aggregate buffer size %zu bytes for bitrate %d",
+                mComponentName.c_str(), mAggregateBufferSizeBytes, bitrate);
+    }
+
     // The audio sink is already opened before the PassThrough decoder is created.
     // Opening again might be relevant if decoder is instantiated after shutdown and
     // format is different.
@@ -167,9 +192,9 @@ sp<ABuffer> NuPlayer::DecoderPassThrough::aggregateBuffer(
     size_t smallSize = accessUnit->size();
     if ((mAggregateBuffer == NULL)
             // Don't bother if only room for a few small buffers.
-            && (smallSize < (kAggregateBufferSizeBytes / 3))) {
+            && (smallSize < (mAggregateBufferSizeBytes / 3))) {
         // Create a larger buffer for combining smaller buffers from the extractor.
-        mAggregateBuffer = new ABuffer(kAggregateBufferSizeBytes);
+        mAggregateBuffer = new ABuffer(mAggregateBufferSizeBytes);
         mAggregateBuffer->setRange(0, 0); // start empty
     }
 
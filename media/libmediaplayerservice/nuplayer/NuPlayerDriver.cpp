@@ -127,6 +127,15 @@ status_t NuPlayerDriver::initCheck() {
     return OK;
 }
 
+status_t NuPlayerDriver::setClientPid(pid_t pid) {
+    if (mState != STATE_IDLE) {
+        ALOGE("setClientPid called in state %d", mState);
+        return INVALID_OPERATION;
+    }
+    mPlayer->setClientPid(pid);
+    return OK;
+}
+
 status_t NuPlayerDriver::setUID(uid_t uid) {
     mPlayer->setUID(uid);
     mClientUid = uid;
@@ -163,6 +163,8 @@ NuPlayer::Renderer::Renderer(
       mUseAudioCallback(false),
       mWakeLock(new AWakeLock()) {
     CHECK(mediaClock != NULL);
+    mVideoPrequeueEnabled =
+            property_get_bool("media.stagefright.video-prequeue", false);
     mPlaybackRate = mPlaybackSettings.mSpeed;
     mMediaClock->setPlaybackRate(mPlaybackRate);
     (void)mSyncFlag.test_and_set();
@@ -384,6 +386,12 @@ void NuPlayer::Renderer::setVideoFrameRate(float fps) {
     msg->post();
 }
 
+void NuPlayer::Renderer::onFrameRendered(nsecs_t renderTimeNs) {
+    sp<AMessage> msg = new AMessage(kWhatFrameRendered, this);
+    msg->setInt64("renderTimeNs", renderTimeNs);
+    msg->post();
+}
+
 // Called on any threads without mLock acquired.
 status_t NuPlayer::Renderer::getCurrentPosition(int64_t *mediaUs) {
     status_t result = mMediaClock->getMediaTime(ALooper::GetNowUs(), mediaUs);
@@ -783,6 +791,16 @@ void NuPlayer::Renderer::onMessageReceived(const sp<AMessage> &msg) {
             break;
         }
 
+        case kWhatFrameRendered:
+        {
+            int64_t renderTimeNs;
+            CHECK(msg->findInt64("renderTimeNs", &renderTimeNs));
+            if (mVideoScheduler != NULL) {
+                mVideoScheduler->onFrameRendered(renderTimeNs);
+            }
+            break;
+        }
+
         case kWhatAudioTearDown:
         {
             int32_t reason;
@@ -1451,6 +1469,15 @@ void NuPlayer::Renderer::onDrainVideoQueue() {
 
     mVideoSampleReceived = true;
 
+    if (mVideoPrequeueEnabled && !mPaused && !tooLate) {
+        // Hand the following frame to the codec right away with its own
+        // release time, so a renderer thread hiccup of less than a frame
+        // interval can't hold up its queueBuffer. The codec passes the
+        // timestamp through to the surface and SurfaceFlinger's latch
+        // does the final vsync selection.
+        prequeueNextVideoFrame(realTimeUs, nowUs);
+    }
+
     if (!mPaused) {
         if (!mVideoRenderingStarted) {
             mVideoRenderingStarted = true;
@@ -1461,6 +1488,43 @@ void NuPlayer::Renderer::onDrainVideoQueue() {
     }
 }
 
+void NuPlayer::Renderer::prequeueNextVideoFrame(int64_t headRealTimeUs, int64_t nowUs) {
+    if (mVideoQueue.empty()) {
+        return;
+    }
+
+    QueueEntry *next = &*mVideoQueue.begin();
+    if (next->mBuffer == NULL) {
+        // Leave EOS to the regular drain path.
+        return;
+    }
+
+    int64_t nextRealTimeUs;
+    if (mFlags & FLAG_REAL_TIME) {
+        CHECK(next->mBuffer->meta()->findInt64("timeUs", &nextRealTimeUs));
+    } else {
+        int64_t nextMediaTimeUs;
+        CHECK(next->mBuffer->meta()->findInt64("timeUs", &nextMediaTimeUs));
+
+        nextRealTimeUs = getRealTimeUs(nextMediaTimeUs, nowUs);
+    }
+    nextRealTimeUs = mVideoScheduler->schedule(nextRealTimeUs * 1000) / 1000;
+
+    int64_t twoVsyncsUs = 2 * (mVideoScheduler->getVsyncPeriod() / 1000);
+    if (nextRealTimeUs - headRealTimeUs > twoVsyncsUs) {
+        // Not due yet, postDrainVideoQueue will schedule it as usual.
+        return;
+    }
+
+    ALOGV("prequeueing video frame due %lld us after head",
+            (long long)(nextRealTimeUs - headRealTimeUs));
+
+    next->mNotifyConsumed->setInt64("timestampNs", nextRealTimeUs * 1000LL);
+    next->mNotifyConsumed->setInt32("render", 1);
+    next->mNotifyConsumed->post();
+    mVideoQueue.erase(mVideoQueue.begin());
+}
+
 void NuPlayer::Renderer::notifyVideoRenderingStart() {
     sp<AMessage> notify = mNotify->dup();
     notify->setInt32("what", kWhatVideoRenderingStart);
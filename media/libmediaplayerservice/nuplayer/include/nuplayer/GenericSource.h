@@ -135,6 +135,8 @@ private:
     Track mTimedTextTrack;
 
     BufferingSettings mBufferingSettings;
+    // bytes we're willing to queue ahead of the decoders (audio + video)
+    int64_t mReadAheadBudgetBytes;
     int32_t mPrevBufferPercentage;
     int32_t mPollBufferingGeneration;
     bool mSentPauseOnBuffering;
@@ -205,6 +207,7 @@ private:
             MediaBufferBase *mbuf,
             media_track_type trackType);
 
+    int64_t getQueuedBufferSizeBytes();
     void postReadBuffer(media_track_type trackType);
     void onReadBuffer(const sp<AMessage>& msg);
     // When |mode| is MediaPlayerSeekMode::SEEK_CLOSEST, the buffer read shall
@@ -38,6 +38,10 @@ struct NuPlayer : public AHandler {
 
     void setUID(uid_t uid);
 
+    // Reassign the client pid of a player that has not yet created decoders;
+    // used when handing out a prewarmed player.
+    void setClientPid(pid_t pid);
+
     void init(const wp<NuPlayerDriver> &driver);
 
     void setDataSourceAsync(const sp<IStreamSource> &source);
@@ -58,6 +58,7 @@ private:
     enum {
         kWhatCodecNotify         = 'cdcN',
         kWhatRenderBuffer        = 'rndr',
+        kWhatFrameRendered       = 'frnd',
         kWhatSetVideoSurface     = 'sSur',
         kWhatAudioOutputFormatChanged = 'aofc',
         kWhatDrmReleaseCrypto    = 'rDrm',
@@ -94,6 +95,7 @@ private:
     int64_t mNumFramesTotal;
     int64_t mNumInputFramesDropped;
     int64_t mNumOutputFramesDropped;
+    int64_t mNumDecodeOnlyFrames;
     int32_t mVideoWidth;
     int32_t mVideoHeight;
     bool mIsAudio;
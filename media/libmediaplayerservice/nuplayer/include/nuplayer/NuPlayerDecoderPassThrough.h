@@ -64,6 +64,9 @@ private:
     // when the power investigation is done.
     size_t  mPendingBuffersToDrain;
     size_t  mCachedBytes;
+    // Capacity of mAggregateBuffer, derived from the stream bitrate
+    // at configure time.
+    size_t  mAggregateBufferSizeBytes;
     AString mComponentName;
 
     bool isStaleReply(const sp<AMessage> &msg);
@@ -32,6 +32,10 @@ struct NuPlayerDriver : public MediaPlayerInterface {
 
     virtual status_t setUID(uid_t uid);
 
+    // Reassign the client pid of a prewarmed player before any data source
+    // is set; see MediaPlayerFactory::prewarmPlayer().
+    status_t setClientPid(pid_t pid);
+
     virtual status_t setDataSource(
             const sp<IMediaHTTPService> &httpService,
             const char *url,
@@ -71,6 +71,9 @@ struct NuPlayer::Renderer : public AHandler {
 
     void setVideoFrameRate(float fps);
 
+    // called when the codec reports a frame was presented on the display
+    void onFrameRendered(nsecs_t renderTimeNs);
+
     status_t getCurrentPosition(int64_t *mediaUs);
     int64_t getVideoLateByUs();
 
@@ -135,6 +138,7 @@ private:
         kWhatDisableOffloadAudio = 'noOA',
         kWhatEnableOffloadAudio  = 'enOA',
         kWhatSetVideoFrameRate   = 'sVFR',
+        kWhatFrameRendered       = 'fRnd',
     };
 
     // if mBuffer != nullptr, it's a buffer containing real data.
@@ -195,6 +199,9 @@ private:
 
     bool mVideoSampleReceived;
     bool mVideoRenderingStarted;
+    // if enabled, hand the next video frame to the codec together with the
+    // current one when it's already due, instead of one message per frame.
+    bool mVideoPrequeueEnabled;
     int32_t mVideoRenderingStartGeneration;
     int32_t mAudioRenderingStartGeneration;
     bool mRenderingDataDelivered;
@@ -253,6 +260,7 @@ private:
 
     void onDrainVideoQueue();
     void postDrainVideoQueue();
+    void prequeueNextVideoFrame(int64_t headRealTimeUs, int64_t nowUs);
 
     void prepareForMediaRenderingStart_l();
     void notifyIfMediaRenderingStarted_l();
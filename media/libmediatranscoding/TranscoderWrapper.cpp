@@ -576,6 +576,18 @@ void TranscoderWrapper::logSessionEnded(const TranscodingLogger::SessionEndedRea
     if (reason == TranscodingLogger::SessionEndedReason::FINISHED && error == AMEDIA_OK) {
         transcodeDuration = std::chrono::duration_cast<std::chrono::microseconds>(
                 std::chrono::steady_clock::now() - mTranscodeStartTime);
+
+        // Log the achieved throughput so batch runs can be profiled from logcat;
+        // the statsd atom has no field for it.
+        int64_t mediaDurationUs = -1;
+        if (mSrcFormat != nullptr && transcodeDuration.count() > 0 &&
+            AMediaFormat_getInt64(mSrcFormat.get(), AMEDIAFORMAT_KEY_DURATION, &mediaDurationUs) &&
+            mediaDurationUs > 0) {
+            ALOGI("session {%lld, %d}: transcoded %.2fs of media in %.2fs (%.2fx realtime)",
+                  (long long)mCurrentClientId, mCurrentSessionId, mediaDurationUs / 1E6,
+                  transcodeDuration.count() / 1E6,
+                  (double)mediaDurationUs / transcodeDuration.count());
+        }
     }
 
     mLogger->logSessionEnded(reason, mCurrentCallingUid, error, transcodeDuration, mSrcFormat.get(),
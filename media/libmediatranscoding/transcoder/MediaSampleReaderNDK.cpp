@@ -18,6 +18,7 @@
 #define LOG_TAG "MediaSampleReader"
 
 #include <android-base/logging.h>
+#include <fcntl.h>
 #include <media/MediaSampleReaderNDK.h>
 
 #include <algorithm>
@@ -45,6 +46,13 @@ std::shared_ptr<MediaSampleReader> MediaSampleReaderNDK::createFromFd(int fd, si
         return nullptr;
     }
 
+    // The transcoding pipeline consumes the source roughly sequentially, and strictly so once
+    // sequential access is enforced, so ask the kernel to read ahead aggressively. This overlaps
+    // the extraction I/O with decoding and encoding without buffering samples in user space.
+    if (posix_fadvise(fd, offset, size, POSIX_FADV_SEQUENTIAL) != 0) {
+        LOG(DEBUG) << "Unable to set readahead hint on source fd";
+    }
+
     auto sampleReader = std::shared_ptr<MediaSampleReaderNDK>(new MediaSampleReaderNDK(extractor));
     return sampleReader;
 }
@@ -84,6 +84,43 @@ static std::shared_ptr<AMediaFormat> createVideoTrackFormat(AMediaFormat* srcFor
     return trackFormat;
 }
 
+static bool canPassthroughVideoTrack(AMediaFormat* srcFormat, AMediaFormat* dstFormat) {
+    const char *srcMime, *dstMime;
+    if (!AMediaFormat_getString(srcFormat, AMEDIAFORMAT_KEY_MIME, &srcMime) ||
+        !AMediaFormat_getString(dstFormat, AMEDIAFORMAT_KEY_MIME, &dstMime) ||
+        strcmp(srcMime, dstMime) != 0) {
+        return false;
+    }
+
+    // Every bitstream-affecting parameter present in the destination format must already hold
+    // for the source track. A destination key the source cannot confirm (e.g. a requested
+    // i-frame interval, or a bit rate the extractor did not report) forces a re-encode.
+    // Encoder-only hints such as priority and operating rate do not affect the output samples
+    // and are deliberately left out.
+    static constexpr const char* kBitstreamKeys[] = {
+            AMEDIAFORMAT_KEY_WIDTH,
+            AMEDIAFORMAT_KEY_HEIGHT,
+            AMEDIAFORMAT_KEY_BIT_RATE,
+            AMEDIAFORMAT_KEY_PROFILE,
+            AMEDIAFORMAT_KEY_LEVEL,
+            AMEDIAFORMAT_KEY_FRAME_RATE,
+            AMEDIAFORMAT_KEY_I_FRAME_INTERVAL,
+            AMEDIAFORMAT_KEY_COLOR_RANGE,
+            AMEDIAFORMAT_KEY_COLOR_STANDARD,
+            AMEDIAFORMAT_KEY_COLOR_TRANSFER,
+    };
+    for (const char* key : kBitstreamKeys) {
+        int32_t srcValue, dstValue;
+        if (!AMediaFormat_getInt32(dstFormat, key, &dstValue)) {
+            continue;
+        }
+        if (!AMediaFormat_getInt32(srcFormat, key, &srcValue) || srcValue != dstValue) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void MediaTranscoder::onThreadFinished(const void* thread, media_status_t threadStatus,
                                        bool threadStopped) {
     LOG(DEBUG) << "Thread " << thread << " finished with status " << threadStatus << " stopped "
@@ -333,13 +370,22 @@ media_status_t MediaTranscoder::configureTrackFormat(size_t trackIndex,
             }
         }
 
-        transcoder = VideoTrackTranscoder::create(shared_from_this(), mPid, mUid);
-
         trackFormat = createVideoTrackFormat(srcTrackFormat, destinationOptions);
         if (trackFormat == nullptr) {
             LOG(ERROR) << "Unable to create video track format";
             return AMEDIA_ERROR_UNKNOWN;
         }
+
+        // If the requested destination format would not change the bitstream, remux the encoded
+        // source samples as-is instead of doing a decode/encode round trip.
+        if (canPassthroughVideoTrack(srcTrackFormat, trackFormat.get())) {
+            LOG(INFO) << "Track #" << trackIndex
+                      << " destination format matches the source, using passthrough.";
+            transcoder = std::make_shared<PassthroughTrackTranscoder>(shared_from_this());
+            trackFormat.reset();
+        } else {
+            transcoder = VideoTrackTranscoder::create(shared_from_this(), mPid, mUid);
+        }
     }
 
     media_status_t status = mSampleReader->selectTrack(trackIndex);
@@ -317,6 +317,16 @@ TEST_F(MediaTranscoderTests, TestPreserveBitrate) {
     EXPECT_LT(getFileSizeDiffPercent(srcPath, destPath, true /* absolute*/), 25);
 }
 
+TEST_F(MediaTranscoderTests, TestPassthroughMatchingFormat) {
+    const char* srcPath = "/data/local/tmp/TranscodingTestAssets/cubicle_avc_480x240_aac_24KHz.mp4";
+    const char* destPath = "/data/local/tmp/MediaTranscoder_PassthroughMatchingFormat.MP4";
+    testTranscodeVideo(srcPath, destPath, AMEDIA_MIMETYPE_VIDEO_AVC);
+
+    // A destination format that matches the source should be remuxed rather than re-encoded,
+    // so the video track comes through unmodified and the file size barely changes.
+    EXPECT_LT(getFileSizeDiffPercent(srcPath, destPath, true /* absolute*/), 5);
+}
+
 TEST_F(MediaTranscoderTests, TestCustomBitrate) {
     const char* srcPath = "/data/local/tmp/TranscodingTestAssets/cubicle_avc_480x240_aac_24KHz.mp4";
     const char* destPath1 = "/data/local/tmp/MediaTranscoder_CustomBitrate_2Mbps.MP4";
@@ -162,6 +162,32 @@ ssize_t MonoPipe::write(const void *buffer, size_t count)
     return totalFramesWritten;
 }
 
+ssize_t MonoPipe::reserve(void *buffers[2], size_t frameCounts[2], size_t count)
+{
+    if (CC_UNLIKELY(!mNegotiated)) {
+        return NEGOTIATE;
+    }
+    audio_utils_iovec iovec[2];
+    ssize_t actual = mFifoWriter.obtain(iovec, count, NULL /*timeout*/);
+    if (actual <= 0) {
+        buffers[0] = buffers[1] = NULL;
+        frameCounts[0] = frameCounts[1] = 0;
+        return actual;
+    }
+    for (int i = 0; i < 2; i++) {
+        buffers[i] = iovec[i].mLength != 0 ?
+                (char *) mBuffer + iovec[i].mOffset * mFrameSize : NULL;
+        frameCounts[i] = iovec[i].mLength;
+    }
+    return actual;
+}
+
+void MonoPipe::commit(size_t count)
+{
+    mFifoWriter.release(count);
+    mFramesWritten += count;
+}
+
 void MonoPipe::setAvgFrames(size_t setpoint)
 {
     mSetpoint = setpoint;
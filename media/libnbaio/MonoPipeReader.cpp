@@ -55,6 +55,32 @@ ssize_t MonoPipeReader::read(void *buffer, size_t count)
     return actual;
 }
 
+ssize_t MonoPipeReader::peek(void *buffers[2], size_t frameCounts[2], size_t count)
+{
+    if (CC_UNLIKELY(!mNegotiated)) {
+        return NEGOTIATE;
+    }
+    audio_utils_iovec iovec[2];
+    ssize_t actual = mFifoReader.obtain(iovec, count, NULL /*timeout*/);
+    if (actual <= 0) {
+        buffers[0] = buffers[1] = NULL;
+        frameCounts[0] = frameCounts[1] = 0;
+        return actual;
+    }
+    for (int i = 0; i < 2; i++) {
+        buffers[i] = iovec[i].mLength != 0 ?
+                (char *) mPipe->mBuffer + iovec[i].mOffset * mPipe->mFrameSize : NULL;
+        frameCounts[i] = iovec[i].mLength;
+    }
+    return actual;
+}
+
+void MonoPipeReader::release(size_t count)
+{
+    mFifoReader.release(count);
+    mFramesRead += count;
+}
+
 void MonoPipeReader::onTimestamp(const ExtendedTimestamp &timestamp)
 {
     mPipe->mTimestampMutator.push(timestamp);
@@ -76,6 +76,40 @@ ssize_t PipeReader::read(void *buffer, size_t count)
     return actual;
 }
 
+ssize_t PipeReader::peek(void *buffers[2], size_t frameCounts[2], size_t count,
+        const struct timespec *timeout)
+{
+    if (CC_UNLIKELY(!mNegotiated)) {
+        return NEGOTIATE;
+    }
+    audio_utils_iovec iovec[2];
+    size_t lost;
+    ssize_t avail = mFifoReader.obtain(iovec, count, timeout, &lost);
+    if (avail == -EOVERFLOW || lost > 0) {
+        mFramesOverrun += lost;
+        ++mOverruns;
+        avail = OVERRUN;
+    }
+    if (avail <= 0) {
+        buffers[0] = buffers[1] = NULL;
+        frameCounts[0] = frameCounts[1] = 0;
+        return avail;
+    }
+    const size_t frameSize = Format_frameSize(mFormat);
+    for (int i = 0; i < 2; i++) {
+        buffers[i] = iovec[i].mLength != 0 ?
+                (char *) mPipe.mBuffer + iovec[i].mOffset * frameSize : NULL;
+        frameCounts[i] = iovec[i].mLength;
+    }
+    return avail;
+}
+
+void PipeReader::release(size_t count)
+{
+    mFifoReader.release(count);
+    mFramesRead += count;
+}
+
 ssize_t PipeReader::flush()
 {
     if (CC_UNLIKELY(!mNegotiated)) {
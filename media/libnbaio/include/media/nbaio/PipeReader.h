@@ -51,6 +51,20 @@ public:
 
     // NBAIO_Source end
 
+    // Zero-copy counterpart of read(), for broadcast fan-out of one capture
+    // stream to several consumers: the writer deposits each block once with
+    // Pipe::write() and every PipeReader views it in place at its own cadence
+    // through its private cursor.  peek() returns the number of frames
+    // readable without copying, described by up to two contiguous regions
+    // (the fifo may wrap).  If timeout is non-NULL, blocks until at least one
+    // frame is available, the timeout expires, or an overrun intervenes;
+    // the wait is futex-based, woken directly by the writer.  The consumer
+    // then calls release() with the number of frames actually consumed,
+    // which must not exceed the peeked count.
+    ssize_t peek(void *buffers[2], size_t frameCounts[2], size_t count,
+            const struct timespec *timeout = NULL);
+    void    release(size_t count);
+
 #if 0   // until necessary
     Pipe& pipe() const { return mPipe; }
 #endif
@@ -63,6 +63,17 @@ public:
     virtual ssize_t write(const void *buffer, size_t count);
     //virtual ssize_t writeVia(writeVia_t via, size_t total, void *user, size_t block);
 
+            // Zero-copy write support.  reserve() returns the number of frames that can
+            // be written in place, not exceeding 'count', and sets buffers[0] and
+            // frameCounts[0] (and buffers[1] / frameCounts[1] when the writable space
+            // wraps around the end of the ring, zero otherwise) to the ring's underlying
+            // contiguous regions.  The producer fills the regions directly, then calls
+            // commit() with the number of frames actually written, which must not exceed
+            // the previously reserved count.  Unlike write(), reserve() never blocks,
+            // regardless of the writeCanBlock constructor parameter.
+            ssize_t reserve(void *buffers[2], size_t frameCounts[2], size_t count);
+            void    commit(size_t count);
+
             // average number of frames present in the pipe under normal conditions.
             // See throttling mechanism in MonoPipe::write()
             size_t  getAvgFrames() const { return mSetpoint; }
@@ -51,6 +51,16 @@ public:
 
     virtual void    onTimestamp(const ExtendedTimestamp &timestamp);
 
+            // Zero-copy read support, the consumer-side counterpart of
+            // MonoPipe::reserve() / commit().  peek() returns the number of frames that
+            // can be processed in place, not exceeding 'count', and sets buffers[0] and
+            // frameCounts[0] (and buffers[1] / frameCounts[1] when the readable data
+            // wraps around the end of the ring, zero otherwise) to the ring's underlying
+            // contiguous regions.  The consumer then calls release() with the number of
+            // frames actually consumed, which must not exceed the peeked count.
+            ssize_t peek(void *buffers[2], size_t frameCounts[2], size_t count);
+            void    release(size_t count);
+
     // NBAIO_Source end
 
 #if 0   // until necessary
@@ -229,7 +229,11 @@ const uint8_t *Reader::findLastValidEntry(const uint8_t *front, const uint8_t *b
 void DumpReader::dump(int fd, size_t indent)
 {
     if (fd < 0) return;
-    std::unique_ptr<Snapshot> snapshot = getSnapshot(false /*flush*/);
+    // Flushing advances our private fifo reader index past the decoded entries,
+    // so the index acts as a per-writer checkpoint: the first dump prints the
+    // retained history and subsequent dumps decode only what was logged since.
+    // Without it every dumpsys re-decoded the entire ring of every writer.
+    std::unique_ptr<Snapshot> snapshot = getSnapshot(true /*flush*/);
     if (snapshot == nullptr) {
         return;
     }
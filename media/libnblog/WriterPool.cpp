@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "NBLog"
+//#define LOG_NDEBUG 0
+
+#include <new>
+
+#include <binder/IMemory.h>
+#include <binder/IServiceManager.h>
+#include <binder/MemoryDealer.h>
+#include <media/IMediaLogService.h>
+#include <media/nblog/Timeline.h>
+#include <media/nblog/WriterPool.h>
+#include <utils/Log.h>
+#include <utils/String16.h>
+
+namespace android {
+namespace NBLog {
+
+WriterPool::WriterPool(size_t poolSize)
+{
+    // checkService() rather than getService(): when media.log is not running
+    // (it lives in audioserver and is optional), clients should get no-op
+    // writers immediately instead of blocking at process startup.
+    const sp<IBinder> binder =
+            defaultServiceManager()->checkService(String16("media.log"));
+    if (binder != 0) {
+        mMediaLogService = interface_cast<IMediaLogService>(binder);
+        mMemoryDealer = new MemoryDealer(poolSize, "NBLog::WriterPool");
+    } else {
+        ALOGV("media.log service unavailable, logging to no-op writers");
+    }
+}
+
+sp<Writer> WriterPool::newWriter(size_t size, const char *name)
+{
+    Mutex::Autolock _l(mLock);
+    return newWriter_l(size, name);
+}
+
+sp<Writer> WriterPool::newWriter_l(size_t size, const char *name)
+{
+    // If there is no memory allocated for logs, return a no-op writer that does nothing.
+    // Similarly if we can't contact the media.log service, also return a no-op writer.
+    if (mMemoryDealer == 0 || mMediaLogService == 0) {
+        return new Writer();
+    }
+    sp<IMemory> shared = mMemoryDealer->allocate(Timeline::sharedSize(size));
+    // If allocation fails, consult the vector of previously unregistered writers
+    // and garbage-collect one or more them until an allocation succeeds
+    if (shared == 0) {
+        for (size_t count = mUnregisteredWriters.size(); count > 0; count--) {
+            {
+                // Pick the oldest stale writer to garbage-collect
+                sp<IMemory> iMemory(mUnregisteredWriters[0]->getIMemory());
+                mUnregisteredWriters.removeAt(0);
+                mMediaLogService->unregisterWriter(iMemory);
+                // Now the media.log remote reference to IMemory is gone.  When our last local
+                // reference to IMemory also drops to zero at end of this block,
+                // the IMemory destructor will deallocate the region from mMemoryDealer.
+            }
+            // Re-attempt the allocation
+            shared = mMemoryDealer->allocate(Timeline::sharedSize(size));
+            if (shared != 0) {
+                goto success;
+            }
+        }
+        // Even after garbage-collecting all old writers, there is still not enough memory,
+        // so return a no-op writer
+        return new Writer();
+    }
+success:
+    Shared *sharedRawPtr = (Shared *) shared->unsecurePointer();
+    new((void *) sharedRawPtr) Shared(); // placement new here, but the corresponding
+                                         // explicit destructor not needed since it is POD
+    mMediaLogService->registerWriter(shared, size, name);
+    return new Writer(shared, size);
+}
+
+void WriterPool::unregisterWriter(const sp<Writer>& writer)
+{
+    if (writer == 0) {
+        return;
+    }
+    sp<IMemory> iMemory(writer->getIMemory());
+    if (iMemory == 0) {
+        return;
+    }
+    // Rather than removing the writer immediately, append it to a queue of old writers to
+    // be garbage-collected later.  This allows us to continue to view old logs for a while.
+    Mutex::Autolock _l(mLock);
+    mUnregisteredWriters.push(writer);
+}
+
+/*static*/ sp<WriterPool> WriterPool::getDefault()
+{
+    static Mutex sLock;
+    static sp<WriterPool> sDefault;
+    Mutex::Autolock _l(sLock);
+    if (sDefault == 0) {
+        sDefault = new WriterPool();
+    }
+    return sDefault;
+}
+
+}   // namespace NBLog
+}   // namespace android
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_MEDIA_NBLOG_WRITERPOOL_H
+#define ANDROID_MEDIA_NBLOG_WRITERPOOL_H
+
+#include <stddef.h>
+
+#include <media/nblog/Writer.h>
+#include <utils/Mutex.h>
+#include <utils/RefBase.h>
+#include <utils/Vector.h>
+
+namespace android {
+
+class IMediaLogService;
+class MemoryDealer;
+
+namespace NBLog {
+
+// WriterPool hands out NBLog writers whose shared memory is registered with
+// the media.log service, so that their timelines show up in the merged log
+// alongside the ones from other processes.  It factors out the pattern that
+// AudioFlinger uses for its thread logs: a single MemoryDealer per process,
+// lazy garbage collection of unregistered writers, and graceful fallback to
+// no-op writers when media.log is unavailable or out of memory.
+//
+// media.log only accepts registrations from the native media service uids;
+// in other processes the writers returned here still work but their
+// timelines are never read, so callers in code that can be loaded into
+// application processes should create the pool only in service context.
+class WriterPool : public RefBase {
+public:
+    // Size of the shared memory region carved up among this pool's writers,
+    // in bytes.  Each writer additionally pays Timeline::sharedSize() overhead.
+    static constexpr size_t kDefaultPoolSize = 0x10000;
+
+    explicit WriterPool(size_t poolSize = kDefaultPoolSize);
+
+    // Returns a writer registered with media.log, or a no-op writer if the
+    // service cannot be reached or the pool is exhausted.  Never returns 0.
+    // 'size' is the timeline size in bytes, as for the Writer constructor.
+    sp<Writer>  newWriter(size_t size, const char *name);
+
+    // Schedules the writer's shared memory for garbage collection.  The
+    // region is kept registered until newWriter() needs the space, so that
+    // recent logs remain visible in dumpsys media.log for a while.
+    void        unregisterWriter(const sp<Writer>& writer);
+
+    // Process-wide pool of default size, created on first use.
+    static sp<WriterPool> getDefault();
+
+private:
+    sp<Writer>  newWriter_l(size_t size, const char *name);
+
+    Mutex                   mLock;
+    // Both of these are 0 if media.log was unavailable at construction time.
+    sp<IMediaLogService>    mMediaLogService;       // const after constructor
+    sp<MemoryDealer>        mMemoryDealer;          // const after constructor
+    Vector<sp<Writer>>      mUnregisteredWriters;   // stale writers pending GC,
+                                                    // protected by mLock
+};
+
+}   // namespace NBLog
+}   // namespace android
+
+#endif  // ANDROID_MEDIA_NBLOG_WRITERPOOL_H
@@ -15,12 +15,68 @@
  */
 #include "media/ShmemCompat.h"
 
+#include <sys/stat.h>
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "binder/MemoryBase.h"
 #include "binder/MemoryHeapBase.h"
 #include "media/ShmemUtil.h"
 
 namespace android {
 namespace media {
+namespace {
+
+// Cache of heaps mapped by convertSharedFileRegionToIMemory(), so that repeated
+// conversions of regions backed by the same file reuse a single mapping instead
+// of duplicating the fd and mmap()ing the heap again on every call.
+//
+// Keyed by the identity of the underlying file (device, inode) plus the mapped
+// range and flags - fd numbers are not stable identifiers, and a writeable
+// mapping must never be served for a read-only request (or vice versa).
+//
+// Entries are weak: a heap stays mapped for as long as at least one converted
+// IMemory references it and expires with its last user, so the cache never
+// pins memory. Dead entries are pruned on lookup.
+struct HeapCacheKey {
+    dev_t dev;
+    ino_t ino;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t flags;
+
+    bool operator<(const HeapCacheKey& other) const {
+        return std::tie(dev, ino, offset, size, flags) <
+               std::tie(other.dev, other.ino, other.offset, other.size, other.flags);
+    }
+};
+
+std::mutex gHeapCacheLock;
+std::map<HeapCacheKey, wp<MemoryHeapBase>> gHeapCache;
+
+sp<MemoryHeapBase> getHeapForRegion(int fd, size_t size, uint32_t flags, uint64_t offset) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        // Cannot establish file identity - fall back to an uncached mapping.
+        return sp<MemoryHeapBase>::make(fd, size, flags, offset);
+    }
+    const HeapCacheKey key = { st.st_dev, st.st_ino, offset, size, flags };
+
+    std::lock_guard<std::mutex> lock(gHeapCacheLock);
+    sp<MemoryHeapBase> heap = gHeapCache[key].promote();
+    if (heap == nullptr) {
+        heap = sp<MemoryHeapBase>::make(fd, size, flags, offset);
+        for (auto it = gHeapCache.begin(); it != gHeapCache.end();) {
+            it = (it->second.promote() == nullptr) ? gHeapCache.erase(it) : std::next(it);
+        }
+        gHeapCache[key] = heap;
+    }
+    return heap;
+}
+
+}  // namespace
 
 bool convertSharedFileRegionToIMemory(const SharedFileRegion& shmem,
                                       sp<IMemory>* result) {
@@ -52,7 +108,7 @@ bool convertSharedFileRegionToIMemory(const SharedFileRegion& shmem,
     uint32_t flags = !shmem.writeable ? IMemoryHeap::READ_ONLY : 0;
 
     const sp<MemoryHeapBase> heap =
-            new MemoryHeapBase(shmem.fd.get(), heapSize, flags, heapStartOffset);
+            getHeapForRegion(shmem.fd.get(), heapSize, flags, heapStartOffset);
     *result = sp<MemoryBase>::make(heap,
                                    shmem.offset - heapStartOffset,
                                    shmem.size);
@@ -102,6 +102,26 @@ TEST(ShmemTest, ConversionReadOnly) {
     EXPECT_EQ(3, p[2]);
 }
 
+TEST(ShmemTest, RepeatedConversionSharesHeap) {
+    SharedFileRegion shmem;
+    {
+        sp<IMemory> imem = makeIMemory({6, 5, 3});
+        ASSERT_TRUE(convertIMemoryToSharedFileRegion(imem, &shmem));
+    }
+    sp<IMemory> first;
+    sp<IMemory> second;
+    ASSERT_TRUE(convertSharedFileRegionToIMemory(shmem, &first));
+    ASSERT_TRUE(convertSharedFileRegionToIMemory(shmem, &second));
+    // Converting the same region twice must reuse the mapped heap.
+    EXPECT_EQ(first->getMemory(), second->getMemory());
+
+    // A read-only view of the same region must not share the writeable mapping.
+    shmem.writeable = false;
+    sp<IMemory> readOnly;
+    ASSERT_TRUE(convertSharedFileRegionToIMemory(shmem, &readOnly));
+    EXPECT_NE(first->getMemory(), readOnly->getMemory());
+}
+
 TEST(ShmemTest, NullConversion) {
     sp<IMemory> reconstructed;
     {
@@ -38,6 +38,7 @@ namespace android {
 
 AACWriter::AACWriter(int fd)
     : mFd(dup(fd)),
+      mWriter(mFd),
       mInitCheck(mFd < 0? NO_INIT: OK),
       mStarted(false),
       mPaused(false),
@@ -57,6 +58,7 @@ AACWriter::~AACWriter() {
     }
 
     if (mFd != -1) {
+        mWriter.flush();
         close(mFd);
         mFd = -1;
     }
@@ -237,7 +239,7 @@ static bool getSampleRateTableIndex(int sampleRate, uint8_t* tableIndex) {
  */
 status_t AACWriter::writeAdtsHeader(uint32_t frameLength) {
     uint8_t data = 0xFF;
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     const uint8_t kFieldId = 0;
     const uint8_t kMpegLayer = 0;
@@ -246,7 +248,7 @@ status_t AACWriter::writeAdtsHeader(uint32_t frameLength) {
     data |= (kFieldId << 3);
     data |= (kMpegLayer << 1);
     data |= kProtectionAbsense;
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     const uint8_t kProfileCode = mAACProfile - 1;
     uint8_t kSampleFreqIndex;
@@ -257,7 +259,7 @@ status_t AACWriter::writeAdtsHeader(uint32_t frameLength) {
     data |= (kSampleFreqIndex << 2);
     data |= (kPrivateStream << 1);
     data |= (kChannelConfigCode >> 2);
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     // 4 bits from originality to copyright start
     const uint8_t kCopyright = 0;
@@ -265,20 +267,20 @@ status_t AACWriter::writeAdtsHeader(uint32_t frameLength) {
     data = ((kChannelConfigCode & 3) << 6);
     data |= (kCopyright << 2);
     data |= ((kFrameLength & 0x1800) >> 11);
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     data = ((kFrameLength & 0x07F8) >> 3);
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     const uint32_t kBufferFullness = 0x7FF;  // VBR
     data = ((kFrameLength & 0x07) << 5);
     data |= ((kBufferFullness & 0x07C0) >> 6);
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     const uint8_t kFrameCount = 0;
     data = ((kBufferFullness & 0x03F) << 2);
     data |= kFrameCount;
-    write(mFd, &data, 1);
+    mWriter.write(&data, 1);
 
     return OK;
 }
@@ -352,7 +354,7 @@ status_t AACWriter::threadFunc() {
         ssize_t dataLength = buffer->range_length();
         uint8_t *data = (uint8_t *)buffer->data() + buffer->range_offset();
         if (writeAdtsHeader(kAdtsHeaderLength + dataLength) != OK ||
-            dataLength != write(mFd, data, dataLength)) {
+            dataLength != mWriter.write(data, dataLength)) {
             err = ERROR_IO;
         }
 
@@ -372,6 +374,11 @@ status_t AACWriter::threadFunc() {
         err = ERROR_MALFORMED;
     }
 
+    status_t flushErr = mWriter.flush();
+    if (flushErr != OK && (err == OK || err == ERROR_END_OF_STREAM)) {
+        err = flushErr;
+    }
+
     close(mFd);
     mFd = -1;
     mReachedEOS = true;
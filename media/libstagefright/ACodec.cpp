@@ -4005,7 +4005,7 @@ status_t ACodec::setInitialColorAspectsForVideoEncoderSurfaceAndGetDataSpace(
         (void)getInputColorAspectsForVideoEncoder(mInputFormat);
     }
 
-    ALOGV("set default color aspects, updated input format to %s, output format to %s",
+    ALOGV_LAZY("set default color aspects, updated input format to %s, output format to %s",
             mInputFormat->debugString(4).c_str(), mOutputFormat->debugString(4).c_str());
 
     return err;
@@ -5428,7 +5428,7 @@ status_t ACodec::getPortFormat(OMX_U32 portIndex, sp<AMessage> &notify) {
             }
             notify->setInt32("width", videoDef->nFrameWidth);
             notify->setInt32("height", videoDef->nFrameHeight);
-            ALOGV("[%s] %s format is %s", mComponentName.c_str(),
+            ALOGV_LAZY("[%s] %s format is %s", mComponentName.c_str(),
                     portIndex == kPortIndexInput ? "input" : "output",
                     notify->debugString().c_str());
 
@@ -33,6 +33,7 @@ namespace android {
 
 AMRWriter::AMRWriter(int fd)
     : mFd(dup(fd)),
+      mWriter(mFd),
       mInitCheck(mFd < 0? NO_INIT: OK),
       mStarted(false),
       mPaused(false),
@@ -45,6 +46,7 @@ AMRWriter::~AMRWriter() {
     }
 
     if (mFd != -1) {
+        mWriter.flush();
         close(mFd);
         mFd = -1;
     }
@@ -87,7 +89,7 @@ status_t AMRWriter::addSource(const sp<MediaSource> &source) {
 
     const char *kHeader = isWide ? "#!AMR-WB\n" : "#!AMR\n";
     ssize_t n = strlen(kHeader);
-    if (write(mFd, kHeader, n) != n) {
+    if (mWriter.write(kHeader, n) != n) {
         return ERROR_IO;
     }
 
@@ -236,7 +238,7 @@ status_t AMRWriter::threadFunc() {
             notify(MEDIA_RECORDER_EVENT_INFO, MEDIA_RECORDER_INFO_MAX_DURATION_REACHED, 0);
             break;
         }
-        ssize_t n = write(mFd,
+        ssize_t n = mWriter.write(
                         (const uint8_t *)buffer->data() + buffer->range_offset(),
                         buffer->range_length());
 
@@ -263,6 +265,11 @@ status_t AMRWriter::threadFunc() {
         err = ERROR_MALFORMED;
     }
 
+    status_t flushErr = mWriter.flush();
+    if (flushErr != OK && (err == OK || err == ERROR_END_OF_STREAM)) {
+        err = flushErr;
+    }
+
     close(mFd);
     mFd = -1;
     mReachedEOS = true;
@@ -24,8 +24,10 @@
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <media/stagefright/ANetworkSession.h>
 #include <media/stagefright/ParsedMessage.h>
@@ -611,30 +613,56 @@ status_t ANetworkSession::Session::writeMore() {
     CHECK_EQ(mState, CONNECTED);
     CHECK(!mOutFragments.empty());
 
+    static const size_t kMaxWriteIov = 16;
+
     ssize_t n = -1;
     while (!mOutFragments.empty()) {
-        const Fragment &frag = *mOutFragments.begin();
+        // Coalesce queued fragments into a single writev call instead of
+        // one send per fragment.
+        struct iovec iov[kMaxWriteIov];
+        size_t numIov = 0;
+        size_t numBytesQueued = 0;
+
+        for (List<Fragment>::iterator it = mOutFragments.begin();
+                it != mOutFragments.end() && numIov < kMaxWriteIov; ++it) {
+            iov[numIov].iov_base = it->mBuffer->data();
+            iov[numIov].iov_len = it->mBuffer->size();
+            numBytesQueued += it->mBuffer->size();
+            ++numIov;
+        }
 
         do {
-            n = send(mSocket, frag.mBuffer->data(), frag.mBuffer->size(), 0);
+            n = writev(mSocket, iov, numIov);
         } while (n < 0 && errno == EINTR);
 
         if (n <= 0) {
             break;
         }
 
-        frag.mBuffer->setRange(
-                frag.mBuffer->offset() + n, frag.mBuffer->size() - n);
+        size_t numBytesWritten = n;
+        while (numBytesWritten > 0) {
+            const Fragment &frag = *mOutFragments.begin();
+            size_t fragSize = frag.mBuffer->size();
 
-        if (frag.mBuffer->size() > 0) {
-            break;
-        }
+            if (numBytesWritten < fragSize) {
+                frag.mBuffer->setRange(
+                        frag.mBuffer->offset() + numBytesWritten,
+                        fragSize - numBytesWritten);
+                break;
+            }
 
-        if (frag.mFlags & FRAGMENT_FLAG_TIME_VALID) {
-            dumpFragmentStats(frag);
+            if (frag.mFlags & FRAGMENT_FLAG_TIME_VALID) {
+                dumpFragmentStats(frag);
+            }
+
+            mOutFragments.erase(mOutFragments.begin());
+            numBytesWritten -= fragSize;
         }
 
-        mOutFragments.erase(mOutFragments.begin());
+        if ((size_t)n < numBytesQueued) {
+            // Socket buffer is full.
+            break;
+        }
     }
 
     status_t err = OK;
@@ -786,7 +814,8 @@ void ANetworkSession::Session::notify(NotificationReason reason) {
 ////////////////////////////////////////////////////////////////////////////////
 
 ANetworkSession::ANetworkSession()
-    : mNextSessionID(1) {
+    : mNextSessionID(1),
+      mEpollFd(-1) {
     mPipeFd[0] = mPipeFd[1] = -1;
 }
 
@@ -805,6 +834,23 @@ status_t ANetworkSession::start() {
         return -errno;
     }
 
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (mEpollFd < 0) {
+        res = -errno;
+
+        close(mPipeFd[0]);
+        close(mPipeFd[1]);
+        mPipeFd[0] = mPipeFd[1] = -1;
+
+        return res;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = mPipeFd[0];
+    CHECK_EQ(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mPipeFd[0], &ev), 0);
+
     mThread = new NetworkThread(this);
 
     status_t err = mThread->run("ANetworkSession", ANDROID_PRIORITY_AUDIO);
@@ -812,6 +858,9 @@ status_t ANetworkSession::start() {
     if (err != OK) {
         mThread.clear();
 
+        close(mEpollFd);
+        mEpollFd = -1;
+
         close(mPipeFd[0]);
         close(mPipeFd[1]);
         mPipeFd[0] = mPipeFd[1] = -1;
@@ -833,6 +882,12 @@ status_t ANetworkSession::stop() {
 
     mThread.clear();
 
+    close(mEpollFd);
+    mEpollFd = -1;
+
+    mRegisteredEvents.clear();
+    mSessionsByFd.clear();
+
     close(mPipeFd[0]);
     close(mPipeFd[1]);
     mPipeFd[0] = mPipeFd[1] = -1;
@@ -1237,16 +1292,12 @@ void ANetworkSession::interrupt() {
 }
 
 void ANetworkSession::threadLoop() {
-    fd_set rs, ws;
-    FD_ZERO(&rs);
-    FD_ZERO(&ws);
-
-    FD_SET(mPipeFd[0], &rs);
-    int maxFd = mPipeFd[0];
-
     {
+        // Sync the epoll interest set with the sessions' current readiness
+        // interest, touching only sockets whose interest changed.
         Mutex::Autolock autoLock(mLock);
 
+        KeyedVector<int, uint32_t> wanted;
         for (size_t i = 0; i < mSessions.size(); ++i) {
             const sp<Session> &session = mSessions.valueAt(i);
 
@@ -1256,49 +1307,86 @@ void ANetworkSession::threadLoop() {
                 continue;
             }
 
+            uint32_t events = 0;
             if (session->wantsToRead()) {
-                FD_SET(s, &rs);
-                if (s > maxFd) {
-                    maxFd = s;
-                }
+                events |= EPOLLIN;
             }
-
             if (session->wantsToWrite()) {
-                FD_SET(s, &ws);
-                if (s > maxFd) {
-                    maxFd = s;
+                events |= EPOLLOUT;
+            }
+
+            if (events != 0) {
+                wanted.add(s, events);
+                ssize_t fdIndex = mSessionsByFd.indexOfKey(s);
+                if (fdIndex < 0) {
+                    mSessionsByFd.add(s, session);
+                } else if (mSessionsByFd.valueAt(fdIndex) != session) {
+                    // The fd number was reused by a new session; the old
+                    // socket's close dropped it from the epoll set, so it
+                    // has to be re-added below.
+                    mSessionsByFd.replaceValueAt(fdIndex, session);
+                    mRegisteredEvents.removeItem(s);
                 }
             }
         }
-    }
 
-    int res = select(maxFd + 1, &rs, &ws, NULL, NULL /* tv */);
+        for (size_t i = mRegisteredEvents.size(); i > 0;) {
+            --i;
+            int s = mRegisteredEvents.keyAt(i);
+            if (wanted.indexOfKey(s) < 0) {
+                // Removal can fail benignly if the socket was already
+                // closed; closing removes it from the epoll set anyway.
+                epoll_ctl(mEpollFd, EPOLL_CTL_DEL, s, NULL);
+                mRegisteredEvents.removeItemsAt(i);
+                mSessionsByFd.removeItem(s);
+            }
+        }
 
-    if (res == 0) {
-        return;
-    }
+        for (size_t i = 0; i < wanted.size(); ++i) {
+            int s = wanted.keyAt(i);
+            uint32_t events = wanted.valueAt(i);
 
-    if (res < 0) {
-        if (errno == EINTR) {
-            return;
-        }
+            ssize_t index = mRegisteredEvents.indexOfKey(s);
+            if (index >= 0 && mRegisteredEvents.valueAt(index) == events) {
+                continue;
+            }
 
-        ALOGE("select failed w/ error %d (%s)", errno, strerror(errno));
-        return;
-    }
+            struct epoll_event ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.events = events;
+            ev.data.fd = s;
 
-    if (FD_ISSET(mPipeFd[0], &rs)) {
-        char c;
-        ssize_t n;
-        do {
-            n = read(mPipeFd[0], &c, 1);
-        } while (n < 0 && errno == EINTR);
+            int res = epoll_ctl(
+                    mEpollFd,
+                    index < 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                    s,
+                    &ev);
 
-        if (n < 0) {
-            ALOGW("Error reading from pipe (%s)", strerror(errno));
+            if (res != 0) {
+                ALOGE("epoll_ctl on socket %d failed w/ error %d (%s)",
+                      s, errno, strerror(errno));
+                continue;
+            }
+
+            if (index < 0) {
+                mRegisteredEvents.add(s, events);
+            } else {
+                mRegisteredEvents.replaceValueAt(index, events);
+            }
         }
+    }
+
+    static const size_t kMaxEpollEvents = 64;
+    struct epoll_event events[kMaxEpollEvents];
+
+    int res = epoll_wait(mEpollFd, events, kMaxEpollEvents, -1);
 
-        --res;
+    if (res <= 0) {
+        if (res < 0 && errno != EINTR) {
+            ALOGE("epoll_wait failed w/ error %d (%s)",
+                  errno, strerror(errno));
+        }
+        return;
     }
 
     {
@@ -1306,21 +1394,42 @@ void ANetworkSession::threadLoop() {
 
         List<sp<Session> > sessionsToAdd;
 
-        for (size_t i = mSessions.size(); res > 0 && i > 0;) {
-            i--;
-            const sp<Session> &session = mSessions.valueAt(i);
+        for (int i = 0; i < res; ++i) {
+            int s = events[i].data.fd;
+            uint32_t readyEvents = events[i].events;
 
-            int s = session->socket();
+            if (s == mPipeFd[0]) {
+                char c;
+                ssize_t n;
+                do {
+                    n = read(mPipeFd[0], &c, 1);
+                } while (n < 0 && errno == EINTR);
+
+                if (n < 0) {
+                    ALOGW("Error reading from pipe (%s)", strerror(errno));
+                }
 
-            if (s < 0) {
                 continue;
             }
 
-            if (FD_ISSET(s, &rs) || FD_ISSET(s, &ws)) {
-                --res;
+            ssize_t index = mSessionsByFd.indexOfKey(s);
+            if (index < 0) {
+                // Session went away after the event was queued.
+                continue;
             }
 
-            if (FD_ISSET(s, &rs)) {
+            const sp<Session> session = mSessionsByFd.valueAt(index);
+
+            // EPOLLERR/EPOLLHUP are delivered regardless of the requested
+            // interest; route them through the handlers the session asked
+            // for so the failure surfaces through the usual read/write
+            // error paths.
+            bool readable = (readyEvents & (EPOLLIN | EPOLLERR | EPOLLHUP))
+                    && session->wantsToRead();
+            bool writable = (readyEvents & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+                    && session->wantsToWrite();
+
+            if (readable) {
                 if (session->isRTSPServer() || session->isTCPDatagramServer()) {
                     struct sockaddr_in remoteAddr;
                     socklen_t remoteAddrLen = sizeof(remoteAddr);
@@ -1377,7 +1486,7 @@ void ANetworkSession::threadLoop() {
                 }
             }
 
-            if (FD_ISSET(s, &ws)) {
+            if (writable) {
                 status_t err = session->writeMore();
                 if (err != OK) {
                     ALOGE("writeMore on socket %d failed w/ error %d (%s)",
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//#define LOG_NDEBUG 0
+#define LOG_TAG "BufferedFileWriter"
+#include <utils/Log.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <media/stagefright/BufferedFileWriter.h>
+#include <media/stagefright/MediaErrors.h>
+#include <utils/Timers.h>
+
+namespace android {
+
+static const size_t kPageSize = 4096;
+
+BufferedFileWriter::BufferedFileWriter(
+        int fd, size_t capacity, int64_t maxDelayUs)
+    : mFd(fd),
+      mCapacity((capacity + kPageSize - 1) & ~(kPageSize - 1)),
+      mMaxDelayUs(maxDelayUs),
+      mBuffer((uint8_t *)malloc(mCapacity)),
+      mLength(0),
+      mOldestTimeUs(-1),
+      mHasError(mBuffer == NULL) {
+}
+
+BufferedFileWriter::~BufferedFileWriter() {
+    flush();
+    free(mBuffer);
+    mBuffer = NULL;
+}
+
+ssize_t BufferedFileWriter::write(const void *data, size_t size) {
+    if (mHasError) {
+        return -1;
+    }
+
+    if (size >= mCapacity) {
+        // Too big to batch; push out what came before it to preserve
+        // ordering, then write it directly.
+        if (flush() != OK || writeFully(data, size) != OK) {
+            return -1;
+        }
+        return size;
+    }
+
+    if (mLength + size > mCapacity && flush() != OK) {
+        return -1;
+    }
+
+    memcpy(mBuffer + mLength, data, size);
+    if (mLength == 0) {
+        mOldestTimeUs = systemTime(SYSTEM_TIME_MONOTONIC) / 1000;
+    }
+    mLength += size;
+
+    if (mLength == mCapacity
+            || systemTime(SYSTEM_TIME_MONOTONIC) / 1000 - mOldestTimeUs
+                    >= mMaxDelayUs) {
+        if (flush() != OK) {
+            return -1;
+        }
+    }
+
+    return size;
+}
+
+status_t BufferedFileWriter::flush() {
+    if (mHasError) {
+        return ERROR_IO;
+    }
+
+    if (mLength == 0) {
+        return OK;
+    }
+
+    status_t err = writeFully(mBuffer, mLength);
+    mLength = 0;
+    mOldestTimeUs = -1;
+    return err;
+}
+
+status_t BufferedFileWriter::sync() {
+    status_t err = flush();
+    if (err != OK) {
+        return err;
+    }
+
+    if (fdatasync(mFd) != 0) {
+        ALOGE("fdatasync failed: %s", strerror(errno));
+        return ERROR_IO;
+    }
+
+    return OK;
+}
+
+status_t BufferedFileWriter::writeFully(const void *data, size_t size) {
+    const uint8_t *ptr = (const uint8_t *)data;
+    while (size > 0) {
+        ssize_t n = ::write(mFd, ptr, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ALOGE("write failed: %s", strerror(errno));
+            mHasError = true;
+            return ERROR_IO;
+        }
+        ptr += n;
+        size -= n;
+    }
+    return OK;
+}
+
+}  // namespace android
@@ -27,6 +27,7 @@
 #include <media/stagefright/foundation/AMessage.h>
 #include <media/stagefright/MediaErrors.h>
 #include <renderengine/RenderEngine.h>
+#include <ui/Fence.h>
 #include <utils/Log.h>
 
 namespace android {
@@ -167,25 +168,64 @@ status_t FrameCaptureLayer::capture(const ui::PixelFormat reqPixelFormat,
         return err;
     }
 
-    // create out buffer
-    const uint32_t usage =
-            GRALLOC_USAGE_SW_READ_OFTEN | GRALLOC_USAGE_SW_WRITE_OFTEN |
-            GRALLOC_USAGE_HW_RENDER | GRALLOC_USAGE_HW_TEXTURE;
-    sp<GraphicBuffer> buffer = new GraphicBuffer(
-            sourceCrop.getWidth(), sourceCrop.getHeight(),
-            static_cast<android_pixel_format>(reqPixelFormat),
-            1, usage, std::string("thumbnail"));
+    sp<GraphicBuffer> buffer = obtainCaptureBuffer(
+            sourceCrop.getWidth(), sourceCrop.getHeight(), reqPixelFormat);
 
+    sp<Fence> drawFence;
     err = FrameCaptureProcessor::getInstance()->capture(
-            new BufferLayer(bi), sourceCrop, buffer);
+            new BufferLayer(bi), sourceCrop, buffer, &drawFence);
     if (err == OK) {
         *outBuffer = buffer;
     }
 
-    (void)releaseBuffer(bi);
+    // Hand the decoded buffer back to the codec with the draw fence
+    // attached instead of draining the GPU first; the codec can line up
+    // the next output while this capture is still being drawn.
+    sp<Fence> releaseFence = drawFence;
+    if (drawFence != nullptr && bi.mFence != nullptr && bi.mFence->isValid()) {
+        releaseFence = Fence::merge("FrameCaptureLayer", bi.mFence, drawFence);
+    }
+    (void)releaseBuffer(bi, releaseFence);
+
+    // the caller maps the output for CPU readback right away, so wait for
+    // the draw only now, with the codec buffer already back in flight
+    if (err == OK && drawFence != nullptr) {
+        err = drawFence->wait(500);
+        if (err != OK) {
+            ALOGW("wait for draw fence returned err %d", err);
+            err = OK;
+        }
+    }
     return err;
 }
 
+sp<GraphicBuffer> FrameCaptureLayer::obtainCaptureBuffer(
+        uint32_t width, uint32_t height, ui::PixelFormat format) {
+    // Re-use a pooled output buffer if the client has dropped its ref;
+    // burst captures (e.g. a video editor filmstrip) otherwise pay a
+    // gralloc allocation for every frame.
+    for (const sp<GraphicBuffer> &buffer : mCaptureBufferPool) {
+        if (buffer->getWidth() == width && buffer->getHeight() == height
+                && buffer->getPixelFormat()
+                        == static_cast<android_pixel_format>(format)
+                && buffer->getStrongCount() == 1) {
+            return buffer;
+        }
+    }
+
+    const uint32_t usage =
+            GRALLOC_USAGE_SW_READ_OFTEN | GRALLOC_USAGE_SW_WRITE_OFTEN |
+            GRALLOC_USAGE_HW_RENDER | GRALLOC_USAGE_HW_TEXTURE;
+    sp<GraphicBuffer> buffer = new GraphicBuffer(
+            width, height, static_cast<android_pixel_format>(format),
+            1, usage, std::string("thumbnail"));
+    if (mCaptureBufferPool.size() >= kCaptureBufferPoolSize) {
+        mCaptureBufferPool.pop_front();
+    }
+    mCaptureBufferPool.push_back(buffer);
+    return buffer;
+}
+
 FrameCaptureLayer::FrameCaptureLayer() : mFrameAvailable(false) {}
 
 void FrameCaptureLayer::onFrameAvailable(const BufferItem& /*item*/) {
@@ -247,12 +287,14 @@ status_t FrameCaptureLayer::acquireBuffer(BufferItem *bi) {
     return OK;
 }
 
-status_t FrameCaptureLayer::releaseBuffer(const BufferItem &bi) {
+status_t FrameCaptureLayer::releaseBuffer(
+        const BufferItem &bi, const sp<Fence> &releaseFence) {
     ALOGV("releaseBuffer");
     Mutex::Autolock _lock(mLock);
 
     return mConsumer->releaseBuffer(bi.mSlot, bi.mFrameNumber,
-            EGL_NO_DISPLAY, EGL_NO_SYNC_KHR, bi.mFence);
+            EGL_NO_DISPLAY, EGL_NO_SYNC_KHR,
+            releaseFence != nullptr ? releaseFence : bi.mFence);
 }
 
 }  // namespace android
@@ -107,13 +107,25 @@ void FrameCaptureProcessor::createRenderEngine() {
 }
 
 status_t FrameCaptureProcessor::capture(
-        const sp<Layer> &layer, const Rect &sourceCrop, const sp<GraphicBuffer> &buffer) {
+        const sp<Layer> &layer, const Rect &sourceCrop, const sp<GraphicBuffer> &buffer,
+        sp<Fence> *outDrawFence) {
     sp<AMessage> msg = new AMessage(kWhatCapture, this);
     msg->setObject("layer", layer);
     msg->setRect("crop", sourceCrop.left, sourceCrop.top, sourceCrop.right, sourceCrop.bottom);
     msg->setObject("buffer", buffer);
+    msg->setInt32("wantFence", outDrawFence != nullptr);
     sp<AMessage> response;
-    return PostAndAwaitResponse(msg, &response);
+    status_t err = PostAndAwaitResponse(msg, &response);
+    if (outDrawFence != nullptr) {
+        // Fence is a LightRefBase so it travels back as a dup'ed fd.
+        int32_t fenceFd = -1;
+        if (err == OK && response->findInt32("fence", &fenceFd) && fenceFd >= 0) {
+            *outDrawFence = new Fence(fenceFd);
+        } else {
+            *outDrawFence = Fence::NO_FENCE;
+        }
+    }
+    return err;
 }
 
 status_t FrameCaptureProcessor::onCreate() {
@@ -134,7 +146,8 @@ status_t FrameCaptureProcessor::onCreate() {
 }
 
 status_t FrameCaptureProcessor::onCapture(const sp<Layer> &layer,
-        const Rect &sourceCrop, const sp<GraphicBuffer> &buffer) {
+        const Rect &sourceCrop, const sp<GraphicBuffer> &buffer,
+        sp<Fence> *outDrawFence) {
     renderengine::DisplaySettings clientCompositionDisplay;
     std::vector<const renderengine::LayerSettings*> clientCompositionLayers;
 
@@ -164,6 +177,10 @@ status_t FrameCaptureProcessor::onCapture(const sp<Layer> &layer,
 
     if (err != OK) {
         ALOGE("drawLayers returned err %d", err);
+    } else if (outDrawFence != nullptr) {
+        // hand the fence to the caller instead of draining the GPU here,
+        // so back-to-back captures can overlap draw with readback
+        *outDrawFence = fence;
     } else {
         err = fence->wait(500);
         if (err != OK) {
@@ -194,15 +211,26 @@ void FrameCaptureProcessor::onMessageReceived(const sp<AMessage> &msg) {
 
             sp<RefBase> layerObj, bufferObj;
             int32_t left, top, right, bottom;
+            int32_t wantFence = 0;
             CHECK(msg->findObject("layer", &layerObj));
             CHECK(msg->findRect("crop", &left, &top, &right, &bottom));
             CHECK(msg->findObject("buffer", &bufferObj));
+            msg->findInt32("wantFence", &wantFence);
 
             sp<GraphicBuffer> buffer = static_cast<GraphicBuffer*>(bufferObj.get());
             sp<Layer> layer = static_cast<Layer*>(layerObj.get());
 
-            PostReplyWithError(replyID,
-                    onCapture(layer, Rect(left, top, right, bottom), buffer));
+            sp<Fence> fence;
+            status_t err = onCapture(layer, Rect(left, top, right, bottom), buffer,
+                    wantFence ? &fence : nullptr);
+
+            sp<AMessage> response = new AMessage;
+            if (err != OK) {
+                response->setInt32("err", err);
+            } else if (fence != nullptr && fence->isValid()) {
+                response->setInt32("fence", fence->dup());
+            }
+            response->postReply(replyID);
 
             break;
         }
@@ -348,6 +348,47 @@ sp<IMemory> FrameDecoder::extractFrame(FrameRect *rect) {
     return mFrameMemory;
 }
 
+status_t FrameDecoder::extractFrames(
+        const std::vector<int64_t> &timestampsUs,
+        std::vector<sp<IMemory>> *frames) {
+    if (frames == NULL) {
+        return BAD_VALUE;
+    }
+    if (mDecoder == NULL) {
+        return NO_INIT;
+    }
+
+    bool firstFrame = true;
+    for (int64_t frameTimeUs : timestampsUs) {
+        status_t err = onPrepareFrame(frameTimeUs, &mReadOptions);
+        if (err != OK) {
+            ALOGE("failed to prepare for frame at %lld us (err %d)",
+                    (long long)frameTimeUs, err);
+            return err;
+        }
+        if (!firstFrame) {
+            // Drop whatever is still in flight from the previous target;
+            // the codec stays configured and started across targets.
+            err = mDecoder->flush();
+            if (err != OK) {
+                ALOGE("failed to flush decoder (err %d)", err);
+                return err;
+            }
+        }
+        mHaveMoreInputs = true;
+        mFirstSample = true;
+        mFrameMemory.clear();
+
+        err = extractInternal();
+        if (err != OK) {
+            return err;
+        }
+        frames->push_back(mFrameMemory);
+        firstFrame = false;
+    }
+    return OK;
+}
+
 status_t FrameDecoder::extractInternal() {
     status_t err = OK;
     bool done = false;
@@ -714,6 +755,20 @@ status_t VideoFrameDecoder::onOutputReceived(
     return ERROR_UNSUPPORTED;
 }
 
+status_t VideoFrameDecoder::onPrepareFrame(
+        int64_t frameTimeUs, MediaSource::ReadOptions *options) {
+    if (frameTimeUs < 0) {
+        return BAD_VALUE;
+    }
+    // The frame of the previous target must not be overwritten; a fresh
+    // one is allocated when the next output arrives.
+    mFrame = NULL;
+    mTargetTimeUs = -1LL;
+    mSampleDurations.clear();
+    options->setSeekTo(frameTimeUs, mSeekMode);
+    return OK;
+}
+
 sp<Surface> VideoFrameDecoder::initSurface() {
     // create the consumer listener interface, and hold sp so that this
     // interface lives as long as the GraphicBufferSource.
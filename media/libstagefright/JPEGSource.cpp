@@ -18,6 +18,8 @@
 #define LOG_TAG "JPEGSource"
 #include <utils/Log.h>
 
+#include <string.h>
+
 #include <media/DataSource.h>
 #include <media/stagefright/foundation/ADebug.h>
 #include <media/stagefright/JPEGSource.h>
@@ -52,6 +54,56 @@
 
 namespace android {
 
+namespace {
+
+// Cached forward reader over a DataSource. The JPEG header fields are tiny
+// and numerous; reading them through a window avoids a DataSource round-trip
+// (possibly a binder transaction) per field.
+struct CachedReader {
+    explicit CachedReader(const sp<DataSource> &source)
+        : mSource(source),
+          mCacheOffset(0),
+          mCacheLength(0) {
+    }
+
+    bool readByte(off64_t offset, uint8_t *value) {
+        return read(offset, value, 1);
+    }
+
+    bool readUInt16(off64_t offset, uint16_t *value) {
+        uint8_t bytes[2];
+        if (!read(offset, bytes, 2)) {
+            return false;
+        }
+        *value = ((uint16_t)bytes[0] << 8) | bytes[1];
+        return true;
+    }
+
+private:
+    static const size_t kCacheSize = 4096;
+
+    bool read(off64_t offset, uint8_t *data, size_t size) {
+        if (offset < mCacheOffset
+                || offset + (off64_t)size > mCacheOffset + (off64_t)mCacheLength) {
+            ssize_t n = mSource->readAt(offset, mCache, kCacheSize);
+            if (n < (ssize_t)size) {
+                return false;
+            }
+            mCacheOffset = offset;
+            mCacheLength = n;
+        }
+        memcpy(data, &mCache[offset - mCacheOffset], size);
+        return true;
+    }
+
+    sp<DataSource> mSource;
+    off64_t mCacheOffset;
+    size_t mCacheLength;
+    uint8_t mCache[kCacheSize];
+};
+
+}  // anonymous namespace
+
 JPEGSource::JPEGSource(const sp<DataSource> &source)
     : mSource(source),
       mGroup(NULL),
@@ -143,10 +195,12 @@ status_t JPEGSource::parseJPEG() {
     mWidth = 0;
     mHeight = 0;
 
+    CachedReader reader(mSource);
+
     off64_t i = 0;
 
     uint16_t soi;
-    if (!mSource->getUInt16(i, &soi)) {
+    if (!reader.readUInt16(i, &soi)) {
         return ERROR_IO;
     }
 
@@ -158,20 +212,20 @@ status_t JPEGSource::parseJPEG() {
 
     for (;;) {
         uint8_t marker;
-        if (mSource->readAt(i++, &marker, 1) != 1) {
+        if (!reader.readByte(i++, &marker)) {
             return ERROR_IO;
         }
 
         CHECK_EQ(marker, 0xff);
 
-        if (mSource->readAt(i++, &marker, 1) != 1) {
+        if (!reader.readByte(i++, &marker)) {
             return ERROR_IO;
         }
 
         CHECK(marker != 0xff);
 
         uint16_t chunkSize;
-        if (!mSource->getUInt16(i, &chunkSize)) {
+        if (!reader.readUInt16(i, &chunkSize)) {
             return ERROR_IO;
         }
 
@@ -206,8 +260,8 @@ status_t JPEGSource::parseJPEG() {
             case JPEG_SOF15:
             {
                 uint16_t width, height;
-                if (!mSource->getUInt16(i + 1, &height)
-                    || !mSource->getUInt16(i + 3, &width)) {
+                if (!reader.readUInt16(i + 1, &height)
+                    || !reader.readUInt16(i + 3, &width)) {
                     return ERROR_IO;
                 }
 
@@ -22,10 +22,12 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <pthread.h>
 #include <sys/prctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <utils/Log.h>
@@ -181,7 +183,9 @@ private:
             : mElementCapacity(elementCapacity),
             mTotalNumTableEntries(0),
             mNumValuesInCurrEntry(0),
-            mCurrTableEntriesElement(NULL) {
+            mCurrTableEntriesElement(NULL),
+            mSpillFd(-1),
+            mNumSpilledBlocks(0) {
             CHECK_GT(mElementCapacity, 0u);
             // Ensure no integer overflow on allocation in add().
             CHECK_LT(ENTRY_SIZE, UINT32_MAX / mElementCapacity);
@@ -194,6 +198,22 @@ private:
                 delete[] (*it);
                 mTableEntryList.erase(it);
             }
+            if (mSpillFd >= 0) {
+                ::close(mSpillFd);
+                mSpillFd = -1;
+            }
+        }
+
+        // Enable spilling of completed entry blocks to the given temporary
+        // file so that append-only tables of a long recording don't hold
+        // all their entries in memory until stop(). Takes ownership of fd;
+        // passing -1 keeps the table fully in memory. Must only be used on
+        // tables that are never modified via set()/adjustEntries() after
+        // entries are added, since spilled blocks are immutable.
+        void enableSpill(int fd) {
+            CHECK_EQ(mTotalNumTableEntries, 0u);
+            CHECK_LT(mSpillFd, 0);
+            mSpillFd = fd;
         }
 
         // Replace the value at the given position by the given value.
@@ -202,9 +222,13 @@ private:
         // @arg pos location the value must be in.
         void set(const TYPE& value, uint32_t pos) {
             CHECK_LT(pos, mTotalNumTableEntries * ENTRY_SIZE);
+            // Spilled blocks are immutable; spilling tables must be
+            // append-only.
+            CHECK_GE(pos, mNumSpilledBlocks * mElementCapacity * ENTRY_SIZE);
 
             typename List<TYPE *>::iterator it = mTableEntryList.begin();
-            uint32_t iterations = (pos / (mElementCapacity * ENTRY_SIZE));
+            uint32_t iterations =
+                (pos / (mElementCapacity * ENTRY_SIZE)) - mNumSpilledBlocks;
             while (it != mTableEntryList.end() && iterations > 0) {
                 ++it;
                 --iterations;
@@ -223,9 +247,14 @@ private:
             if (pos >= mTotalNumTableEntries * ENTRY_SIZE) {
                 return false;
             }
+            // Spilled entries are no longer resident.
+            if (pos < mNumSpilledBlocks * mElementCapacity * ENTRY_SIZE) {
+                return false;
+            }
 
             typename List<TYPE *>::iterator it = mTableEntryList.begin();
-            uint32_t iterations = (pos / (mElementCapacity * ENTRY_SIZE));
+            uint32_t iterations =
+                (pos / (mElementCapacity * ENTRY_SIZE)) - mNumSpilledBlocks;
             while (it != mTableEntryList.end() && iterations > 0) {
                 ++it;
                 --iterations;
@@ -240,6 +269,9 @@ private:
         // adjusts all values by |adjust(value)|
         void adjustEntries(
                 std::function<void(size_t /* ix */, TYPE(& /* entry */)[ENTRY_SIZE])> update) {
+            // Spilled blocks are immutable; spilling tables must be
+            // append-only.
+            CHECK_EQ(mNumSpilledBlocks, 0u);
             size_t nEntries = mTotalNumTableEntries + mNumValuesInCurrEntry / ENTRY_SIZE;
             size_t ix = 0;
             for (TYPE *entryArray : mTableEntryList) {
@@ -271,6 +303,9 @@ private:
             if ((mNumValuesInCurrEntry % ENTRY_SIZE) == 0) {
                 ++mTotalNumTableEntries;
                 mNumValuesInCurrEntry = 0;
+                if (mSpillFd >= 0 && (mTotalNumTableEntries % mElementCapacity) == 0) {
+                    spillCurrentBlock();
+                }
             }
         }
 
@@ -282,6 +317,21 @@ private:
             CHECK_EQ(mNumValuesInCurrEntry % ENTRY_SIZE, 0u);
             uint32_t nEntries = mTotalNumTableEntries;
             writer->writeInt32(nEntries);
+            if (mNumSpilledBlocks > 0) {
+                // Stream the spilled blocks back from the temporary file
+                // first; they precede all resident blocks.
+                const size_t blockBytes =
+                    sizeof(TYPE) * ENTRY_SIZE * mElementCapacity;
+                TYPE *scratch = new TYPE[ENTRY_SIZE * mElementCapacity];
+                for (uint32_t i = 0; i < mNumSpilledBlocks; ++i) {
+                    ssize_t numBytes = pread64(
+                            mSpillFd, scratch, blockBytes, (off64_t)i * blockBytes);
+                    CHECK_EQ(numBytes, (ssize_t)blockBytes);
+                    writer->write(scratch, sizeof(TYPE) * ENTRY_SIZE, mElementCapacity);
+                }
+                delete[] scratch;
+                nEntries -= mNumSpilledBlocks * mElementCapacity;
+            }
             for (typename List<TYPE *>::iterator it = mTableEntryList.begin();
                 it != mTableEntryList.end(); ++it) {
                 CHECK_GT(nEntries, 0u);
@@ -299,11 +349,36 @@ private:
         uint32_t count() const { return mTotalNumTableEntries; }
 
     private:
+        // Write the just-completed entry block to the spill file and drop
+        // it from memory. On failure spilling is disabled and the table
+        // keeps accumulating entries in memory as before.
+        void spillCurrentBlock() {
+            const size_t blockBytes = sizeof(TYPE) * ENTRY_SIZE * mElementCapacity;
+            ssize_t numBytes = pwrite64(
+                    mSpillFd, mCurrTableEntriesElement, blockBytes,
+                    (off64_t)mNumSpilledBlocks * blockBytes);
+            if (numBytes != (ssize_t)blockBytes) {
+                ALOGW("spilling table entries failed (%s), keeping them in memory",
+                        strerror(errno));
+                ::close(mSpillFd);
+                mSpillFd = -1;
+                return;
+            }
+            typename List<TYPE *>::iterator it = --mTableEntryList.end();
+            CHECK(*it == mCurrTableEntriesElement);
+            delete[] (*it);
+            mTableEntryList.erase(it);
+            mCurrTableEntriesElement = NULL;
+            ++mNumSpilledBlocks;
+        }
+
         uint32_t         mElementCapacity;  // # entries in an element
         uint32_t         mTotalNumTableEntries;
         uint32_t         mNumValuesInCurrEntry;  // up to ENTRY_SIZE
         TYPE             *mCurrTableEntriesElement;
         mutable List<TYPE *>     mTableEntryList;
+        int              mSpillFd;           // owned; -1 if not spilling
+        uint32_t         mNumSpilledBlocks;  // # full elements spilled to mSpillFd
 
         DISALLOW_EVIL_CONSTRUCTORS(ListTableEntries);
     };
@@ -1650,6 +1725,15 @@ static void StripStartcode(MediaBuffer *buffer) {
 }
 
 void MPEG4Writer::addMultipleLengthPrefixedSamples_l(MediaBuffer *buffer) {
+    // Gather the length prefix and payload of every NAL unit in this access
+    // unit into a single writev instead of issuing two write syscalls per
+    // NAL unit; samples are written straight from the sample buffer.
+    static const size_t kMaxNalsPerBatch = 32;
+    struct iovec iov[kMaxNalsPerBatch * 2];
+    uint8_t prefixes[kMaxNalsPerBatch][4];
+    size_t numNals = 0;
+    const size_t prefixLength = mUse4ByteNalLength ? 4 : 2;
+
     const uint8_t *dataStart = (const uint8_t *)buffer->data() + buffer->range_offset();
     const uint8_t *currentNalStart = dataStart;
     const uint8_t *nextNalStart;
@@ -1657,45 +1741,45 @@ void MPEG4Writer::addMultipleLengthPrefixedSamples_l(MediaBuffer *buffer) {
     size_t nextNalSize;
     size_t searchSize = buffer->range_length();
 
-    while (getNextNALUnit(&data, &searchSize, &nextNalStart,
-            &nextNalSize, true) == OK) {
-        size_t currentNalSize = nextNalStart - currentNalStart - 4 /* strip start-code */;
-        MediaBuffer *nalBuf = new MediaBuffer((void *)currentNalStart, currentNalSize);
-        addLengthPrefixedSample_l(nalBuf);
-        nalBuf->release();
-
-        currentNalStart = nextNalStart;
-    }
-
-    size_t currentNalOffset = currentNalStart - dataStart;
-    buffer->set_range(buffer->range_offset() + currentNalOffset,
-            buffer->range_length() - currentNalOffset);
-    addLengthPrefixedSample_l(buffer);
-}
+    bool lastNal = false;
+    while (!lastNal) {
+        size_t currentNalSize;
+        if (getNextNALUnit(&data, &searchSize, &nextNalStart,
+                &nextNalSize, true) == OK) {
+            currentNalSize = nextNalStart - currentNalStart - 4 /* strip start-code */;
+        } else {
+            // the final NAL unit runs to the end of the buffer
+            currentNalSize = buffer->range_length() - (currentNalStart - dataStart);
+            lastNal = true;
+        }
+        ALOGV("alp:currentNalSize:%lld", (long long)currentNalSize);
+
+        uint8_t *prefix = prefixes[numNals];
+        if (mUse4ByteNalLength) {
+            prefix[0] = currentNalSize >> 24;
+            prefix[1] = (currentNalSize >> 16) & 0xff;
+            prefix[2] = (currentNalSize >> 8) & 0xff;
+            prefix[3] = currentNalSize & 0xff;
+        } else {
+            CHECK_LT(currentNalSize, 65536u);
+            prefix[0] = currentNalSize >> 8;
+            prefix[1] = currentNalSize & 0xff;
+        }
+        iov[numNals * 2].iov_base = prefix;
+        iov[numNals * 2].iov_len = prefixLength;
+        iov[numNals * 2 + 1].iov_base = const_cast<uint8_t *>(currentNalStart);
+        iov[numNals * 2 + 1].iov_len = currentNalSize;
+        mOffset += currentNalSize + prefixLength;
+        ++numNals;
 
-void MPEG4Writer::addLengthPrefixedSample_l(MediaBuffer *buffer) {
-    ALOGV("alp:buffer->range_length:%lld", (long long)buffer->range_length());
-    size_t length = buffer->range_length();
-    if (mUse4ByteNalLength) {
-        ALOGV("mUse4ByteNalLength");
-        uint8_t x[4];
-        x[0] = length >> 24;
-        x[1] = (length >> 16) & 0xff;
-        x[2] = (length >> 8) & 0xff;
-        x[3] = length & 0xff;
-        writeOrPostError(mFd, &x, 4);
-        writeOrPostError(mFd, (const uint8_t*)buffer->data() + buffer->range_offset(), length);
-        mOffset += length + 4;
-    } else {
-        ALOGV("mUse2ByteNalLength");
-        CHECK_LT(length, 65536u);
+        if (numNals == kMaxNalsPerBatch || lastNal) {
+            writevOrPostError(mFd, iov, numNals * 2);
+            numNals = 0;
+        }
 
-        uint8_t x[2];
-        x[0] = length >> 8;
-        x[1] = length & 0xff;
-        writeOrPostError(mFd, &x, 2);
-        writeOrPostError(mFd, (const uint8_t*)buffer->data() + buffer->range_offset(), length);
-        mOffset += length + 2;
+        if (!lastNal) {
+            currentNalStart = nextNalStart;
+        }
     }
 }
 
@@ -1764,6 +1848,38 @@ void MPEG4Writer::writeOrPostError(int fd, const void* buf, size_t count) {
     WARN_UNLESS(msg->post() == OK, "writeOrPostError:error posting ERROR_IO");
 }
 
+void MPEG4Writer::writevOrPostError(int fd, const struct iovec *iov, int iovCount) {
+    if (mWriteSeekErr == true)
+        return;
+
+    size_t count = 0;
+    for (int i = 0; i < iovCount; ++i) {
+        count += iov[i].iov_len;
+    }
+
+    auto beforeTP = std::chrono::high_resolution_clock::now();
+    ssize_t bytesWritten = ::writev(fd, iov, iovCount);
+    auto afterTP = std::chrono::high_resolution_clock::now();
+    auto writeDuration =
+            std::chrono::duration_cast<std::chrono::microseconds>(afterTP - beforeTP).count();
+    mWriteDurationPQ.emplace(writeDuration);
+    if (mWriteDurationPQ.size() > kWriteDurationsCount) {
+        mWriteDurationPQ.pop();
+    }
+
+    if (bytesWritten == (ssize_t)count)
+        return;
+    mWriteSeekErr = true;
+    // Note that errno is not changed even when bytesWritten < count.
+    ALOGE("writevOrPostError bytesWritten:%zd, count:%zu, error:%s(%d)", bytesWritten, count,
+          std::strerror(errno), errno);
+
+    // Can't guarantee that file is usable or write would succeed anymore, hence signal to stop.
+    sp<AMessage> msg = new AMessage(kWhatIOError, mReflector);
+    msg->setInt32("err", ERROR_IO);
+    WARN_UNLESS(msg->post() == OK, "writevOrPostError:error posting ERROR_IO");
+}
+
 void MPEG4Writer::seekOrPostError(int fd, off64_t offset, int whence) {
     if (mWriteSeekErr == true)
         return;
@@ -1783,6 +1899,36 @@ void MPEG4Writer::seekOrPostError(int fd, off64_t offset, int whence) {
     WARN_UNLESS(msg->post() == OK, "seekOrPostError:error posting ERROR_IO");
 }
 
+int MPEG4Writer::createTempSpillFd() {
+    if (mFd < 0) {
+        return -1;
+    }
+    // Resolve the directory of the output file so the spill file lands on
+    // the same (recordable, hence writable) filesystem. The file is created
+    // unlinked (O_TMPFILE) and disappears when the fd is closed.
+    char fdPath[32];
+    char filePath[PATH_MAX];
+    snprintf(fdPath, sizeof(fdPath), "/proc/self/fd/%d", mFd);
+    ssize_t len = readlink(fdPath, filePath, sizeof(filePath) - 1);
+    if (len < 0) {
+        ALOGW("could not resolve output file path (%s)", std::strerror(errno));
+        return -1;
+    }
+    filePath[len] = '\0';
+    char *lastSlash = strrchr(filePath, '/');
+    if (lastSlash == NULL) {
+        return -1;
+    }
+    *lastSlash = '\0';
+    int fd = open(filePath[0] != '\0' ? filePath : "/",
+            O_TMPFILE | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        ALOGV("could not create spill file in %s (%s)",
+                filePath, std::strerror(errno));
+    }
+    return fd;
+}
+
 void MPEG4Writer::beginBox(uint32_t id) {
     ALOGV("beginBox:%" PRIu32, id);
 
@@ -2199,6 +2345,13 @@ MPEG4Writer::Track::Track(
       mGridCols(0),
       mNumTiles(1),
       mTileIndex(0) {
+    // stsz and co64 grow linearly with recording length and are never
+    // modified once an entry is added; spill their finalized blocks to a
+    // temporary file so a long recording doesn't hold all sample table
+    // entries in memory until stop().
+    mStszTableEntries->enableSpill(mOwner->createTempSpillFd());
+    mCo64TableEntries->enableSpill(mOwner->createTempSpillFd());
+
     getCodecSpecificDataFromInputFormatIfPossible();
 
     const char *mime;
@@ -2257,10 +2410,12 @@ void MPEG4Writer::Track::resetInternal() {
     if (mStszTableEntries != NULL) {
         delete mStszTableEntries;
         mStszTableEntries = new ListTableEntries<uint32_t, 1>(1000);
+        mStszTableEntries->enableSpill(mOwner->createTempSpillFd());
     }
     if (mCo64TableEntries != NULL) {
         delete mCo64TableEntries;
         mCo64TableEntries = new ListTableEntries<off64_t, 1>(1000);
+        mCo64TableEntries->enableSpill(mOwner->createTempSpillFd());
     }
     if (mStscTableEntries != NULL) {
         delete mStscTableEntries;
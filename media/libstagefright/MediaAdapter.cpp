@@ -18,6 +18,8 @@
 #define LOG_TAG "MediaAdapter"
 #include <utils/Log.h>
 
+#include <string.h>
+
 #include <media/stagefright/foundation/ADebug.h>
 #include <media/stagefright/MediaAdapter.h>
 #include <media/stagefright/MediaBuffer.h>
@@ -25,7 +27,7 @@
 namespace android {
 
 MediaAdapter::MediaAdapter(const sp<MetaData> &meta)
-    : mCurrentMediaBuffer(NULL),
+    : mQueuedBytes(0),
       mStarted(false),
       mOutputFormat(meta) {
 }
@@ -33,7 +35,7 @@ MediaAdapter::MediaAdapter(const sp<MetaData> &meta)
 MediaAdapter::~MediaAdapter() {
     Mutex::Autolock autoLock(mAdapterLock);
     mOutputFormat.clear();
-    CHECK(mCurrentMediaBuffer == NULL);
+    CHECK(mBufferQueue.empty());
 }
 
 status_t MediaAdapter::start(MetaData * /* params */) {
@@ -45,24 +47,23 @@ status_t MediaAdapter::start(MetaData * /* params */) {
 }
 
 status_t MediaAdapter::stop() {
-    MediaBuffer *currentBuffer = NULL;
-    {
-        Mutex::Autolock autoLock(mAdapterLock);
-        if (mStarted) {
-            mStarted = false;
-            // If stop() happens immediately after a pushBuffer(), we should
-            // clean up the mCurrentMediaBuffer. But need to release without
-            // the lock as signalBufferReturned() will acquire the lock.
-            currentBuffer = mCurrentMediaBuffer;
-            mCurrentMediaBuffer = NULL;
-
-            // While read() is still waiting, we should signal it to finish.
-            mBufferReadCond.signal();
+    Mutex::Autolock autoLock(mAdapterLock);
+    if (mStarted) {
+        mStarted = false;
+        // If stop() happens while samples are still queued, clean them up.
+        // The queued copies carry no observer, so releasing them here just
+        // frees them without calling back into signalBufferReturned().
+        while (!mBufferQueue.empty()) {
+            List<MediaBuffer *>::iterator it = mBufferQueue.begin();
+            mQueuedBytes -= (*it)->size();
+            (*it)->release();
+            mBufferQueue.erase(it);
         }
-    }
-    if (currentBuffer != NULL) {
-        currentBuffer->release();
-        currentBuffer = NULL;
+
+        // While read() is still waiting, we should signal it to finish.
+        mBufferReadCond.signal();
+        // And wake any producer waiting for queue space.
+        mBufferReturnedCond.broadcast();
     }
     return OK;
 }
@@ -78,7 +79,6 @@ void MediaAdapter::signalBufferReturned(MediaBufferBase *buffer) {
     buffer->setObserver(0);
     buffer->release();
     ALOGV("buffer returned %p", buffer);
-    mBufferReturnedCond.signal();
 }
 
 status_t MediaAdapter::read(
@@ -89,21 +89,24 @@ status_t MediaAdapter::read(
         return ERROR_END_OF_STREAM;
     }
 
-    while (mCurrentMediaBuffer == NULL && mStarted) {
+    while (mBufferQueue.empty() && mStarted) {
         ALOGV("waiting @ read()");
         mBufferReadCond.wait(mAdapterLock);
     }
 
     if (!mStarted) {
         ALOGV("read interrupted after stop");
-        CHECK(mCurrentMediaBuffer == NULL);
+        CHECK(mBufferQueue.empty());
         return ERROR_END_OF_STREAM;
     }
 
-    CHECK(mCurrentMediaBuffer != NULL);
+    List<MediaBuffer *>::iterator it = mBufferQueue.begin();
+    *buffer = *it;
+    mQueuedBytes -= (*it)->size();
+    mBufferQueue.erase(it);
 
-    *buffer = mCurrentMediaBuffer;
-    mCurrentMediaBuffer = NULL;
+    // A queue slot freed up; wake a producer waiting in pushBuffer().
+    mBufferReturnedCond.signal();
 
     return OK;
 }
@@ -114,24 +117,56 @@ status_t MediaAdapter::pushBuffer(MediaBuffer *buffer) {
         return -EINVAL;
     }
 
-    /* As mAdapterLock is unlocked while waiting for signalBufferReturned,
-     * a new buffer for the same track could be pushed from another thread
-     * in the client process, mBufferGatingMutex will help to hold that
-     * until the previous buffer is processed.
+    /* As mAdapterLock is unlocked while waiting for queue space, a new
+     * buffer for the same track could be pushed from another thread in the
+     * client process, mBufferGatingMutex will help to hold that until the
+     * previous buffer is queued.
      */
     std::unique_lock<std::mutex> lk(mBufferGatingMutex);
 
-    Mutex::Autolock autoLock(mAdapterLock);
-    if (!mStarted) {
-        ALOGE("pushBuffer called before start");
-        return INVALID_OPERATION;
+    {
+        Mutex::Autolock autoLock(mAdapterLock);
+        if (!mStarted) {
+            ALOGE("pushBuffer called before start");
+            return INVALID_OPERATION;
+        }
+
+        // Block only while the queue is at capacity, i.e. the writer is
+        // falling behind. An oversized sample is still admitted once the
+        // queue has drained.
+        while (mStarted
+                && (mBufferQueue.size() >= kMaxQueuedBuffers
+                        || (!mBufferQueue.empty()
+                                && mQueuedBytes + buffer->range_length()
+                                        > kMaxQueuedBytes))) {
+            ALOGV("waiting for queue space @ pushBuffer! %p", buffer);
+            mBufferReturnedCond.wait(mAdapterLock);
+        }
+
+        if (!mStarted) {
+            ALOGV("pushBuffer interrupted by stop");
+            return INVALID_OPERATION;
+        }
+
+        // Queue a copy of the sample so the caller may re-use its buffer
+        // as soon as we return. The copy has no observer; the writer frees
+        // it with the final release() once it has consumed it.
+        MediaBuffer *copy = new MediaBuffer(buffer->range_length());
+        memcpy(copy->data(),
+               (uint8_t *)buffer->data() + buffer->range_offset(),
+               buffer->range_length());
+        copy->set_range(0, buffer->range_length());
+        copy->meta_data() = buffer->meta_data();
+
+        mQueuedBytes += copy->size();
+        mBufferQueue.push_back(copy);
+        mBufferReadCond.signal();
     }
-    mCurrentMediaBuffer = buffer;
-    mCurrentMediaBuffer->setObserver(this);
-    mBufferReadCond.signal();
 
-    ALOGV("wait for the buffer returned @ pushBuffer! %p", buffer);
-    mBufferReturnedCond.wait(mAdapterLock);
+    // The caller's reference is dropped through signalBufferReturned(),
+    // which acquires mAdapterLock, so release outside of it.
+    buffer->setObserver(this);
+    buffer->release();
 
     return OK;
 }
@@ -30,6 +30,11 @@ namespace android {
 // If larger than this threshold, it's treated as discontinuity.
 static const int64_t kAnchorFluctuationAllowedUs = 10000LL;
 
+// When a wakeup fires an expired timer, timers due within this much real
+// time are fired on the same wakeup instead of scheduling another thread
+// wake moments later for each of them.
+static const int64_t kTimerSlackRealUs = 2000LL;
+
 MediaClock::Timer::Timer(const sp<AMessage> &notify, int64_t mediaTimeUs, int64_t adjustRealUs)
     : mNotify(notify),
       mMediaTimeUs(mediaTimeUs),
@@ -261,6 +266,24 @@ void MediaClock::processTimers_l() {
         return;
     }
 
+    // Coalesce wakeups: if some timer has expired, also fire the timers
+    // landing within the slack window on this wakeup, trading a little
+    // early delivery for fewer thread wakes. Timer deadlines are re-derived
+    // from media time on every pass, so a playback rate change simply takes
+    // effect the next time the timers are processed.
+    bool anyTimerExpired = false;
+    for (auto it = mTimers.begin(); it != mTimers.end(); ++it) {
+        if (it->mAdjustRealUs * (double)mPlaybackRate
+                + it->mMediaTimeUs - nowMediaTimeUs <= 0) {
+            anyTimerExpired = true;
+            break;
+        }
+    }
+    int64_t dueThresholdMediaUs = 0;
+    if (anyTimerExpired) {
+        dueThresholdMediaUs = kTimerSlackRealUs * (double)mPlaybackRate;
+    }
+
     int64_t nextLapseRealUs = INT64_MAX;
     std::multimap<int64_t, Timer> notifyList;
     auto it = mTimers.begin();
@@ -276,7 +299,7 @@ void MediaClock::processTimers_l() {
             diffMediaUs = diff;
         }
 
-        if (diffMediaUs <= 0) {
+        if (diffMediaUs <= dueThresholdMediaUs) {
             notifyList.emplace(diffMediaUs, *it);
             it = mTimers.erase(it);
         } else {
@@ -280,6 +280,13 @@ struct MediaCodec::ResourceManagerServiceProxy : public RefBase {
     static void addCookie(void* cookie);
     static void removeCookie(void* cookie);
 
+    // process-wide cached binder to the resource manager, so that creating a
+    // codec does not pay a service manager lookup every time
+    static Mutex sLockService;
+    static std::shared_ptr<IResourceManagerService> sService;
+    static std::shared_ptr<IResourceManagerService> getService();
+    static void dropService(const std::shared_ptr<IResourceManagerService>& service);
+
     void addResource(const MediaResourceParcel &resource);
     void removeResource(const MediaResourceParcel &resource);
     void removeClient();
@@ -321,8 +328,7 @@ MediaCodec::ResourceManagerServiceProxy::~ResourceManagerServiceProxy() {
 }
 
 status_t MediaCodec::ResourceManagerServiceProxy::init() {
-    ::ndk::SpAIBinder binder(AServiceManager_getService("media.resource_manager"));
-    mService = IResourceManagerService::fromBinder(binder);
+    mService = getService();
     if (mService == nullptr) {
         ALOGE("Failed to get ResourceManagerService");
         return UNKNOWN_ERROR;
@@ -360,6 +366,34 @@ status_t MediaCodec::ResourceManagerServiceProxy::init() {
 [[clang::no_destroy]] Mutex MediaCodec::ResourceManagerServiceProxy::sLockCookies;
 [[clang::no_destroy]] std::set<void*> MediaCodec::ResourceManagerServiceProxy::sCookies;
 
+[[clang::no_destroy]] Mutex MediaCodec::ResourceManagerServiceProxy::sLockService;
+[[clang::no_destroy]] std::shared_ptr<IResourceManagerService>
+        MediaCodec::ResourceManagerServiceProxy::sService;
+
+//static
+std::shared_ptr<IResourceManagerService> MediaCodec::ResourceManagerServiceProxy::getService() {
+    Mutex::Autolock _l(sLockService);
+    // The cached binder can be stale if the service died while no codec was alive
+    // to observe the death notification.
+    if (sService != nullptr && !AIBinder_isAlive(sService->asBinder().get())) {
+        sService = nullptr;
+    }
+    if (sService == nullptr) {
+        ::ndk::SpAIBinder binder(AServiceManager_getService("media.resource_manager"));
+        sService = IResourceManagerService::fromBinder(binder);
+    }
+    return sService;
+}
+
+//static
+void MediaCodec::ResourceManagerServiceProxy::dropService(
+        const std::shared_ptr<IResourceManagerService>& service) {
+    Mutex::Autolock _l(sLockService);
+    if (sService == service) {
+        sService = nullptr;
+    }
+}
+
 //static
 void MediaCodec::ResourceManagerServiceProxy::addCookie(void* cookie) {
     Mutex::Autolock _l(sLockCookies);
@@ -383,8 +417,13 @@ void MediaCodec::ResourceManagerServiceProxy::BinderDiedCallback(void* cookie) {
 
 void MediaCodec::ResourceManagerServiceProxy::binderDied() {
     ALOGW("ResourceManagerService died.");
-    Mutex::Autolock _l(mLock);
-    mService = nullptr;
+    std::shared_ptr<IResourceManagerService> service;
+    {
+        Mutex::Autolock _l(mLock);
+        service = mService;
+        mService = nullptr;
+    }
+    dropService(service);
 }
 
 void MediaCodec::ResourceManagerServiceProxy::addResource(
@@ -5237,6 +5276,10 @@ status_t MediaCodec::onQueueInputBuffer(const sp<AMessage> &msg) {
         buffer->meta()->setInt32("csd", true);
     }
 
+    if (flags & BUFFER_FLAG_DECODE_ONLY) {
+        buffer->meta()->setInt32("decode-only", true);
+    }
+
     if (mTunneled) {
         TunnelPeekState previousState = mTunnelPeekState;
         switch(mTunnelPeekState){
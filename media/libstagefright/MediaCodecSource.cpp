@@ -499,31 +499,42 @@ status_t MediaCodecSource::init() {
 
 status_t MediaCodecSource::initEncoder() {
 
-    mReflector = new AHandlerReflector<MediaCodecSource>(this);
-    mLooper->registerHandler(mReflector);
+    if (mReflector == NULL) {
+        mReflector = new AHandlerReflector<MediaCodecSource>(this);
+        mLooper->registerHandler(mReflector);
+    }
+
+    if (mCodecLooper == NULL) {
+        mCodecLooper = new ALooper;
+        mCodecLooper->setName("codec_looper");
+        mCodecLooper->start();
+    }
 
-    mCodecLooper = new ALooper;
-    mCodecLooper->setName("codec_looper");
-    mCodecLooper->start();
+    // Keep the format the client configured us with. mOutputFormat is replaced
+    // with the encoder's actual output format below, and a restart after stop()
+    // must configure the new codec from the original request.
+    if (mConfigFormat == NULL) {
+        mConfigFormat = mOutputFormat;
+    }
 
     if (mFlags & FLAG_USE_SURFACE_INPUT) {
-        mOutputFormat->setInt32(KEY_CREATE_INPUT_SURFACE_SUSPENDED, 1);
+        mConfigFormat->setInt32(KEY_CREATE_INPUT_SURFACE_SUSPENDED, 1);
     }
 
     AString outputMIME;
-    CHECK(mOutputFormat->findString("mime", &outputMIME));
+    CHECK(mConfigFormat->findString("mime", &outputMIME));
     mIsVideo = outputMIME.startsWithIgnoreCase("video/");
 
     AString name;
     status_t err = NO_INIT;
-    if (mOutputFormat->findString("testing-name", &name)) {
+    if (mConfigFormat->findString("testing-name", &name)) {
         mEncoder = MediaCodec::CreateByComponentName(mCodecLooper, name);
 
         mEncoderActivityNotify = new AMessage(kWhatEncoderActivity, mReflector);
         mEncoder->setCallback(mEncoderActivityNotify);
 
         err = mEncoder->configure(
-                    mOutputFormat,
+                    mConfigFormat,
                     NULL /* nativeWindow */,
                     NULL /* crypto */,
                     MediaCodec::CONFIGURE_FLAG_ENCODE);
@@ -542,13 +553,13 @@ status_t MediaCodecSource::initEncoder() {
                 continue;
             }
 
-            ALOGV("output format is '%s'", mOutputFormat->debugString(0).c_str());
+            ALOGV("output format is '%s'", mConfigFormat->debugString(0).c_str());
 
             mEncoderActivityNotify = new AMessage(kWhatEncoderActivity, mReflector);
             mEncoder->setCallback(mEncoderActivityNotify);
 
             err = mEncoder->configure(
-                        mOutputFormat,
+                        mConfigFormat,
                         NULL /* nativeWindow */,
                         NULL /* crypto */,
                         MediaCodec::CONFIGURE_FLAG_ENCODE);
@@ -802,10 +813,35 @@ status_t MediaCodecSource::feedEncoderInputBuffers() {
 }
 
 status_t MediaCodecSource::onStart(MetaData *params) {
-    if (mStopping || mOutput.lock()->mEncoderReachedEOS) {
-        ALOGE("Failed to start while we're stopping or encoder already stopped due to EOS error");
+    if (mStopping) {
+        ALOGE("Failed to start while we're stopping");
         return INVALID_OPERATION;
     }
+    if (mOutput.lock()->mEncoderReachedEOS) {
+        if (mEncoder == NULL && (mFlags & FLAG_USE_SURFACE_INPUT)
+                && mPersistentSurface != NULL
+                && mOutput.lock()->mErrorCode == ERROR_END_OF_STREAM) {
+            // The previous recording ended cleanly and the encoder has been
+            // released. With a persistent surface the producer handle the
+            // client holds stays valid across codec instances, so recreate
+            // the encoder in place instead of requiring a full teardown of
+            // the source between clips.
+            ALOGI("MediaCodecSource (%s) restarting encoder after stop",
+                    mIsVideo ? "video" : "audio");
+            status_t err = initEncoder();
+            if (err != OK) {
+                ALOGE("Failed to recreate encoder on restart (err %d)", err);
+                releaseEncoder();
+                return err;
+            }
+            mStarted = false;
+            mFirstSampleSystemTimeUs = -1LL;
+            mPausePending = false;
+        } else {
+            ALOGE("Failed to start while we're stopping or encoder already stopped due to EOS error");
+            return INVALID_OPERATION;
+        }
+    }
     int64_t startTimeUs;
     if (params == NULL || !params->findInt64(kKeyTime, &startTimeUs)) {
         startTimeUs = -1LL;
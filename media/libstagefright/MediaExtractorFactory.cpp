@@ -37,6 +37,8 @@
 #include <dirent.h>
 #include <dlfcn.h>
 
+#include <map>
+
 namespace android {
 
 // static
@@ -128,6 +130,50 @@ std::shared_ptr<std::list<sp<ExtractorPlugin>>> MediaExtractorFactory::gPlugins;
 bool MediaExtractorFactory::gPluginsRegistered = false;
 bool MediaExtractorFactory::gIgnoreVersion = false;
 
+namespace {
+
+// Remember which plugin sniffed a file best, keyed by file size and leading
+// bytes. Bulk scans sniff the same files again and again; on a cache hit only
+// the remembered winner's sniff is rerun (it has to regenerate its meta
+// anyway), and the full every-plugin pass remains the fallback whenever the
+// winner no longer matches.
+constexpr size_t kSniffCachePrefixSize = 64;
+constexpr size_t kSniffCacheMaxEntries = 256;
+
+struct SniffCacheKey {
+    off64_t size;
+    uint8_t prefix[kSniffCachePrefixSize];
+
+    bool operator<(const SniffCacheKey &other) const {
+        if (size != other.size) {
+            return size < other.size;
+        }
+        return memcmp(prefix, other.prefix, sizeof(prefix)) < 0;
+    }
+};
+
+Mutex gSniffCacheMutex;
+std::map<SniffCacheKey, media_uuid_t> gSniffCache;
+// the plugin list the cache was built against; entries are dropped wholesale
+// when the extractors are updated
+std::shared_ptr<std::list<sp<ExtractorPlugin>>> gSniffCachePlugins;
+
+void *sniffOnePlugin(
+        const sp<ExtractorPlugin> &plugin, const sp<DataSource> &source,
+        float *confidence, void **meta, FreeMetaFunc *freeMeta) {
+    *confidence = 0.0f;
+    *meta = nullptr;
+    *freeMeta = nullptr;
+    if (plugin->def.def_version == EXTRACTORDEF_VERSION_NDK_V1) {
+        return (void*) plugin->def.u.v2.sniff(source->wrap(), confidence, meta, freeMeta);
+    } else if (plugin->def.def_version == EXTRACTORDEF_VERSION_NDK_V2) {
+        return (void*) plugin->def.u.v3.sniff(source->wrap(), confidence, meta, freeMeta);
+    }
+    return nullptr;
+}
+
+}  // namespace
+
 // static
 void *MediaExtractorFactory::sniff(
         const sp<DataSource> &source, float *confidence, void **meta,
@@ -144,6 +190,48 @@ void *MediaExtractorFactory::sniff(
         plugins = gPlugins;
     }
 
+    SniffCacheKey cacheKey;
+    bool haveCacheKey = false;
+    if (source->getSize(&cacheKey.size) == OK) {
+        memset(cacheKey.prefix, 0, sizeof(cacheKey.prefix));
+        haveCacheKey = source->readAt(0, cacheKey.prefix, sizeof(cacheKey.prefix)) > 0;
+    }
+
+    if (haveCacheKey) {
+        sp<ExtractorPlugin> cachedPlugin;
+        {
+            Mutex::Autolock autoLock(gSniffCacheMutex);
+            if (gSniffCachePlugins != plugins) {
+                gSniffCache.clear();
+                gSniffCachePlugins = plugins;
+            } else {
+                auto it = gSniffCache.find(cacheKey);
+                if (it != gSniffCache.end()) {
+                    for (const sp<ExtractorPlugin> &candidate : *plugins) {
+                        if (!memcmp(&candidate->def.extractor_uuid, &it->second,
+                                sizeof(media_uuid_t))) {
+                            cachedPlugin = candidate;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        if (cachedPlugin != nullptr) {
+            ALOGV("sniff cache hit: %s", cachedPlugin->def.extractor_name);
+            void *creator = sniffOnePlugin(cachedPlugin, source, confidence, meta, freeMeta);
+            if (creator != NULL) {
+                plugin = cachedPlugin;
+                *creatorVersion = cachedPlugin->def.def_version;
+                return creator;
+            }
+            // the remembered winner no longer matches (e.g. the file at this
+            // size/prefix changed); forget it and run the full pass
+            Mutex::Autolock autoLock(gSniffCacheMutex);
+            gSniffCache.erase(cacheKey);
+        }
+    }
+
     void *bestCreator = NULL;
     for (auto it = plugins->begin(); it != plugins->end(); ++it) {
         ALOGV("sniffing %s", (*it)->def.extractor_name);
@@ -151,14 +239,8 @@ void *MediaExtractorFactory::sniff(
         void *newMeta = nullptr;
         FreeMetaFunc newFreeMeta = nullptr;
 
-        void *curCreator = NULL;
-        if ((*it)->def.def_version == EXTRACTORDEF_VERSION_NDK_V1) {
-            curCreator = (void*) (*it)->def.u.v2.sniff(
-                    source->wrap(), &newConfidence, &newMeta, &newFreeMeta);
-        } else if ((*it)->def.def_version == EXTRACTORDEF_VERSION_NDK_V2) {
-            curCreator = (void*) (*it)->def.u.v3.sniff(
-                    source->wrap(), &newConfidence, &newMeta, &newFreeMeta);
-        }
+        void *curCreator = sniffOnePlugin(
+                *it, source, &newConfidence, &newMeta, &newFreeMeta);
 
         if (curCreator) {
             if (newConfidence > *confidence) {
@@ -179,6 +261,16 @@ void *MediaExtractorFactory::sniff(
         }
     }
 
+    if (bestCreator != NULL && haveCacheKey) {
+        Mutex::Autolock autoLock(gSniffCacheMutex);
+        if (gSniffCachePlugins == plugins) {
+            if (gSniffCache.size() >= kSniffCacheMaxEntries) {
+                gSniffCache.clear();
+            }
+            gSniffCache[cacheKey] = plugin->def.extractor_uuid;
+        }
+    }
+
     return bestCreator;
 }
 
@@ -239,7 +239,9 @@ status_t MediaMuxer::writeSampleData(const sp<ABuffer> &buffer, size_t trackInde
     }
 
     sp<MediaAdapter> currentTrack = mTrackList[trackIndex];
-    // This pushBuffer will wait until the mediaBuffer is consumed.
+    // pushBuffer queues a copy of the sample on the track and only waits
+    // while the track's queue is full, so producers of different tracks
+    // don't serialize on the writer consuming each sample.
     return currentTrack->pushBuffer(mediaBuffer);
 }
 
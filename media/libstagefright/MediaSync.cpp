@@ -17,6 +17,7 @@
 //#define LOG_NDEBUG 0
 #define LOG_TAG "MediaSync"
 #include <inttypes.h>
+#include <math.h>
 
 #include <gui/BufferQueue.h>
 #include <gui/IGraphicBufferConsumer.h>
@@ -38,6 +39,17 @@
 // frame arrives later than this number, it will be discarded without rendering.
 static const int64_t kMaxAllowedVideoLateTimeUs = 40000LL;
 
+// Parameters of the audio drift servo used when syncing to vsync. The trim is
+// bounded well below the audibility threshold for time stretching, and small
+// changes are skipped so AudioTrack is not peppered with rate updates. The
+// gains are chosen to pull half a vsync period (~8 ms at 60 Hz) of phase error
+// back in over roughly ten seconds.
+static const double kMaxDriftTrim = 0.001;               // +/- 1000 ppm
+static const double kMinDriftTrimStep = 5e-7;            // 0.5 ppm
+static const int64_t kMinTrimUpdateIntervalUs = 500000LL;
+static const double kDriftProportionalGain = 2.5e-8;     // trim per us of error
+static const double kDriftIntegralGain = 1e-11;          // trim per us of integral
+
 namespace android {
 
 // static
@@ -59,7 +71,10 @@ MediaSync::MediaSync()
         mNumFramesWritten(0),
         mHasAudio(false),
         mNextBufferItemMediaUs(-1),
-        mPlaybackRate(0.0) {
+        mPlaybackRate(0.0),
+        mDriftTrim(0.0),
+        mDriftErrorIntegralUs(0.0),
+        mLastTrimUpdateUs(0) {
     mMediaClock = new MediaClock;
     mMediaClock->init();
 
@@ -241,6 +256,7 @@ void MediaSync::resync_l() {
     }
 
     // TODO: resync ourselves to the current clock (e.g. on sync source change)
+    resetDriftServo_l();
     updatePlaybackRate_l(mPlaybackRate);
 }
 
@@ -249,11 +265,67 @@ void MediaSync::updatePlaybackRate_l(float rate) {
         mNextBufferItemMediaUs = -1;
     }
     mPlaybackRate = rate;
+    // the audio track was just set to the raw requested rate, so any trim
+    // previously applied on top of the old rate is gone
+    resetDriftServo_l();
     // TODO: update frame scheduler with this info
     mMediaClock->setPlaybackRate(rate);
     onDrainVideo_l();
 }
 
+void MediaSync::updateDriftServo_l(
+        int64_t scheduledRealUs, int64_t clockRealUs, int64_t nowUs) {
+    // The scheduler snaps each frame to the vsync grid; the snap distance is
+    // the phase error between the audio-driven media clock and the display.
+    // When the display clock free-runs (e.g. an external display), trim the
+    // audio rate by a few ppm to keep that phase centered, instead of letting
+    // it wrap into a repeated or dropped frame.
+    const double errorUs = (double)(scheduledRealUs - clockRealUs);
+    mDriftErrorIntegralUs += errorUs;
+    // anti-windup: don't let the I term alone demand more than the max trim
+    const double maxIntegralUs = kMaxDriftTrim / kDriftIntegralGain;
+    if (mDriftErrorIntegralUs > maxIntegralUs) {
+        mDriftErrorIntegralUs = maxIntegralUs;
+    } else if (mDriftErrorIntegralUs < -maxIntegralUs) {
+        mDriftErrorIntegralUs = -maxIntegralUs;
+    }
+
+    double trim = kDriftProportionalGain * errorUs
+            + kDriftIntegralGain * mDriftErrorIntegralUs;
+    if (trim > kMaxDriftTrim) {
+        trim = kMaxDriftTrim;
+    } else if (trim < -kMaxDriftTrim) {
+        trim = -kMaxDriftTrim;
+    }
+
+    if (nowUs - mLastTrimUpdateUs < kMinTrimUpdateIntervalUs
+            || fabs(trim - mDriftTrim) < kMinDriftTrimStep) {
+        return;
+    }
+
+    AudioPlaybackRate rate = mPlaybackSettings;
+    rate.mSpeed = (float)(mPlaybackSettings.mSpeed * (1.0 + trim));
+    if (mSyncSettings.mAudioAdjustMode == AVSYNC_AUDIO_ADJUST_MODE_RESAMPLE) {
+        // scale pitch with speed so the trim is applied as a pure sample
+        // rate conversion in the mixer instead of time stretching
+        rate.mPitch = (float)(mPlaybackSettings.mPitch * (1.0 + trim));
+    }
+    if (mAudioTrack->setPlaybackRate(rate) == OK) {
+        ALOGV("drift servo: error %.0f us, trim %.2f ppm", errorUs, trim * 1e6);
+        mDriftTrim = trim;
+        mLastTrimUpdateUs = nowUs;
+    }
+    // Note that mPlaybackSettings and mMediaClock keep the raw requested
+    // rate; the media clock follows the trimmed audio through the anchor
+    // updates in updateQueuedAudioData().
+}
+
+void MediaSync::resetDriftServo_l() {
+    mDriftTrim = 0.0;
+    mDriftErrorIntegralUs = 0.0;
+    mLastTrimUpdateUs = 0;
+}
+
 sp<const MediaClock> MediaSync::getMediaClock() {
     return mMediaClock;
 }
@@ -541,12 +613,19 @@ void MediaSync::onDrainVideo_l() {
         int64_t nowUs = ALooper::GetNowUs();
         BufferItem *bufferItem = &*mBufferItems.begin();
         int64_t itemMediaUs = bufferItem->mTimestamp / 1000;
-        int64_t itemRealUs = getRealTime(itemMediaUs, nowUs);
+        int64_t clockRealUs = getRealTime(itemMediaUs, nowUs);
 
         // adjust video frame PTS based on vsync
-        itemRealUs = mFrameScheduler->schedule(itemRealUs * 1000) / 1000;
+        int64_t itemRealUs = mFrameScheduler->schedule(clockRealUs * 1000) / 1000;
         int64_t twoVsyncsUs = 2 * (mFrameScheduler->getVsyncPeriod() / 1000);
 
+        // When syncing to the display, steer the audio rate so the media
+        // clock tracks the display clock.
+        if (mSyncSettings.mSource == AVSYNC_SOURCE_VSYNC
+                && mHasAudio && mAudioTrack != NULL) {
+            updateDriftServo_l(itemRealUs, clockRealUs, nowUs);
+        }
+
         // post 2 display refreshes before rendering is due
         if (itemRealUs <= nowUs + twoVsyncsUs) {
             ALOGV("adjusting PTS from %lld to %lld",
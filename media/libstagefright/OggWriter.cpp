@@ -52,6 +52,7 @@ namespace android {
 
 OggWriter::OggWriter(int fd)
       : mFd(dup(fd)),
+        mWriter(mFd),
         mHaveAllCodecSpecificData(false),
         mInitCheck(mFd < 0 ? NO_INIT : OK) {
     // empty
@@ -63,6 +64,7 @@ OggWriter::~OggWriter() {
     }
 
     if (mFd != -1) {
+        mWriter.flush();
         close(mFd);
         mFd = -1;
     }
@@ -149,8 +151,8 @@ status_t OggWriter::writeOggHeaderPackets(unsigned char *buf, size_t size) {
     int ret;
     while ((ret = ogg_stream_flush((ogg_stream_state*)mOs, &og))) {
         if (!ret) break;
-        write(mFd, og.header, og.header_len);
-        write(mFd, og.body, og.body_len);
+        mWriter.write(og.header, og.header_len);
+        mWriter.write(og.body, og.body_len);
     }
 
 
@@ -179,8 +181,8 @@ status_t OggWriter::writeOggHeaderPackets(unsigned char *buf, size_t size) {
 
     while ((ret = ogg_stream_flush((ogg_stream_state*)mOs, &og))) {
         if (!ret) break;
-        write(mFd, og.header, og.header_len);
-        write(mFd, og.body, og.body_len);
+        mWriter.write(og.header, og.header_len);
+        mWriter.write(og.body, og.body_len);
     }
 
     free(comments);
@@ -388,8 +390,8 @@ status_t OggWriter::threadFunc() {
         size_t n = 0;
 
         while (ogg_stream_flush((ogg_stream_state*)mOs, &og) > 0) {
-            write(mFd, og.header, og.header_len);
-            write(mFd, og.body, og.body_len);
+            mWriter.write(og.header, og.header_len);
+            mWriter.write(og.body, og.body_len);
             n = n + og.header_len + og.body_len;
         }
 
@@ -419,6 +421,11 @@ status_t OggWriter::threadFunc() {
         err = ERROR_MALFORMED;
     }
 
+    status_t flushErr = mWriter.flush();
+    if (err == OK && flushErr != OK) {
+        err = flushErr;
+    }
+
     close(mFd);
     mFd = -1;
     mReachedEOS = true;
@@ -76,16 +76,27 @@ void SkipCutBuffer::submit(MediaBuffer *buffer) {
     }
 
 
-    // append data to cutbuffer
-    char *src = ((char*) buffer->data()) + offset;
-    write(src, buflen);
+    // With 'held' bytes delayed in the cutbuffer, this buffer can emit all
+    // but the last mBackPadding bytes of the combined data. The delayed
+    // invariant keeps held <= mBackPadding, so the emitted data always fits
+    // in the buffer's original range and can be trimmed in place.
+    int32_t held = size();
+    int32_t emit = held + buflen - mBackPadding;
+    if (emit < 0) emit = 0;
+    int32_t fromRing = (emit < held) ? emit : held;
 
+    char *src = ((char*) buffer->data()) + offset;
 
-    // the mediabuffer is now empty. Fill it from cutbuffer, always leaving
-    // at least mBackPadding bytes in the cutbuffer
-    char *dst = (char*) buffer->data();
-    size_t copied = read(dst, buffer->size());
-    buffer->set_range(0, copied);
+    // hold back the new tail before it is shifted over
+    write(src + (emit - fromRing), buflen - (emit - fromRing));
+    if (fromRing > 0) {
+        // make room in front for the delayed bytes; a single shift instead
+        // of copying the whole payload out through the ring and back in
+        memmove(src + fromRing, src, emit - fromRing);
+        read(src, fromRing);
+    }
+    // with no end cut and nothing delayed, this was a pure range adjustment
+    buffer->set_range(offset, emit);
 }
 
 template <typename T>
@@ -109,16 +120,24 @@ void SkipCutBuffer::submitInternal(const sp<T>& buffer) {
     }
 
 
-    // append data to cutbuffer
-    char *src = (char*) buffer->data();
-    write(src, buflen);
+    // Same in-place trim as the MediaBuffer variant above.
+    int32_t held = size();
+    int32_t emit = held + buflen - mBackPadding;
+    if (emit < 0) emit = 0;
+    int32_t fromRing = (emit < held) ? emit : held;
 
+    char *src = ((char*) buffer->base()) + offset;
 
-    // the mediabuffer is now empty. Fill it from cutbuffer, always leaving
-    // at least mBackPadding bytes in the cutbuffer
-    char *dst = (char*) buffer->base();
-    size_t copied = read(dst, buffer->capacity());
-    buffer->setRange(0, copied);
+    // hold back the new tail before it is shifted over
+    write(src + (emit - fromRing), buflen - (emit - fromRing));
+    if (fromRing > 0) {
+        // make room in front for the delayed bytes; a single shift instead
+        // of copying the whole payload out through the ring and back in
+        memmove(src + fromRing, src, emit - fromRing);
+        read(src, fromRing);
+    }
+    // with no end cut and nothing delayed, this was a pure range adjustment
+    buffer->setRange(offset, emit);
 }
 
 void SkipCutBuffer::submit(const sp<ABuffer>& buffer) {
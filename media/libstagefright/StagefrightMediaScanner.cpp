@@ -44,7 +44,7 @@ static bool FileHasAcceptableExtension(const char *extension) {
         gSupportedExtensions = MediaExtractorFactory::getSupportedTypes();
     }
 
-    for (auto ext: gSupportedExtensions) {
+    for (const auto &ext : gSupportedExtensions) {
         if (ext == (extension + 1)) {
             return true;
         }
@@ -82,7 +82,10 @@ MediaScanResult StagefrightMediaScanner::processFileInternal(
         return MEDIA_SCAN_RESULT_SKIPPED;
     }
 
-    sp<MediaMetadataRetriever> mRetriever(new MediaMetadataRetriever);
+    Mutex::Autolock autoLock(mRetrieverLock);
+    if (mRetriever == NULL) {
+        mRetriever = new MediaMetadataRetriever;
+    }
 
     int fd = open(path, O_RDONLY | O_LARGEFILE);
     status_t status;
@@ -159,7 +162,11 @@ MediaAlbumArt *StagefrightMediaScanner::extractAlbumArt(int fd) {
     }
     lseek64(fd, 0, SEEK_SET);
 
-    sp<MediaMetadataRetriever> mRetriever(new MediaMetadataRetriever);
+    Mutex::Autolock autoLock(mRetrieverLock);
+    if (mRetriever == NULL) {
+        mRetriever = new MediaMetadataRetriever;
+    }
+
     if (mRetriever->setDataSource(fd, 0, size) == OK) {
         sp<IMemory> mem = mRetriever->extractAlbumArt();
         if (mem != NULL) {
@@ -331,7 +331,8 @@ VideoFrameSchedulerBase::VideoFrameSchedulerBase()
       mVsyncPeriod(0),
       mVsyncRefreshAt(0),
       mLastVsyncTime(-1),
-      mTimeCorrection(0) {
+      mTimeCorrection(0),
+      mVsyncDrift(0) {
 }
 
 void VideoFrameSchedulerBase::init(float videoFps) {
@@ -339,6 +340,7 @@ void VideoFrameSchedulerBase::init(float videoFps) {
 
     mLastVsyncTime = -1;
     mTimeCorrection = 0;
+    mVsyncDrift = 0;
 
     mPll.reset(videoFps);
 }
@@ -371,6 +373,13 @@ nsecs_t VideoFrameSchedulerBase::schedule(nsecs_t renderTime) {
     nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
     if (now >= mVsyncRefreshAt) {
         updateVsync();
+        // fresh timing from the display supersedes feedback-measured drift
+        mVsyncDrift = 0;
+    } else if (mVsyncDrift != 0 && mVsyncPeriod > 0) {
+        // fold grid drift measured from actual presentation times into the
+        // vsync estimate, so the edges we round to track the display
+        mVsyncTime += mVsyncDrift;
+        mVsyncDrift = 0;
     }
 
     // without VSYNC info, there is nothing to do
@@ -464,6 +473,29 @@ nsecs_t VideoFrameSchedulerBase::schedule(nsecs_t renderTime) {
     return renderTime;
 }
 
+void VideoFrameSchedulerBase::onFrameRendered(nsecs_t renderTimeNs) {
+    if (renderTimeNs <= 0 || mVsyncPeriod == 0) {
+        return;
+    }
+
+    // Frames latch on VSYNC edges, so the offset of a reported presentation
+    // time from our estimate of the VSYNC grid measures how far the grid has
+    // drifted since updateVsync().  Closing this loop keeps pulldown
+    // decisions (e.g. 3:2 for 24Hz-on-60Hz) from flipping VSYNC buckets
+    // between display timing refreshes.
+    nsecs_t drift = (renderTimeNs - mVsyncTime) % mVsyncPeriod;
+    if (drift < 0) {
+        drift += mVsyncPeriod;
+    }
+    if (drift > mVsyncPeriod / 2) {
+        drift -= mVsyncPeriod;
+    }
+
+    // low-pass the measurement so a single late latch does not yank the grid
+    mVsyncDrift = (mVsyncDrift * 3 + drift) / 4;
+    ATRACE_INT("VSYNC_DRIFT(us)", (int32_t)(mVsyncDrift / 1000));
+}
+
 VideoFrameSchedulerBase::~VideoFrameSchedulerBase() {}
 
 } // namespace android
@@ -47,6 +47,11 @@ status_t FrameDropper::setMaxFrameRate(float maxFrameRate) {
     return OK;
 }
 
+bool FrameDropper::willDrop(int64_t timeUs) const {
+    return mMinIntervalUs > 0 && mDesiredMinTimeUs >= 0
+            && timeUs < (mDesiredMinTimeUs - kMaxJitterUs);
+}
+
 bool FrameDropper::shouldDrop(int64_t timeUs) {
     if (mMinIntervalUs <= 0) {
         return false;
@@ -1009,13 +1009,36 @@ status_t GraphicBufferSource::acquireBuffer_l(VideoBuffer *ab) {
 }
 
 // BufferQueue::ConsumerListener callback
-void GraphicBufferSource::onFrameAvailable(const BufferItem& item __unused) {
+void GraphicBufferSource::onFrameAvailable(const BufferItem& item) {
     Mutex::Autolock autoLock(mMutex);
 
     ALOGV("onFrameAvailable: executing=%d available=%zu+%d",
             mExecuting, mAvailableBuffers.size(), mNumAvailableUnacquiredBuffers);
     ++mNumAvailableUnacquiredBuffers;
 
+    // If the frame dropper is already certain to reject this frame, acquire and
+    // release it right away instead of waiting for a free codec buffer. A
+    // high-rate producer capped to a low encode rate (e.g. display capture)
+    // otherwise keeps BufferQueue slots tied up in frames that are never
+    // submitted. Restricted to the plain encoding state so that action
+    // processing and frame-repeat bookkeeping still see their frames.
+    if (mFrameDropper != nullptr && !areWeDiscardingAvailableBuffers_l()
+            && mActionQueue.empty() && mFrameRepeatIntervalUs <= 0LL
+            && (mSkipFramesBeforeNs < 0LL || item.mTimestamp >= mSkipFramesBeforeNs)) {
+        const int64_t timeUs =
+                (mSkipFramesBeforeNs > 0 ? item.mTimestamp - mSkipFramesBeforeNs
+                                         : item.mTimestamp) / 1000;
+        if (mFrameDropper->willDrop(timeUs)) {
+            VideoBuffer buffer;
+            if (acquireBuffer_l(&buffer) == OK) {
+                ALOGV("onFrameAvailable: dropping frame (%lld) before codec handoff",
+                        (long long)timeUs);
+                mLastFrameTimestampUs = item.mTimestamp / 1000;
+                return; // released as the acquired reference goes out of scope
+            }
+        }
+    }
+
     // For BufferQueue we cannot acquire a buffer if we cannot immediately feed it to the codec
     // UNLESS we are discarding this buffer (acquiring and immediately releasing it), which makes
     // this an ugly logic.
@@ -37,6 +37,11 @@ struct FrameDropper : public RefBase {
     // Returns false if max frame rate has not been set via setMaxFrameRate.
     bool shouldDrop(int64_t timeUs);
 
+    // Returns whether shouldDrop() would reject this frame, without advancing
+    // the dropper's state. A true verdict is stable: the desired frame time
+    // only moves forward, so a frame destined to be dropped stays dropped.
+    bool willDrop(int64_t timeUs) const;
+
     // Returns true if all frame drop logic should be disabled.
     bool disabled() { return (mMinIntervalUs == -1ll); }
 
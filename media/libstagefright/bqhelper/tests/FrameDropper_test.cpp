@@ -102,6 +102,8 @@ protected:
             int64_t testTimeUs = frames[i].timeUs + jitter;
             printf("time %lld, testTime %lld, jitter %d\n",
                     (long long)frames[i].timeUs, (long long)testTimeUs, jitter);
+            // willDrop() must predict shouldDrop() without perturbing its state.
+            EXPECT_EQ(frames[i].shouldDrop, mFrameDropper->willDrop(testTimeUs));
             EXPECT_EQ(frames[i].shouldDrop, mFrameDropper->shouldDrop(testTimeUs));
         }
     }
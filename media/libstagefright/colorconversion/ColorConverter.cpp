@@ -39,11 +39,13 @@
 
 #if defined(__aarch64__) || defined(__ARM_NEON__)
 #define USE_NEON_Y410 1
+#define USE_NEON_P010 1
 #else
 #define USE_NEON_Y410 0
+#define USE_NEON_P010 0
 #endif
 
-#if USE_NEON_Y410
+#if USE_NEON_Y410 || USE_NEON_P010
 #include <arm_neon.h>
 #endif
 
@@ -864,6 +866,8 @@ status_t ColorConverter::convertYUVP010(
     return ERROR_UNSUPPORTED;
 }
 
+#if !USE_NEON_P010
+
 status_t ColorConverter::convertYUVP010ToRGBA1010102(
         const BitmapParams &src, const BitmapParams &dst) {
     const struct Coeffs *matrix = getMatrix();
@@ -933,6 +937,135 @@ status_t ColorConverter::convertYUVP010ToRGBA1010102(
     return OK;
 }
 
+#else
+
+// Convert 4 P010 pixels (10-bit Y with duplicated chroma, zero-based and
+// sign-extended to 16 bits) to packed RGBA1010102 using the same factored
+// matrix as the scalar version. The arithmetic shift by 8 instead of the
+// scalar division rounds negatives differently, but those lanes clamp to
+// zero either way.
+static inline uint32x4_t convertP010QuadToRGBA1010102(
+        int16x4_t y, int16x4_t u, int16x4_t v,
+        int16_t c_y, int16_t c_b_u, int16_t c_neg_g_u, int16_t c_neg_g_v,
+        int16_t c_r_v) {
+    int32x4_t tmp = vaddq_s32(vmull_n_s16(y, c_y), vdupq_n_s32(128));
+    int32x4_t r = vshrq_n_s32(vmlal_n_s16(tmp, v, c_r_v), 8);
+    int32x4_t g = vshrq_n_s32(
+            vmlal_n_s16(vmlal_n_s16(tmp, u, c_neg_g_u), v, c_neg_g_v), 8);
+    int32x4_t b = vshrq_n_s32(vmlal_n_s16(tmp, u, c_b_u), 8);
+
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t max = vdupq_n_s32(1023);
+    uint32x4_t rc = vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(r, zero), max));
+    uint32x4_t gc = vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(g, zero), max));
+    uint32x4_t bc = vreinterpretq_u32_s32(vminq_s32(vmaxq_s32(b, zero), max));
+
+    return vorrq_u32(
+            vorrq_u32(rc, vshlq_n_u32(gc, 10)),
+            vorrq_u32(vshlq_n_u32(bc, 20), vdupq_n_u32(3u << 30)));
+}
+
+status_t ColorConverter::convertYUVP010ToRGBA1010102(
+        const BitmapParams &src, const BitmapParams &dst) {
+    const struct Coeffs *matrix = getMatrix();
+    if (!matrix) {
+        return ERROR_UNSUPPORTED;
+    }
+
+    const int16_t _b_u = matrix->_b_u;
+    const int16_t _neg_g_u = -matrix->_g_u;
+    const int16_t _neg_g_v = -matrix->_g_v;
+    const int16_t _r_v = matrix->_r_v;
+    const int16_t _y = matrix->_y;
+    const int16_t _c16 =
+            mSrcColorSpace.mRange == ColorUtils::kColorRangeLimited ? 64 : 0;
+
+    uint8_t *dst_ptr = (uint8_t *)dst.mBits
+            + dst.mCropTop * dst.mStride + dst.mCropLeft * dst.mBpp;
+
+    uint16_t *src_y = (uint16_t *)((uint8_t *)src.mBits
+            + src.mCropTop * src.mStride + src.mCropLeft * src.mBpp);
+
+    uint16_t *src_uv = (uint16_t *)((uint8_t *)src.mBits
+            + src.mStride * src.mHeight
+            + (src.mCropTop / 2) * src.mStride + src.mCropLeft * src.mBpp);
+
+    for (size_t y = 0; y < src.cropHeight(); ++y) {
+        uint32_t *out = (uint32_t *)dst_ptr;
+        size_t x = 0;
+
+        // Process 8 pixels at a time: P010 stores 10-bit values in the top
+        // bits of each 16-bit word, and chroma interleaved at half rate.
+        for (; x + 8 <= src.cropWidth(); x += 8) {
+            int16x8_t y8 = vsubq_s16(
+                    vreinterpretq_s16_u16(vshrq_n_u16(vld1q_u16(src_y + x), 6)),
+                    vdupq_n_s16(_c16));
+
+            uint16x4x2_t uvraw = vld2_u16(src_uv + x);
+            int16x4_t u4 = vsub_s16(
+                    vreinterpret_s16_u16(vshr_n_u16(uvraw.val[0], 6)),
+                    vdup_n_s16(512));
+            int16x4_t v4 = vsub_s16(
+                    vreinterpret_s16_u16(vshr_n_u16(uvraw.val[1], 6)),
+                    vdup_n_s16(512));
+
+            // duplicate each chroma sample for its two luma samples
+            int16x4x2_t uu = vzip_s16(u4, u4);
+            int16x4x2_t vv = vzip_s16(v4, v4);
+
+            vst1q_u32(out + x, convertP010QuadToRGBA1010102(
+                    vget_low_s16(y8), uu.val[0], vv.val[0],
+                    _y, _b_u, _neg_g_u, _neg_g_v, _r_v));
+            vst1q_u32(out + x + 4, convertP010QuadToRGBA1010102(
+                    vget_high_s16(y8), uu.val[1], vv.val[1],
+                    _y, _b_u, _neg_g_u, _neg_g_v, _r_v));
+        }
+
+        // Process the (even) leftovers 2 pixels at a time.
+        for (; x < src.cropWidth(); x += 2) {
+            signed y1 = (src_y[x] >> 6) - _c16;
+            signed y2 = (src_y[x + 1] >> 6) - _c16;
+            signed u = int(src_uv[x] >> 6) - 512;
+            signed v = int(src_uv[x + 1] >> 6) - 512;
+
+            signed u_b = u * _b_u;
+            signed u_g = u * _neg_g_u;
+            signed v_g = v * _neg_g_v;
+            signed v_r = v * _r_v;
+
+            auto clip10 = [](signed val) -> uint32_t {
+                return (uint32_t)(val < 0 ? 0 : (val > 1023 ? 1023 : val));
+            };
+
+            signed tmp1 = y1 * _y + 128;
+            out[x] = clip10((tmp1 + v_r) / 256)
+                    | (clip10((tmp1 + v_g + u_g) / 256) << 10)
+                    | (clip10((tmp1 + u_b) / 256) << 20)
+                    | (3u << 30);
+
+            if (x + 1 < src.cropWidth()) {
+                signed tmp2 = y2 * _y + 128;
+                out[x + 1] = clip10((tmp2 + v_r) / 256)
+                        | (clip10((tmp2 + v_g + u_g) / 256) << 10)
+                        | (clip10((tmp2 + u_b) / 256) << 20)
+                        | (3u << 30);
+            }
+        }
+
+        src_y += src.mStride / 2;
+
+        if (y & 1) {
+            src_uv += src.mStride / 2;
+        }
+
+        dst_ptr += dst.mStride;
+    }
+
+    return OK;
+}
+
+#endif // USE_NEON_P010
+
 
 #if !USE_NEON_Y410
 
@@ -27,52 +27,11 @@
 
 namespace android {
 
-status_t SaturationFilter::configure(const sp<AMessage> &msg) {
-    status_t err = SimpleFilter::configure(msg);
-    if (err != OK) {
-        return err;
-    }
-
-    if (!msg->findString("cacheDir", &mCacheDir)) {
-        ALOGE("Failed to find cache directory in config message.");
-        return NAME_NOT_FOUND;
-    }
-
-    return OK;
-}
-
 status_t SaturationFilter::start() {
-    // TODO: use a single RS context object for entire application
-    mRS = new RSC::RS();
-
-    if (!mRS->init(mCacheDir.c_str())) {
-        ALOGE("Failed to initialize RenderScript context.");
-        return NO_INIT;
-    }
-
-    // 32-bit elements for ARGB8888
-    RSC::sp<const RSC::Element> e = RSC::Element::U8_4(mRS);
-
-    RSC::Type::Builder tb(mRS, e);
-    tb.setX(mWidth);
-    tb.setY(mHeight);
-    RSC::sp<const RSC::Type> t = tb.create();
-
-    mAllocIn = RSC::Allocation::createTyped(mRS, t);
-    mAllocOut = RSC::Allocation::createTyped(mRS, t);
-
-    mScript = new ScriptC_saturationARGB(mRS);
-
-    mScript->set_gSaturation(mSaturation);
-
     return OK;
 }
 
 void SaturationFilter::reset() {
-    mScript.clear();
-    mAllocOut.clear();
-    mAllocIn.clear();
-    mRS.clear();
 }
 
 status_t SaturationFilter::setParameters(const sp<AMessage> &msg) {
@@ -89,9 +48,33 @@ status_t SaturationFilter::setParameters(const sp<AMessage> &msg) {
 
 status_t SaturationFilter::processBuffers(
         const sp<MediaCodecBuffer> &srcBuffer, const sp<MediaCodecBuffer> &outBuffer) {
-    mAllocIn->copy1DRangeFrom(0, mWidth * mHeight, srcBuffer->data());
-    mScript->forEach_root(mAllocIn, mAllocOut);
-    mAllocOut->copy1DRangeTo(0, mWidth * mHeight, outBuffer->data());
+    const uint8_t *src = srcBuffer->data();
+    uint8_t *dst = outBuffer->data();
+    const size_t pixelCount = (size_t)mWidth * mHeight;
+    const float saturation = mSaturation;
+
+    const auto toByte = [](float value) -> uint8_t {
+        value = value * 255.f + 0.5f;
+        if (value < 0.f) value = 0.f;
+        if (value > 255.f) value = 255.f;
+        return (uint8_t)value;
+    };
+
+    for (size_t i = 0; i < pixelCount; ++i, src += 4, dst += 4) {
+        dst[0] = src[0];    // don't modify A
+
+        // get RGB, scale 0-255 uchar to 0-1.0 float
+        const float r = src[1] * (1.f / 255.f);
+        const float g = src[2] * (1.f / 255.f);
+        const float b = src[3] * (1.f / 255.f);
+
+        // blend between the mono (grey) value and the original color
+        const float mono = r * 0.299f + g * 0.587f + b * 0.114f;
+        dst[1] = toByte(mono + (r - mono) * saturation);
+        dst[2] = toByte(mono + (g - mono) * saturation);
+        dst[3] = toByte(mono + (b - mono) * saturation);
+    }
+    outBuffer->setRange(0, srcBuffer->size());
 
     return OK;
 }
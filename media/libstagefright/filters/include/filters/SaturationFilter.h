@@ -17,9 +17,6 @@
 #ifndef SATURATION_FILTER_H_
 #define SATURATION_FILTER_H_
 
-#include <RenderScript.h>
-
-#include "ScriptC_saturationARGB.h"
 #include "SimpleFilter.h"
 
 namespace android {
@@ -28,7 +25,6 @@ struct SaturationFilter : public SimpleFilter {
 public:
     SaturationFilter() : mSaturation(1.f) {};
 
-    virtual status_t configure(const sp<AMessage> &msg);
     virtual status_t start();
     virtual void reset();
     virtual status_t setParameters(const sp<AMessage> &msg);
@@ -39,11 +35,6 @@ protected:
     virtual ~SaturationFilter() {};
 
 private:
-    AString mCacheDir;
-    RSC::sp<RSC::RS> mRS;
-    RSC::sp<RSC::Allocation> mAllocIn;
-    RSC::sp<RSC::Allocation> mAllocOut;
-    RSC::sp<ScriptC_saturationARGB> mScript;
     float mSaturation;
 };
 
@@ -20,13 +20,66 @@
 #include "ALooper.h"
 #include "AMessage.h"
 
+#include <utils/Mutex.h>
+
 namespace android {
 
+// Small owned buffers are carved out of fixed-size blocks recycled through a
+// freelist, so that high-rate senders (access units, codec config data, ...)
+// do not hit the process allocator for every payload. Larger buffers go
+// straight to malloc as before.
+namespace {
+
+const size_t kPooledBufferCapacity = 4096;
+const size_t kMaxPooledBuffers = 32;
+
+struct FreeBufferBlock {
+    FreeBufferBlock *next;
+};
+
+Mutex gBufferPoolLock;
+FreeBufferBlock *gBufferPool = NULL;
+size_t gBufferPoolSize = 0;
+size_t gBufferPoolReused = 0;
+size_t gBufferPoolFromHeap = 0;
+
+void *acquirePooledData() {
+    {
+        Mutex::Autolock autoLock(gBufferPoolLock);
+        if (gBufferPool != NULL) {
+            FreeBufferBlock *block = gBufferPool;
+            gBufferPool = block->next;
+            --gBufferPoolSize;
+            ++gBufferPoolReused;
+            return block;
+        }
+        ++gBufferPoolFromHeap;
+    }
+    return malloc(kPooledBufferCapacity);
+}
+
+void releasePooledData(void *data) {
+    {
+        Mutex::Autolock autoLock(gBufferPoolLock);
+        if (gBufferPoolSize < kMaxPooledBuffers) {
+            FreeBufferBlock *block = static_cast<FreeBufferBlock *>(data);
+            block->next = gBufferPool;
+            gBufferPool = block;
+            ++gBufferPoolSize;
+            return;
+        }
+    }
+    free(data);
+}
+
+}  // namespace
+
 ABuffer::ABuffer(size_t capacity)
     : mRangeOffset(0),
       mInt32Data(0),
-      mOwnsData(true) {
-    mData = malloc(capacity);
+      mOwnsData(true),
+      mPooled(capacity <= kPooledBufferCapacity) {
+    mData = mPooled ? acquirePooledData() : malloc(capacity);
     if (mData == NULL) {
         mCapacity = 0;
         mRangeLength = 0;
@@ -42,7 +95,8 @@ ABuffer::ABuffer(void *data, size_t capacity)
       mRangeOffset(0),
       mRangeLength(capacity),
       mInt32Data(0),
-      mOwnsData(false) {
+      mOwnsData(false),
+      mPooled(false) {
 }
 
 // static
@@ -56,10 +110,22 @@ sp<ABuffer> ABuffer::CreateAsCopy(const void *data, size_t capacity)
     return res;
 }
 
+// static
+void ABuffer::GetPoolStats(size_t *reused, size_t *fromHeap, size_t *cached) {
+    Mutex::Autolock autoLock(gBufferPoolLock);
+    *reused = gBufferPoolReused;
+    *fromHeap = gBufferPoolFromHeap;
+    *cached = gBufferPoolSize;
+}
+
 ABuffer::~ABuffer() {
     if (mOwnsData) {
         if (mData != NULL) {
-            free(mData);
+            if (mPooled) {
+                releasePooledData(mData);
+            } else {
+                free(mData);
+            }
             mData = NULL;
         }
     }
@@ -166,6 +166,9 @@ status_t ALooper::stop() {
 }
 
 void ALooper::post(const sp<AMessage> &msg, int64_t delayUs) {
+    sp<AHandler> handler = msg->mHandler.promote();
+    Lane lane = (handler != NULL) ? handler->messageLane() : kLaneDefault;
+
     Mutex::Autolock autoLock(mLock);
 
     int64_t whenUs;
@@ -177,20 +180,31 @@ void ALooper::post(const sp<AMessage> &msg, int64_t delayUs) {
         whenUs = GetNowUs();
     }
 
-    List<Event>::iterator it = mEventQueue.begin();
-    while (it != mEventQueue.end() && (*it).mWhenUs <= whenUs) {
-        ++it;
+    // Messages are almost always posted in due-time order, so search for the
+    // insertion point from the back of the queue.
+    List<Event> &queue = mEventQueues[lane];
+    List<Event>::iterator it = queue.end();
+    while (it != queue.begin()) {
+        List<Event>::iterator prev = it;
+        --prev;
+        if ((*prev).mWhenUs <= whenUs) {
+            break;
+        }
+        it = prev;
     }
 
     Event event;
     event.mWhenUs = whenUs;
     event.mMessage = msg;
 
-    if (it == mEventQueue.begin()) {
+    queue.insert(it, event);
+
+    // Only wake the looper thread if this message moves its wakeup earlier;
+    // a post behind a message it is already waiting for changes nothing.
+    if (mWaitingUntilUs >= 0 && whenUs < mWaitingUntilUs) {
+        mWaitingUntilUs = whenUs;
         mQueueChangedCondition.signal();
     }
-
-    mEventQueue.insert(it, event);
 }
 
 bool ALooper::loop() {
@@ -201,25 +215,56 @@ bool ALooper::loop() {
         if (mThread == NULL && !mRunningLocally) {
             return false;
         }
-        if (mEventQueue.empty()) {
-            mQueueChangedCondition.wait(mLock);
-            return true;
-        }
-        int64_t whenUs = (*mEventQueue.begin()).mWhenUs;
+
+        // Pick the highest-priority lane with a due message; lanes are
+        // scanned in priority order, so a due realtime message preempts
+        // older due messages in lower lanes.
         int64_t nowUs = GetNowUs();
+        int64_t earliestWhenUs = INT64_MAX;
+        int32_t laneIx = -1;
+        for (int32_t i = 0; i < kNumLanes; ++i) {
+            if (mEventQueues[i].empty()) {
+                continue;
+            }
+            int64_t whenUs = (*mEventQueues[i].begin()).mWhenUs;
+            if (whenUs <= nowUs) {
+                laneIx = i;
+                break;
+            }
+            if (whenUs < earliestWhenUs) {
+                earliestWhenUs = whenUs;
+            }
+        }
 
-        if (whenUs > nowUs) {
-            int64_t delayUs = whenUs - nowUs;
+        if (laneIx < 0) {
+            if (earliestWhenUs == INT64_MAX) {
+                mWaitingUntilUs = INT64_MAX;
+                mQueueChangedCondition.wait(mLock);
+                mWaitingUntilUs = -1;
+                return true;
+            }
+            int64_t delayUs = earliestWhenUs - nowUs;
             if (delayUs > INT64_MAX / 1000) {
                 delayUs = INT64_MAX / 1000;
             }
+            mWaitingUntilUs = earliestWhenUs;
             mQueueChangedCondition.waitRelative(mLock, delayUs * 1000ll);
+            mWaitingUntilUs = -1;
 
             return true;
         }
 
-        event = *mEventQueue.begin();
-        mEventQueue.erase(mEventQueue.begin());
+        event = *mEventQueues[laneIx].begin();
+        mEventQueues[laneIx].erase(mEventQueues[laneIx].begin());
+
+        int64_t lagUs = nowUs - event.mWhenUs;
+        LaneStats &stats = mLaneStats[laneIx];
+        ++stats.mCount;
+        if (lagUs > stats.mMaxLagUs) {
+            stats.mMaxLagUs = lagUs;
+        }
+        ++stats.mBuckets[
+                lagUs < 1000 ? 0 : lagUs < 10000 ? 1 : lagUs < 100000 ? 2 : 3];
     }
 
     event.mMessage->deliver();
@@ -232,6 +277,30 @@ bool ALooper::loop() {
     return true;
 }
 
+void ALooper::appendLaneStats(AString *s) {
+    static const char *kLaneNames[kNumLanes] = {
+        "realtime", "default", "background"
+    };
+
+    Mutex::Autolock autoLock(mLock);
+    for (int32_t i = 0; i < kNumLanes; ++i) {
+        const LaneStats &stats = mLaneStats[i];
+        if (i > 0) {
+            s->append("; ");
+        }
+        s->append(AStringPrintf(
+                "%s: %llu (<1ms %llu, <10ms %llu, <100ms %llu, rest %llu, "
+                "max %lldus)",
+                kLaneNames[i],
+                (unsigned long long)stats.mCount,
+                (unsigned long long)stats.mBuckets[0],
+                (unsigned long long)stats.mBuckets[1],
+                (unsigned long long)stats.mBuckets[2],
+                (unsigned long long)stats.mBuckets[3],
+                (long long)stats.mMaxLagUs));
+    }
+}
+
 // to be called by AMessage::postAndAwaitResponse only
 sp<AReplyToken> ALooper::createReplyToken() {
     return new AReplyToken(this);
@@ -23,6 +23,7 @@
 
 #include "ALooperRoster.h"
 
+#include "ABuffer.h"
 #include "ADebug.h"
 #include "AHandler.h"
 #include "AMessage.h"
@@ -135,11 +136,22 @@ void ALooperRoster::dump(int fd, const Vector<String16>& args) {
     size_t n = mHandlers.size();
     s.appendFormat(" %zu registered handlers:\n", n);
 
+    Vector<sp<ALooper> > loopers;
     for (size_t i = 0; i < n; i++) {
         s.appendFormat("  %d: ", mHandlers.keyAt(i));
         HandlerInfo &info = mHandlers.editValueAt(i);
         sp<ALooper> looper = info.mLooper.promote();
         if (looper != NULL) {
+            bool seen = false;
+            for (size_t j = 0; j < loopers.size(); j++) {
+                if (loopers[j] == looper) {
+                    seen = true;
+                    break;
+                }
+            }
+            if (!seen) {
+                loopers.add(looper);
+            }
             s.append(looper->getName());
             sp<AHandler> handler = info.mHandler.promote();
             if (handler != NULL) {
@@ -168,6 +180,22 @@ void ALooperRoster::dump(int fd, const Vector<String16>& args) {
         }
         s.append("\n");
     }
+
+    s.append(" looper dispatch lanes:\n");
+    for (size_t i = 0; i < loopers.size(); i++) {
+        AString laneStats;
+        loopers[i]->appendLaneStats(&laneStats);
+        s.appendFormat("  %s: %s\n", loopers[i]->getName(), laneStats.c_str());
+    }
+
+    size_t reused, fromHeap, cached;
+    AMessage::GetPoolStats(&reused, &fromHeap, &cached);
+    s.appendFormat(" message pool: %zu reused, %zu from heap, %zu cached\n",
+            reused, fromHeap, cached);
+    ABuffer::GetPoolStats(&reused, &fromHeap, &cached);
+    s.appendFormat(" small buffer pool: %zu reused, %zu from heap, %zu cached\n",
+            reused, fromHeap, cached);
+
     (void)write(fd, s.string(), s.size());
 }
 
@@ -33,6 +33,8 @@
 
 #include <media/stagefright/foundation/hexdump.h>
 
+#include <utils/Mutex.h>
+
 #if defined(__ANDROID__) && !defined(__ANDROID_VNDK__) && !defined(__ANDROID_APEX__)
 #include <binder/Parcel.h>
 #endif
@@ -41,6 +43,70 @@ namespace android {
 
 extern ALooperRoster gLooperRoster;
 
+// Looper-based code allocates and frees messages at a very high rate during
+// playback, enough for malloc to show up in mediaserver profiles. Since
+// AMessage blocks are all the same size they are recycled through a simple
+// freelist instead of going back to the process allocator. The freelist is
+// process-wide rather than per-looper because messages routinely travel
+// between loopers and may outlive the looper that delivered them.
+namespace {
+
+struct FreeMessageBlock {
+    FreeMessageBlock *next;
+};
+
+Mutex gMessagePoolLock;
+FreeMessageBlock *gMessagePool = NULL;
+size_t gMessagePoolSize = 0;
+size_t gMessagePoolReused = 0;
+size_t gMessagePoolFromHeap = 0;
+
+// bound on the number of cached blocks; beyond this freed messages simply go
+// back to the allocator.
+const size_t kMaxPooledMessages = 256;
+
+}  // namespace
+
+void *AMessage::operator new(size_t size) {
+    if (size == sizeof(AMessage)) {
+        Mutex::Autolock autoLock(gMessagePoolLock);
+        if (gMessagePool != NULL) {
+            FreeMessageBlock *block = gMessagePool;
+            gMessagePool = block->next;
+            --gMessagePoolSize;
+            ++gMessagePoolReused;
+            return block;
+        }
+        ++gMessagePoolFromHeap;
+    }
+    return ::operator new(size);
+}
+
+void AMessage::operator delete(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return;
+    }
+    if (size == sizeof(AMessage)) {
+        Mutex::Autolock autoLock(gMessagePoolLock);
+        if (gMessagePoolSize < kMaxPooledMessages) {
+            FreeMessageBlock *block = static_cast<FreeMessageBlock *>(ptr);
+            block->next = gMessagePool;
+            gMessagePool = block;
+            ++gMessagePoolSize;
+            return;
+        }
+    }
+    ::operator delete(ptr);
+}
+
+// static
+void AMessage::GetPoolStats(size_t *reused, size_t *fromHeap, size_t *cached) {
+    Mutex::Autolock autoLock(gMessagePoolLock);
+    *reused = gMessagePoolReused;
+    *fromHeap = gMessagePoolFromHeap;
+    *cached = gMessagePoolSize;
+}
+
 status_t AReplyToken::setReply(const sp<AMessage> &reply) {
     if (mReplied) {
         ALOGE("trying to post a duplicate reply");
@@ -150,13 +216,25 @@ static void reportStats() {
 }
 #endif
 
+// FNV-1a over the item name. Lookups compare hashes before bytes, so
+// same-length keys sharing a prefix (color-range vs color-standard, the
+// common shape of format keys) are rejected without a memcmp.
+static uint32_t hashName(const char *name, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
 inline size_t AMessage::findItemIndex(const char *name, size_t len) const {
 #ifdef DUMP_STATS
     size_t memchecks = 0;
 #endif
+    const uint32_t hash = hashName(name, len);
     size_t i = 0;
     for (; i < mItems.size(); i++) {
-        if (len != mItems[i].mNameLength) {
+        if (len != mItems[i].mNameLength || hash != mItems[i].mNameHash) {
             continue;
         }
 #ifdef DUMP_STATS
@@ -182,6 +260,7 @@ inline size_t AMessage::findItemIndex(const char *name, size_t len) const {
 // assumes item's name was uninitialized or NULL
 void AMessage::Item::setName(const char *name, size_t len) {
     mNameLength = len;
+    mNameHash = hashName(name, len);
     mName = new char[len + 1];
     memcpy((void*)mName, name, len + 1);
 }
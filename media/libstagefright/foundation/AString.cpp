@@ -33,57 +33,59 @@
 
 namespace android {
 
-// static
-constexpr const char *AString::kEmptyString;
-
 AString::AString()
-    : mData((char *)kEmptyString),
+    : mData(mInlineData),
       mSize(0),
-      mAllocSize(1) {
+      mAllocSize(kInlineCapacity) {
+    mInlineData[0] = '\0';
 }
 
 AString::AString(const char *s)
-    : mData(NULL),
-      mSize(0),
-      mAllocSize(1) {
+    : AString() {
     if (!s) {
         ALOGW("ctor got NULL, using empty string instead");
-        clear();
     } else {
         setTo(s);
     }
 }
 
 AString::AString(const char *s, size_t size)
-    : mData(NULL),
-      mSize(0),
-      mAllocSize(1) {
+    : AString() {
     if (!s) {
         ALOGW("ctor got NULL, using empty string instead");
-        clear();
     } else {
         setTo(s, size);
     }
 }
 
 AString::AString(const String8 &from)
-    : mData(NULL),
-      mSize(0),
-      mAllocSize(1) {
+    : AString() {
     setTo(from.string(), from.length());
 }
 
 AString::AString(const AString &from)
-    : mData(NULL),
-      mSize(0),
-      mAllocSize(1) {
+    : AString() {
     setTo(from, 0, from.size());
 }
 
+AString::AString(AString &&from) noexcept
+    : mSize(from.mSize),
+      mAllocSize(from.mAllocSize) {
+    if (from.isInline()) {
+        mData = mInlineData;
+        memcpy(mInlineData, from.mInlineData, from.mSize + 1);
+    } else {
+        // steal the heap allocation
+        mData = from.mData;
+        from.mAllocSize = kInlineCapacity;
+    }
+    from.mData = from.mInlineData;
+    from.mSize = 0;
+    from.mInlineData[0] = '\0';
+}
+
 AString::AString(const AString &from, size_t offset, size_t n)
-    : mData(NULL),
-      mSize(0),
-      mAllocSize(1) {
+    : AString() {
     setTo(from, offset, n);
 }
 
@@ -99,6 +101,25 @@ AString &AString::operator=(const AString &from) {
     return *this;
 }
 
+AString &AString::operator=(AString &&from) noexcept {
+    if (&from != this) {
+        clear();
+        if (from.isInline()) {
+            memcpy(mInlineData, from.mInlineData, from.mSize + 1);
+        } else {
+            mData = from.mData;
+            mAllocSize = from.mAllocSize;
+            from.mData = from.mInlineData;
+            from.mAllocSize = kInlineCapacity;
+        }
+        mSize = from.mSize;
+        from.mSize = 0;
+        from.mInlineData[0] = '\0';
+    }
+
+    return *this;
+}
+
 size_t AString::size() const {
     return mSize;
 }
@@ -128,12 +149,13 @@ void AString::setTo(const AString &from, size_t offset, size_t n) {
 }
 
 void AString::clear() {
-    if (mData != kEmptyString) {
+    if (!isInline()) {
         free(mData);
-        mData = (char *)kEmptyString;
+        mData = mInlineData;
     }
     mSize = 0;
-    mAllocSize = 1;
+    mAllocSize = kInlineCapacity;
+    mData[0] = '\0';
 }
 
 size_t AString::hash() const {
@@ -150,8 +172,6 @@ bool AString::operator==(const AString &other) const {
 }
 
 void AString::trim() {
-    makeMutable();
-
     size_t i = 0;
     while (i < mSize && isspace(mData[i])) {
         ++i;
@@ -171,16 +191,21 @@ void AString::erase(size_t start, size_t n) {
     CHECK_LT(start, mSize);
     CHECK_LE(start + n, mSize);
 
-    makeMutable();
-
     memmove(&mData[start], &mData[start + n], mSize - start - n);
     mSize -= n;
     mData[mSize] = '\0';
 }
 
-void AString::makeMutable() {
-    if (mData == kEmptyString) {
-        mData = strdup(kEmptyString);
+void AString::grow(size_t extra) {
+    mAllocSize = (mAllocSize + extra + 31) & -32;
+    if (isInline()) {
+        char *data = (char *)malloc(mAllocSize);
+        CHECK(data != NULL);
+        memcpy(data, mInlineData, mSize + 1);
+        mData = data;
+    } else {
+        mData = (char *)realloc(mData, mAllocSize);
+        CHECK(mData != NULL);
     }
 }
 
@@ -189,12 +214,8 @@ void AString::append(const char *s) {
 }
 
 void AString::append(const char *s, size_t size) {
-    makeMutable();
-
     if (mSize + size + 1 > mAllocSize) {
-        mAllocSize = (mAllocSize + size + 31) & -32;
-        mData = (char *)realloc(mData, mAllocSize);
-        CHECK(mData != NULL);
+        grow(size);
     }
 
     memcpy(&mData[mSize], s, size);
@@ -293,12 +314,8 @@ void AString::insert(const char *from, size_t size, size_t insertionPos) {
     CHECK_GE(insertionPos, 0u);
     CHECK_LE(insertionPos, mSize);
 
-    makeMutable();
-
     if (mSize + size + 1 > mAllocSize) {
-        mAllocSize = (mAllocSize + size + 31) & -32;
-        mData = (char *)realloc(mData, mAllocSize);
-        CHECK(mData != NULL);
+        grow(size);
     }
 
     memmove(&mData[insertionPos + size],
@@ -330,8 +347,6 @@ bool AString::equalsIgnoreCase(const AString &other) const {
 }
 
 void AString::tolower() {
-    makeMutable();
-
     for (size_t i = 0; i < mSize; ++i) {
         mData[i] = ::tolower(mData[i]);
     }
@@ -386,10 +401,28 @@ AString AStringPrintf(const char *format, ...) {
     va_list ap;
     va_start(ap, format);
 
+    // Format into a stack buffer first; the common short results then avoid
+    // the heap entirely (and fit AString's inline storage).
+    char stackBuffer[128];
+    va_list ap2;
+    va_copy(ap2, ap);
+    int len = vsnprintf(stackBuffer, sizeof(stackBuffer), format, ap);
+    va_end(ap);
+
+    if (len < 0) {
+        va_end(ap2);
+        return AString();
+    }
+
+    if ((size_t)len < sizeof(stackBuffer)) {
+        va_end(ap2);
+        return AString(stackBuffer, len);
+    }
+
     char *buffer;
-    int bufferSize = vasprintf(&buffer, format, ap);
+    int bufferSize = vasprintf(&buffer, format, ap2);
 
-    va_end(ap);
+    va_end(ap2);
 
     if(bufferSize < 0) {
         return AString();
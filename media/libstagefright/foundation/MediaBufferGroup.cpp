@@ -17,6 +17,7 @@
 #define LOG_TAG "MediaBufferGroup"
 #include <utils/Log.h>
 
+#include <atomic>
 #include <list>
 
 #include <binder/MemoryDealer.h>
@@ -39,6 +40,11 @@ static const size_t kSharedMemoryThreshold = MIN(
 struct MediaBufferGroup::InternalData {
     Mutex mLock;
     Condition mCondition;
+    // Number of acquirers blocked waiting for a buffer to be returned.
+    // Read without mLock in signalBufferReturned() so the producer/consumer
+    // hot path of returning a buffer does not contend on the group lock
+    // unless someone is actually waiting. Modified under mLock.
+    std::atomic<uint32_t> mWaiters{0};
     size_t mGrowthLimit;  // Do not automatically grow group larger than this.
     std::list<MediaBufferBase *> mBuffers;
 };
@@ -164,6 +170,7 @@ bool MediaBufferGroup::has_buffers() {
 status_t MediaBufferGroup::acquire_buffer(
         MediaBufferBase **out, bool nonBlocking, size_t requestedSize) {
     Mutex::Autolock autoLock(mInternal->mLock);
+    bool registeredAsWaiter = false;
     for (;;) {
         size_t smallest = requestedSize;
         size_t biggest = requestedSize;
@@ -212,6 +219,9 @@ status_t MediaBufferGroup::acquire_buffer(
             }
         }
         if (buffer != nullptr) {
+            if (registeredAsWaiter) {
+                mInternal->mWaiters.fetch_sub(1, std::memory_order_seq_cst);
+            }
             buffer->add_ref();
             buffer->reset();
             *out = buffer;
@@ -221,7 +231,14 @@ status_t MediaBufferGroup::acquire_buffer(
             *out = nullptr;
             return WOULD_BLOCK;
         }
-        // All buffers are in use, block until one of them is returned.
+        // All buffers are in use. Register as a waiter and rescan once before
+        // actually waiting, so a buffer returned while we were scanning cannot
+        // slip past the unlocked waiter check in signalBufferReturned().
+        if (!registeredAsWaiter) {
+            registeredAsWaiter = true;
+            mInternal->mWaiters.fetch_add(1, std::memory_order_seq_cst);
+            continue;
+        }
         mInternal->mCondition.wait(mInternal->mLock);
     }
     // Never gets here.
@@ -232,6 +249,13 @@ size_t MediaBufferGroup::buffers() const {
 }
 
 void MediaBufferGroup::signalBufferReturned(MediaBufferBase *) {
+    // Order the buffer's refcount reaching zero before the waiter check:
+    // either a registering acquirer's rescan sees the buffer free, or this
+    // load sees the acquirer registered and takes the slow path.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mInternal->mWaiters.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
     Mutex::Autolock autoLock(mInternal->mLock);
     mInternal->mCondition.signal();
 }
@@ -40,6 +40,12 @@ static void appendIndent(AString *s, int32_t indent) {
 }
 
 void hexdump(const void *_data, size_t size, size_t indent, AString *appendTo) {
+    if (appendTo == NULL && !ADEBUG_IS_LOGGABLE(ANDROID_LOG_INFO)) {
+        // the log sink is filtered out (log.tag.hexdump raised above INFO);
+        // don't bother formatting the dump
+        return;
+    }
+
     const uint8_t *data = (const uint8_t *)_data;
 
     size_t offset = 0;
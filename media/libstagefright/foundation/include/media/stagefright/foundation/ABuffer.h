@@ -43,6 +43,10 @@ struct ABuffer : public RefBase {
     // create buffer from dup of some memory block
     static sp<ABuffer> CreateAsCopy(const void *data, size_t capacity);
 
+    // Retrieves statistics for the process-wide small-buffer freelist;
+    // reported in ALooperRoster::dump().
+    static void GetPoolStats(size_t *reused, size_t *fromHeap, size_t *cached);
+
     void setInt32Data(int32_t data) { mInt32Data = data; }
     int32_t int32Data() const { return mInt32Data; }
 
@@ -62,6 +66,7 @@ private:
     int32_t mInt32Data;
 
     bool mOwnsData;
+    bool mPooled;
 
     DISALLOW_EVIL_CONSTRUCTORS(ABuffer);
 };
@@ -94,6 +94,34 @@ inline static const char *asString(status_t i, const char *def = "??") {
             __FILE__ ":" LITERAL_TO_STRING(__LINE__)            \
                 " Should not be here. " __VA_ARGS__);
 
+// True when LOG_TAG would actually log at |priority|. This honors the
+// per-tag runtime toggle (the log.tag.<LOG_TAG> property), with VERBOSE
+// and DEBUG off by default. Use it to guard debug state that is expensive
+// to build when the message would only be discarded:
+//
+//     if (ADEBUG_IS_LOGGABLE(ANDROID_LOG_VERBOSE)) {
+//         ALOGV("format is %s", format->debugString().c_str());
+//     }
+#define ADEBUG_IS_LOGGABLE(priority) \
+    CC_UNLIKELY(__android_log_is_loggable((priority), LOG_TAG, ANDROID_LOG_INFO))
+
+// ALOGV/ALOGD that evaluate their argument expressions only when the tag
+// is loggable; the plain macros format their arguments even when the
+// message is then filtered out.
+#define ALOGV_LAZY(...)                                          \
+    do {                                                         \
+        if (ADEBUG_IS_LOGGABLE(ANDROID_LOG_VERBOSE)) {           \
+            ALOGV(__VA_ARGS__);                                  \
+        }                                                        \
+    } while (false)
+
+#define ALOGD_LAZY(...)                                          \
+    do {                                                         \
+        if (ADEBUG_IS_LOGGABLE(ANDROID_LOG_DEBUG)) {             \
+            ALOGD(__VA_ARGS__);                                  \
+        }                                                        \
+    } while (false)
+
 #ifdef NDEBUG
 #define CHECK_DBG CHECK
 #define CHECK_EQ_DBG CHECK_EQ
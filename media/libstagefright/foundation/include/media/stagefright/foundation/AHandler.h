@@ -29,6 +29,7 @@ struct AMessage;
 struct AHandler : public RefBase {
     AHandler()
         : mID(0),
+          mLane(ALooper::kLaneDefault),
           mVerboseStats(false),
           mMessageCounter(0) {
     }
@@ -50,6 +51,16 @@ struct AHandler : public RefBase {
         return const_cast<AHandler *>(this);
     }
 
+    // Selects the priority lane this handler's messages are dispatched on;
+    // takes effect for subsequently posted messages. See ALooper::Lane.
+    void setMessageLane(ALooper::Lane lane) {
+        mLane = lane;
+    }
+
+    ALooper::Lane messageLane() const {
+        return mLane;
+    }
+
 protected:
     virtual void onMessageReceived(const sp<AMessage> &msg) = 0;
 
@@ -58,6 +69,7 @@ private:
     friend struct ALooperRoster; // setID()
 
     ALooper::handler_id mID;
+    ALooper::Lane mLane;
     wp<ALooper> mLooper;
 
     inline void setID(ALooper::handler_id id, const wp<ALooper> &looper) {
@@ -36,6 +36,18 @@ struct ALooper : public RefBase {
     typedef int32_t event_id;
     typedef int32_t handler_id;
 
+    // Priority lanes for message dispatch. A due message in a higher-priority
+    // lane is delivered ahead of due messages in lower lanes regardless of
+    // their timestamps; within a lane delivery order is unchanged, so
+    // messages to one handler are never reordered. Handlers select their
+    // lane with AHandler::setMessageLane().
+    enum Lane {
+        kLaneRealtime = 0,
+        kLaneDefault = 1,
+        kLaneBackground = 2,
+        kNumLanes = 3,
+    };
+
     ALooper();
 
     // Takes effect in a subsequent call to start().
@@ -58,6 +70,10 @@ struct ALooper : public RefBase {
         return mName.c_str();
     }
 
+    // Appends per-lane dispatch-latency statistics to |s|; used by
+    // ALooperRoster::dump().
+    void appendLaneStats(AString *s);
+
 protected:
     virtual ~ALooper();
 
@@ -69,12 +85,28 @@ private:
         sp<AMessage> mMessage;
     };
 
+    // Histogram of how late messages were delivered relative to their due
+    // time, per lane: <1ms, <10ms, <100ms and the rest.
+    struct LaneStats {
+        LaneStats() : mCount(0), mMaxLagUs(0), mBuckets{} {}
+        uint64_t mCount;
+        int64_t mMaxLagUs;
+        uint64_t mBuckets[4];
+    };
+
     Mutex mLock;
     Condition mQueueChangedCondition;
 
     AString mName;
 
-    List<Event> mEventQueue;
+    List<Event> mEventQueues[kNumLanes];
+    LaneStats mLaneStats[kNumLanes];
+
+    // Deadline the looper thread is currently sleeping towards, INT64_MAX if
+    // sleeping indefinitely, or -1 if it is not blocked in loop(). Lets post()
+    // skip the condition signal unless the new message actually moves the
+    // wakeup earlier.
+    int64_t mWaitingUntilUs = -1;
 
     struct LooperThread;
     sp<LooperThread> mThread;
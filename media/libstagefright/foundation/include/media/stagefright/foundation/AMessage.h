@@ -65,6 +65,14 @@ struct AMessage : public RefBase {
     AMessage();
     AMessage(uint32_t what, const sp<const AHandler> &handler);
 
+    // AMessage objects are recycled through a process-wide freelist to keep
+    // high-rate message churn off the process allocator during playback.
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
+    // Retrieves freelist statistics; reported in ALooperRoster::dump().
+    static void GetPoolStats(size_t *reused, size_t *fromHeap, size_t *cached);
+
 #if !defined(__ANDROID_VNDK__) && !defined(__ANDROID_APEX__)
     // Construct an AMessage from a parcel.
     // nestingAllowed determines how many levels AMessage can be nested inside
@@ -303,9 +311,12 @@ private:
         } u;
         const char *mName;
         size_t      mNameLength;
+        // hash of mName, compared before the bytes to cheaply reject
+        // same-length keys during lookup
+        uint32_t    mNameHash;
         Type mType;
         void setName(const char *name, size_t len);
-        Item() : mName(nullptr), mNameLength(0), mType(kTypeInt32) { }
+        Item() : mName(nullptr), mNameLength(0), mNameHash(0), mType(kTypeInt32) { }
         Item(const char *name, size_t length);
     };
 
@@ -32,10 +32,12 @@ struct AString {
     AString(const char *s, size_t size);
     AString(const String8 &from);  // NOLINT, implicit conversion
     AString(const AString &from);
+    AString(AString &&from) noexcept;
     AString(const AString &from, size_t offset, size_t n);
     ~AString();
 
     AString &operator=(const AString &from);
+    AString &operator=(AString &&from) noexcept;
     void setTo(const char *s);
     void setTo(const char *s, size_t size);
     void setTo(const AString &from, size_t offset, size_t n);
@@ -95,13 +97,18 @@ struct AString {
 #endif
 
 private:
-    constexpr static const char *kEmptyString = "";
+    // Strings shorter than this (including the '\0' terminator) live in
+    // mInlineData and never touch the heap. Most strings in the framework
+    // (message keys, MIME types, state names) fit.
+    constexpr static size_t kInlineCapacity = 24;
 
-    char *mData;
+    char *mData;       // points at mInlineData or a heap allocation
     size_t mSize;
     size_t mAllocSize;
+    char mInlineData[kInlineCapacity];
 
-    void makeMutable();
+    bool isInline() const { return mData == mInlineData; }
+    void grow(size_t extra);
 };
 
 AString AStringPrintf(const char *format, ...);
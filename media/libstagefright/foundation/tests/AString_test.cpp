@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <utils/Log.h>
+
+#include "gtest/gtest.h"
+
+#include <media/stagefright/foundation/ADebug.h>
+#include <media/stagefright/foundation/AString.h>
+
+#include <utility>
+
+namespace android {
+
+class AStringTest : public ::testing::Test {
+};
+
+// strings short enough for the inline storage and long enough to force a
+// heap allocation
+static const char kShort[] = "video/avc";
+static const char kLong[] =
+        "a considerably longer string that cannot fit in the inline storage";
+
+TEST_F(AStringTest, Basic) {
+    AString s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(0u, s.size());
+    EXPECT_STREQ("", s.c_str());
+
+    s.setTo(kShort);
+    EXPECT_EQ(strlen(kShort), s.size());
+    EXPECT_STREQ(kShort, s.c_str());
+
+    s.setTo(kLong);
+    EXPECT_EQ(strlen(kLong), s.size());
+    EXPECT_STREQ(kLong, s.c_str());
+
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_STREQ("", s.c_str());
+}
+
+TEST_F(AStringTest, Copy) {
+    AString shortStr(kShort);
+    AString longStr(kLong);
+
+    AString copyShort(shortStr);
+    AString copyLong(longStr);
+    EXPECT_EQ(shortStr, copyShort);
+    EXPECT_EQ(longStr, copyLong);
+
+    // copies must not share storage
+    copyShort.append('x');
+    copyLong.append('x');
+    EXPECT_STREQ(kShort, shortStr.c_str());
+    EXPECT_STREQ(kLong, longStr.c_str());
+}
+
+TEST_F(AStringTest, Move) {
+    AString shortStr(kShort);
+    AString movedShort(std::move(shortStr));
+    EXPECT_STREQ(kShort, movedShort.c_str());
+    EXPECT_TRUE(shortStr.empty());
+    EXPECT_STREQ("", shortStr.c_str());
+
+    AString longStr(kLong);
+    const char *heapData = longStr.c_str();
+    AString movedLong(std::move(longStr));
+    EXPECT_STREQ(kLong, movedLong.c_str());
+    // a heap-backed string is stolen, not copied
+    EXPECT_EQ(heapData, movedLong.c_str());
+    EXPECT_TRUE(longStr.empty());
+    EXPECT_STREQ("", longStr.c_str());
+
+    AString assigned(kShort);
+    assigned = std::move(movedLong);
+    EXPECT_STREQ(kLong, assigned.c_str());
+    EXPECT_TRUE(movedLong.empty());
+
+    // a moved-from string must remain usable
+    movedLong.append(kShort);
+    EXPECT_STREQ(kShort, movedLong.c_str());
+}
+
+TEST_F(AStringTest, GrowAcrossInlineBoundary) {
+    AString s;
+    AString expected;
+    for (size_t i = 0; i < 100; ++i) {
+        s.append('a' + (i % 26));
+        expected.append('a' + (i % 26));
+        ASSERT_EQ(i + 1, s.size());
+    }
+    EXPECT_EQ(expected, s);
+    EXPECT_STREQ(expected.c_str(), s.c_str());
+}
+
+TEST_F(AStringTest, EraseTrimInsert) {
+    AString s("  hello, world  ");
+    s.trim();
+    EXPECT_STREQ("hello, world", s.c_str());
+
+    s.erase(5, 7);
+    EXPECT_STREQ("hello", s.c_str());
+
+    s.insert(AString(kLong), 5);
+    AString expected("hello");
+    expected.append(kLong);
+    EXPECT_EQ(expected, s);
+}
+
+TEST_F(AStringTest, Printf) {
+    AString s = AStringPrintf("%s:%d", kShort, 42);
+    EXPECT_STREQ("video/avc:42", s.c_str());
+
+    // result larger than the internal stack formatting buffer
+    AString big = AStringPrintf("%s|%s|%s", kLong, kLong, kLong);
+    AString expected(kLong);
+    expected.append('|');
+    expected.append(kLong);
+    expected.append('|');
+    expected.append(kLong);
+    EXPECT_EQ(expected, big);
+}
+
+}  // namespace android
@@ -144,12 +144,19 @@ ssize_t HTTPDownloader::fetchBlock(
         range_length = buffer->size() + block_size;
     }
     for (;;) {
-        // Only resize when we don't know the size.
+        // Only resize when we don't know the size, or when the caller seeded
+        // a buffer smaller than the known size (the seed is just an estimate).
         size_t bufferRemaining = buffer->capacity() - buffer->size();
-        if (bufferRemaining == 0 && getSizeErr != OK) {
-            size_t bufferIncrement = buffer->size() / 2;
-            if (bufferIncrement < 32768) {
-                bufferIncrement = 32768;
+        if (bufferRemaining == 0
+                && (getSizeErr != OK || buffer->capacity() < (size_t)size)) {
+            size_t bufferIncrement;
+            if (getSizeErr != OK) {
+                bufferIncrement = buffer->size() / 2;
+                if (bufferIncrement < 32768) {
+                    bufferIncrement = 32768;
+                }
+            } else {
+                bufferIncrement = size - buffer->size();
             }
             bufferRemaining = bufferIncrement;
 
@@ -228,7 +235,8 @@ ssize_t HTTPDownloader::fetchFile(
 }
 
 sp<M3UParser> HTTPDownloader::fetchPlaylist(
-        const char *url, uint8_t *curPlaylistHash, bool *unchanged) {
+        const char *url, uint8_t *curPlaylistHash, bool *unchanged,
+        const sp<M3UParser> &previous) {
     ALOGV("fetchPlaylist '%s'", url);
 
     *unchanged = false;
@@ -264,8 +272,8 @@ sp<M3UParser> HTTPDownloader::fetchPlaylist(
     }
 #endif
 
-    sp<M3UParser> playlist =
-        new M3UParser(actualUrl.string(), buffer->data(), buffer->size());
+    sp<M3UParser> playlist = new M3UParser(
+            actualUrl.string(), buffer->data(), buffer->size(), previous);
 
     if (playlist->initCheck() != OK) {
         ALOGE("failed to parse .m3u8 playlist");
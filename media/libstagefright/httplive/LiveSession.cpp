@@ -492,9 +492,36 @@ status_t LiveSession::getStreamFormatMeta(StreamType stream, sp<MetaData> *meta)
 }
 
 sp<HTTPDownloader> LiveSession::getHTTPDownloader() {
+    {
+        Mutex::Autolock autoLock(mIdleDownloadersLock);
+        if (!mIdleDownloaders.isEmpty()) {
+            sp<HTTPDownloader> downloader =
+                mIdleDownloaders.top();
+            mIdleDownloaders.pop();
+            downloader->reconnect();
+            return downloader;
+        }
+    }
     return new HTTPDownloader(mHTTPService, mExtraHeaders);
 }
 
+void LiveSession::releaseHTTPDownloader(const sp<HTTPDownloader> &downloader) {
+    if (downloader == NULL) {
+        return;
+    }
+    downloader->disconnect();
+
+    // Fetchers are torn down and recreated on seeks, bandwidth switches
+    // and track changes; keeping a few downloaders around lets their
+    // replacements skip the round trip to the client's http service.
+    static const size_t kMaxIdleDownloaders = 4;
+
+    Mutex::Autolock autoLock(mIdleDownloadersLock);
+    if (mIdleDownloaders.size() < kMaxIdleDownloaders) {
+        mIdleDownloaders.push(downloader);
+    }
+}
+
 void LiveSession::setBufferingSettings(
         const BufferingSettings &buffering) {
     sp<AMessage> msg = new AMessage(kWhatSetBufferingSettings, this);
@@ -81,6 +81,7 @@ struct LiveSession : public AHandler {
     status_t getStreamFormatMeta(StreamType stream, sp<MetaData> *meta);
 
     sp<HTTPDownloader> getHTTPDownloader();
+    void releaseHTTPDownloader(const sp<HTTPDownloader> &downloader);
 
     void connectAsync(
             const char *url,
@@ -196,6 +197,11 @@ private:
 
     KeyedVector<String8, String8> mExtraHeaders;
 
+    // Downloaders handed back by torn-down fetchers, reused by the next
+    // fetcher instead of making a fresh connection to the http service.
+    Mutex mIdleDownloadersLock;
+    Vector<sp<HTTPDownloader> > mIdleDownloaders;
+
     AString mMasterURL;
 
     Vector<BandwidthItem> mBandwidthItems;
@@ -250,7 +250,8 @@ bool M3UParser::MediaGroup::getActiveURI(AString *uri, const char *baseURL) cons
 ////////////////////////////////////////////////////////////////////////////////
 
 M3UParser::M3UParser(
-        const char *baseURI, const void *data, size_t size)
+        const char *baseURI, const void *data, size_t size,
+        const sp<M3UParser> &previous)
     : mInitCheck(NO_INIT),
       mBaseURI(baseURI),
       mIsExtM3U(false),
@@ -262,8 +263,10 @@ M3UParser::M3UParser(
       mTargetDurationUs(-1LL),
       mDiscontinuitySeq(0),
       mDiscontinuityCount(0),
-      mSelectedIndex(-1) {
-    mInitCheck = parse(data, size);
+      mSelectedIndex(-1),
+      mParseLineNo(0),
+      mParseSegmentRangeOffset(0) {
+    mInitCheck = parse(data, size, previous);
 }
 
 M3UParser::~M3UParser() {
@@ -566,7 +569,8 @@ AString M3UParser::MediaGroup::Media::makeURL(const char *baseURL) const {
     return out;
 }
 
-status_t M3UParser::parse(const void *_data, size_t size) {
+status_t M3UParser::parse(
+        const void *_data, size_t size, const sp<M3UParser> &previous) {
     int32_t lineNo = 0;
 
     sp<AMessage> itemMeta;
@@ -574,6 +578,45 @@ status_t M3UParser::parse(const void *_data, size_t size) {
     const char *data = (const char *)_data;
     size_t offset = 0;
     uint64_t segmentRangeOffset = 0;
+    size_t firstUncheckedItem = 0;
+
+    // Live servers typically refresh a playlist by appending new segments to
+    // the text of the previous one. If the previous refresh's text is a byte
+    // prefix of the new text, everything parsed last time would parse
+    // identically, so reuse those items and resume scanning at the first new
+    // byte. The prefix must end on a line boundary, otherwise the previous
+    // parse consumed a line that has since grown.
+    if (previous != NULL
+            && previous->mInitCheck == OK
+            && !previous->mIsVariantPlaylist
+            && !previous->mIsComplete
+            && previous->mBaseURI == mBaseURI
+            && !previous->mRawText.empty()
+            && previous->mRawText.c_str()[previous->mRawText.size() - 1] == '\n'
+            && size >= previous->mRawText.size()
+            && !memcmp(data, previous->mRawText.c_str(),
+                    previous->mRawText.size())) {
+        mIsExtM3U = previous->mIsExtM3U;
+        mIsEvent = previous->mIsEvent;
+        mDiscontinuitySeq = previous->mDiscontinuitySeq;
+        mDiscontinuityCount = previous->mDiscontinuityCount;
+        if (previous->mMeta != NULL) {
+            mMeta = previous->mMeta->dup();
+        }
+        mItems = previous->mItems;
+        firstUncheckedItem = mItems.size();
+
+        lineNo = previous->mParseLineNo;
+        if (previous->mParseItemMeta != NULL) {
+            itemMeta = previous->mParseItemMeta->dup();
+        }
+        segmentRangeOffset = previous->mParseSegmentRangeOffset;
+        offset = previous->mRawText.size();
+
+        ALOGV("resuming parse at offset %zu of %zu (%zu items reused)",
+                offset, size, mItems.size());
+    }
+
     while (offset < size) {
         size_t offsetLF = offset;
         while (offsetLF < size && data[offsetLF] != '\n') {
@@ -713,6 +756,15 @@ status_t M3UParser::parse(const void *_data, size_t size) {
         return ERROR_MALFORMED;
     }
 
+    // A live media playlist will be refreshed; keep the raw text and the
+    // loop-carried parser state so the next refresh can resume from here.
+    if (!mIsVariantPlaylist && !mIsComplete) {
+        mRawText.setTo(data, size);
+        mParseLineNo = lineNo;
+        mParseItemMeta = itemMeta;
+        mParseSegmentRangeOffset = segmentRangeOffset;
+    }
+
     // error checking of all fields that's required to appear once
     // (currently only checking "target-duration"), and
     // initialization of playlist properties (eg. mTargetDurationUs)
@@ -732,7 +784,8 @@ status_t M3UParser::parse(const void *_data, size_t size) {
         mLastSeqNumber = mFirstSeqNumber + mItems.size() - 1;
     }
 
-    for (size_t i = 0; i < mItems.size(); ++i) {
+    // items reused from |previous| already passed this check
+    for (size_t i = firstUncheckedItem; i < mItems.size(); ++i) {
         sp<AMessage> meta = mItems.itemAt(i).mMeta;
         const char *keys[] = {"audio", "video", "subtitles"};
         for (size_t j = 0; j < sizeof(keys) / sizeof(const char *); ++j) {
@@ -27,7 +27,12 @@
 namespace android {
 
 struct M3UParser : public RefBase {
-    M3UParser(const char *baseURI, const void *data, size_t size);
+    // |previous| optionally supplies the parser built from the last refresh
+    // of the same live playlist; when the new text merely appends segments
+    // to the old one, only the appended lines are parsed and the previously
+    // parsed items are reused.
+    M3UParser(const char *baseURI, const void *data, size_t size,
+            const sp<M3UParser> &previous = NULL);
 
     status_t initCheck() const;
 
@@ -89,7 +94,16 @@ private:
     // Media groups keyed by group ID.
     KeyedVector<AString, sp<MediaGroup> > mMediaGroups;
 
-    status_t parse(const void *data, size_t size);
+    // The raw playlist text and the parser state carried across lines at the
+    // end of parse(), kept (for live playlists only) so that the parser built
+    // from the next refresh can resume where this one stopped instead of
+    // re-parsing the whole playlist.
+    AString mRawText;
+    int32_t mParseLineNo;
+    sp<AMessage> mParseItemMeta;
+    uint64_t mParseSegmentRangeOffset;
+
+    status_t parse(const void *data, size_t size, const sp<M3UParser> &previous);
 
     static status_t parseMetaData(
             const AString &line, sp<AMessage> *meta, const char *key);
@@ -142,6 +142,187 @@ void PlaylistFetcher::DownloadState::saveState(
     mLastSeqNumberInPlaylist = lastSeqNumberInPlaylist;
 }
 
+// On high-RTT links the gap between finishing one segment and receiving the
+// first bytes of the next is dominated by the request round trip. The
+// prefetcher issues the next segment's request on its own downloader (and
+// looper) as soon as the fetcher knows which segment comes next, then hands
+// the first block and the open connection back to the fetcher when it gets
+// there.
+struct PlaylistFetcher::SegmentPrefetcher : public AHandler {
+    explicit SegmentPrefetcher(const sp<HTTPDownloader> &downloader)
+        : mDownloader(downloader),
+          mState(IDLE),
+          mRangeOffset(0),
+          mRangeLength(-1),
+          mSizeHint(0),
+          mBytesRead(0),
+          mDelayUs(0) {
+    }
+
+    // Kicks off a fetch of the first block of |uri|; no-op if that block
+    // is already prefetched or in flight. |sizeHint| (0 if unknown)
+    // pre-sizes the download buffer so chunked transfers don't regrow.
+    void prefetch(const AString &uri, int64_t rangeOffset, int64_t rangeLength,
+            size_t sizeHint) {
+        {
+            Mutex::Autolock autoLock(mLock);
+            if (mState == IN_FLIGHT) {
+                // the fetcher is strictly sequential, one prefetch at a time
+                return;
+            }
+            if (mState == DONE && mBlock != NULL
+                    && uri == mUri && rangeOffset == mRangeOffset) {
+                return;
+            }
+            mState = IN_FLIGHT;
+            mUri = uri;
+            mRangeOffset = rangeOffset;
+            mRangeLength = rangeLength;
+            mSizeHint = sizeHint;
+            mBlock.clear();
+            mBytesRead = 0;
+            mDelayUs = 0;
+        }
+
+        sp<AMessage> msg = new AMessage(kWhatPrefetch, this);
+        msg->setString("uri", uri.c_str());
+        msg->setInt64("range-offset", rangeOffset);
+        msg->post();
+    }
+
+    // If the first block of |uri| was prefetched (or still in flight, in
+    // which case we wait for it), returns it along with the downloader
+    // holding the open connection; the caller continues the segment on that
+    // downloader and leaves us its idle one. Returns false if nothing (or a
+    // different segment) was prefetched.
+    bool take(const AString &uri, int64_t rangeOffset,
+            sp<ABuffer> *block, ssize_t *bytesRead, int64_t *delayUs,
+            sp<HTTPDownloader> *downloader) {
+        Mutex::Autolock autoLock(mLock);
+        if (mState == IDLE || !(uri == mUri) || rangeOffset != mRangeOffset) {
+            return false;
+        }
+        while (mState == IN_FLIGHT) {
+            mCondition.wait(mLock);
+        }
+        if (mState != DONE || mBlock == NULL || mBytesRead <= 0) {
+            mBlock.clear();
+            mState = IDLE;
+            return false;
+        }
+        *block = mBlock;
+        *bytesRead = mBytesRead;
+        *delayUs = mDelayUs;
+        sp<HTTPDownloader> idle = *downloader;
+        *downloader = mDownloader;
+        mDownloader = idle;
+        mBlock.clear();
+        mState = IDLE;
+        return true;
+    }
+
+    // Discards prefetched data and aborts an in-flight prefetch. Safe to
+    // call from any thread.
+    void cancel() {
+        Mutex::Autolock autoLock(mLock);
+        if (mState == IN_FLIGHT) {
+            mDownloader->disconnect();
+        }
+        mUri.clear();
+        mBlock.clear();
+        mState = IDLE;
+        mCondition.broadcast();
+    }
+
+protected:
+    virtual ~SegmentPrefetcher() {
+    }
+
+    virtual void onMessageReceived(const sp<AMessage> &msg) {
+        CHECK_EQ(msg->what(), (uint32_t)kWhatPrefetch);
+
+        AString uri;
+        int64_t rangeOffset, rangeLength;
+        size_t sizeHint;
+        CHECK(msg->findString("uri", &uri));
+        CHECK(msg->findInt64("range-offset", &rangeOffset));
+
+        {
+            Mutex::Autolock autoLock(mLock);
+            if (mState != IN_FLIGHT || !(uri == mUri)
+                    || rangeOffset != mRangeOffset) {
+                // canceled or superseded before we got to run
+                return;
+            }
+            rangeLength = mRangeLength;
+            sizeHint = mSizeHint;
+        }
+
+        mDownloader->reconnect();
+
+        sp<ABuffer> block;
+        if (sizeHint > 0) {
+            block = new ABuffer(sizeHint + sizeHint / 4);
+            if (block->data() == NULL) {
+                block.clear();
+            } else {
+                block->setRange(0, 0);
+            }
+        }
+        int64_t startUs = ALooper::GetNowUs();
+        ssize_t bytesRead = mDownloader->fetchBlock(
+                uri.c_str(), &block, rangeOffset, rangeLength,
+                PlaylistFetcher::kDownloadBlockSize,
+                NULL /* actualUrl */, true /* reconnect */);
+        int64_t fetchDelayUs = ALooper::GetNowUs() - startUs;
+
+        Mutex::Autolock autoLock(mLock);
+        if (mState != IN_FLIGHT || !(uri == mUri)) {
+            // canceled while we were fetching
+            return;
+        }
+        mBlock = block;
+        mBytesRead = bytesRead;
+        mDelayUs = fetchDelayUs;
+        mState = DONE;
+        mCondition.broadcast();
+    }
+
+    // Relinquishes the downloader for reuse elsewhere; only call after
+    // cancel() once no prefetch can be in flight anymore.
+    sp<HTTPDownloader> releaseDownloader() {
+        Mutex::Autolock autoLock(mLock);
+        sp<HTTPDownloader> downloader = mDownloader;
+        mDownloader.clear();
+        return downloader;
+    }
+
+private:
+    enum {
+        kWhatPrefetch = 'pftc',
+    };
+
+    enum State {
+        IDLE,
+        IN_FLIGHT,
+        DONE,
+    };
+
+    Mutex mLock;
+    Condition mCondition;
+    sp<HTTPDownloader> mDownloader;
+    State mState;
+    AString mUri;
+    int64_t mRangeOffset;
+    int64_t mRangeLength;
+    size_t mSizeHint;
+    sp<ABuffer> mBlock;
+    ssize_t mBytesRead;
+    int64_t mDelayUs;
+
+    DISALLOW_EVIL_CONSTRUCTORS(SegmentPrefetcher);
+};
+
 PlaylistFetcher::PlaylistFetcher(
         const sp<AMessage> &notify,
         const sp<LiveSession> &session,
@@ -177,15 +358,29 @@ PlaylistFetcher::PlaylistFetcher(
       mSampleAesKeyItemChanged(false),
       mThresholdRatio(-1.0f),
       mDownloadState(new DownloadState()),
-      mHasMetadata(false) {
+      mHasMetadata(false),
+      mLastSegmentBytes(0) {
     memset(mPlaylistHash, 0, sizeof(mPlaylistHash));
     mHTTPDownloader = mSession->getHTTPDownloader();
 
+    mPrefetcher = new SegmentPrefetcher(mSession->getHTTPDownloader());
+    mPrefetchLooper = new ALooper;
+    mPrefetchLooper->setName("hls_prefetch");
+    mPrefetchLooper->start();
+    mPrefetchLooper->registerHandler(mPrefetcher);
+
     memset(mKeyData, 0, sizeof(mKeyData));
     memset(mAESInitVec, 0, sizeof(mAESInitVec));
 }
 
 PlaylistFetcher::~PlaylistFetcher() {
+    mPrefetcher->cancel();
+    mPrefetchLooper->unregisterHandler(mPrefetcher->id());
+    mPrefetchLooper->stop();
+
+    // Hand the downloaders back so the next fetcher can reuse them.
+    mSession->releaseHTTPDownloader(mHTTPDownloader);
+    mSession->releaseHTTPDownloader(mPrefetcher->releaseDownloader());
 }
 
 int32_t PlaylistFetcher::getFetcherID() const {
@@ -519,25 +714,33 @@ void PlaylistFetcher::cancelMonitorQueue() {
 }
 
 void PlaylistFetcher::setStoppingThreshold(float thresholdRatio, bool disconnect) {
+    sp<HTTPDownloader> downloader;
     {
         AutoMutex _l(mThresholdLock);
         mThresholdRatio = thresholdRatio;
+        // mHTTPDownloader may be swapped with the prefetcher's on the
+        // fetcher thread, take a ref under the lock
+        downloader = mHTTPDownloader;
     }
     if (disconnect) {
-        mHTTPDownloader->disconnect();
+        downloader->disconnect();
+        mPrefetcher->cancel();
     }
 }
 
 void PlaylistFetcher::resetStoppingThreshold(bool disconnect) {
+    sp<HTTPDownloader> downloader;
     {
         AutoMutex _l(mThresholdLock);
         mThresholdRatio = -1.0f;
+        downloader = mHTTPDownloader;
     }
     if (disconnect) {
-        mHTTPDownloader->disconnect();
+        downloader->disconnect();
+        mPrefetcher->cancel();
     } else {
         // allow reconnect
-        mHTTPDownloader->reconnect();
+        downloader->reconnect();
     }
 }
 
@@ -937,7 +1140,7 @@ status_t PlaylistFetcher::refreshPlaylist() {
     if (delayUsToRefreshPlaylist() <= 0) {
         bool unchanged;
         sp<M3UParser> playlist = mHTTPDownloader->fetchPlaylist(
-                mURI.c_str(), mPlaylistHash, &unchanged);
+                mURI.c_str(), mPlaylistHash, &unchanged, mPlaylist);
 
         if (playlist == NULL) {
             if (unchanged) {
@@ -1369,10 +1572,36 @@ void PlaylistFetcher::onDownloadNext() {
     ssize_t bytesRead;
     do {
         int64_t startUs = ALooper::GetNowUs();
-        bytesRead = mHTTPDownloader->fetchBlock(
-                uri.c_str(), &buffer, range_offset, range_length, kDownloadBlockSize,
-                NULL /* actualURL */, connectHTTP);
-        int64_t delayUs = ALooper::GetNowUs() - startUs;
+        int64_t delayUs;
+        sp<HTTPDownloader> prefetchedDownloader = mHTTPDownloader;
+        if (connectHTTP
+                && mPrefetcher->take(uri, range_offset, &buffer, &bytesRead,
+                        &delayUs, &prefetchedDownloader)) {
+            // the first block was prefetched while we were finishing up the
+            // previous segment; adopt the downloader holding the open
+            // connection and continue the segment on it
+            FLOGV("adopting prefetched first block (%zd bytes) of '%s'",
+                    bytesRead, uriDebugString(uri).c_str());
+            AutoMutex _l(mThresholdLock);
+            mHTTPDownloader = prefetchedDownloader;
+        } else {
+            if (buffer == NULL && mLastSegmentBytes > 0) {
+                // Seed the download buffer from the last segment's size so
+                // chunked transfers (no Content-Length) don't repeatedly
+                // regrow and memcpy the whole segment; fetchBlock still
+                // grows past the estimate if this segment runs larger.
+                buffer = new ABuffer(mLastSegmentBytes + mLastSegmentBytes / 4);
+                if (buffer->data() == NULL) {
+                    buffer.clear();
+                } else {
+                    buffer->setRange(0, 0);
+                }
+            }
+            bytesRead = mHTTPDownloader->fetchBlock(
+                    uri.c_str(), &buffer, range_offset, range_length, kDownloadBlockSize,
+                    NULL /* actualURL */, connectHTTP);
+            delayUs = ALooper::GetNowUs() - startUs;
+        }
 
         if (bytesRead == ERROR_NOT_CONNECTED) {
             return;
@@ -1476,6 +1705,10 @@ void PlaylistFetcher::onDownloadNext() {
         }
     } while (bytesRead != 0);
 
+    if (buffer != NULL && buffer->size() > 0) {
+        mLastSegmentBytes = buffer->size();
+    }
+
     if (bufferStartsWithTsSyncByte(buffer)) {
         // If we don't see a stream in the program table after fetching a full ts segment
         // mark it as nonexistent.
@@ -1551,10 +1784,43 @@ void PlaylistFetcher::onDownloadNext() {
     }
 
     if (!shouldPause) {
+        // start pulling the next segment's first block while we wait
+        maybePrefetchNextSegment();
         postMonitorQueue();
     }
 }
 
+void PlaylistFetcher::maybePrefetchNextSegment() {
+    if (mPlaylist == NULL || mStopParams != NULL) {
+        return;
+    }
+
+    int32_t firstSeqNumberInPlaylist, lastSeqNumberInPlaylist;
+    mPlaylist->getSeqNumberRange(
+            &firstSeqNumberInPlaylist, &lastSeqNumberInPlaylist);
+
+    if (mSeqNumber < firstSeqNumberInPlaylist
+            || mSeqNumber > lastSeqNumberInPlaylist) {
+        return;
+    }
+
+    AString uri;
+    sp<AMessage> itemMeta;
+    if (!mPlaylist->itemAt(
+                mSeqNumber - firstSeqNumberInPlaylist, &uri, &itemMeta)) {
+        return;
+    }
+
+    int64_t range_offset, range_length;
+    if (!itemMeta->findInt64("range-offset", &range_offset)
+            || !itemMeta->findInt64("range-length", &range_length)) {
+        range_offset = 0;
+        range_length = -1;
+    }
+
+    mPrefetcher->prefetch(uri, range_offset, range_length, mLastSegmentBytes);
+}
+
 /*
  * returns true if we need to adjust mSeqNumber
  */
@@ -1741,14 +2007,11 @@ status_t PlaylistFetcher::extractAndQueueAccessUnitsFromTs(const sp<ABuffer> &bu
     }
 
     size_t offset = 0;
-    while (offset + 188 <= buffer->size()) {
-        status_t err = mTSParser->feedTSPacket(buffer->data() + offset, 188);
+    status_t err = mTSParser->feedTSPackets(
+            buffer->data(), buffer->size(), &offset);
 
-        if (err != OK) {
-            return err;
-        }
-
-        offset += 188;
+    if (err != OK) {
+        return err;
     }
     // setRange to indicate consumed bytes.
     buffer->setRange(buffer->offset() + offset, buffer->size() - offset);
@@ -1810,7 +2073,7 @@ status_t PlaylistFetcher::extractAndQueueAccessUnitsFromTs(const sp<ABuffer> &bu
         }
     }
 
-    status_t err = OK;
+    err = OK;
     for (size_t i = mPacketSources.size(); i > 0;) {
         i--;
         sp<AnotherPacketSource> packetSource = mPacketSources.valueAt(i);
@@ -106,6 +106,7 @@ private:
     };
 
     struct DownloadState;
+    struct SegmentPrefetcher;
 
     static const int64_t kMaxMonitorDelayUs;
     static const int32_t kNumSkipFrames;
@@ -187,6 +188,15 @@ private:
 
     sp<DownloadState> mDownloadState;
 
+    // fetches the first block of the next segment on its own thread while
+    // we're still parsing the current one or waiting out a full buffer
+    sp<ALooper> mPrefetchLooper;
+    sp<SegmentPrefetcher> mPrefetcher;
+
+    // size of the last fully downloaded segment, used to pre-size download
+    // buffers so chunked transfers don't repeatedly regrow and copy
+    size_t mLastSegmentBytes;
+
     bool mHasMetadata;
 
     // Set first to true if decrypting the first segment of a playlist segment. When
@@ -223,6 +233,7 @@ private:
     void onStop(const sp<AMessage> &msg);
     void onMonitorQueue();
     void onDownloadNext();
+    void maybePrefetchNextSegment();
     void initSeqNumberForLiveStream(
             int32_t &firstSeqNumberInPlaylist,
             int32_t &lastSeqNumberInPlaylist);
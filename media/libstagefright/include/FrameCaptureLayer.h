@@ -23,8 +23,11 @@
 #include <utils/Mutex.h>
 #include <utils/Condition.h>
 
+#include <list>
+
 namespace android {
 
+class Fence;
 class GraphicBuffer;
 class IGraphicBufferConsumer;
 class Rect;
@@ -54,6 +57,10 @@ struct FrameCaptureLayer : public ConsumerListener {
 
 private:
     struct BufferLayer;
+    enum {
+        // output buffers kept around for re-use across captures
+        kCaptureBufferPoolSize = 4,
+    };
     // Note: do not hold any sp ref to GraphicBufferSource
     // GraphicBufferSource is holding an sp to us, holding any sp ref
     // to GraphicBufferSource will cause circular dependency and both
@@ -65,9 +72,13 @@ private:
     Mutex mLock;
     Condition mCondition;
     bool mFrameAvailable GUARDED_BY(mLock);
+    std::list<sp<GraphicBuffer> > mCaptureBufferPool;
 
     status_t acquireBuffer(BufferItem *bi);
-    status_t releaseBuffer(const BufferItem &bi);
+    status_t releaseBuffer(const BufferItem &bi,
+            const sp<Fence> &releaseFence = nullptr);
+    sp<GraphicBuffer> obtainCaptureBuffer(
+            uint32_t width, uint32_t height, ui::PixelFormat format);
 
     DISALLOW_EVIL_CONSTRUCTORS(FrameCaptureLayer);
 };
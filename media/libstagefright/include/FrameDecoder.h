@@ -49,6 +49,16 @@ struct FrameDecoder : public RefBase {
 
     sp<IMemory> extractFrame(FrameRect *rect = NULL);
 
+    // Extract one frame for each entry of |timestampsUs| in a single codec
+    // session: the codec configured by init() is re-armed with a flush and
+    // a new seek between targets instead of being torn down. Frames are
+    // appended to |frames| as they are decoded; on error, frames decoded
+    // so far are kept and the error of the failed target is returned.
+    // Only supported by decoders that implement onPrepareFrame().
+    status_t extractFrames(
+            const std::vector<int64_t> &timestampsUs,
+            std::vector<sp<IMemory>> *frames);
+
     static sp<IMemory> getMetadataOnly(
             const sp<MetaData> &trackMeta, int colorFormat,
             bool thumbnail = false, uint32_t bitDepth = 0);
@@ -76,6 +86,15 @@ protected:
             int64_t timeUs,
             bool *done) = 0;
 
+    // Reset per-frame decoding state and set up the seek for the next
+    // target of extractFrames(). Decoders that can't re-arm for another
+    // target keep the default and don't support batch extraction.
+    virtual status_t onPrepareFrame(
+            int64_t frameTimeUs __unused,
+            MediaSource::ReadOptions *options __unused) {
+        return ERROR_UNSUPPORTED;
+    }
+
     sp<MetaData> trackMeta()     const      { return mTrackMeta; }
     OMX_COLOR_FORMATTYPE dstFormat() const  { return mDstFormat; }
     ui::PixelFormat captureFormat() const   { return mCaptureFormat; }
@@ -133,6 +152,10 @@ protected:
             int64_t timeUs,
             bool *done) override;
 
+    virtual status_t onPrepareFrame(
+            int64_t frameTimeUs,
+            MediaSource::ReadOptions *options) override;
+
 private:
     sp<FrameCaptureLayer> mCaptureLayer;
     VideoFrame *mFrame;
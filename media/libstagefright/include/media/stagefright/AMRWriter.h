@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 
+#include <media/stagefright/BufferedFileWriter.h>
 #include <media/stagefright/MediaWriter.h>
 #include <utils/threads.h>
 
@@ -41,6 +42,7 @@ protected:
 
 private:
     int   mFd;
+    BufferedFileWriter mWriter;
     status_t mInitCheck;
     sp<MediaSource> mSource;
     bool mStarted;
@@ -103,9 +103,16 @@ private:
     int32_t mNextSessionID;
 
     int mPipeFd[2];
+    int mEpollFd;
 
     KeyedVector<int32_t, sp<Session> > mSessions;
 
+    // Mirror of the epoll interest set, keyed by socket fd, so the network
+    // thread only issues epoll_ctl calls for sessions whose readiness
+    // interest actually changed.
+    KeyedVector<int, uint32_t> mRegisteredEvents;
+    KeyedVector<int, sp<Session> > mSessionsByFd;
+
     enum Mode {
         kModeCreateUDPSession,
         kModeCreateTCPDatagramSessionPassive,
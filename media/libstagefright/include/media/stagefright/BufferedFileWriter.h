@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUFFERED_FILE_WRITER_H_
+
+#define BUFFERED_FILE_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <utils/Errors.h>
+
+namespace android {
+
+/**
+ * Batches the small sequential writes emitted by the audio file writers
+ * (one encoded frame, or single ADTS header bytes, at a time) into larger
+ * write() calls. Data is flushed once the buffer fills or once the oldest
+ * buffered byte exceeds a bounded delay, whichever comes first, so the
+ * durability window stays small while the syscall rate drops by orders of
+ * magnitude. Full-buffer flushes are issued at the buffer's page-multiple
+ * size, which keeps them friendly to direct and flash-aware I/O paths.
+ *
+ * Not thread safe; intended for use from a single writer thread.
+ */
+struct BufferedFileWriter {
+    // Flush at 64 KiB or half a second of buffered data, whichever is first.
+    static constexpr size_t kDefaultCapacity = 65536;
+    static constexpr int64_t kDefaultMaxDelayUs = 500000;
+
+    // |fd| is borrowed, not owned; it must remain open until the final
+    // flush() has been issued. |capacity| is rounded up to a page multiple.
+    explicit BufferedFileWriter(
+            int fd,
+            size_t capacity = kDefaultCapacity,
+            int64_t maxDelayUs = kDefaultMaxDelayUs);
+
+    // Flushes remaining data, best effort; call flush() explicitly to
+    // observe the result.
+    ~BufferedFileWriter();
+
+    // Mirrors ::write(): returns |size| once the data has been accepted,
+    // or -1 after any underlying write has failed. A write failure is
+    // sticky; buffered data is dropped and later calls fail immediately.
+    ssize_t write(const void *data, size_t size);
+
+    // Writes out all buffered bytes.
+    status_t flush();
+
+    // flush() followed by fdatasync(), for callers that need the data to
+    // survive a crash at this point in the stream.
+    status_t sync();
+
+private:
+    const int mFd;
+    const size_t mCapacity;
+    const int64_t mMaxDelayUs;
+
+    uint8_t *mBuffer;
+    size_t mLength;
+    // When the oldest byte in |mBuffer| was accepted; -1 when empty.
+    int64_t mOldestTimeUs;
+    bool mHasError;
+
+    status_t writeFully(const void *data, size_t size);
+
+    BufferedFileWriter(const BufferedFileWriter &);
+    BufferedFileWriter &operator=(const BufferedFileWriter &);
+};
+
+}  // namespace android
+
+#endif  // BUFFERED_FILE_WRITER_H_
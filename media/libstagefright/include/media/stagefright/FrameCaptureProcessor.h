@@ -23,6 +23,7 @@
 namespace android {
 
 struct AMessage;
+class Fence;
 class GraphicBuffer;
 class Rect;
 
@@ -51,9 +52,14 @@ public:
 
     static sp<FrameCaptureProcessor> getInstance();
 
+    // Renders |layer| into |outBuffer|. If |outDrawFence| is not null, the
+    // draw fence is returned through it instead of being waited on here,
+    // so the caller can pipeline successive captures and defer the wait
+    // until it actually maps the buffer.
     status_t capture(
             const sp<Layer> &layer,
-            const Rect &sourceCrop, const sp<GraphicBuffer> &outBuffer);
+            const Rect &sourceCrop, const sp<GraphicBuffer> &outBuffer,
+            sp<Fence> *outDrawFence = nullptr);
 
 protected:
     virtual ~FrameCaptureProcessor();
@@ -88,7 +94,8 @@ private:
     // message handlers
     status_t onCreate();
     status_t onCapture(const sp<Layer> &layer,
-            const Rect &sourceCrop, const sp<GraphicBuffer> &outBuffer);
+            const Rect &sourceCrop, const sp<GraphicBuffer> &outBuffer,
+            sp<Fence> *outDrawFence);
 
     DISALLOW_EVIL_CONSTRUCTORS(FrameCaptureProcessor);
 };
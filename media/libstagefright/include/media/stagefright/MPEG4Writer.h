@@ -63,8 +63,15 @@ public:
     inline size_t write(const void *ptr, size_t size, size_t nmemb);
     // Write to file system by calling ::write() or post error message to looper on failure.
     void writeOrPostError(int fd, const void *buf, size_t count);
+    // Gather-write to file system by calling ::writev() or post error message to looper
+    // on failure.
+    void writevOrPostError(int fd, const struct iovec *iov, int iovCount);
     // Seek in the file by calling ::lseek64() or post error message to looper on failure.
     void seekOrPostError(int fd, off64_t offset, int whence);
+    // Open an unlinked temporary file next to the output file for spilling
+    // finalized sample table entries. Returns -1 on failure, in which case
+    // the tables stay fully in memory.
+    int createTempSpillFd();
     void endBox();
     uint32_t interleaveDuration() const { return mInterleaveDurationUs; }
     status_t setInterleaveDuration(uint32_t duration);
@@ -292,7 +299,6 @@ private:
     off64_t addSample_l(
             MediaBuffer *buffer, bool usePrefix,
             uint32_t tiffHdrOffset, size_t *bytesWritten);
-    void addLengthPrefixedSample_l(MediaBuffer *buffer);
     void addMultipleLengthPrefixedSamples_l(MediaBuffer *buffer);
     uint16_t addProperty_l(const ItemProperty &);
     status_t reserveItemId_l(size_t numItems, uint16_t *itemIdBase);
@@ -21,6 +21,7 @@
 #include <media/stagefright/foundation/ABase.h>
 #include <media/stagefright/MediaBuffer.h>
 #include <media/stagefright/MetaData.h>
+#include <utils/List.h>
 #include <utils/threads.h>
 
 namespace android {
@@ -52,19 +53,30 @@ public:
     // Non-inherited functions:
     /////////////////////////////////////////////////
 
-    // pushBuffer() will wait for the read() finish, and read() will have a
-    // deep copy, such that after pushBuffer return, the buffer can be re-used.
+    // pushBuffer() copies the sample into a bounded per-track queue that
+    // read() drains, so the caller's buffer can be re-used as soon as
+    // pushBuffer() returns. pushBuffer() only blocks while the queue is at
+    // capacity, i.e. when the writer is falling behind.
     status_t pushBuffer(MediaBuffer *buffer);
 
 private:
+    // Bounds on the queued samples so that a slow writer backpressures the
+    // producer through pushBuffer() instead of growing memory unboundedly.
+    enum {
+        kMaxQueuedBuffers = 8,
+        kMaxQueuedBytes = 4 * 1024 * 1024,
+    };
+
     Mutex mAdapterLock;
     std::mutex mBufferGatingMutex;
     // Make sure the read() wait for the incoming buffer.
     Condition mBufferReadCond;
-    // Make sure the pushBuffer() wait for the current buffer consumed.
+    // Make sure the pushBuffer() wait while the sample queue is full.
     Condition mBufferReturnedCond;
 
-    MediaBuffer *mCurrentMediaBuffer;
+    // Sample copies queued by pushBuffer() and not yet picked up by read().
+    List<MediaBuffer *> mBufferQueue;
+    size_t mQueuedBytes;
 
     bool mStarted;
     sp<MetaData> mOutputFormat;
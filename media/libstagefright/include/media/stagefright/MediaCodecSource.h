@@ -124,6 +124,9 @@ private:
     sp<ALooper> mCodecLooper;
     sp<AHandlerReflector<MediaCodecSource> > mReflector;
     sp<AMessage> mOutputFormat;
+    // the format the client configured us with, used to reconfigure a new
+    // codec when restarting after stop()
+    sp<AMessage> mConfigFormat;
     Mutexed<sp<MetaData>> mMeta;
     sp<Puller> mPuller;
     sp<MediaCodec> mEncoder;
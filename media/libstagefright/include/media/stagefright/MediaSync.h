@@ -226,6 +226,13 @@ private:
     AudioPlaybackRate mPlaybackSettings;
     AVSyncSettings mSyncSettings;
 
+    // Drift servo state, used when the sync source is vsync and audio is
+    // present. The servo trims the audio rate by a few ppm around the
+    // requested speed so the audio clock tracks the display clock.
+    double mDriftTrim;             // fractional trim currently applied to audio
+    double mDriftErrorIntegralUs;  // accumulated phase error, for the I term
+    int64_t mLastTrimUpdateUs;     // real time of the last rate update
+
     sp<MediaClock> mMediaClock;
 
     MediaSync();
@@ -277,6 +284,14 @@ private:
     // apply new sync settings
     void resync_l();
 
+    // Feed one frame's phase error (distance the scheduler moved the frame
+    // to land on the vsync grid) into the drift servo, and trim the audio
+    // playback rate when the accumulated correction is worth applying.
+    void updateDriftServo_l(int64_t scheduledRealUs, int64_t clockRealUs, int64_t nowUs);
+
+    // forget accumulated drift state, e.g. on a rate or sync source change
+    void resetDriftServo_l();
+
     // apply playback settings only - without resyncing or updating playback rate
     status_t setPlaybackSettings_l(const AudioPlaybackRate &rate);
 
@@ -20,6 +20,8 @@
 
 #include <stdio.h>
 
+#include <media/stagefright/BufferedFileWriter.h>
+
 #include <media/stagefright/MediaWriter.h>
 #include <utils/threads.h>
 
@@ -43,6 +45,7 @@ protected:
 
 private:
     int mFd;
+    BufferedFileWriter mWriter;
     bool mHaveAllCodecSpecificData;
     status_t mInitCheck;
     sp<MediaSource> mSource;
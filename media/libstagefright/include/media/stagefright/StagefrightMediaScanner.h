@@ -20,8 +20,13 @@
 
 #include <media/mediascanner.h>
 
+#include <utils/StrongPointer.h>
+#include <utils/threads.h>
+
 namespace android {
 
+class MediaMetadataRetriever;
+
 struct StagefrightMediaScanner : public MediaScanner {
     StagefrightMediaScanner();
     virtual ~StagefrightMediaScanner();
@@ -39,6 +44,13 @@ private:
     MediaScanResult processFileInternal(
             const char *path, const char *mimeType,
             MediaScannerClient &client);
+
+    // One retriever (i.e. one connection to the media server's metadata
+    // service) reused for every file of a scan; connecting per file
+    // dominates the cost of scanning large collections. The lock keeps
+    // setDataSource/extractMetadata atomic per file.
+    Mutex mRetrieverLock;
+    sp<MediaMetadataRetriever> mRetriever;
 };
 
 }  // namespace android
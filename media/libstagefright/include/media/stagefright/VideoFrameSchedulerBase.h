@@ -34,6 +34,11 @@ struct VideoFrameSchedulerBase : public RefBase {
     // get adjusted nanotime for a video frame render at renderTime
     nsecs_t schedule(nsecs_t renderTime);
 
+    // feed back the time a frame was actually presented on the display
+    // (e.g. from MediaCodec's frame-rendered notification) so scheduling
+    // can track measured VSYNC drift between display timing refreshes
+    void onFrameRendered(nsecs_t renderTimeNs);
+
     // returns the vsync period for the main display
     nsecs_t getVsyncPeriod();
 
@@ -90,6 +95,7 @@ private:
 
     nsecs_t mLastVsyncTime;    // estimated vsync time for last frame
     nsecs_t mTimeCorrection;   // running adjustment
+    nsecs_t mVsyncDrift;       // vsync grid drift measured from render feedback
     PLL mPll;                  // PLL for video frame rate based on render time
 
     DISALLOW_EVIL_CONSTRUCTORS(VideoFrameSchedulerBase);
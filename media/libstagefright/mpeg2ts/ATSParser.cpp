@@ -44,6 +44,7 @@
 #include <utils/Vector.h>
 
 #include <inttypes.h>
+#include <string.h>
 
 namespace android {
 using hardware::hidl_string;
@@ -1893,6 +1894,55 @@ status_t ATSParser::feedTSPacket(const void *data, size_t size,
     return parseTS(&br, event);
 }
 
+status_t ATSParser::feedTSPackets(const void *data, size_t size,
+        size_t *consumed, SyncEvent *event) {
+    const uint8_t *ptr = (const uint8_t *)data;
+    size_t offset = 0;
+
+    while (offset + kTSPacketSize <= size) {
+        const uint8_t *packet = &ptr[offset];
+
+        if (packet[0] != 0x47u) {
+            // Lost sync, scan ahead for the next sync byte. memchr is
+            // vectorized by the C library, no need to hand-roll anything.
+            const uint8_t *sync = (const uint8_t *)memchr(
+                    packet + 1, 0x47, size - offset - 1);
+            if (sync == NULL) {
+                offset = size;
+                break;
+            }
+            ALOGW("lost TS sync, skipping %lld bytes",
+                    (long long)(sync - packet));
+            offset = sync - ptr;
+            continue;
+        }
+
+        // Reject packets we'd throw away anyway without spinning up a bit
+        // reader: stuffing packets (PID 0x1fff) and packets flagged with
+        // the transport_error_indicator.
+        unsigned PID = ((packet[1] & 0x1f) << 8) | packet[2];
+        if ((packet[1] & 0x80) == 0 && PID != 0x1fffu) {
+            ABitReader br(packet, kTSPacketSize);
+            status_t err = parseTS(&br, event);
+            if (err != OK) {
+                if (consumed != NULL) {
+                    *consumed = offset;
+                }
+                return err;
+            }
+        } else {
+            ++mNumTSPacketsParsed;
+        }
+
+        offset += kTSPacketSize;
+    }
+
+    if (consumed != NULL) {
+        *consumed = offset;
+    }
+    return OK;
+}
+
 status_t ATSParser::setMediaCas(const sp<ICas> &cas) {
     status_t err = mCasManager->setMediaCas(cas);
     if (err != OK) {
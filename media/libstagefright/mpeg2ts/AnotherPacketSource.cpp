@@ -37,6 +37,82 @@ namespace android {
 
 const int64_t kNearEOSMarkUs = 2000000LL; // 2 secs
 
+// initial slot count of the access unit ring, must be a power of two
+static const size_t kInitialRingCapacity = 32;
+
+AnotherPacketSource::BufferRing::BufferRing()
+    : mHead(0),
+      mCount(0) {
+}
+
+const sp<ABuffer> &AnotherPacketSource::BufferRing::itemAt(size_t i) const {
+    CHECK_LT(i, mCount);
+    return mSlots.itemAt((mHead + i) & (mSlots.size() - 1));
+}
+
+void AnotherPacketSource::BufferRing::grow() {
+    size_t newCapacity =
+        mSlots.isEmpty() ? kInitialRingCapacity : mSlots.size() * 2;
+
+    Vector<sp<ABuffer> > newSlots;
+    newSlots.insertAt(sp<ABuffer>(), 0, newCapacity);
+    for (size_t i = 0; i < mCount; ++i) {
+        newSlots.editItemAt(i) = itemAt(i);
+    }
+    mSlots = newSlots;
+    mHead = 0;
+}
+
+void AnotherPacketSource::BufferRing::push_back(const sp<ABuffer> &buffer) {
+    if (mCount == mSlots.size()) {
+        grow();
+    }
+    mSlots.editItemAt((mHead + mCount) & (mSlots.size() - 1)) = buffer;
+    ++mCount;
+}
+
+void AnotherPacketSource::BufferRing::push_front(const sp<ABuffer> &buffer) {
+    if (mCount == mSlots.size()) {
+        grow();
+    }
+    mHead = (mHead + mSlots.size() - 1) & (mSlots.size() - 1);
+    mSlots.editItemAt(mHead) = buffer;
+    ++mCount;
+}
+
+sp<ABuffer> AnotherPacketSource::BufferRing::pop_front() {
+    CHECK_GT(mCount, 0u);
+    sp<ABuffer> buffer = mSlots.itemAt(mHead);
+    mSlots.editItemAt(mHead).clear();
+    mHead = (mHead + 1) & (mSlots.size() - 1);
+    --mCount;
+    return buffer;
+}
+
+void AnotherPacketSource::BufferRing::removeFrontUntil(size_t end) {
+    CHECK_LE(end, mCount);
+    for (size_t i = 0; i < end; ++i) {
+        mSlots.editItemAt((mHead + i) & (mSlots.size() - 1)).clear();
+    }
+    mHead = (mHead + end) & (mSlots.size() - 1);
+    mCount -= end;
+}
+
+void AnotherPacketSource::BufferRing::removeBackFrom(size_t start) {
+    CHECK_LE(start, mCount);
+    for (size_t i = start; i < mCount; ++i) {
+        mSlots.editItemAt((mHead + i) & (mSlots.size() - 1)).clear();
+    }
+    mCount = start;
+}
+
+void AnotherPacketSource::BufferRing::clear() {
+    // Drop the references but keep the slot array, so refilling after a
+    // seek or channel change doesn't regrow from scratch.
+    removeFrontUntil(mCount);
+    mHead = 0;
+}
+
 AnotherPacketSource::AnotherPacketSource(const sp<MetaData> &meta)
     : mIsAudio(false),
       mIsVideo(false),
@@ -97,9 +173,8 @@ sp<MetaData> AnotherPacketSource::getFormat() {
         return mFormat;
     }
 
-    List<sp<ABuffer> >::iterator it = mBuffers.begin();
-    while (it != mBuffers.end()) {
-        sp<ABuffer> buffer = *it;
+    for (size_t i = 0; i < mBuffers.size(); ++i) {
+        const sp<ABuffer> &buffer = mBuffers.itemAt(i);
         int32_t discontinuity;
         if (!buffer->meta()->findInt32("discontinuity", &discontinuity)) {
             sp<RefBase> object;
@@ -108,8 +183,6 @@ sp<MetaData> AnotherPacketSource::getFormat() {
                 return mFormat;
             }
         }
-
-        ++it;
     }
     return NULL;
 }
@@ -123,8 +196,7 @@ status_t AnotherPacketSource::dequeueAccessUnit(sp<ABuffer> *buffer) {
     }
 
     if (!mBuffers.empty()) {
-        *buffer = *mBuffers.begin();
-        mBuffers.erase(mBuffers.begin());
+        *buffer = mBuffers.pop_front();
 
         int32_t discontinuity;
         if ((*buffer)->meta()->findInt32("discontinuity", &discontinuity)) {
@@ -175,8 +247,7 @@ status_t AnotherPacketSource::read(
 
     if (!mBuffers.empty()) {
 
-        const sp<ABuffer> buffer = *mBuffers.begin();
-        mBuffers.erase(mBuffers.begin());
+        const sp<ABuffer> buffer = mBuffers.pop_front();
 
         int32_t discontinuity;
         if (buffer->meta()->findInt32("discontinuity", &discontinuity)) {
@@ -365,18 +436,19 @@ void AnotherPacketSource::queueDiscontinuity(
 
     if (discard) {
         // Leave only discontinuities in the queue.
-        List<sp<ABuffer> >::iterator it = mBuffers.begin();
-        while (it != mBuffers.end()) {
-            sp<ABuffer> oldBuffer = *it;
+        Vector<sp<ABuffer> > discontinuities;
+        for (size_t i = 0; i < mBuffers.size(); ++i) {
+            const sp<ABuffer> &oldBuffer = mBuffers.itemAt(i);
 
             int32_t oldDiscontinuityType;
-            if (!oldBuffer->meta()->findInt32(
+            if (oldBuffer->meta()->findInt32(
                         "discontinuity", &oldDiscontinuityType)) {
-                it = mBuffers.erase(it);
-                continue;
+                discontinuities.push_back(oldBuffer);
             }
-
-            ++it;
+        }
+        mBuffers.clear();
+        for (size_t i = 0; i < discontinuities.size(); ++i) {
+            mBuffers.push_back(discontinuities.itemAt(i));
         }
 
         for (List<DiscontinuitySegment>::iterator it2 = mDiscontinuitySegments.begin();
@@ -434,10 +506,9 @@ bool AnotherPacketSource::hasDataBufferAvailable(status_t *finalResult) {
     if (!mEnabled) {
         return false;
     }
-    List<sp<ABuffer> >::iterator it;
-    for (it = mBuffers.begin(); it != mBuffers.end(); it++) {
+    for (size_t i = 0; i < mBuffers.size(); ++i) {
         int32_t discontinuity;
-        if (!(*it)->meta()->findInt32("discontinuity", &discontinuity)) {
+        if (!mBuffers.itemAt(i)->meta()->findInt32("discontinuity", &discontinuity)) {
             return true;
         }
     }
@@ -460,6 +531,16 @@ size_t AnotherPacketSource::getAvailableBufferCount(status_t *finalResult) {
     return 0;
 }
 
+size_t AnotherPacketSource::getBufferedSizeBytes() {
+    Mutex::Autolock autoLock(mLock);
+
+    size_t totalSize = 0;
+    for (size_t i = 0; i < mBuffers.size(); ++i) {
+        totalSize += mBuffers.itemAt(i)->size();
+    }
+    return totalSize;
+}
+
 int64_t AnotherPacketSource::getBufferedDurationUs(status_t *finalResult) {
     Mutex::Autolock autoLock(mLock);
     *finalResult = mEOSResult;
@@ -484,11 +565,10 @@ int64_t AnotherPacketSource::getEstimatedBufferDurationUs() {
     }
 
     SortedVector<int64_t> maxTimesUs;
-    List<sp<ABuffer> >::iterator it;
     int64_t t1 = 0, t2 = 0;
-    for (it = mBuffers.begin(); it != mBuffers.end(); ++it) {
+    for (size_t i = 0; i < mBuffers.size(); ++i) {
         int64_t timeUs = 0;
-        const sp<ABuffer> &buffer = *it;
+        const sp<ABuffer> &buffer = mBuffers.itemAt(i);
         if (!buffer->meta()->findInt64("timeUs", &timeUs)) {
             continue;
         }
@@ -511,7 +591,7 @@ status_t AnotherPacketSource::nextBufferTime(int64_t *timeUs) {
         return mEOSResult != OK ? mEOSResult : -EWOULDBLOCK;
     }
 
-    sp<ABuffer> buffer = *mBuffers.begin();
+    const sp<ABuffer> &buffer = mBuffers.itemAt(0);
     CHECK(buffer->meta()->findInt64("timeUs", timeUs));
 
     return OK;
@@ -553,9 +633,8 @@ sp<AMessage> AnotherPacketSource::getMetaAfterLastDequeued(int64_t delayUs) {
     int64_t lastUs = -1;
     int64_t durationUs = 0;
 
-    List<sp<ABuffer> >::iterator it;
-    for (it = mBuffers.begin(); it != mBuffers.end(); ++it) {
-        const sp<ABuffer> &buffer = *it;
+    for (size_t i = 0; i < mBuffers.size(); ++i) {
+        const sp<ABuffer> &buffer = mBuffers.itemAt(i);
         int32_t discontinuity;
         if (buffer->meta()->findInt32("discontinuity", &discontinuity)) {
             durationUs += lastUs - firstUs;
@@ -598,12 +677,12 @@ void AnotherPacketSource::trimBuffersAfterMeta(
     ALOGV("trimBuffersAfterMeta: discontinuitySeq %d, timeUs %lld",
             stopTime.mSeq, (long long)stopTime.mTimeUs);
 
-    List<sp<ABuffer> >::iterator it;
-    List<DiscontinuitySegment >::iterator it2;
+    size_t i;
+    List<DiscontinuitySegment >::iterator it2 = mDiscontinuitySegments.begin();
     sp<AMessage> newLatestEnqueuedMeta = NULL;
     int64_t newLastQueuedTimeUs = 0;
-    for (it = mBuffers.begin(), it2 = mDiscontinuitySegments.begin(); it != mBuffers.end(); ++it) {
-        const sp<ABuffer> &buffer = *it;
+    for (i = 0; i < mBuffers.size(); ++i) {
+        const sp<ABuffer> &buffer = mBuffers.itemAt(i);
         int32_t discontinuity;
         if (buffer->meta()->findInt32("discontinuity", &discontinuity)) {
             // CHECK(it2 != mDiscontinuitySegments.end());
@@ -621,7 +700,7 @@ void AnotherPacketSource::trimBuffersAfterMeta(
         newLastQueuedTimeUs = curTime.mTimeUs;
     }
 
-    mBuffers.erase(it, mBuffers.end());
+    mBuffers.removeBackFrom(i);
     mLatestEnqueuedMeta = newLatestEnqueuedMeta;
     mLastQueuedTimeUs = newLastQueuedTimeUs;
 
@@ -657,9 +736,9 @@ sp<AMessage> AnotherPacketSource::trimBuffersBeforeMeta(
     sp<MetaData> format;
     bool isAvc = false;
 
-    List<sp<ABuffer> >::iterator it;
-    for (it = mBuffers.begin(); it != mBuffers.end(); ++it) {
-        const sp<ABuffer> &buffer = *it;
+    size_t i;
+    for (i = 0; i < mBuffers.size(); ++i) {
+        const sp<ABuffer> &buffer = mBuffers.itemAt(i);
         int32_t discontinuity;
         if (buffer->meta()->findInt32("discontinuity", &discontinuity)) {
             mDiscontinuitySegments.erase(mDiscontinuitySegments.begin());
@@ -691,7 +770,7 @@ sp<AMessage> AnotherPacketSource::trimBuffersBeforeMeta(
             break;
         }
     }
-    mBuffers.erase(mBuffers.begin(), it);
+    mBuffers.removeFrontUntil(i);
     mLatestDequeuedMeta = NULL;
 
     // CHECK(!mDiscontinuitySegments.empty());
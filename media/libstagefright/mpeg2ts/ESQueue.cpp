@@ -83,6 +83,8 @@ void ElementaryStreamQueue::clear(bool clearFormat) {
         mFormat.clear();
     }
 
+    mH264ScanState.reset();
+
     mEOSReached = false;
 }
 
@@ -1332,21 +1334,20 @@ int64_t ElementaryStreamQueue::fetchTimestamp(
 }
 
 sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
-    const uint8_t *data = mBuffer->data();
+    // Scanning resumes where the previous (unsuccessful) call left off, with
+    // the NAL units it located banked in mH264ScanState, so appending more
+    // data does not make us re-visit bytes we have already parsed.
+    H264ScanState &scan = mH264ScanState;
+    const uint8_t *data = mBuffer->data() + scan.scanOffset;
 
-    size_t size = mBuffer->size();
-    Vector<NALPosition> nals;
-
-    size_t totalSize = 0;
-    size_t seiCount = 0;
+    size_t size = mBuffer->size() - scan.scanOffset;
 
     status_t err;
     const uint8_t *nalStart;
     size_t nalSize;
-    bool foundSlice = false;
-    bool foundIDR = false;
 
-    ALOGV("dequeueAccessUnit_H264[%d] %p/%zu", mAUIndex, data, size);
+    ALOGV("dequeueAccessUnit_H264[%d] %p/%zu resuming at %zu",
+            mAUIndex, mBuffer->data(), mBuffer->size(), scan.scanOffset);
 
     while ((err = getNextNALUnit(&data, &size, &nalStart, &nalSize)) == OK) {
         if (nalSize == 0) continue;
@@ -1356,9 +1357,9 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
 
         if (nalType == 1 || nalType == 5) {
             if (nalType == 5) {
-                foundIDR = true;
+                scan.foundIDR = true;
             }
-            if (foundSlice) {
+            if (scan.foundSlice) {
                 //TODO: Shouldn't this have been called with nalSize-1?
                 ABitReader br(nalStart + 1, nalSize);
                 unsigned first_mb_in_slice = parseUE(&br);
@@ -1370,27 +1371,27 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
                 }
             }
 
-            foundSlice = true;
-        } else if ((nalType == 9 || nalType == 7) && foundSlice) {
+            scan.foundSlice = true;
+        } else if ((nalType == 9 || nalType == 7) && scan.foundSlice) {
             // Access unit delimiter and SPS will be associated with the
             // next frame.
 
             flush = true;
         } else if (nalType == 6 && nalSize > 0) {
             // found non-zero sized SEI
-            ++seiCount;
+            ++scan.seiCount;
         }
 
         if (flush) {
             // The access unit will contain all nal units up to, but excluding
             // the current one, separated by 0x00 0x00 0x00 0x01 startcodes.
 
-            size_t auSize = 4 * nals.size() + totalSize;
+            size_t auSize = 4 * scan.nals.size() + scan.totalSize;
             sp<ABuffer> accessUnit = new ABuffer(auSize);
             sp<ABuffer> sei;
 
-            if (seiCount > 0) {
-                sei = new ABuffer(seiCount * sizeof(NALPosition));
+            if (scan.seiCount > 0) {
+                sei = new ABuffer(scan.seiCount * sizeof(NALPosition));
                 accessUnit->meta()->setBuffer("sei", sei);
             }
 
@@ -1401,14 +1402,15 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
             size_t dstOffset = 0;
             size_t seiIndex = 0;
             size_t shrunkBytes = 0;
-            for (size_t i = 0; i < nals.size(); ++i) {
-                const NALPosition &pos = nals.itemAt(i);
+            for (size_t i = 0; i < scan.nals.size(); ++i) {
+                const NALPosition &pos = scan.nals.itemAt(i);
 
                 unsigned nalType = mBuffer->data()[pos.nalOffset] & 0x1f;
 
                 if (nalType == 6 && pos.nalSize > 0) {
                     if (seiIndex >= sei->size() / sizeof(NALPosition)) {
                         ALOGE("Wrong seiIndex");
+                        scan.reset();
                         return NULL;
                     }
                     NALPosition &seiPos = ((NALPosition *)sei->data())[seiIndex++];
@@ -1435,6 +1437,7 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
                         // don't log unless verbose, since this can get called a lot if
                         // the caller is trying to resynchronize
                         ALOGV("expected sample size < %u, got %zu", pos.nalSize, newSize);
+                        scan.reset();
                         return NULL;
                     }
                     memcpy(accessUnit->data() + dstOffset + 4,
@@ -1463,7 +1466,7 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
             ALOGV("accessUnit contains nal types %s", out.c_str());
 #endif
 
-            const NALPosition &pos = nals.itemAt(nals.size() - 1);
+            const NALPosition &pos = scan.nals.itemAt(scan.nals.size() - 1);
             size_t nextScan = pos.nalOffset + pos.nalSize;
 
             memmove(mBuffer->data(),
@@ -1472,6 +1475,13 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
 
             mBuffer->setRange(0, mBuffer->size() - nextScan);
 
+            bool foundIDR = scan.foundIDR;
+            size_t nalCount = scan.nals.size();
+            size_t totalSize = scan.totalSize;
+            // The current nal (the one that triggered the flush) stays in
+            // mBuffer and is re-scanned for the next access unit.
+            scan.reset();
+
             int64_t timeUs = fetchTimestamp(nextScan);
             if (timeUs < 0LL) {
                 ALOGE("Negative timeUs");
@@ -1501,7 +1511,7 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
 
             ALOGV("dequeueAccessUnitH264[%d]: AU %p(%zu) dstOffset:%zu, nals:%zu, totalSize:%zu ",
                     mAUIndex, accessUnit->data(), accessUnit->size(),
-                    dstOffset, nals.size(), totalSize);
+                    dstOffset, nalCount, totalSize);
             mAUIndex++;
 
             return accessUnit;
@@ -1511,15 +1521,19 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
         pos.nalOffset = nalStart - mBuffer->data();
         pos.nalSize = nalSize;
 
-        nals.push(pos);
+        scan.nals.push(pos);
 
-        totalSize += nalSize;
+        scan.totalSize += nalSize;
+        scan.scanOffset = pos.nalOffset + pos.nalSize;
     }
     if (err != (status_t)-EAGAIN) {
         ALOGE("Unexpeted err");
+        scan.reset();
         return NULL;
     }
 
+    // Incomplete access unit; the scan resumes after the last complete NAL
+    // once more data has been appended.
     return NULL;
 }
 
@@ -27,15 +27,21 @@
 namespace android {
 
 HlsSampleDecryptor::HlsSampleDecryptor()
-    : mValidKeyInfo(false) {
+    : mCipherCtx(EVP_CIPHER_CTX_new()),
+      mValidKeyInfo(false) {
 }
 
 HlsSampleDecryptor::HlsSampleDecryptor(const sp<AMessage> &sampleAesKeyItem)
-    : mValidKeyInfo(false) {
+    : mCipherCtx(EVP_CIPHER_CTX_new()),
+      mValidKeyInfo(false) {
 
     signalNewSampleAesKey(sampleAesKeyItem);
 }
 
+HlsSampleDecryptor::~HlsSampleDecryptor() {
+    EVP_CIPHER_CTX_free(mCipherCtx);
+}
+
 void HlsSampleDecryptor::signalNewSampleAesKey(const sp<AMessage> &sampleAesKeyItem) {
 
     if (sampleAesKeyItem == NULL) {
@@ -59,8 +65,14 @@ void HlsSampleDecryptor::signalNewSampleAesKey(const sp<AMessage> &sampleAesKeyI
         memcpy(KeyData, keyDataBuffer->data(), AES_BLOCK_SIZE);
         memcpy(mAESInitVec, initVecBuffer->data(), AES_BLOCK_SIZE);
 
-        mValidKeyInfo = (AES_set_decrypt_key(KeyData, 8*AES_BLOCK_SIZE/*128*/, &mAesKey) == 0);
-        if (!mValidKeyInfo) {
+        // Set the key schedule once; decryptBlock() only re-arms the IV.
+        mValidKeyInfo = (mCipherCtx != NULL
+                && EVP_DecryptInit_ex(mCipherCtx, EVP_aes_128_cbc(), NULL,
+                        KeyData, mAESInitVec) == 1);
+        if (mValidKeyInfo) {
+            // Samples carry whole blocks plus a clear trailer; no PKCS padding.
+            EVP_CIPHER_CTX_set_padding(mCipherCtx, 0);
+        } else {
             ALOGE("signalNewSampleAesKey: failed to set AES decryption key.");
         }
 
@@ -109,20 +121,15 @@ size_t HlsSampleDecryptor::processNal(uint8_t *nalData, size_t nalSize) {
         size_t offset = VIDEO_CLEAR_LEAD;
         size_t remainingBytes = nalSize - VIDEO_CLEAR_LEAD;
 
-        // a copy of initVec as decryptBlock updates it
-        unsigned char AESInitVec[AES_BLOCK_SIZE];
-        memcpy(AESInitVec, mAESInitVec, AES_BLOCK_SIZE);
-
+        // encrypted_block: protected blocks use 10% skip encryption.
+        // Gather the scattered encrypted blocks into one contiguous scratch
+        // buffer so the whole NAL is decrypted with a single cipher call.
+        // The CBC chain is unaffected: it runs over the same ciphertext
+        // blocks in the same order, just without the clear gaps.
+        mEncryptedBlockOffsets.clear();
         while (remainingBytes > 0) {
-            // encrypted_block: protected block uses 10% skip encryption
             if (remainingBytes > AES_BLOCK_SIZE) {
-                uint8_t *encrypted = nalData + offset;
-                status_t ret = decryptBlock(encrypted, AES_BLOCK_SIZE, AESInitVec);
-                if (ret != OK) {
-                    ALOGE("processNal failed with %d", ret);
-                    return nalSize; // revisit this
-                }
-
+                mEncryptedBlockOffsets.push_back(offset);
                 offset += AES_BLOCK_SIZE;
                 remainingBytes -= AES_BLOCK_SIZE;
             }
@@ -134,6 +141,31 @@ size_t HlsSampleDecryptor::processNal(uint8_t *nalData, size_t nalSize) {
             remainingBytes -= clearBytes;
         } // while
 
+        if (!mEncryptedBlockOffsets.empty()) {
+            mEncryptedBlockScratch.resize(
+                    mEncryptedBlockOffsets.size() * AES_BLOCK_SIZE);
+            uint8_t *gathered = mEncryptedBlockScratch.data();
+            for (size_t i = 0; i < mEncryptedBlockOffsets.size(); ++i) {
+                memcpy(gathered + i * AES_BLOCK_SIZE,
+                        nalData + mEncryptedBlockOffsets[i], AES_BLOCK_SIZE);
+            }
+
+            // a copy of initVec as decryptBlock updates it
+            unsigned char AESInitVec[AES_BLOCK_SIZE];
+            memcpy(AESInitVec, mAESInitVec, AES_BLOCK_SIZE);
+            status_t ret = decryptBlock(
+                    gathered, mEncryptedBlockScratch.size(), AESInitVec);
+            if (ret != OK) {
+                ALOGE("processNal failed with %d", ret);
+                return nalSize; // revisit this
+            }
+
+            for (size_t i = 0; i < mEncryptedBlockOffsets.size(); ++i) {
+                memcpy(nalData + mEncryptedBlockOffsets[i],
+                        gathered + i * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+            }
+        }
+
     } else { // isEncrypted == false
         ALOGV("processNal[%d]: Unencrypted NALU  (%p)/%zu", nalType, nalData, nalSize);
     }
@@ -318,7 +350,22 @@ status_t HlsSampleDecryptor::decryptBlock(uint8_t *buffer, size_t size,
 
     ALOGV("decryptBlock: %p (%zu)", buffer, size);
 
-    AES_cbc_encrypt(buffer, buffer, size, &mAesKey, AESInitVec, AES_DECRYPT);
+    // The chaining vector after decryption is the last ciphertext block;
+    // save it before the in-place decrypt overwrites the input.
+    uint8_t lastCipherBlock[AES_BLOCK_SIZE];
+    memcpy(lastCipherBlock, buffer + size - AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+
+    // Re-arm the persistent context with this run's chaining vector; the key
+    // schedule set in signalNewSampleAesKey() is reused.
+    int outLength = 0;
+    if (EVP_DecryptInit_ex(mCipherCtx, NULL, NULL, NULL, AESInitVec) != 1
+            || EVP_DecryptUpdate(mCipherCtx, buffer, &outLength, buffer, size) != 1
+            || (size_t)outLength != size) {
+        ALOGE("decryptBlock: EVP decrypt failed");
+        return UNKNOWN_ERROR;
+    }
+
+    memcpy(AESInitVec, lastCipherBlock, AES_BLOCK_SIZE);
 
     return OK;
 }
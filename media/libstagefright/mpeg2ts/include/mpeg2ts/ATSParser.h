@@ -122,6 +122,16 @@ struct ATSParser : public RefBase {
     status_t feedTSPacket(
             const void *data, size_t size, SyncEvent *event = NULL);
 
+    // Feeds a whole buffer of TS packets in one call. |size| need not be a
+    // multiple of the packet size; *consumed is set to the number of bytes
+    // actually ingested so the caller can carry over a trailing partial
+    // packet. Re-syncs by scanning forward when a packet does not start on
+    // a sync byte, and drops stuffing packets (PID 0x1fff) and packets with
+    // the transport_error_indicator set without parsing them.
+    status_t feedTSPackets(
+            const void *data, size_t size, size_t *consumed,
+            SyncEvent *event = NULL);
+
     void signalDiscontinuity(
             DiscontinuityType type, const sp<AMessage> &extra);
 
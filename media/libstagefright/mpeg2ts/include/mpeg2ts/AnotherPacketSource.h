@@ -22,6 +22,7 @@
 #include <media/stagefright/foundation/ABase.h>
 #include <utils/threads.h>
 #include <utils/List.h>
+#include <utils/Vector.h>
 
 #include "ATSParser.h"
 
@@ -53,6 +54,9 @@ struct AnotherPacketSource : public MediaSource {
     // if this method returns non-0, or the final result if it returns 0.
     size_t getAvailableBufferCount(status_t *finalResult);
 
+    // Returns the total size in bytes of the queued access units.
+    size_t getBufferedSizeBytes();
+
     // Returns the difference between the last and the first queued
     // presentation timestamps since the last discontinuity (if any).
     int64_t getBufferedDurationUs(status_t *finalResult);
@@ -102,6 +106,36 @@ private:
         }
     };
 
+    // Circular queue of access units. A List would heap-allocate a node
+    // per queued access unit; the ring instead recycles a power-of-two
+    // array of slots that only grows (and keeps its capacity across
+    // clear()), so steady-state queue/dequeue doesn't allocate at all.
+    // Index 0 is the oldest queued entry. Protected by mLock.
+    struct BufferRing {
+        BufferRing();
+
+        bool empty() const { return mCount == 0; }
+        size_t size() const { return mCount; }
+        const sp<ABuffer> &itemAt(size_t i) const;
+
+        void push_back(const sp<ABuffer> &buffer);
+        void push_front(const sp<ABuffer> &buffer);
+        sp<ABuffer> pop_front();
+
+        // Removes entries [0, end) resp. [start, size()).
+        void removeFrontUntil(size_t end);
+        void removeBackFrom(size_t start);
+
+        void clear();
+
+    private:
+        Vector<sp<ABuffer> > mSlots;
+        size_t mHead;
+        size_t mCount;
+
+        void grow();
+    };
+
     // Discontinuity segments are consecutive access units between
     // discontinuity markers. There should always be at least _ONE_
     // discontinuity segment, hence the various CHECKs in
@@ -117,7 +151,7 @@ private:
     sp<MetaData> mFormat;
     int64_t mLastQueuedTimeUs;
     int64_t mEstimatedBufferDurationUs;
-    List<sp<ABuffer> > mBuffers;
+    BufferRing mBuffers;
     status_t mEOSResult;
     sp<AMessage> mLatestEnqueuedMeta;
     sp<AMessage> mLatestDequeuedMeta;
@@ -20,9 +20,11 @@
 
 #include <media/stagefright/foundation/ABase.h>
 #include <media/stagefright/foundation/AMessage.h>
+#include <media/stagefright/foundation/avc_utils.h>
 #include <utils/Errors.h>
 #include <utils/List.h>
 #include <utils/RefBase.h>
+#include <utils/Vector.h>
 #include <vector>
 
 #include "SampleDecryptor.h"
@@ -112,6 +114,30 @@ private:
     sp<SampleDecryptor> mSampleDecryptor;
     int mAUIndex;
 
+    // Incremental scan state for dequeueAccessUnitH264(). The NAL units
+    // located so far for the access unit being assembled are kept across
+    // calls, so an incomplete access unit does not cause the same bytes to
+    // be re-scanned on every dequeue. Offsets are relative to mBuffer and
+    // stay valid because appendData() only ever appends.
+    struct H264ScanState {
+        Vector<NALPosition> nals;
+        size_t scanOffset = 0;  // where the NAL scan resumes in mBuffer
+        size_t totalSize = 0;   // sum of the sizes of the NALs in |nals|
+        size_t seiCount = 0;
+        bool foundSlice = false;
+        bool foundIDR = false;
+
+        void reset() {
+            nals.clear();
+            scanOffset = 0;
+            totalSize = 0;
+            seiCount = 0;
+            foundSlice = false;
+            foundIDR = false;
+        }
+    };
+    H264ScanState mH264ScanState;
+
     bool isSampleEncrypted() const {
         return (mFlags & kFlag_SampleEncryptedData) != 0;
     }
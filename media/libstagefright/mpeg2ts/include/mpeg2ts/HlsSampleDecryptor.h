@@ -22,12 +22,15 @@
 #include <media/stagefright/foundation/AString.h>
 
 #include <openssl/aes.h>
+#include <openssl/evp.h>
 
 #include <utils/Errors.h>
 #include <utils/List.h>
 #include <utils/RefBase.h>
 #include <utils/Vector.h>
 
+#include <vector>
+
 #include "SampleDecryptor.h"
 
 namespace android {
@@ -36,6 +39,7 @@ struct HlsSampleDecryptor : SampleDecryptor {
 
     HlsSampleDecryptor();
     explicit HlsSampleDecryptor(const sp<AMessage> &sampleAesKeyItem);
+    virtual ~HlsSampleDecryptor();
 
     virtual void signalNewSampleAesKey(const sp<AMessage> &sampleAesKeyItem);
 
@@ -53,10 +57,19 @@ private:
     static const int VIDEO_CLEAR_LEAD = 32;
     static const int AUDIO_CLEAR_LEAD = 16;
 
-    AES_KEY mAesKey;
+    // Persistent cipher context; the key schedule is set once per key in
+    // signalNewSampleAesKey() and only the chaining vector is re-armed per
+    // sample.  EVP_aes_128_cbc() dispatches to AES-NI/ARMv8-CE where
+    // available, unlike the low-level AES_cbc_encrypt() path.
+    EVP_CIPHER_CTX *mCipherCtx;
     uint8_t mAESInitVec[AES_BLOCK_SIZE];
     bool mValidKeyInfo;
 
+    // Reused per-NAL scratch for gathering the scattered encrypted blocks of
+    // a skip-encrypted NAL into one contiguous cipher call.
+    std::vector<size_t> mEncryptedBlockOffsets;
+    std::vector<uint8_t> mEncryptedBlockScratch;
+
     DISALLOW_EVIL_CONSTRUCTORS(HlsSampleDecryptor);
 };
 
@@ -376,8 +376,15 @@ OMXNodeInstance::CallbackDispatcher::~CallbackDispatcher() {
 void OMXNodeInstance::CallbackDispatcher::post(const omx_message &msg, bool realTime) {
     Mutex::Autolock autoLock(mLock);
 
+    const bool wasEmpty = mQueue.empty();
     mQueue.push_back(msg);
-    if (realTime || mQueue.size() >= kMaxQueueSize) {
+    // The loop thread only blocks on the condition when it observes an empty
+    // queue, so a signal is needed only on the empty -> non-empty transition
+    // (or at the batching threshold for non-realtime messages).  Skipping the
+    // redundant signals lets completions that arrive while a dispatch is in
+    // flight coalesce into the next queue swap instead of waking the thread
+    // once per message.
+    if ((realTime && wasEmpty) || mQueue.size() >= kMaxQueueSize) {
         mQueueChanged.signal();
     }
 }
@@ -39,6 +39,7 @@
 
 #include <arpa/inet.h>
 #include <sys/socket.h>
+#include <time.h>
 
 namespace android {
 
@@ -134,6 +135,44 @@ static void bumpSocketBufferSize(int s) {
     CHECK_EQ(setsockopt(s, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)), 0);
 }
 
+// Ask the kernel to stamp incoming packets at rx time, so jitter statistics
+// aren't distorted by the scheduling delay between a packet arriving and our
+// poll loop getting around to reading it.
+static void enableRxTimestamps(int s) {
+    int on = 1;
+    if (setsockopt(s, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) != 0) {
+        ALOGW("failed to enable rx timestamps on socket(%d). err=%s",
+                s, strerror(errno));
+    }
+}
+
+// Returns the kernel rx timestamp of the received packet rebased onto
+// ALooper::GetNowUs()'s (monotonic) timebase, or the current time if the
+// kernel didn't stamp it.
+static int64_t getPacketRxTimeUs(struct msghdr *sMsg) {
+    int64_t nowUs = ALooper::GetNowUs();
+    for (struct cmsghdr *cMsg = CMSG_FIRSTHDR(sMsg); cMsg != NULL;
+            cMsg = CMSG_NXTHDR(sMsg, cMsg)) {
+        if (cMsg->cmsg_level == SOL_SOCKET
+                && cMsg->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec stampTs;
+            memcpy(&stampTs, CMSG_DATA(cMsg), sizeof(stampTs));
+
+            // the stamp is CLOCK_REALTIME, rebase onto the monotonic clock
+            struct timespec realTs;
+            clock_gettime(CLOCK_REALTIME, &realTs);
+            int64_t ageUs = (realTs.tv_sec - stampTs.tv_sec) * 1000000LL
+                    + (realTs.tv_nsec - stampTs.tv_nsec) / 1000LL;
+            if (ageUs >= 0 && ageUs <= 1000000LL) {
+                return nowUs - ageUs;
+            }
+            // a wall clock step makes the stamp unusable, fall through
+            break;
+        }
+    }
+    return nowUs;
+}
+
 // static
 void ARTPConnection::MakePortPair(
         int *rtpSocket, int *rtcpSocket, unsigned *rtpPort) {
@@ -372,6 +411,11 @@ void ARTPConnection::onAddStream(const sp<AMessage> &msg) {
 
     info->mIsInjected = injected;
 
+    if (!injected) {
+        enableRxTimestamps(info->mRTPSocket);
+        enableRxTimestamps(info->mRTCPSocket);
+    }
+
     sp<RefBase> obj;
     CHECK(msg->findObject("session-desc", &obj));
     info->mSessionDesc = static_cast<ASessionDescription *>(obj.get());
@@ -631,7 +675,7 @@ status_t ARTPConnection::receive(StreamInfo *s, bool receiveRTP) {
     sMsg.msg_iovlen = 1;
 
     int cMsgSize = sizeof(struct cmsghdr) + sizeof(uint8_t);
-    char buf[CMSG_SPACE(cMsgSize)];
+    char buf[CMSG_SPACE(cMsgSize) + CMSG_SPACE(sizeof(struct timespec))];
     sMsg.msg_control = buf;
     sMsg.msg_controllen = sizeof(buf);
     sMsg.msg_flags = 0;
@@ -659,6 +703,7 @@ status_t ARTPConnection::receive(StreamInfo *s, bool receiveRTP) {
     }
 
     buffer->setRange(0, nbytes);
+    buffer->meta()->setInt64("recv-time-us", getPacketRxTimeUs(&sMsg));
 
     // ALOGI("received %d bytes.", buffer->size());
 
@@ -854,7 +899,11 @@ status_t ARTPConnection::parseRTP(StreamInfo *s, const sp<ABuffer> &buffer) {
         notify->setInt32("payload-type", ARTPSource::RTP_FIRST_PACKET);
         notify->setInt32("rtp-time", (int32_t)rtpTime);
         notify->setInt32("rtp-seq-num", seq);
-        notify->setInt64("recv-time-us", ALooper::GetNowUs());
+        int64_t recvTimeUs;
+        if (!buffer->meta()->findInt64("recv-time-us", &recvTimeUs)) {
+            recvTimeUs = ALooper::GetNowUs();
+        }
+        notify->setInt64("recv-time-us", recvTimeUs);
         notify->post();
 
         ALOGD("send first-rtp event to upper layer");
@@ -263,7 +263,13 @@ void ARTPSource::adjustAnchorTimeIfRequired(int64_t nowUs) {
 }
 
 bool ARTPSource::queuePacket(const sp<ABuffer> &buffer) {
-    int64_t nowUs = ALooper::GetNowUs();
+    // Prefer the kernel rx stamp over the current time, so jitter stats and
+    // anchor adjustment see true arrival times even when packets sat in the
+    // socket buffer waiting for our turn on the poll loop.
+    int64_t nowUs;
+    if (!buffer->meta()->findInt64("recv-time-us", &nowUs)) {
+        nowUs = ALooper::GetNowUs();
+    }
     int64_t rtpTime = 0;
     uint32_t seqNum = (uint32_t)buffer->int32Data();
     int32_t ssrc = 0;
@@ -68,6 +68,9 @@ static char kCNAME[255] = "someone@somewhere";
 static const size_t kTrafficRecorderMaxEntries = 128;
 static const size_t kTrafficRecorderMaxTimeSpanMs = 2000;
 
+// Upper bound on RTP packets per sendmmsg() batch.
+static const size_t kMaxRTPPacketBatch = 32;
+
 static int UniformRand(int limit) {
     return ((double)rand() * limit) / RAND_MAX;
 }
@@ -604,6 +607,8 @@ void ARTPWriter::onRead(const sp<AMessage> &msg) {
         } else if (mMode == AMR_NB || mMode == AMR_WB) {
             sendAMRData(mediaBuf);
         }
+
+        flushRTPPackets();
     }
 
     mediaBuf->release();
@@ -625,40 +630,88 @@ void ARTPWriter::onSendSR(const sp<AMessage> &msg) {
     msg->post(3000000);
 }
 
-void ARTPWriter::send(const sp<ABuffer> &buffer, bool isRTCP) {
-    int sizeSockSt;
-    struct sockaddr *remAddr;
-
+struct sockaddr *ARTPWriter::remoteAddr(bool isRTCP, int *sizeSockSt) {
     if (mIsIPv6) {
-        sizeSockSt = sizeof(struct sockaddr_in6);
-        if (isRTCP)
-            remAddr = (struct sockaddr *)&mRTCPAddr6;
-        else
-            remAddr = (struct sockaddr *)&mRTPAddr6;
-    } else {
-        sizeSockSt = sizeof(struct sockaddr_in);
-        if (isRTCP)
-            remAddr = (struct sockaddr *)&mRTCPAddr;
-        else
-            remAddr = (struct sockaddr *)&mRTPAddr;
+        *sizeSockSt = sizeof(struct sockaddr_in6);
+        return (struct sockaddr *)(isRTCP ? (void *)&mRTCPAddr6 : (void *)&mRTPAddr6);
     }
+    *sizeSockSt = sizeof(struct sockaddr_in);
+    return (struct sockaddr *)(isRTCP ? (void *)&mRTCPAddr : (void *)&mRTPAddr);
+}
+
+void ARTPWriter::send(const sp<ABuffer> &buffer, bool isRTCP) {
+    if (!isRTCP) {
+        // RTP packets of one access unit leave in a single batch.
+        mPendingRTPPackets.push_back(buffer);
+        if (mPendingRTPPackets.size() >= kMaxRTPPacketBatch) {
+            flushRTPPackets();
+        }
+        return;
+    }
+
+    int sizeSockSt;
+    struct sockaddr *remAddr = remoteAddr(true /* isRTCP */, &sizeSockSt);
 
     // Unseal code if moderator is needed (prevent overflow of instant bandwidth)
     // Set limit bits per period through the moderator.
     // ex) 6KByte/10ms = 48KBit/10ms = 4.8MBit/s instant limit
     // ModerateInstantTraffic(10, 6 * 1024);
 
-    ssize_t n = sendto(isRTCP ? mRTCPSocket : mRTPSocket,
+    ssize_t n = sendto(mRTCPSocket,
             buffer->data(), buffer->size(), 0, remAddr, sizeSockSt);
 
     if (n != (ssize_t)buffer->size()) {
         ALOGW("packets can not be sent. ret=%d, buf=%d", (int)n, (int)buffer->size());
     } else {
-        // Record current traffic & Print bits while last 1sec (1000ms)
-        mTrafficRec->writeBytes(buffer->size() +
-                (mIsIPv6 ? TCPIPV6_HEADER_SIZE : TCPIPV4_HEADER_SIZE));
-        mTrafficRec->printAccuBitsForLastPeriod(1000, 1000);
+        onPacketSent(buffer, true /* isRTCP */);
     }
+}
+
+void ARTPWriter::flushRTPPackets() {
+    const size_t count = mPendingRTPPackets.size();
+    if (count == 0) {
+        return;
+    }
+
+    int sizeSockSt;
+    struct sockaddr *remAddr = remoteAddr(false /* isRTCP */, &sizeSockSt);
+
+    struct iovec iov[kMaxRTPPacketBatch];
+    struct mmsghdr msgs[kMaxRTPPacketBatch];
+    memset(msgs, 0, sizeof(mmsghdr) * count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const sp<ABuffer> &packet = mPendingRTPPackets[i];
+        iov[i].iov_base = packet->data();
+        iov[i].iov_len = packet->size();
+        msgs[i].msg_hdr.msg_name = remAddr;
+        msgs[i].msg_hdr.msg_namelen = sizeSockSt;
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t offset = 0;
+    while (offset < count) {
+        int n = sendmmsg(mRTPSocket, &msgs[offset], count - offset, 0);
+        if (n <= 0) {
+            ALOGW("packets can not be sent. ret=%d, pending=%d",
+                    n, (int)(count - offset));
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            onPacketSent(mPendingRTPPackets[offset + i], false /* isRTCP */);
+        }
+        offset += n;
+    }
+
+    mPendingRTPPackets.clear();
+}
+
+void ARTPWriter::onPacketSent(const sp<ABuffer> &buffer, bool isRTCP __unused) {
+    // Record current traffic & Print bits while last 1sec (1000ms)
+    mTrafficRec->writeBytes(buffer->size() +
+            (mIsIPv6 ? TCPIPV6_HEADER_SIZE : TCPIPV4_HEADER_SIZE));
+    mTrafficRec->printAccuBitsForLastPeriod(1000, 1000);
 
 #if LOG_TO_FILES
     int fd = isRTCP ? mRTCPFd : mRTPFd;
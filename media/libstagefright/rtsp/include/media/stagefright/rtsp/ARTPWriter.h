@@ -27,6 +27,8 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 
+#include <utils/Vector.h>
+
 #include <android/multinetwork.h>
 #include "TrafficRecorder.h"
 
@@ -126,6 +128,11 @@ private:
     int32_t mRTPCVOExtMap;
     int32_t mRTPCVODegrees;
 
+    // RTP packets produced while fragmenting the current access unit.
+    // They are transmitted in one sendmmsg() batch instead of one sendto()
+    // per fragment; 4K I-frames fan out into dozens of fragments.
+    Vector<sp<ABuffer> > mPendingRTPPackets;
+
     enum {
         INVALID,
         H265,
@@ -158,6 +165,9 @@ private:
     void sendAMRData(MediaBufferBase *mediaBuf);
 
     void send(const sp<ABuffer> &buffer, bool isRTCP);
+    void flushRTPPackets();
+    void onPacketSent(const sp<ABuffer> &buffer, bool isRTCP);
+    struct sockaddr *remoteAddr(bool isRTCP, int *sizeSockSt);
     void makeSocketPairAndBind(String8& localIp, int localPort, String8& remoteIp, int remotePort);
 
     void ModerateInstantTraffic(uint32_t samplePeriod, uint32_t limitBytes);
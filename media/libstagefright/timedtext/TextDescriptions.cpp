@@ -28,6 +28,14 @@ status_t TextDescriptions::getParcelOfDescriptions(
         uint32_t flags, int timeMs, Parcel *parcel) {
     parcel->freeData();
 
+    // Cue parsing runs on the player's looper for every text sample; reserve
+    // the parceled size up front so dense dialog does not pay repeated
+    // grow-and-copy cycles inside Parcel. Boxes expand at most 4x when
+    // parceled (a 12-byte 'styl' record becomes twelve int32 writes).
+    if (size > 0) {
+        parcel->setDataCapacity(size * 4 + 64);
+    }
+
     if (flags & IN_BAND_TEXT_3GPP) {
         if (flags & GLOBAL_DESCRIPTIONS) {
             return extract3GPPGlobalDescriptions(data, size, parcel);
@@ -24,7 +24,9 @@
 #include <media/stagefright/foundation/ADebug.h>
 
 #include <utils/Log.h>
+#include <errno.h>
 #include <inttypes.h>
+#include <unistd.h>
 
 using namespace webm;
 
@@ -59,6 +61,69 @@ status_t WebmFrameThread::stop() {
 
 //=================================================================================================
 
+WebmClusterWriteThread::WebmClusterWriteThread(const int& fd)
+    : mFd(fd),
+      mDone(true) {
+}
+
+void WebmClusterWriteThread::queue(const sp<ABuffer>& blob) {
+    Mutex::Autolock autolock(mLock);
+    while (!mDone && mPending.size() >= kMaxPendingClusters) {
+        mNotFullCondition.wait(mLock);
+    }
+    mPending.push_back(blob);
+    mNotEmptyCondition.signal();
+}
+
+status_t WebmClusterWriteThread::start() {
+    mDone = false;
+    return WebmFrameThread::start();
+}
+
+status_t WebmClusterWriteThread::stop() {
+    {
+        // wake the writer with an empty sentinel; pending clusters are
+        // still drained before the thread exits
+        Mutex::Autolock autolock(mLock);
+        mDone = true;
+        mNotEmptyCondition.signal();
+        mNotFullCondition.broadcast();
+    }
+    return WebmFrameThread::stop();
+}
+
+void WebmClusterWriteThread::run() {
+    for (;;) {
+        sp<ABuffer> blob;
+        {
+            Mutex::Autolock autolock(mLock);
+            while (!mDone && mPending.empty()) {
+                mNotEmptyCondition.wait(mLock);
+            }
+            if (mPending.empty()) {
+                break;
+            }
+            blob = *mPending.begin();
+            mPending.erase(mPending.begin());
+            mNotFullCondition.signal();
+        }
+
+        const uint8_t *data = blob->data();
+        size_t left = blob->size();
+        while (left > 0) {
+            ssize_t written = ::write(mFd, data, left);
+            if (written < 0) {
+                ALOGE("cluster write failed; errno = %d", errno);
+                break;
+            }
+            data += written;
+            left -= written;
+        }
+    }
+}
+
+//=================================================================================================
+
 WebmFrameSourceThread::WebmFrameSourceThread(
     int type,
     LinkedBlockingQueue<const sp<WebmFrame> >& sink)
@@ -78,7 +143,9 @@ WebmFrameSinkThread::WebmFrameSinkThread(
       mVideoFrames(videoThread->mSink),
       mAudioFrames(audioThread->mSink),
       mCues(cues),
+      mWriteThread(new WebmClusterWriteThread(fd)),
       mStartOffsetTimecode(UINT64_MAX),
+      mLogicalPos(0),
       mDone(true) {
 }
 
@@ -93,7 +160,9 @@ WebmFrameSinkThread::WebmFrameSinkThread(
       mVideoFrames(videoSource),
       mAudioFrames(audioSource),
       mCues(cues),
+      mWriteThread(new WebmClusterWriteThread(fd)),
       mStartOffsetTimecode(UINT64_MAX),
+      mLogicalPos(0),
       mDone(true) {
 }
 
@@ -128,9 +197,15 @@ void WebmFrameSinkThread::writeCluster(List<sp<WebmElement> >& children) {
     // children must contain at least one simpleblock and its timecode
     CHECK_GE(children.size(), 2u);
 
-    uint64_t size;
+    // Seal the cluster into a blob and hand it to the write thread; only
+    // the logical file position advances here, so a storage latency spike
+    // stalls the writer, not cluster assembly.
     sp<WebmElement> cluster = new WebmMaster(kMkvCluster, children);
-    cluster->write(mFd, size);
+    uint64_t size = cluster->totalSize();
+    sp<ABuffer> blob = new ABuffer(size);
+    cluster->serializeInto(blob->data());
+    mWriteThread->queue(blob);
+    mLogicalPos += size;
     children.clear();
 }
 
@@ -148,7 +223,9 @@ void WebmFrameSinkThread::flushFrames(List<const sp<WebmFrame> >& frames, bool l
     initCluster(frames, clusterTimecodeL, children);
 
     uint64_t cueTime = clusterTimecodeL;
-    off_t fpos = ::lseek(mFd, 0, SEEK_CUR);
+    // cluster writes are asynchronous, so the cue position comes from the
+    // logical file position rather than the fd offset
+    uint64_t fpos = mLogicalPos;
     size_t n = frames.size();
     if (!last) {
         // If we are not flushing the last sequence of outstanding frames, flushFrames
@@ -193,6 +270,10 @@ void WebmFrameSinkThread::flushFrames(List<const sp<WebmFrame> >& frames, bool l
 
 status_t WebmFrameSinkThread::start() {
     mDone = false;
+    status_t err = mWriteThread->start();
+    if (err != OK) {
+        return err;
+    }
     return WebmFrameThread::start();
 }
 
@@ -200,11 +281,16 @@ status_t WebmFrameSinkThread::stop() {
     mDone = true;
     mVideoFrames.push(WebmFrame::EOS);
     mAudioFrames.push(WebmFrame::EOS);
-    return WebmFrameThread::stop();
+    status_t err = WebmFrameThread::stop();
+    // drain the queued clusters so the fd offset is at the segment end
+    // before the caller writes cues and fixes up the header
+    status_t writeErr = mWriteThread->stop();
+    return (err != OK) ? err : writeErr;
 }
 
 void WebmFrameSinkThread::run() {
     int numVideoKeyFrames = 0;
+    mLogicalPos = ::lseek(mFd, 0, SEEK_CUR);
     List<const sp<WebmFrame> > outstandingFrames;
     while (!mDone) {
         ALOGV("wait v frame");
@@ -53,6 +53,35 @@ private:
 
 //=================================================================================================
 
+// Writes sealed cluster blobs to the output file on its own thread, so
+// cluster assembly never waits out a storage latency spike. The queue is
+// double buffered: at most kMaxPendingClusters serialized clusters are in
+// flight, and queue() blocks once that bound is hit.
+class WebmClusterWriteThread : public WebmFrameThread {
+public:
+    explicit WebmClusterWriteThread(const int& fd);
+
+    void queue(const sp<ABuffer>& blob);
+
+    void run();
+    status_t start();
+    status_t stop();
+
+private:
+    enum {
+        kMaxPendingClusters = 2,
+    };
+
+    const int& mFd;
+    Mutex mLock;
+    Condition mNotEmptyCondition;
+    Condition mNotFullCondition;
+    List<sp<ABuffer> > mPending;
+    bool mDone;
+};
+
+//=================================================================================================
+
 class WebmFrameSourceThread;
 class WebmFrameSinkThread : public WebmFrameThread {
 public:
@@ -83,7 +112,9 @@ private:
     LinkedBlockingQueue<const sp<WebmFrame> >& mVideoFrames;
     LinkedBlockingQueue<const sp<WebmFrame> >& mAudioFrames;
     List<sp<WebmElement> >& mCues;
+    sp<WebmClusterWriteThread> mWriteThread;
     uint64_t mStartOffsetTimecode;
+    uint64_t mLogicalPos;  // file position as if queued clusters were written
 
     volatile bool mDone;
 
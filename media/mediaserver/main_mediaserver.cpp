@@ -23,6 +23,7 @@
 #include <binder/IServiceManager.h>
 #include <hidl/HidlTransportSupport.h>
 #include <utils/Log.h>
+#include <utils/Timers.h>
 #include "RegisterExtensions.h"
 
 // from LOCAL_C_INCLUDES
@@ -47,12 +48,21 @@ int main(int argc __unused, char **argv __unused)
     sp<ProcessState> proc(ProcessState::self());
     sp<IServiceManager> sm(defaultServiceManager());
     ALOGI("ServiceManager: %p", sm.get());
+    // Log the per-service bring-up time so boot regressions are attributable.
+    const nsecs_t bringUpStartNs = systemTime();
     MediaPlayerService::instantiate();
+    const nsecs_t playerReadyNs = systemTime();
     ResourceManagerService::instantiate();
+    const nsecs_t resourceReadyNs = systemTime();
 #ifdef NO_CAMERA_SERVER
     CameraService::instantiate();
 #endif
     registerExtensions();
+    ALOGI("Service bring-up: MediaPlayerService %.1f ms, ResourceManagerService %.1f ms,"
+            " total %.1f ms",
+            (playerReadyNs - bringUpStartNs) / 1e6,
+            (resourceReadyNs - playerReadyNs) / 1e6,
+            (systemTime() - bringUpStartNs) / 1e6);
     ::android::hardware::configureRpcThreadpool(16, false);
     ProcessState::self()->startThreadPool();
     IPCThreadState::self()->joinThreadPool();
@@ -162,7 +162,7 @@ int MtpFfsCompatHandle::receiveFile(mtp_file_range mfr, bool zero_packet) {
     // A >4G file is given as 0xFFFFFFFF
     uint32_t file_length = mfr.length;
     uint64_t offset = mfr.offset;
-    int packet_size = getPacketSize(mBulkOut);
+    int packet_size = mBulkOutPacketSize;
 
     unsigned char *data = mIobuf[0].bufs.data();
     unsigned char *data2 = mIobuf[1].bufs.data();
@@ -248,7 +248,7 @@ int MtpFfsCompatHandle::sendFile(mtp_file_range mfr) {
     uint32_t given_length = std::min(static_cast<uint64_t>(MAX_MTP_FILE_SIZE),
             file_length + sizeof(mtp_data_header));
     uint64_t offset = mfr.offset;
-    int packet_size = getPacketSize(mBulkIn);
+    int packet_size = mBulkInPacketSize;
 
     // If file_length is larger than a size_t, truncating would produce the wrong comparison.
     // Instead, promote the left side to 64 bits, then truncate the small result.
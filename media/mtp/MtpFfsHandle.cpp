@@ -72,7 +72,9 @@ int MtpFfsHandle::getPacketSize(int ffs_fd) {
     }
 }
 
-MtpFfsHandle::MtpFfsHandle(int controlFd) {
+MtpFfsHandle::MtpFfsHandle(int controlFd) :
+    mBulkInPacketSize(MAX_PACKET_SIZE_HS),
+    mBulkOutPacketSize(MAX_PACKET_SIZE_HS) {
     mControl.reset(controlFd);
     mBatchCancel = android::base::GetBoolProperty("sys.usb.mtp.batchcancel", false);
 }
@@ -109,15 +111,18 @@ bool MtpFfsHandle::openEndpoints(bool ptp) {
             return false;
         }
     }
+    refreshPacketSizes();
     return true;
 }
 
+void MtpFfsHandle::refreshPacketSizes() {
+    mBulkInPacketSize = getPacketSize(mBulkIn);
+    mBulkOutPacketSize = getPacketSize(mBulkOut);
+}
+
 void MtpFfsHandle::advise(int fd) {
-    for (unsigned i = 0; i < NUM_IO_BUFS; i++) {
-        if (posix_madvise(mIobuf[i].bufs.data(), MAX_FILE_CHUNK_SIZE,
-                POSIX_MADV_SEQUENTIAL | POSIX_MADV_WILLNEED) != 0)
-            PLOG(ERROR) << "Failed to madvise";
-    }
+    // The io buffers are madvised once in start(); only the file fd changes
+    // per transfer.
     if (posix_fadvise(fd, 0, 0,
                 POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE | POSIX_FADV_WILLNEED) != 0)
         PLOG(ERROR) << "Failed to fadvise";
@@ -149,7 +154,7 @@ int MtpFfsHandle::doAsync(void* data, size_t len, bool read, bool zero_packet) {
         if (static_cast<size_t>(ret) < this_len) break;
     }
 
-    int packet_size = getPacketSize(read ? mBulkOut : mBulkIn);
+    int packet_size = read ? mBulkOutPacketSize : mBulkInPacketSize;
     if (len % packet_size == 0 && zero_packet) {
         int ret = iobufSubmit(&mIobuf[0], read ? mBulkOut : mBulkIn, 0, read);
         if (ret < 0) return -1;
@@ -186,6 +191,9 @@ int MtpFfsHandle::handleEvent() {
         switch (event->type) {
         case FUNCTIONFS_BIND:
         case FUNCTIONFS_ENABLE:
+            // The connection speed (and thus the packet size) may change
+            // between enumerations.
+            refreshPacketSizes();
             ret = 0;
             errno = 0;
             break;
@@ -279,6 +287,9 @@ int MtpFfsHandle::start(bool ptp) {
             mIobuf[i].buf[j] = mIobuf[i].bufs.data() + j * AIO_BUF_LEN;
             mIobuf[i].iocb[j] = &mIobuf[i].iocbs[j];
         }
+        if (posix_madvise(mIobuf[i].bufs.data(), MAX_FILE_CHUNK_SIZE,
+                POSIX_MADV_SEQUENTIAL | POSIX_MADV_WILLNEED) != 0)
+            PLOG(ERROR) << "Failed to madvise";
     }
 
     memset(&mCtx, 0, sizeof(mCtx));
@@ -458,7 +469,7 @@ int MtpFfsHandle::receiveFile(mtp_file_range mfr, bool zero_packet) {
     bool has_write = false;
     bool error = false;
     bool write_error = false;
-    int packet_size = getPacketSize(mBulkOut);
+    int packet_size = mBulkOutPacketSize;
     bool short_packet = false;
     advise(mfr.fd);
 
@@ -566,7 +577,7 @@ int MtpFfsHandle::sendFile(mtp_file_range mfr) {
     uint32_t given_length = std::min(static_cast<uint64_t>(MAX_MTP_FILE_SIZE),
             file_length + sizeof(mtp_data_header));
     uint64_t offset = mfr.offset;
-    int packet_size = getPacketSize(mBulkIn);
+    int packet_size = mBulkInPacketSize;
 
     // If file_length is larger than a size_t, truncating would produce the wrong comparison.
     // Instead, promote the left side to 64 bits, then truncate the small result.
@@ -57,8 +57,15 @@ protected:
 
     static int getPacketSize(int ffs_fd);
 
+    // Refresh the cached bulk endpoint max packet sizes. Called when the
+    // endpoints are opened and when the function is (re)enabled, so transfer
+    // paths don't need an ioctl per transfer to learn the packet size.
+    void refreshPacketSizes();
+
     bool mCanceled;
     bool mBatchCancel;
+    int mBulkInPacketSize;
+    int mBulkOutPacketSize;
 
     android::base::unique_fd mControl;
     // "in" from the host's perspective => sink for mtp server
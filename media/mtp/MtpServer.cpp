@@ -570,9 +570,13 @@ MtpResponseCode MtpServer::doGetObjectPropsSupported() {
     if (mRequest.getParameterCount() < 1)
         return MTP_RESPONSE_INVALID_PARAMETER;
     MtpObjectFormat format = mRequest.getParameter(1);
-    MtpObjectPropertyList* properties = mDatabase->getSupportedObjectProperties(format);
-    mData.putAUInt16(properties);
-    delete properties;
+    auto cached = mSupportedObjectPropsCache.find(format);
+    if (cached == mSupportedObjectPropsCache.end()) {
+        cached = mSupportedObjectPropsCache.emplace(format,
+                std::unique_ptr<MtpObjectPropertyList>(
+                        mDatabase->getSupportedObjectProperties(format))).first;
+    }
+    mData.putAUInt16(cached->second.get());
     return MTP_RESPONSE_OK;
 }
 
@@ -1343,11 +1347,16 @@ MtpResponseCode MtpServer::doGetObjectPropDesc() {
     MtpObjectFormat format = mRequest.getParameter(2);
     ALOGV("GetObjectPropDesc %s %s\n", MtpDebug::getObjectPropCodeName(propCode),
                                         MtpDebug::getFormatCodeName(format));
-    MtpProperty* property = mDatabase->getObjectPropertyDesc(propCode, format);
-    if (!property)
+    const uint32_t cacheKey = (static_cast<uint32_t>(format) << 16) | (propCode & 0xFFFF);
+    auto cached = mObjectPropDescCache.find(cacheKey);
+    if (cached == mObjectPropDescCache.end()) {
+        cached = mObjectPropDescCache.emplace(cacheKey,
+                std::unique_ptr<MtpProperty>(
+                        mDatabase->getObjectPropertyDesc(propCode, format))).first;
+    }
+    if (!cached->second)
         return MTP_RESPONSE_OBJECT_PROP_NOT_SUPPORTED;
-    property->write(mData);
-    delete property;
+    cached->second->write(mData);
     return MTP_RESPONSE_OK;
 }
 
@@ -26,6 +26,7 @@
 #include "MtpUtils.h"
 #include "IMtpHandle.h"
 
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -100,6 +101,16 @@ private:
     };
     std::vector<ObjectEdit*>  mObjectEditList;
 
+    // Hosts enumerating large folders interleave GetObjectPropDesc and
+    // GetObjectPropsSupported with the per-object queries. The descriptors
+    // and supported-property lists are static metadata, so remember the
+    // database's answers instead of paying a database round-trip per request.
+    // Object property descriptors, keyed by (format << 16 | property code);
+    // a null entry caches OBJECT_PROP_NOT_SUPPORTED.
+    std::map<uint32_t, std::unique_ptr<MtpProperty>> mObjectPropDescCache;
+    // Supported object property lists, keyed by format.
+    std::map<MtpObjectFormat, std::unique_ptr<MtpObjectPropertyList>> mSupportedObjectPropsCache;
+
 public:
                         MtpServer(IMtpDatabase* database, int controlFd, bool ptp,
                                     const char *deviceInfoManufacturer,
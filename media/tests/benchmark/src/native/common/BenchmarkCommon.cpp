@@ -18,7 +18,32 @@
 #define LOG_TAG "BenchmarkCommon"
 
 #include "BenchmarkCommon.h"
+#include <errno.h>
+#include <sched.h>
 #include <iostream>
+#include <sstream>
+
+bool PinBenchmarkToCpus(const string &cpuList) {
+    if (cpuList.empty()) return true;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    stringstream stream(cpuList);
+    string cpu;
+    while (getline(stream, cpu, ',')) {
+        char *end = nullptr;
+        long cpuIndex = strtol(cpu.c_str(), &end, 10);
+        if (end == cpu.c_str() || *end != '\0' || cpuIndex < 0 || cpuIndex >= CPU_SETSIZE) {
+            ALOGE("Invalid CPU index \"%s\" in list \"%s\"", cpu.c_str(), cpuList.c_str());
+            return false;
+        }
+        CPU_SET(cpuIndex, &cpuSet);
+    }
+    if (sched_setaffinity(0 /* calling thread */, sizeof(cpuSet), &cpuSet) != 0) {
+        ALOGE("sched_setaffinity(%s) failed: %d", cpuList.c_str(), errno);
+        return false;
+    }
+    return true;
+}
 
 void CallBackHandle::ioThread() {
     ALOGV("In %s mIsDone : %d, mSawError : %d ", __func__, mIsDone, mSawError);
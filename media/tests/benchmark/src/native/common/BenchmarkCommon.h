@@ -117,6 +117,14 @@ class CallBackHandle {
     Stats *mStats;
 };
 
+/*
+ * Pins the calling thread (and its future children) to the given CPUs so that
+ * runs on big.LITTLE devices are comparable between drops. cpuList is a
+ * comma-separated list of CPU indices, e.g. "4,5,6,7"; an empty list is a
+ * no-op. Returns false if parsing or sched_setaffinity() fails.
+ */
+bool PinBenchmarkToCpus(const string &cpuList);
+
 // Async API's callback
 void OnInputAvailableCB(AMediaCodec *codec, void *userdata, int32_t index);
 
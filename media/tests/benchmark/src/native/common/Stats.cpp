@@ -87,3 +87,77 @@ void Stats::dumpStatistics(string operation, string inputReference, int64_t dura
     out << rowData;
     out.close();
 }
+
+/**
+ * Returns the given percentile from a sorted vector of per-frame intervals.
+ */
+static nsecs_t getPercentile(const std::vector<nsecs_t> &sortedIntervalNs, int32_t percentile) {
+    size_t idx = (sortedIntervalNs.size() * percentile) / 100;
+    if (idx >= sortedIntervalNs.size()) idx = sortedIntervalNs.size() - 1;
+    return sortedIntervalNs.at(idx);
+}
+
+/**
+ * Dumps the stats of the operation as one JSON object per call, including
+ * percentiles of the per-frame output intervals. Appending to the same file
+ * from multiple scenarios produces a JSON-lines report that lab tooling can
+ * consume without parsing the CSV layout of dumpStatistics().
+ *
+ * \param operation      describes the operation performed on the input media
+ *                       (i.e. extract/mux/decode/encode)
+ * \param inputReference input media
+ * \param durationUs     is a duration of the input media in microseconds.
+ * \param componentName  describes the codecName/muxFormat/mimeType.
+ * \param mode           the operating mode: sync/async.
+ * \param statsFile      the file where the stats data is to be written.
+ */
+void Stats::dumpJsonStatistics(string operation, string inputReference, int64_t durationUs,
+                               string componentName, string mode, string statsFile) {
+    ALOGV("In %s", __func__);
+    if (!mOutputTimer.size()) {
+        ALOGE("No output produced");
+        return;
+    }
+    nsecs_t totalTimeTakenNs = getTotalTime();
+    nsecs_t timeToFirstFrameNs = *mOutputTimer.begin() - mStartTimeNs;
+    int64_t size = std::accumulate(mFrameSizes.begin(), mFrameSizes.end(), (int64_t)0);
+
+    std::vector<nsecs_t> intervalNs;
+    nsecs_t prevTimeNs = mStartTimeNs;
+    for (nsecs_t outputTimeNs : mOutputTimer) {
+        intervalNs.push_back(outputTimeNs - prevTimeNs);
+        prevTimeNs = outputTimeNs;
+    }
+    std::sort(intervalNs.begin(), intervalNs.end());
+
+    string json = "{";
+    json.append("\"timestampNs\": " + to_string(systemTime(CLOCK_MONOTONIC)) + ", ");
+    json.append("\"input\": \"" + inputReference + "\", ");
+    json.append("\"operation\": \"" + operation + "\", ");
+    json.append("\"component\": \"" + componentName + "\", ");
+    json.append("\"api\": \"NDK\", ");
+    json.append("\"mode\": \"" + mode + "\", ");
+    json.append("\"durationUs\": " + to_string(durationUs) + ", ");
+    json.append("\"initTimeNs\": " + to_string(mInitTimeNs) + ", ");
+    json.append("\"deInitTimeNs\": " + to_string(mDeInitTimeNs) + ", ");
+    json.append("\"timeToFirstFrameNs\": " + to_string(timeToFirstFrameNs) + ", ");
+    json.append("\"totalTimeNs\": " + to_string(totalTimeTakenNs) + ", ");
+    json.append("\"frames\": " + to_string(mOutputTimer.size()) + ", ");
+    json.append("\"bytes\": " + to_string(size) + ", ");
+    json.append("\"avgFrameTimeNs\": " + to_string(totalTimeTakenNs / mOutputTimer.size()) + ", ");
+    json.append("\"minFrameTimeNs\": " + to_string(intervalNs.front()) + ", ");
+    json.append("\"p50FrameTimeNs\": " + to_string(getPercentile(intervalNs, 50)) + ", ");
+    json.append("\"p90FrameTimeNs\": " + to_string(getPercentile(intervalNs, 90)) + ", ");
+    json.append("\"p95FrameTimeNs\": " + to_string(getPercentile(intervalNs, 95)) + ", ");
+    json.append("\"p99FrameTimeNs\": " + to_string(getPercentile(intervalNs, 99)) + ", ");
+    json.append("\"maxFrameTimeNs\": " + to_string(intervalNs.back()));
+    json.append("}\n");
+
+    ofstream out(statsFile, ios::out | ios::app);
+    if (out.bad()) {
+        ALOGE("Failed to open stats file for writing!");
+        return;
+    }
+    out << json;
+    out.close();
+}
@@ -104,6 +104,9 @@ class Stats {
 
     void dumpStatistics(string operation, string inputReference, int64_t duarationUs,
                         string codecName = "", string mode = "", string statsFile = "");
+
+    void dumpJsonStatistics(string operation, string inputReference, int64_t durationUs,
+                            string codecName = "", string mode = "", string statsFile = "");
 };
 
 #endif  // __STATS_H__
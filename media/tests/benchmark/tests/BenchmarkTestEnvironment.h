@@ -21,6 +21,8 @@
 
 #include <getopt.h>
 
+#include "BenchmarkCommon.h"
+
 using namespace std;
 
 class BenchmarkTestEnvironment : public ::testing::Environment {
@@ -36,6 +38,10 @@ class BenchmarkTestEnvironment : public ::testing::Environment {
 
     const string getRes() const { return res; }
 
+    void setCpus(const char *_cpus) { cpus = _cpus; }
+
+    const string getCpus() const { return cpus; }
+
     void setStatsFile(const string module) { statsFile = getRes() + module; }
 
     const string getStatsFile() const { return statsFile; }
@@ -44,15 +50,18 @@ class BenchmarkTestEnvironment : public ::testing::Environment {
 
   private:
     string res;
+    string cpus;
     string statsFile;
 };
 
 int BenchmarkTestEnvironment::initFromOptions(int argc, char **argv) {
-    static struct option options[] = {{"path", required_argument, 0, 'P'}, {0, 0, 0, 0}};
+    static struct option options[] = {{"path", required_argument, 0, 'P'},
+                                      {"cpus", required_argument, 0, 'C'},
+                                      {0, 0, 0, 0}};
 
     while (true) {
         int index = 0;
-        int c = getopt_long(argc, argv, "P:", options, &index);
+        int c = getopt_long(argc, argv, "P:C:", options, &index);
         if (c == -1) {
             break;
         }
@@ -62,6 +71,10 @@ int BenchmarkTestEnvironment::initFromOptions(int argc, char **argv) {
                 setRes(optarg);
                 break;
             }
+            case 'C': {
+                setCpus(optarg);
+                break;
+            }
             default:
                 break;
         }
@@ -72,10 +85,15 @@ int BenchmarkTestEnvironment::initFromOptions(int argc, char **argv) {
                 "unrecognized option: %s\n\n"
                 "usage: %s <gtest options> <test options>\n\n"
                 "test options are:\n\n"
-                "-P, --path: Resource files directory location\n",
+                "-P, --path: Resource files directory location\n"
+                "-C, --cpus: Comma-separated CPUs to pin the benchmark to\n",
                 argv[optind ?: 1], argv[0]);
         return 2;
     }
+
+    if (!PinBenchmarkToCpus(getCpus())) {
+        return 2;
+    }
     return 0;
 }
 
@@ -376,9 +376,18 @@ TimerThread::Handle TimerThread::MonitorThread::add(
         std::shared_ptr<const Request> request, TimerCallback&& func, Duration timeout) {
     std::lock_guard _l(mMutex);
     const Handle handle = getUniqueHandle_l(timeout);
+    // The monitor thread sleeps until the earliest deadline of both request
+    // maps, so a wakeup is only needed when the new request expires before
+    // everything already queued.  Requests are keyed by deadline, so this is
+    // a single comparison against the front of the map; skipping the
+    // redundant notify avoids waking the monitor thread (and having it
+    // rescan its deadlines) on every monitored binder call.
+    const bool needsWake = mMonitorRequests.empty() || handle < mMonitorRequests.begin()->first;
     mMonitorRequests.emplace_hint(mMonitorRequests.end(),
             handle, std::make_pair(std::move(request), std::move(func)));
-    mCond.notify_all();
+    if (needsWake) {
+        mCond.notify_all();
+    }
     return handle;
 }
 
@@ -85,6 +85,21 @@ static inline bool isAudioServerOrMediaServerUid(uid_t uid) {
     }
 }
 
+// media.log accepts shared-memory log writers from the native media services only.
+// Applications host MediaCodec in-process and must not be able to pin service memory,
+// so app uids are deliberately excluded here.
+static inline bool isMediaLogWriterUid(uid_t uid) {
+    switch (uid) {
+    case AID_MEDIA:
+    case AID_MEDIA_CODEC:
+    case AID_AUDIOSERVER:
+    case AID_CAMERASERVER:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool recordingAllowed(const AttributionSourceState& attributionSource,
         audio_source_t source = AUDIO_SOURCE_DEFAULT);
 bool startRecording(const AttributionSourceState& attributionSource,
@@ -2284,6 +2284,38 @@ sp<MemoryDealer> AudioFlinger::Client::heap() const
     return mMemoryDealer;
 }
 
+sp<IMemory> AudioFlinger::Client::allocateCblk(size_t size)
+{
+    {
+        Mutex::Autolock _l(mCblkCacheLock);
+        for (auto it = mCblkCache.begin(); it != mCblkCache.end(); ++it) {
+            // Exact size match only: a larger region would strand heap space and a
+            // smaller one obviously cannot be used.  Typical workloads replay the
+            // same stream configuration, so hit rates are high in practice.
+            if ((*it)->size() == size) {
+                sp<IMemory> memory = *it;
+                mCblkCache.erase(it);
+                return memory;
+            }
+        }
+    }
+    return mMemoryDealer->allocate(size);
+}
+
+void AudioFlinger::Client::recycleCblk(const sp<IMemory>& memory)
+{
+    if (memory == 0 || memory->unsecurePointer() == NULL) {
+        return;
+    }
+    Mutex::Autolock _l(mCblkCacheLock);
+    if (mCblkCache.size() >= kMaxCachedCblks) {
+        // Cache full: drop the oldest entry back to the dealer so a burst of
+        // unusual sizes can't pin the client heap indefinitely.
+        mCblkCache.erase(mCblkCache.begin());
+    }
+    mCblkCache.push_back(memory);
+}
+
 // ----------------------------------------------------------------------------
 
 AudioFlinger::NotificationClient::NotificationClient(const sp<AudioFlinger>& audioFlinger,
@@ -88,6 +88,7 @@
 #include "FastMixer.h"
 #include <media/nbaio/NBAIO.h>
 #include "AudioWatchdog.h"
+#include "ConfigEventRing.h"
 #include "AudioStreamOut.h"
 #include "SpdifStreamOut.h"
 #include "AudioHwDevice.h"
@@ -255,6 +256,12 @@ public:
     virtual status_t createAudioPatch(const struct audio_patch *patch,
                                        audio_patch_handle_t *handle);
 
+    /* Create several audio patches as a single transaction: either all patches
+     * in the batch are created or none.  Not yet exposed through the binder
+     * interface; intended for multi-zone routing changes. */
+            status_t createAudioPatches(const std::vector<struct audio_patch>& patches,
+                                        std::vector<audio_patch_handle_t> *handles);
+
     /* Release an audio patch */
     virtual status_t releaseAudioPatch(audio_patch_handle_t handle);
 
@@ -513,12 +520,27 @@ private:
         pid_t               pid() const { return mPid; }
         sp<AudioFlinger>    audioFlinger() const { return mAudioFlinger; }
 
+        // Recycling cache for track control block + buffer allocations.
+        // Short-lived AudioTrack sessions (voice assistants, UI sounds) create
+        // and destroy tracks at a high rate; handing a stopped track's shared
+        // memory region to the next track of the same size avoids repeated
+        // MemoryDealer carving and the associated heap lock traffic on the
+        // binder createTrack path.  allocateCblk() returns a cached region on
+        // exact size match or falls through to heap()->allocate(); the TrackBase
+        // destructor returns regions via recycleCblk().
+        sp<IMemory>         allocateCblk(size_t size);
+        void                recycleCblk(const sp<IMemory>& memory);
+
     private:
         DISALLOW_COPY_AND_ASSIGN(Client);
 
         const sp<AudioFlinger> mAudioFlinger;
               sp<MemoryDealer> mMemoryDealer;
         const pid_t         mPid;
+
+        static constexpr size_t kMaxCachedCblks = 4;
+        Mutex               mCblkCacheLock;
+        std::vector<sp<IMemory>> mCblkCache;    // guarded by mCblkCacheLock
     };
 
     // --- Notification Client ---
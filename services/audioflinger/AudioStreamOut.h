@@ -93,6 +93,12 @@ public:
     virtual status_t flush();
     virtual status_t standby();
 
+    /**
+     * Dump information about the wrapper itself, ahead of the HAL stream dump.
+     * The base class has nothing to report.
+     */
+    virtual void dump(int fd __unused) const {}
+
     // Avoid suppressing retrograde motion in mRenderPosition for gapless offload/direct when
     // transitioning between tracks.
     // The HAL resets the frame position without flush/stop being called, but calls back prior to
@@ -34,24 +34,42 @@ void AudioWatchdogDump::dump(int fd)
     } else {
         strcpy(buf, "N/A\n");
     }
-    dprintf(fd, "Watchdog: underruns=%u, logs=%u, most recent underrun log at %s",
-            mUnderruns, mLogs, buf);
+    dprintf(fd, "Watchdog: underruns=%u, logs=%u, heartbeat stalls=%u,"
+            " most recent underrun log at %s",
+            mUnderruns, mLogs, mHeartbeatStalls, buf);
+    dprintf(fd, "Watchdog overrun histogram (cycle length in nominal periods):\n");
+    for (unsigned i = 0; i < kOverrunBuckets; i++) {
+        if (mOverrunHistogram[i] != 0) {
+            if (i == kOverrunBuckets - 1) {
+                dprintf(fd, "  >=%ux: %u\n", 1u << i, mOverrunHistogram[i]);
+            } else {
+                dprintf(fd, "  [%ux, %ux): %u\n", 1u << i, 1u << (i + 1),
+                        mOverrunHistogram[i]);
+            }
+        }
+    }
 }
 
 bool AudioWatchdog::threadLoop()
 {
-    {
-        AutoMutex _l(mMyLock);
-        if (mPaused) {
-            mMyCond.wait(mMyLock);
-            // ignore previous timestamp after resume()
-            mOldTsValid = false;
-            // force an immediate log on first underrun after resume()
-            mLogTs.tv_sec = MIN_TIME_BETWEEN_LOGS_SEC;
-            mLogTs.tv_nsec = 0;
-            // caller will check for exitPending()
-            return true;
+    struct timespec req;
+    req.tv_sec = 0;
+    req.tv_nsec = mPeriodNs;
+    if (mPaused.load(std::memory_order_relaxed)) {
+        // Poll the pause flag at the normal period instead of blocking on a
+        // condition variable, so pause()/resume() never take a lock shared
+        // with the monitored thread.
+        // ignore previous timestamp after resume()
+        mOldTsValid = false;
+        // force an immediate log on first underrun after resume()
+        mLogTs.tv_sec = MIN_TIME_BETWEEN_LOGS_SEC;
+        mLogTs.tv_nsec = 0;
+        int rc = nanosleep(&req, NULL);
+        if (!((rc == 0) || (rc == -1 && errno == EINTR))) {
+            return false;
         }
+        // caller will check for exitPending()
+        return true;
     }
     struct timespec newTs;
     int rc = clock_gettime(CLOCK_MONOTONIC, &newTs);
@@ -62,6 +80,8 @@ bool AudioWatchdog::threadLoop()
     if (!mOldTsValid) {
         mOldTs = newTs;
         mOldTsValid = true;
+        // resample the heartbeat baseline as well
+        mLastHeartbeatSequence = mHeartbeat.mSequence.load(std::memory_order_acquire);
         return true;
     }
     time_t sec = newTs.tv_sec - mOldTs.tv_sec;
@@ -85,8 +105,31 @@ bool AudioWatchdog::threadLoop()
         mLogTs.tv_sec++;
         mLogTs.tv_nsec -= 1000000000;
     }
+
+    // Sample the heartbeat, if the monitored thread has started publishing one.
+    // A stall is a sample interval in which the sequence did not advance and the
+    // last beat is older than the maximum allowed cycle; attribution then points
+    // at the monitored thread itself, rather than general CPU starvation.
+    const uint32_t heartbeatSequence = mHeartbeat.mSequence.load(std::memory_order_acquire);
+    if (heartbeatSequence != 0) {
+        const int64_t nowNs = (int64_t)newTs.tv_sec * 1000000000 + newTs.tv_nsec;
+        const int64_t beatAgeNs = nowNs - mHeartbeat.mTimeNs.load(std::memory_order_relaxed);
+        if (heartbeatSequence == mLastHeartbeatSequence && beatAgeNs > (int64_t)mMaxCycleNs) {
+            mDump->mHeartbeatStalls = ++mHeartbeatStalls;
+        }
+        mLastHeartbeatSequence = heartbeatSequence;
+    }
+
     if (cycleNs > mMaxCycleNs) {
         mDump->mUnderruns = ++mUnderruns;
+        // bucket by cycle length in nominal periods, log2 spaced
+        uint32_t ratio = cycleNs / mPeriodNs;
+        unsigned bucket = 0;
+        while (ratio > 1 && bucket < AudioWatchdogDump::kOverrunBuckets - 1) {
+            ratio >>= 1;
+            bucket++;
+        }
+        mDump->mOverrunHistogram[bucket]++;
         if (mLogTs.tv_sec >= MIN_TIME_BETWEEN_LOGS_SEC) {
             mDump->mLogs = ++mLogs;
             mDump->mMostRecent = time(NULL);
@@ -96,9 +139,6 @@ bool AudioWatchdog::threadLoop()
             mLogTs.tv_nsec = 0;
         }
     }
-    struct timespec req;
-    req.tv_sec = 0;
-    req.tv_nsec = mPeriodNs;
     rc = nanosleep(&req, NULL);
     if (!((rc == 0) || (rc == -1 && errno == EINTR))) {
         pause();
@@ -114,21 +154,6 @@ void AudioWatchdog::requestExit()
     resume();
 }
 
-void AudioWatchdog::pause()
-{
-    AutoMutex _l(mMyLock);
-    mPaused = true;
-}
-
-void AudioWatchdog::resume()
-{
-    AutoMutex _l(mMyLock);
-    if (mPaused) {
-        mPaused = false;
-        mMyCond.signal();
-    }
-}
-
 void AudioWatchdog::setDump(AudioWatchdogDump *dump)
 {
     mDump = dump != NULL ? dump : &mDummyDump;
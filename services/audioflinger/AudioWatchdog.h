@@ -17,25 +17,52 @@
 // The watchdog thread runs periodically.  It has two functions:
 //   (a) verify that adequate CPU time is available, and log
 //       as soon as possible when there appears to be a CPU shortage
-//   (b) monitor the other threads [not yet implemented]
+//   (b) monitor a heartbeat optionally published by another thread
+//       (e.g. FastMixer), detecting stalled cycles without any
+//       synchronization against the monitored thread
 
 #ifndef AUDIO_WATCHDOG_H
 #define AUDIO_WATCHDOG_H
 
+#include <atomic>
+#include <stdint.h>
 #include <time.h>
 #include <utils/Thread.h>
 
 namespace android {
 
+// Heartbeat published by a monitored thread and sampled by the watchdog.
+// Both sides use only atomic loads/stores, so publishing from a fast thread
+// cannot contend with the watchdog (or vice versa).
+struct AudioWatchdogHeartbeat {
+    AudioWatchdogHeartbeat() : mSequence(0), mTimeNs(0) { }
+
+    // Called by the monitored thread once per cycle.
+    void beat(int64_t nowNs) {
+        mTimeNs.store(nowNs, std::memory_order_relaxed);
+        mSequence.fetch_add(1, std::memory_order_release);
+    }
+
+    std::atomic<uint32_t> mSequence; // incremented each cycle; 0 until first beat
+    std::atomic<int64_t>  mTimeNs;   // CLOCK_MONOTONIC time of most recent beat
+};
+
 // Keeps a cache of AudioWatchdog statistics that can be logged by dumpsys.
 // The usual caveats about atomicity of information apply.
 struct AudioWatchdogDump {
-    AudioWatchdogDump() : mUnderruns(0), mLogs(0), mMostRecent(0) { }
+    static const unsigned kOverrunBuckets = 8;  // power-of-two overrun ratio buckets
+
+    AudioWatchdogDump() : mUnderruns(0), mLogs(0), mHeartbeatStalls(0), mMostRecent(0),
+            mOverrunHistogram{} { }
     /*virtual*/ ~AudioWatchdogDump() { }
-    uint32_t mUnderruns;    // total number of underruns
-    uint32_t mLogs;         // total number of log messages
-    time_t   mMostRecent;   // time of most recent log
-    void     dump(int fd);  // should only be called on a stable copy, not the original
+    uint32_t mUnderruns;       // total number of underruns
+    uint32_t mLogs;            // total number of log messages
+    uint32_t mHeartbeatStalls; // cycles where the monitored heartbeat did not advance in time
+    time_t   mMostRecent;      // time of most recent log
+    // histogram of overrun cycle lengths: bucket i counts cycles of
+    // [2^i, 2^(i+1)) nominal periods, last bucket is open-ended
+    uint32_t mOverrunHistogram[kOverrunBuckets];
+    void     dump(int fd);     // should only be called on a stable copy, not the original
 };
 
 class AudioWatchdog : public Thread {
@@ -45,7 +72,8 @@ public:
             mPeriodNs(periodMs * 1000000), mMaxCycleNs(mPeriodNs * 2),
             // mOldTs
             // mLogTs initialized below
-            mOldTsValid(false), mUnderruns(0), mLogs(0), mDump(&mDummyDump)
+            mOldTsValid(false), mUnderruns(0), mLogs(0), mHeartbeatStalls(0),
+            mLastHeartbeatSequence(0), mDump(&mDummyDump)
         {
 #define MIN_TIME_BETWEEN_LOGS_SEC 60
             // force an immediate log on first underrun
@@ -59,18 +87,24 @@ public:
     virtual void        requestExit();
 
     // FIXME merge API and implementation with AudioTrackThread
-    void            pause();        // suspend thread from execution at next loop boundary
-    void            resume();       // allow thread to execute, if not requested to exit
+    // pause() and resume() are plain atomic stores, so the monitored thread can
+    // call them on its state transitions without contending with the watchdog
+    // thread.  A paused watchdog keeps polling the flag at its normal period
+    // rather than blocking on a condition variable.
+    void            pause() { mPaused.store(true, std::memory_order_relaxed); }
+    void            resume() { mPaused.store(false, std::memory_order_relaxed); }
 
     // Where to store the dump, or NULL to not update
     void            setDump(AudioWatchdogDump* dump);
 
+    // Heartbeat slot handed to the monitored thread (e.g. via FastThreadState);
+    // remains valid for the lifetime of the watchdog.
+    AudioWatchdogHeartbeat* heartbeat() { return &mHeartbeat; }
+
 private:
     virtual bool    threadLoop();
 
-    Mutex           mMyLock;        // Thread::mLock is private
-    Condition       mMyCond;        // Thread::mThreadExitedCondition is private
-    bool            mPaused;        // whether thread is currently paused
+    std::atomic<bool> mPaused;      // whether thread is currently paused
 
     uint32_t        mPeriodNs;      // nominal period
     uint32_t        mMaxCycleNs;    // maximum allowed time of one cycle before declaring underrun
@@ -79,6 +113,9 @@ private:
     bool            mOldTsValid;    // whether mOldTs is valid
     uint32_t        mUnderruns;     // total number of underruns
     uint32_t        mLogs;          // total number of logs
+    uint32_t        mHeartbeatStalls;        // total number of heartbeat stalls observed
+    uint32_t        mLastHeartbeatSequence;  // heartbeat sequence at previous sample
+    AudioWatchdogHeartbeat  mHeartbeat;  // published by the monitored thread, sampled here
     AudioWatchdogDump*  mDump;      // where to store the dump, always non-NULL
     AudioWatchdogDump   mDummyDump; // default area for dump in case setDump() is not called
 };
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_CONFIG_EVENT_RING_H
+#define ANDROID_AUDIO_CONFIG_EVENT_RING_H
+
+#include <atomic>
+#include <stddef.h>
+
+#include <utils/RefBase.h>
+
+// The config event ring was driven by this use case / requirements:
+//  Multiple binder threads deliver configuration changes (ConfigEvents) to a
+//  playback or record thread.  The historical path appends to a Vector under
+//  ThreadBase::mLock, which the mixer loop also takes every cycle; when many
+//  tracks start or stop at once (app churn), binder threads pile up on mLock
+//  and can hold it across allocation, delaying the ~20 ms mixer loop and
+//  showing up as FastMixer underruns.
+//  This ring lets binder-side producers hand off events that do not need a
+//  synchronous status reply without touching mLock at all.  The consumer
+//  (the thread loop) drains it at the top of each cycle.
+//  Compare StateQueue.h, which solves the single-writer/single-reader state
+//  handoff to the fast mixer; this is the multi-writer analog for commands.
+//
+// Requirements:
+//  - multiple producers (binder threads), single consumer (the thread loop)
+//  - bounded: producers must never block; on overflow the caller falls back
+//    to the mutex-protected mConfigEvents path, so no event is ever lost
+//  - no allocation on push/pop; slots hold strong pointers assigned in place
+//
+// The implementation is a bounded ring with a per-slot sequence number
+// (Vyukov-style).  Producers claim a slot with fetch_add on the tail;
+// the slot's sequence tells each side whether the slot is ready for it.
+
+namespace android {
+
+template<typename T, size_t N = 16>   // N must be a power of 2
+class ConfigEventRing {
+
+    static_assert((N & (N - 1)) == 0, "N must be a power of 2");
+
+public:
+    ConfigEventRing() : mTail(0), mHead(0) {
+        for (size_t i = 0; i < N; i++) {
+            mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~ConfigEventRing() { }
+
+    // Called by any producer thread; lock-free and wait-free apart from a
+    // bounded CAS retry against concurrent producers.
+    // Returns false if the ring is full; the caller must then use the
+    // mutex-protected path instead.
+    bool push(const sp<T>& event) {
+        uint32_t pos = mTail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = mSlots[pos & (N - 1)];
+            const uint32_t seq = slot.mSequence.load(std::memory_order_acquire);
+            const int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                // Slot is free; try to claim it.
+                if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.mEvent = event;
+                    slot.mSequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // CAS failure reloaded pos; retry.
+            } else if (diff < 0) {
+                // Slot still occupied by an event the consumer hasn't taken: full.
+                return false;
+            } else {
+                // Another producer claimed this slot; advance.
+                pos = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Called by the single consumer thread only.
+    // Returns false if the ring is empty.
+    bool pop(sp<T>& event) {
+        const uint32_t pos = mHead.load(std::memory_order_relaxed);
+        Slot& slot = mSlots[pos & (N - 1)];
+        const uint32_t seq = slot.mSequence.load(std::memory_order_acquire);
+        if ((int32_t)(seq - (pos + 1)) < 0) {
+            return false;       // producer hasn't published this slot yet
+        }
+        event = slot.mEvent;
+        slot.mEvent.clear();    // drop the ring's reference promptly
+        slot.mSequence.store(pos + N, std::memory_order_release);
+        mHead.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer-side peek at emptiness; approximate for producers.
+    bool isEmpty() const {
+        return mHead.load(std::memory_order_relaxed) == mTail.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t>   mSequence;
+        sp<T>                   mEvent;
+    };
+
+    // Separate cache lines so producers hammering mTail don't bounce the
+    // consumer's mHead line, mirroring the layout advice in StateQueue.h.
+    alignas(64) std::atomic<uint32_t>   mTail;  // next slot for producers
+    alignas(64) std::atomic<uint32_t>   mHead;  // next slot for the consumer
+    alignas(64) Slot                    mSlots[N];
+};
+
+}   // namespace android
+
+#endif  // ANDROID_AUDIO_CONFIG_EVENT_RING_H
@@ -570,7 +570,9 @@ AudioFlinger::EffectModule::EffectModule(const sp<AudioFlinger::EffectCallbackIn
       mDisableWaitCnt(0),    // set by process() and updateState()
       mOffloaded(false),
       mAddedToHal(false),
-      mIsOutput(false)
+      mIsOutput(false),
+      mPassThrough(false),
+      mPassThroughPollCnt(0)
 #ifdef FLOAT_EFFECT_CHAIN
       , mSupportsFloat(false)
 #endif
@@ -820,6 +822,31 @@ void AudioFlinger::EffectModule::process()
                         sizeof(float) * outChannelCount * mConfig.outputCfg.buffer.frameCount);
             }
 #endif
+            // Pass-through declaration by the engine: -ENODATA from an enabled
+            // insert effect means its output is identical to its input this cycle
+            // (e.g. an equalizer with all bands flat).  Only honored on the simple
+            // path with no framework format/channel conversion, so that eliding
+            // later engine calls (see passThroughElide()) skips no needed work.
+            const bool passThroughCapable = !auxType && mState == ACTIVE
+#ifdef FLOAT_EFFECT_CHAIN
+                    && mSupportsFloat
+                    && mInChannelCountRequested == inChannelCount
+                    && mOutChannelCountRequested == outChannelCount
+#endif
+                    ;
+            if (passThroughCapable && ret == -ENODATA) {
+                if (mConfig.inputCfg.buffer.raw != mConfig.outputCfg.buffer.raw) {
+                    // The engine produced no output: splice the input across.
+                    if (mConfig.outputCfg.accessMode == EFFECT_BUFFER_ACCESS_ACCUMULATE) {
+                        accumulateInputToOutput();
+                    } else {
+                        copyInputToOutput();
+                    }
+                }
+                mPassThrough = true;
+            } else {
+                mPassThrough = false;
+            }
         } else {
 #ifdef FLOAT_EFFECT_CHAIN
             data_bypass:
@@ -867,6 +894,22 @@ void AudioFlinger::EffectModule::process()
     }
 }
 
+bool AudioFlinger::EffectModule::passThroughElide()
+{
+    if (!mPassThrough
+            || mState != ACTIVE
+            // only safe in place: skipping then leaves the audio untouched
+            || mConfig.inputCfg.buffer.raw != mConfig.outputCfg.buffer.raw) {
+        mPassThroughPollCnt = 0;
+        return false;
+    }
+    if (++mPassThroughPollCnt >= PASS_THROUGH_POLL_PERIOD) {
+        mPassThroughPollCnt = 0;
+        return false;   // poll the engine this cycle
+    }
+    return true;
+}
+
 void AudioFlinger::EffectModule::reset_l()
 {
     if (mStatus != NO_ERROR || mEffectInterface == 0) {
@@ -1231,6 +1274,9 @@ status_t AudioFlinger::EffectModule::command(int32_t cmdCode,
     if (maxReplySize < 0 || maxReplySize > EFFECT_PARAM_SIZE_MAX) {
         return -EINVAL;
     }
+    // Any command may change the engine's identity state (e.g. a flat equalizer
+    // becoming non-flat): re-engage processing until it reports again.
+    mPassThrough = false;
     size_t cmdSize = cmdData.size();
     const effect_param_t* param = cmdSize >= sizeof(effect_param_t)
                                   ? reinterpret_cast<const effect_param_t*>(cmdData.data())
@@ -2285,6 +2331,9 @@ void AudioFlinger::EffectChain::process_l()
             mOutBuffer->update();
         }
         for (size_t i = 0; i < size; i++) {
+            if (mEffects[i]->passThroughElide()) {
+                continue;   // pass-through in place: buffer already holds its output
+            }
             mEffects[i]->process();
         }
         mInBuffer->commit();
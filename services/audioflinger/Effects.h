@@ -246,6 +246,16 @@ public:
     bool isOffloadedOrDirect() const;
     bool isVolumeControlEnabled() const;
 
+    // An enabled insert effect whose engine returns -ENODATA from process()
+    // declares that its output is identical to its input this cycle (e.g. an
+    // equalizer with all bands flat).  See process() and passThroughElide().
+    bool isPassThrough() const { return mPassThrough; }
+    // Called by EffectChain::process_l() before process(): returns true if this
+    // cycle's engine call can be elided because the effect is pass-through and
+    // processes in place, so skipping it leaves the audio unchanged.  The engine
+    // is still polled occasionally, and any command() re-engages it immediately.
+    bool passThroughElide();
+
     void        setInBuffer(const sp<EffectBufferHalInterface>& buffer);
     int16_t     *inBuffer() const {
         return mInBuffer != 0 ? reinterpret_cast<int16_t*>(mInBuffer->ptr()) : NULL;
@@ -295,6 +305,10 @@ private:
     // Maximum time allocated to effect engines to complete the turn off sequence
     static const uint32_t MAX_DISABLE_TIME_MS = 10000;
 
+    // Number of elided process() calls after which a pass-through engine is
+    // polled again, in case its identity state changed without a command().
+    static const uint32_t PASS_THROUGH_POLL_PERIOD = 64;
+
     DISALLOW_COPY_AND_ASSIGN(EffectModule);
 
     status_t start_l();
@@ -319,6 +333,8 @@ private:
     bool     mOffloaded;            // effect is currently offloaded to the audio DSP
     bool     mAddedToHal;           // effect has been added to the audio HAL
     bool     mIsOutput;             // direction of the AF thread
+    bool     mPassThrough;          // effect reported identity output on last process()
+    uint32_t mPassThroughPollCnt;   // process() calls elided while pass-through
 
 #ifdef FLOAT_EFFECT_CHAIN
     bool    mSupportsFloat;         // effect supports float processing
@@ -18,6 +18,9 @@
 //define LOG_NDEBUG 0
 
 #include "Configuration.h"
+#ifdef FAST_THREAD_STATISTICS
+#include <audio_utils/Statistics.h>
+#endif
 #include <utils/Log.h>
 #include "FastCaptureDumpState.h"
 #include "FastCaptureState.h"
@@ -49,6 +52,43 @@ void FastCaptureDumpState::dump(int fd) const
                 FastCaptureState::commandToString(mCommand), mReadSequence, mFramesRead,
                 mReadErrors, mSampleRate, mFrameCount, measuredWarmupMs, mWarmupCycles,
                 periodSec * 1e3, mSilenced ? "true" : "false");
+#ifdef FAST_THREAD_STATISTICS
+    // find the interval of valid samples
+    const uint32_t bounds = mBounds;
+    const uint32_t newestOpen = bounds & 0xFFFF;
+    uint32_t oldestClosed = bounds >> 16;
+
+    uint32_t n;
+    __builtin_sub_overflow(newestOpen, oldestClosed, &n);
+    n &= 0xFFFF;
+
+    if (n > mSamplingN) {
+        ALOGE("too many samples %u", n);
+        n = mSamplingN;
+    }
+    // statistics for monotonic (wall clock) time and thread raw CPU load in time
+    audio_utils::Statistics<double> wall, loadNs;
+    // loop over all the samples
+    for (uint32_t j = 0; j < n; ++j) {
+        size_t i = oldestClosed++ & (mSamplingN - 1);
+        wall.add(mMonotonicNs[i]);
+        loadNs.add(mLoadNs[i]);
+    }
+    if (n) {
+        dprintf(fd, "  Simple moving statistics over last %.1f seconds:\n",
+                    wall.getN() * periodSec);
+        dprintf(fd, "    wall clock time in ms per read cycle:\n"
+                    "      mean=%.2f min=%.2f max=%.2f stddev=%.2f\n",
+                    wall.getMean()*1e-6, wall.getMin()*1e-6, wall.getMax()*1e-6,
+                    wall.getStdDev()*1e-6);
+        dprintf(fd, "    raw CPU load in us per read cycle:\n"
+                    "      mean=%.0f min=%.0f max=%.0f stddev=%.0f\n",
+                    loadNs.getMean()*1e-3, loadNs.getMin()*1e-3, loadNs.getMax()*1e-3,
+                    loadNs.getStdDev()*1e-3);
+    } else {
+        dprintf(fd, "  No FastCapture statistics available currently\n");
+    }
+#endif
 }
 
 }   // android
@@ -26,6 +26,7 @@
 #include <cutils/atomic.h>
 #include <utils/Log.h>
 #include <utils/Trace.h>
+#include "AudioWatchdog.h"
 #include "FastThread.h"
 #include "FastThreadDumpState.h"
 #include "TypedLogger.h"
@@ -53,6 +54,7 @@ FastThread::FastThread(const char *cycleMs, const char *loadUs) : Thread(false /
     // re-initialized to &mDummySubclassDumpState by subclass constructor
     mDummyDumpState(NULL),
     mDumpState(NULL),
+    mHeartbeat(NULL),
     mIgnoreNextOverrun(true),
 #ifdef FAST_THREAD_STATISTICS
     // mOldLoad
@@ -122,6 +124,7 @@ bool FastThread::threadLoop()
 
             // As soon as possible of learning of a new dump area, start using it
             mDumpState = next->mDumpState != NULL ? next->mDumpState : mDummyDumpState;
+            mHeartbeat = next->mHeartbeat;  // may be NULL
             tlNBLogWriter = next->mNBLogWriter != NULL ?
                     next->mNBLogWriter : mDummyNBLogWriter.get();
             setNBLogWriter(tlNBLogWriter); // This is used for debugging only
@@ -222,6 +225,10 @@ bool FastThread::threadLoop()
         struct timespec newTs;
         int rc = clock_gettime(CLOCK_MONOTONIC, &newTs);
         if (rc == 0) {
+            if (mHeartbeat != NULL) {
+                // atomic publication only; see AudioWatchdogHeartbeat
+                mHeartbeat->beat((int64_t)newTs.tv_sec * 1000000000 + newTs.tv_nsec);
+            }
             if (mOldTsValid) {
                 time_t sec = newTs.tv_sec - mOldTs.tv_sec;
                 long nsec = newTs.tv_nsec - mOldTs.tv_nsec;
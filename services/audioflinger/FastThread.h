@@ -26,6 +26,8 @@
 
 namespace android {
 
+struct AudioWatchdogHeartbeat;
+
 // FastThread is the common abstract base class of FastMixer and FastCapture
 class FastThread : public Thread {
 
@@ -64,6 +66,7 @@ protected:
     long            mWarmupNsMax;   // and less than or equal to this value
     FastThreadDumpState* mDummyDumpState;
     FastThreadDumpState* mDumpState;
+    AudioWatchdogHeartbeat* mHeartbeat;  // optional watchdog heartbeat, published per cycle
     bool            mIgnoreNextOverrun;     // used to ignore initial overrun and first after an
                                             // underrun
 #ifdef FAST_THREAD_STATISTICS
@@ -23,6 +23,7 @@
 
 namespace android {
 
+struct AudioWatchdogHeartbeat;
 struct FastThreadDumpState;
 
 // Represents a single state of a FastThread
@@ -45,6 +46,7 @@ struct FastThreadState {
     // This might be a one-time configuration rather than per-state
     FastThreadDumpState* mDumpState; // if non-NULL, then update dump state periodically
     NBLog::Writer* mNBLogWriter; // non-blocking logger
+    AudioWatchdogHeartbeat* mHeartbeat; // if non-NULL, then beat once per cycle (atomics only)
 
     // returns NULL if command belongs to a subclass
     static const char *commandToString(Command command);
@@ -199,7 +199,7 @@ private:
             // determine number of frames for Tee
             if (frames == 0) {
                 // TODO: consider varying frame count based on type.
-                frames = DEFAULT_TEE_FRAMES;
+                frames = teeFrames();
             }
 
             // TODO: should we check minimum number of frames?
@@ -246,6 +246,15 @@ private:
 
         void write(const void *buffer, size_t frameCount) {
             if (!mEnabled.load() || frameCount == 0) return;
+            // Decimated sampling: keep only one in af.tee.decimation writes so
+            // long-running tees cycle the pipe more slowly at a fraction of the
+            // memory bandwidth. The counter is relaxed; an occasional double
+            // sample on a race is fine for sampled capture.
+            const uint32_t decimation = teeDecimation();
+            if (decimation > 1
+                    && mWriteCounter.fetch_add(1, std::memory_order_relaxed) % decimation != 0) {
+                return;
+            }
             (void)mSinkSource.first->write(buffer, frameCount);
             mDataReady.store(true);
         }
@@ -263,9 +272,30 @@ private:
         // 0x200000 stereo 16-bit PCM frames = 47.5 seconds at 44.1 kHz, 8 megabytes
         static constexpr size_t DEFAULT_TEE_FRAMES = 0x200000;
 
+        /** Pipe size in frames, overridable with af.tee.frames to bound the
+            shared-memory budget per tee (read once, like af.tee). */
+        static size_t teeFrames() {
+            static const size_t frames = []() -> size_t {
+                const int32_t configFrames = property_get_int32("af.tee.frames", 0);
+                return configFrames > 0 ? (size_t)configFrames : DEFAULT_TEE_FRAMES;
+            }();
+            return frames;
+        }
+
+        /** Write decimation factor from af.tee.decimation; 1 (default) keeps
+            every write, N keeps one in N. */
+        static uint32_t teeDecimation() {
+            static const uint32_t decimation = [] {
+                const int32_t configDecimation = property_get_int32("af.tee.decimation", 1);
+                return configDecimation > 1 ? (uint32_t)configDecimation : 1u;
+            }();
+            return decimation;
+        }
+
         // atomic status checking
         std::atomic<bool> mEnabled{false};
         std::atomic<bool> mDataReady{false};
+        std::atomic<uint64_t> mWriteCounter{0};
 
         // locked dump information
         mutable std::mutex mLock;
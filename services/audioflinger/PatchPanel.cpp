@@ -79,6 +79,21 @@ status_t AudioFlinger::createAudioPatch(const struct audio_patch *patch,
     return mPatchPanel.createAudioPatch(patch, handle);
 }
 
+/* Connect a batch of patches as a single transaction */
+status_t AudioFlinger::createAudioPatches(const std::vector<struct audio_patch>& patches,
+                                          std::vector<audio_patch_handle_t> *handles)
+{
+    for (const auto& patch : patches) {
+        status_t status = AudioValidator::validateAudioPatch(patch);
+        if (status != NO_ERROR) {
+            return status;
+        }
+    }
+
+    Mutex::Autolock _l(mLock);
+    return mPatchPanel.createAudioPatches(patches, handles);
+}
+
 /* Disconnect a patch */
 status_t AudioFlinger::releaseAudioPatch(audio_patch_handle_t handle)
 {
@@ -380,43 +395,11 @@ status_t AudioFlinger::PatchPanel::createAudioPatch(const struct audio_patch *pa
             }
         } break;
         case AUDIO_PORT_TYPE_MIX: {
-            audio_module_handle_t srcModule =  patch->sources[0].ext.mix.hw_module;
-            ssize_t index = mAudioFlinger.mAudioHwDevs.indexOfKey(srcModule);
-            if (index < 0) {
-                ALOGW("%s() bad src hw module %d", __func__, srcModule);
-                status = BAD_VALUE;
-                goto exit;
-            }
-            // limit to connections between devices and output streams
             DeviceDescriptorBaseVector devices;
-            for (unsigned int i = 0; i < patch->num_sinks; i++) {
-                if (patch->sinks[i].type != AUDIO_PORT_TYPE_DEVICE) {
-                    ALOGW("%s() invalid sink type %d for mix source",
-                            __func__, patch->sinks[i].type);
-                    status = BAD_VALUE;
-                    goto exit;
-                }
-                // limit to connections between sinks and sources on same HW module
-                if (patch->sinks[i].ext.device.hw_module != srcModule) {
-                    status = BAD_VALUE;
-                    goto exit;
-                }
-                sp<DeviceDescriptorBase> device = new DeviceDescriptorBase(
-                        patch->sinks[i].ext.device.type);
-                device->setAddress(patch->sinks[i].ext.device.address);
-                device->applyAudioPortConfig(&patch->sinks[i]);
-                devices.push_back(device);
-            }
-            sp<ThreadBase> thread =
-                            mAudioFlinger.checkPlaybackThread_l(patch->sources[0].ext.mix.handle);
-            if (thread == 0) {
-                thread = mAudioFlinger.checkMmapThread_l(patch->sources[0].ext.mix.handle);
-                if (thread == 0) {
-                    ALOGW("%s() bad playback I/O handle %d",
-                            __func__, patch->sources[0].ext.mix.handle);
-                    status = BAD_VALUE;
-                    goto exit;
-                }
+            sp<ThreadBase> thread;
+            status = checkMixToDevicesPatch(patch, &thread, &devices);
+            if (status != NO_ERROR) {
+                goto exit;
             }
             if (thread == mAudioFlinger.primaryPlaybackThread_l()) {
                 mAudioFlinger.updateOutDevicesForRecordThreads_l(devices);
@@ -460,6 +443,146 @@ exit:
     return status;
 }
 
+// Validates a mix -> device patch and resolves its source thread and sink devices.
+status_t AudioFlinger::PatchPanel::checkMixToDevicesPatch(const struct audio_patch *patch,
+        sp<ThreadBase> *thread, DeviceDescriptorBaseVector *devices)
+{
+    audio_module_handle_t srcModule = patch->sources[0].ext.mix.hw_module;
+    ssize_t index = mAudioFlinger.mAudioHwDevs.indexOfKey(srcModule);
+    if (index < 0) {
+        ALOGW("%s() bad src hw module %d", __func__, srcModule);
+        return BAD_VALUE;
+    }
+    // limit to connections between devices and output streams
+    for (unsigned int i = 0; i < patch->num_sinks; i++) {
+        if (patch->sinks[i].type != AUDIO_PORT_TYPE_DEVICE) {
+            ALOGW("%s() invalid sink type %d for mix source",
+                    __func__, patch->sinks[i].type);
+            return BAD_VALUE;
+        }
+        // limit to connections between sinks and sources on same HW module
+        if (patch->sinks[i].ext.device.hw_module != srcModule) {
+            return BAD_VALUE;
+        }
+        sp<DeviceDescriptorBase> device = new DeviceDescriptorBase(
+                patch->sinks[i].ext.device.type);
+        device->setAddress(patch->sinks[i].ext.device.address);
+        device->applyAudioPortConfig(&patch->sinks[i]);
+        devices->push_back(device);
+    }
+    sp<ThreadBase> localThread =
+                    mAudioFlinger.checkPlaybackThread_l(patch->sources[0].ext.mix.handle);
+    if (localThread == 0) {
+        localThread = mAudioFlinger.checkMmapThread_l(patch->sources[0].ext.mix.handle);
+        if (localThread == 0) {
+            ALOGW("%s() bad playback I/O handle %d",
+                    __func__, patch->sources[0].ext.mix.handle);
+            return BAD_VALUE;
+        }
+    }
+    *thread = localThread;
+    return NO_ERROR;
+}
+
+/* Connect a batch of patches as a single transaction: either all patches in the
+ * batch are created or none.  Mix -> device patches are posted to their playback
+ * threads before any status is collected, so the HAL calls made by different
+ * threads overlap and a multi-zone routing change costs roughly one HAL
+ * round-trip instead of one per patch. */
+status_t AudioFlinger::PatchPanel::createAudioPatches(
+        const std::vector<struct audio_patch>& patches,
+        std::vector<audio_patch_handle_t> *handles)
+{
+    if (handles == nullptr) {
+        return BAD_VALUE;
+    }
+    ALOGV("%s() %zu patches", __func__, patches.size());
+    handles->assign(patches.size(), AUDIO_PATCH_HANDLE_NONE);
+
+    // Pass 1: validate every patch before creating anything, so a malformed
+    // entry cannot leave the batch half applied.
+    for (const auto& patch : patches) {
+        if (!audio_patch_is_valid(&patch) ||
+                (patch.num_sinks == 0 && patch.num_sources != 2) || patch.num_sources > 2) {
+            return BAD_VALUE;
+        }
+    }
+
+    // Pass 2: resolve mix -> device patches and post their creation events
+    // without waiting.  Other patch types are not expected in routing batches
+    // and go through the serialized createAudioPatch() path in pass 3.
+    std::vector<sp<ThreadBase>> threads(patches.size());
+    std::vector<sp<ThreadBase::ConfigEvent>> events(patches.size());
+    for (size_t i = 0; i < patches.size(); i++) {
+        if (patches[i].sources[0].type != AUDIO_PORT_TYPE_MIX) {
+            continue;
+        }
+        DeviceDescriptorBaseVector devices;
+        status_t status = checkMixToDevicesPatch(&patches[i], &threads[i], &devices);
+        if (status != NO_ERROR) {
+            return status;  // nothing has been created yet
+        }
+        if (threads[i] == mAudioFlinger.primaryPlaybackThread_l()) {
+            mAudioFlinger.updateOutDevicesForRecordThreads_l(devices);
+        }
+        events[i] = threads[i]->postCreateAudioPatchConfigEvent(&patches[i]);
+    }
+
+    // Pass 3: collect the posted events in order and register the resulting
+    // patches; remaining patch types are created serially.  After a failure
+    // keep collecting so that no posted event is abandoned with its HAL patch
+    // left dangling, then roll back.
+    status_t firstError = NO_ERROR;
+    std::vector<audio_patch_handle_t> created;
+    for (size_t i = 0; i < patches.size(); i++) {
+        status_t status;
+        audio_patch_handle_t handle = AUDIO_PATCH_HANDLE_NONE;
+        if (events[i] != nullptr) {
+            audio_patch_handle_t halHandle = AUDIO_PATCH_HANDLE_NONE;
+            status = ThreadBase::waitForCreateAudioPatchConfigEvent(events[i], &halHandle);
+            if (status == NO_ERROR) {
+                Patch newPatch{patches[i], false /*endpointPatch*/};
+                newPatch.setThread(threads[i]);
+                newPatch.mHalHandle = halHandle;
+                // remove stale audio patch with same output as source if any
+                for (auto& iter : mPatches) {
+                    if (iter.second.mAudioPatch.sources[0].ext.mix.handle == threads[i]->id() &&
+                            !iter.second.mIsEndpointPatch) {
+                        erasePatch(iter.first);
+                        break;
+                    }
+                }
+                handle = (audio_patch_handle_t) mAudioFlinger.nextUniqueId(
+                        AUDIO_UNIQUE_ID_USE_PATCH);
+                mAudioFlinger.mDeviceEffectManager.createAudioPatch(handle, newPatch);
+                mPatches.insert(std::make_pair(handle, std::move(newPatch)));
+            }
+        } else if (firstError == NO_ERROR) {
+            status = createAudioPatch(&patches[i], &handle);
+        } else {
+            continue;
+        }
+        if (status != NO_ERROR) {
+            ALOGW("%s() patch %zu failed with status %d", __func__, i, status);
+            if (firstError == NO_ERROR) {
+                firstError = status;
+            }
+            continue;
+        }
+        (*handles)[i] = handle;
+        created.push_back(handle);
+    }
+
+    if (firstError != NO_ERROR) {
+        // roll back everything this call created to keep the transaction atomic
+        for (const auto& handle : created) {
+            releaseAudioPatch(handle);
+        }
+        handles->assign(patches.size(), AUDIO_PATCH_HANDLE_NONE);
+    }
+    return firstError;
+}
+
 AudioFlinger::PatchPanel::Patch::~Patch()
 {
     ALOGE_IF(isSoftware(), "Software patch connections leaked %d %d",
@@ -59,6 +59,13 @@ public:
                               audio_patch_handle_t *handle,
                               bool endpointPatch = false);
 
+    /* Create several patches as a single transaction: either all patches in
+     * the batch are created or none.  Mix -> device patches are processed
+     * concurrently on their playback threads so a multi-zone routing change
+     * costs roughly one HAL round-trip instead of one per patch. */
+    status_t createAudioPatches(const std::vector<struct audio_patch>& patches,
+                                std::vector<audio_patch_handle_t> *handles);
+
     /* Release a patch */
     status_t releaseAudioPatch(audio_patch_handle_t handle);
 
@@ -229,6 +236,8 @@ public:
     std::map<audio_patch_handle_t, Patch>& patches_l() { return mPatches; }
 
 private:
+    status_t checkMixToDevicesPatch(const struct audio_patch *patch,
+            sp<ThreadBase> *thread, DeviceDescriptorBaseVector *devices);
     AudioHwDevice* findAudioHwDeviceByModule(audio_module_handle_t module);
     sp<DeviceHalInterface> findHwDeviceByModule(audio_module_handle_t module);
     void addSoftwarePatchToInsertedModules(
@@ -17,8 +17,11 @@
 
 #define LOG_TAG "AudioFlinger"
 //#define LOG_NDEBUG 0
+#include <stdio.h>
+
 #include <system/audio.h>
 #include <utils/Log.h>
+#include <utils/Timers.h>
 
 #include <audio_utils/spdif/SPDIFEncoder.h>
 
@@ -116,13 +119,30 @@ int SpdifStreamOut::standby()
 
 ssize_t SpdifStreamOut::writeDataBurst(const void* buffer, size_t bytes)
 {
-    return AudioStreamOut::write(buffer, bytes);
+    const int64_t startNs = systemTime();
+    const ssize_t written = AudioStreamOut::write(buffer, bytes);
+    mHalWriteNs += systemTime() - startNs;
+    return written;
 }
 
 ssize_t SpdifStreamOut::write(const void* buffer, size_t numBytes)
 {
     // Write to SPDIF wrapper. It will call back to writeDataBurst().
-    return mSpdifEncoder.write(buffer, numBytes);
+    // Track the wrapping overhead; the HAL write itself may legitimately
+    // block until the data burst has been consumed, so writeDataBurst()
+    // time is measured separately and excluded.
+    const int64_t startNs = systemTime();
+    mHalWriteNs = 0;
+    const ssize_t written = mSpdifEncoder.write(buffer, numBytes);
+    mFramingTimeMs.add((systemTime() - startNs - mHalWriteNs) * 1e-6);
+    return written;
+}
+
+void SpdifStreamOut::dump(int fd) const
+{
+    if (mFramingTimeMs.getN() > 0) {
+        dprintf(fd, "  IEC61937 framing time ms stats: %s\n", mFramingTimeMs.toString().c_str());
+    }
 }
 
 } // namespace android
@@ -25,6 +25,7 @@
 
 #include "AudioStreamOut.h"
 
+#include <audio_utils/Statistics.h>
 #include <audio_utils/spdif/SPDIFEncoder.h>
 
 namespace android {
@@ -87,6 +88,8 @@ public:
     virtual status_t flush();
     virtual status_t standby();
 
+    void dump(int fd) const override;
+
 private:
 
     class MySPDIFEncoder : public SPDIFEncoder
@@ -111,6 +114,13 @@ private:
     uint32_t             mApplicationSampleRate;
     audio_channel_mask_t mApplicationChannelMask;
 
+    // CPU cost of wrapping one write into IEC61937 data bursts, excluding the
+    // time blocked in the HAL write. Updated on the playback thread, reported
+    // in dump().
+    audio_utils::Statistics<double> mFramingTimeMs{0.995 /* alpha */};
+    // Time spent in writeDataBurst() during the current write(), in ns.
+    int64_t              mHalWriteNs = 0;
+
     ssize_t  writeDataBurst(const void* data, size_t bytes);
     ssize_t  writeInternal(const void* buffer, size_t bytes);
 
@@ -43,7 +43,8 @@ void StateQueueMutatorDump::dump(int fd)
 template<typename T> StateQueue<T>::StateQueue() :
     mAck(NULL), mCurrent(NULL),
     mMutating(&mStates[0]), mExpecting(NULL),
-    mInMutation(false), mIsDirty(false), mIsInitialized(false)
+    mInMutation(false), mIsDirty(false), mIsInitialized(false),
+    mInTransaction(false), mDeferredPush(false), mDeferredBlock(BLOCK_NEVER)
 #ifdef STATE_QUEUE_DUMP
     , mObserverDump(&mObserverDummyDump), mMutatorDump(&mMutatorDummyDump)
 #endif
@@ -99,6 +100,17 @@ template<typename T> bool StateQueue<T>::push(StateQueue<T>::block_t block)
 
     ALOG_ASSERT(!mInMutation, "push() called when in a mutation");
 
+    if (mInTransaction && block != BLOCK_UNTIL_ACKED) {
+        // defer to commitTransaction(), remembering the strongest mode requested
+        if (mIsDirty) {
+            mDeferredPush = true;
+            if (block > mDeferredBlock) {
+                mDeferredBlock = block;
+            }
+        }
+        return true;
+    }
+
 #ifdef STATE_QUEUE_DUMP
     if (block == BLOCK_UNTIL_ACKED) {
         mMutatorDump->mPushAck++;
@@ -185,6 +197,25 @@ template<typename T> bool StateQueue<T>::push(StateQueue<T>::block_t block)
     return true;
 }
 
+template<typename T> void StateQueue<T>::beginTransaction()
+{
+    ALOG_ASSERT(!mInMutation, "beginTransaction() called when in a mutation");
+    mInTransaction = true;
+}
+
+template<typename T> bool StateQueue<T>::commitTransaction()
+{
+    ALOG_ASSERT(!mInMutation, "commitTransaction() called when in a mutation");
+    if (!mInTransaction) {
+        return true;
+    }
+    mInTransaction = false;
+    const block_t block = mDeferredBlock;
+    mDeferredBlock = BLOCK_NEVER;
+    mDeferredPush = false;
+    return push(block);
+}
+
 }   // namespace android
 
 // hack for gcc
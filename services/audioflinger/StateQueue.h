@@ -170,6 +170,21 @@ public:
     };
     bool    push(block_t block = BLOCK_NEVER);
 
+    // Transactional batching.
+    // Between beginTransaction() and commitTransaction(), calls to push() with
+    // BLOCK_NEVER or BLOCK_UNTIL_PUSHED do not publish: they are recorded (keeping
+    // the strongest requested blocking mode) and the state remains dirty, so several
+    // begin()/end()/push() sequences -- e.g. fast track generation changes from
+    // prepareTracks_l() followed by a command change in threadLoop_write() -- are
+    // coalesced into the single publication done by commitTransaction().
+    // push(BLOCK_UNTIL_ACKED) is never deferred, as callers rely on the observer
+    // having acknowledged before they proceed (e.g. track teardown); it publishes
+    // immediately, including any previously deferred changes.
+    // beginTransaction() is idempotent; commitTransaction() outside a transaction
+    // is a no-op returning true.  Must not be called in the middle of a mutation.
+    void    beginTransaction();
+    bool    commitTransaction();
+
     // Return whether the current state is dirty (modified and not pushed).
     bool    isDirty() const { return mIsDirty; }
 
@@ -200,6 +215,9 @@ private:
     bool              mInMutation;      // whether we're currently in the middle of a mutation
     bool              mIsDirty;         // whether mutating state has been modified since last push
     bool              mIsInitialized;   // whether mutating state has been initialized yet
+    bool              mInTransaction;   // whether pushes are currently being deferred
+    bool              mDeferredPush;    // whether a push was deferred by the transaction
+    block_t           mDeferredBlock;   // strongest blocking mode of the deferred pushes
 
 #ifdef STATE_QUEUE_DUMP
     StateQueueObserverDump  mObserverDummyDump; // default area for observer dump if not set
@@ -650,6 +650,28 @@ status_t AudioFlinger::ThreadBase::sendConfigEvent_l(sp<ConfigEvent>& event)
     return status;
 }
 
+// May be called by any thread without holding ThreadBase::mLock.
+// Only valid for fire-and-forget events (event->mWaitStatus must be false);
+// events that need a synchronous status must go through sendConfigEvent_l().
+void AudioFlinger::ThreadBase::sendAsyncConfigEvent(const sp<ConfigEvent>& event)
+{
+    LOG_ALWAYS_FATAL_IF(event->mWaitStatus, "%s: event %d waits for status", __func__,
+            event->mType);
+    if ((event->mRequiresSystemReady && !mSystemReady) || !mAsyncConfigEvents.push(event)) {
+        // Ring full (burst larger than its capacity) or system not ready:
+        // fall back to the locked path, which also handles mPendingConfigEvents.
+        Mutex::Autolock _l(mLock);
+        sp<ConfigEvent> e = event;
+        sendConfigEvent_l(e);
+        return;
+    }
+    // Signal without holding mLock: if the thread loop is concurrently deciding
+    // to sleep the signal can be missed, but the loop wakes periodically and
+    // drains the ring at the top of each cycle, so delivery delay is bounded
+    // by the mixer sleep timeout rather than by mLock contention.
+    mWaitWorkCV.signal();
+}
+
 void AudioFlinger::ThreadBase::sendIoConfigEvent(audio_io_config_event_t event, pid_t pid,
                                                  audio_port_handle_t portId)
 {
@@ -669,6 +691,7 @@ void AudioFlinger::ThreadBase::sendIoConfigEvent_l(audio_io_config_event_t event
     mLatencyMs.reset();
     mProcessTimeMs.reset();
     mMonopipePipeDepthStats.reset();
+    mIoTimeMs.reset();
     mTimestampVerifier.discontinuity(mTimestampVerifier.DISCONTINUITY_MODE_CONTINUOUS);
 
     sp<ConfigEvent> configEvent = (ConfigEvent *)new IoConfigEvent(event, pid, portId);
@@ -677,8 +700,10 @@ void AudioFlinger::ThreadBase::sendIoConfigEvent_l(audio_io_config_event_t event
 
 void AudioFlinger::ThreadBase::sendPrioConfigEvent(pid_t pid, pid_t tid, int32_t prio, bool forApp)
 {
-    Mutex::Autolock _l(mLock);
-    sendPrioConfigEvent_l(pid, tid, prio, forApp);
+    // Fire-and-forget: use the lock-free ring so a binder thread raising a
+    // client priority never contends with the mixer loop for mLock.
+    sp<ConfigEvent> configEvent = (ConfigEvent *)new PrioConfigEvent(pid, tid, prio, forApp);
+    sendAsyncConfigEvent(configEvent);
 }
 
 // sendPrioConfigEvent_l() must be called with ThreadBase::mLock held
@@ -723,6 +748,40 @@ status_t AudioFlinger::ThreadBase::sendCreateAudioPatchConfigEvent(
     return status;
 }
 
+sp<AudioFlinger::ThreadBase::ConfigEvent>
+        AudioFlinger::ThreadBase::postCreateAudioPatchConfigEvent(const struct audio_patch *patch)
+{
+    Mutex::Autolock _l(mLock);
+    sp<ConfigEvent> configEvent = (ConfigEvent *)new CreateAudioPatchConfigEvent(
+            *patch, AUDIO_PATCH_HANDLE_NONE);
+    mConfigEvents.add(configEvent);
+    ALOGV("%s() num events %zu", __func__, mConfigEvents.size());
+    mWaitWorkCV.signal();
+    return configEvent;
+}
+
+/*static*/ status_t AudioFlinger::ThreadBase::waitForCreateAudioPatchConfigEvent(
+        const sp<ConfigEvent>& event, audio_patch_handle_t *handle)
+{
+    status_t status;
+    {
+        Mutex::Autolock _l(event->mLock);
+        while (event->mWaitStatus) {
+            if (event->mCond.waitRelative(event->mLock, kConfigEventTimeoutNs) != NO_ERROR) {
+                event->mStatus = TIMED_OUT;
+                event->mWaitStatus = false;
+            }
+        }
+        status = event->mStatus;
+    }
+    if (status == NO_ERROR) {
+        CreateAudioPatchConfigEventData *data =
+                (CreateAudioPatchConfigEventData *)event->mData.get();
+        *handle = data->mHandle;
+    }
+    return status;
+}
+
 status_t AudioFlinger::ThreadBase::sendReleaseAudioPatchConfigEvent(
                                                                 const audio_patch_handle_t handle)
 {
@@ -753,8 +812,9 @@ void AudioFlinger::ThreadBase::sendResizeBufferConfigEvent_l(int32_t maxSharedAu
 
 void AudioFlinger::ThreadBase::sendCheckOutputStageEffectsEvent()
 {
-    Mutex::Autolock _l(mLock);
-    sendCheckOutputStageEffectsEvent_l();
+    sp<ConfigEvent> configEvent =
+            (ConfigEvent *)new CheckOutputStageEffectsEvent();
+    sendAsyncConfigEvent(configEvent);
 }
 
 void AudioFlinger::ThreadBase::sendCheckOutputStageEffectsEvent_l()
@@ -775,6 +835,15 @@ void AudioFlinger::ThreadBase::processConfigEvents_l()
 {
     bool configChanged = false;
 
+    // Drain events pushed lock-free by binder threads via sendAsyncConfigEvent()
+    // into the ordered queue before processing, so both paths share one dispatch.
+    {
+        sp<ConfigEvent> asyncEvent;
+        while (mAsyncConfigEvents.pop(asyncEvent)) {
+            mConfigEvents.add(asyncEvent);
+        }
+    }
+
     while (!mConfigEvents.isEmpty()) {
         ALOGV("processConfigEvents_l() remaining events %zu", mConfigEvents.size());
         sp<ConfigEvent> event = mConfigEvents[0];
@@ -1044,6 +1113,22 @@ void AudioFlinger::ThreadBase::dumpBase_l(int fd, const Vector<String16>& args _
             isOutput() ? "write" : "read",
             mMonopipePipeDepthStats.toString().c_str());
     }
+
+    if (mIoTimeMs.getN() > 0) {
+        dprintf(fd, "  Hal %s time ms stats: %s\n",
+                isOutput() ? "write" : "read",
+                mIoTimeMs.toString().c_str());
+    }
+
+    if (isOutput()) {
+        dprintf(fd, "  Underrun counters: periods=%llu frames=%llu silent periods=%llu\n",
+                (unsigned long long)mUnderrunPeriods.load(std::memory_order_relaxed),
+                (unsigned long long)mUnderrunFrames.load(std::memory_order_relaxed),
+                (unsigned long long)mSilentPeriods.load(std::memory_order_relaxed));
+    } else {
+        dprintf(fd, "  Overrun counter: %llu\n",
+                (unsigned long long)mOverruns.load(std::memory_order_relaxed));
+    }
 }
 
 void AudioFlinger::ThreadBase::dumpEffectChains_l(int fd, const Vector<String16>& args)
@@ -2008,6 +2093,22 @@ void AudioFlinger::ThreadBase::sendStatistics(bool force)
         item->setDouble(MM_PREFIX "monopipePipeDepthStats.std",
                         mMonopipePipeDepthStats.getStdDev());
     }
+    if (mIoTimeMs.getN() > 0) {
+        item->setDouble(MM_PREFIX "ioTimeMs.mean", mIoTimeMs.getMean());
+        item->setDouble(MM_PREFIX "ioTimeMs.std", mIoTimeMs.getStdDev());
+    }
+    // the underrun and overrun counters are monotonic since thread creation.
+    if (isOutput()) {
+        item->setInt64(MM_PREFIX "underrunPeriods",
+                (int64_t)mUnderrunPeriods.load(std::memory_order_relaxed));
+        item->setInt64(MM_PREFIX "underrunFrames",
+                (int64_t)mUnderrunFrames.load(std::memory_order_relaxed));
+        item->setInt64(MM_PREFIX "silentPeriods",
+                (int64_t)mSilentPeriods.load(std::memory_order_relaxed));
+    } else {
+        item->setInt64(MM_PREFIX "overruns",
+                (int64_t)mOverruns.load(std::memory_order_relaxed));
+    }
 
     item->selfrecord();
 }
@@ -2254,6 +2355,7 @@ void AudioFlinger::PlaybackThread::dumpInternals_l(int fd, const Vector<String16
         dprintf(fd, "  PipeSink frames written: %lld\n", (long long)mPipeSink->framesWritten());
     }
     if (output != nullptr) {
+        output->dump(fd);
         dprintf(fd, "  Hal stream dump:\n");
         (void)output->stream->dump(fd, args);
     }
@@ -3917,7 +4019,8 @@ bool AudioFlinger::PlaybackThread::threadLoop()
                     sendStatistics(false /* force */);
                 }
 
-                if (mActiveTracks.isEmpty() && mConfigEvents.isEmpty()) {
+                if (mActiveTracks.isEmpty() && mConfigEvents.isEmpty()
+                        && mAsyncConfigEvents.isEmpty()) {
                     // we're about to wait, flush the binder command buffer
                     IPCThreadState::self()->flushCommands();
 
@@ -4008,6 +4111,7 @@ bool AudioFlinger::PlaybackThread::threadLoop()
                     mCurrentWriteLength = mSinkBufferSize;
 
                     // Tally underrun frames as we are inserting 0s here.
+                    bool silentUnderrun = false;
                     for (const auto& track : activeTracks) {
                         if (track->mFillingUpStatus == Track::FS_ACTIVE
                                 && !track->isStopped()
@@ -4017,8 +4121,12 @@ bool AudioFlinger::PlaybackThread::threadLoop()
                                     __func__, track->id(), track->getTrackStateAsString(),
                                     mNormalFrameCount);
                             track->mAudioTrackServerProxy->tallyUnderrunFrames(mNormalFrameCount);
+                            silentUnderrun = true;
                         }
                     }
+                    if (silentUnderrun) {
+                        mSilentPeriods.fetch_add(1, std::memory_order_relaxed);
+                    }
                 }
             }
             // Either threadLoop_mix() or threadLoop_sleepTime() should have set
@@ -4219,6 +4327,7 @@ bool AudioFlinger::PlaybackThread::threadLoop()
                                 Mutex::Autolock _l(mLock);
                                 mIoJitterMs.add(jitterMs);
                                 mProcessTimeMs.add(processMs);
+                                mIoTimeMs.add((lastIoEndNs - lastIoBeginNs) * 1e-6);
 
                                 if (mPipeSink.get() != nullptr) {
                                     // Using the Monopipe availableToWrite, we estimate the current
@@ -4341,7 +4450,8 @@ bool AudioFlinger::PlaybackThread::threadLoop()
                     // update sleep time (which is >= 0)
                     mSleepTimeUs = deltaNs / 1000;
                 }
-                if (!mSignalPending && mConfigEvents.isEmpty() && !exitPending()) {
+                if (!mSignalPending && mConfigEvents.isEmpty() && mAsyncConfigEvents.isEmpty()
+                        && !exitPending()) {
                     mWaitWorkCV.waitRelative(mLock, microseconds((nsecs_t)mSleepTimeUs));
                 }
                 ATRACE_END();
@@ -4919,6 +5029,13 @@ AudioFlinger::MixerThread::MixerThread(const sp<AudioFlinger>& audioFlinger, Aud
         mAudioWatchdog->run("AudioWatchdog", PRIORITY_URGENT_AUDIO);
         tid = mAudioWatchdog->getTid();
         sendPrioConfigEvent(getpid(), tid, kPriorityFastMixer, false /*forApp*/);
+
+        // hand the watchdog's heartbeat slot to the fast mixer, which will
+        // publish a beat per cycle using atomics only
+        state = sq->begin();
+        state->mHeartbeat = mAudioWatchdog->heartbeat();
+        sq->end();
+        sq->push(FastMixerStateQueue::BLOCK_UNTIL_PUSHED);
 #endif
     } else {
 #ifdef TEE_SINK
@@ -5028,6 +5145,8 @@ ssize_t AudioFlinger::MixerThread::threadLoop_write()
         } else {
             sq->end(false /*didModify*/);
         }
+        // single publication per cycle: includes changes deferred by prepareTracks_l()
+        sq->commitTransaction();
     }
     return PlaybackThread::threadLoop_write();
 }
@@ -5066,6 +5185,7 @@ void AudioFlinger::MixerThread::threadLoop_standby()
         } else {
             sq->end(false /*didModify*/);
         }
+        sq->commitTransaction();
     }
     PlaybackThread::threadLoop_standby();
 }
@@ -5148,8 +5268,11 @@ void AudioFlinger::MixerThread::threadLoop_sleepTime()
                 const size_t pipeFrames = monoPipe->maxFrames();
                 const size_t framesLeft = pipeFrames - max(availableToWrite, 0);
                 // HAL_framecount <= framesDelay ~ framesLeft / 2 <= Normal_Mixer_framecount
+                // (times mRelaxedPeriodFactor when all active tracks are deep-buffer
+                // tolerant, so a lone low-rate stream doesn't keep the full cadence)
                 const size_t framesDelay = std::min(
-                        mNormalFrameCount, max(framesLeft / 2, mFrameCount));
+                        mRelaxedPeriodFactor * mNormalFrameCount,
+                        max(framesLeft / 2, mFrameCount));
                 ALOGV("pipeFrames:%zu framesLeft:%zu framesDelay:%zu",
                         pipeFrames, framesLeft, framesDelay);
                 mSleepTimeUs = framesDelay * MICROS_PER_SECOND / mSampleRate;
@@ -5185,6 +5308,12 @@ void AudioFlinger::MixerThread::threadLoop_sleepTime()
                 "anticipated start");
     }
     // TODO add standby time extension fct of effect tail
+
+    if (mFastMixer != 0) {
+        // Not writing this cycle: publish anything prepareTracks_l() deferred
+        // so the fast mixer still observes track changes without extra delay.
+        mFastMixer->sq()->commitTransaction();
+    }
 }
 
 // prepareTracks_l() must be called with ThreadBase::mLock held
@@ -5232,6 +5361,12 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::MixerThread::prepareTrac
     bool coldIdle = false;
     if (mFastMixer != 0) {
         sq = mFastMixer->sq();
+        // Defer our push so it coalesces with the possible command change in
+        // threadLoop_write(), for a single publication per mixer cycle even when
+        // several fast tracks change generation at once.  The transaction is
+        // committed by threadLoop_write(), threadLoop_sleepTime() or
+        // threadLoop_standby(), whichever runs next in this cycle.
+        sq->beginTransaction();
         state = sq->begin();
         coldIdle = state->mCommand == FastMixerState::COLD_IDLE;
     }
@@ -5242,9 +5377,11 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::MixerThread::prepareTrac
     // DeferredOperations handles statistics after setting mixerStatus.
     class DeferredOperations {
     public:
-        DeferredOperations(mixer_state *mixerStatus, ThreadMetrics *threadMetrics)
+        DeferredOperations(mixer_state *mixerStatus, ThreadMetrics *threadMetrics,
+                MixerThread *thread)
             : mMixerStatus(mixerStatus)
-            , mThreadMetrics(threadMetrics) {}
+            , mThreadMetrics(threadMetrics)
+            , mThread(thread) {}
 
         // when leaving scope, tally frames properly.
         ~DeferredOperations() {
@@ -5260,6 +5397,10 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::MixerThread::prepareTrac
             }
             // send the max underrun frames for this mixer period
             mThreadMetrics->logUnderrunFrames(maxUnderrunFrames);
+            if (maxUnderrunFrames > 0) {
+                mThread->mUnderrunPeriods.fetch_add(1, std::memory_order_relaxed);
+                mThread->mUnderrunFrames.fetch_add(maxUnderrunFrames, std::memory_order_relaxed);
+            }
         }
 
         // tallyUnderrunFrames() is called to update the track counters
@@ -5272,8 +5413,9 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::MixerThread::prepareTrac
     private:
         const mixer_state * const mMixerStatus;
         ThreadMetrics * const mThreadMetrics;
+        MixerThread * const mThread;
         std::vector<std::pair<sp<Track>, size_t>> mUnderrunFrames;
-    } deferredOperations(&mixerStatus, &mThreadMetrics);
+    } deferredOperations(&mixerStatus, &mThreadMetrics, this);
     // implicit nested scope for variable capture
 
     bool noFastHapticTrack = true;
@@ -5963,6 +6105,31 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::MixerThread::prepareTrac
     if (fastTracks > 0) {
         mixerStatus = MIXER_TRACKS_READY;
     }
+
+    // Adaptive cadence: qualify this cycle for a relaxed mixer period if every
+    // active track tolerates deep buffering.  A fast track or a track with a
+    // small client buffer disqualifies immediately (snap back); the factor is
+    // only raised after a sustained run of qualifying cycles.
+    {
+        bool deepBufferTolerant = fastTracks == 0 && mActiveTracks.size() > 0;
+        if (deepBufferTolerant) {
+            for (const sp<Track> &t : mActiveTracks) {
+                if (t->isFastTrack()
+                        || t->frameCount() < kDeepBufferMinPeriods * mNormalFrameCount) {
+                    deepBufferTolerant = false;
+                    break;
+                }
+            }
+        }
+        if (!deepBufferTolerant) {
+            mRelaxedPeriodFactor = 1;
+            mRelaxedQualifyingCycles = 0;
+        } else if (mRelaxedQualifyingCycles < kRelaxedEntryCycles) {
+            mRelaxedQualifyingCycles++;
+        } else if (mRelaxedPeriodFactor < kMaxRelaxedPeriodFactor) {
+            mRelaxedPeriodFactor++;     // widen gradually, one period at a time
+        }
+    }
     return mixerStatus;
 }
 
@@ -6115,6 +6282,8 @@ void AudioFlinger::MixerThread::dumpInternals_l(int fd, const Vector<String16>&
     PlaybackThread::dumpInternals_l(fd, args);
     dprintf(fd, "  Thread throttle time (msecs): %u\n", mThreadThrottleTimeMs);
     dprintf(fd, "  AudioMixer tracks: %s\n", mAudioMixer->trackNames().c_str());
+    dprintf(fd, "  AudioMixer process hook calls: %s\n",
+            mAudioMixer->processHookCounts().c_str());
     dprintf(fd, "  Master mono: %s\n", mMasterMono ? "on" : "off");
     dprintf(fd, "  Master balance: %f (%s)\n", mMasterBalance.load(),
             (hasFastMixer() ? std::to_string(mFastMixer->getMasterBalance())
@@ -6190,6 +6359,8 @@ void AudioFlinger::DirectOutputThread::dumpInternals_l(int fd, const Vector<Stri
     PlaybackThread::dumpInternals_l(fd, args);
     dprintf(fd, "  Master balance: %f  Left: %f  Right: %f\n",
             mMasterBalance.load(), mMasterBalanceLeft, mMasterBalanceRight);
+    dprintf(fd, "  HAL writes: passthrough %llu copied %llu\n",
+            (unsigned long long)mPassthroughWrites, (unsigned long long)mCopiedWrites);
 }
 
 void AudioFlinger::DirectOutputThread::setMasterBalance(float balance)
@@ -6502,10 +6673,51 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::DirectOutputThread::prep
     return mixerStatus;
 }
 
+void AudioFlinger::DirectOutputThread::releasePassthroughBuffer()
+{
+    if (mPassthroughTrack != 0) {
+        mPassthroughTrack->releaseBuffer(&mPassthroughBuffer);
+        mPassthroughTrack.clear();
+    }
+}
+
 void AudioFlinger::DirectOutputThread::threadLoop_mix()
 {
     size_t frameCount = mFrameCount;
     int8_t *curBuf = (int8_t *)mSinkBuffer;
+
+    // Drop a region left over from an iteration whose write was skipped
+    // (e.g. the output became suspended after mixing); the regular path
+    // discards such data as well.
+    releasePassthroughBuffer();
+
+    // Bit-exact passthrough: a direct output performs no sample processing
+    // on this thread (volume goes to the HAL or the effect chain), so when
+    // the track's ring yields one contiguous region covering the whole
+    // burst, hand that region to threadLoop_write() as-is instead of
+    // copying it through mSinkBuffer.  It is released as soon as the HAL
+    // write returns.
+    if (mEffectChains.isEmpty() && !mUseAsyncWrite && !isSuspended()) {
+        AudioBufferProvider::Buffer buffer;
+        buffer.frameCount = frameCount;
+        status_t status = mActiveTrack->getNextBuffer(&buffer);
+        if (status == NO_ERROR && buffer.raw != NULL) {
+            if (buffer.frameCount == frameCount) {
+                mPassthroughBuffer = buffer;
+                mPassthroughTrack = mActiveTrack;
+                mCurrentWriteLength = frameCount * mFrameSize;
+                mSleepTimeUs = 0;
+                mStandbyTimeNs = systemTime() + mStandbyDelayNs;
+                mActiveTrack.clear();
+                return;
+            }
+            // Less than a full contiguous burst available; give the region
+            // back untouched and gather it through mSinkBuffer below.
+            buffer.frameCount = 0;
+            mActiveTrack->releaseBuffer(&buffer);
+        }
+    }
+
     // output audio to hardware
     while (frameCount) {
         AudioBufferProvider::Buffer buffer;
@@ -6529,6 +6741,40 @@ void AudioFlinger::DirectOutputThread::threadLoop_mix()
     mActiveTrack.clear();
 }
 
+ssize_t AudioFlinger::DirectOutputThread::threadLoop_write()
+{
+    if (mPassthroughTrack == 0) {
+        ++mCopiedWrites;
+        return PlaybackThread::threadLoop_write();
+    }
+
+    LOG_HIST_TS();
+    mInWrite = true;
+    ATRACE_BEGIN("write");
+    ssize_t bytesWritten = mOutput->write(mPassthroughBuffer.raw, mBytesRemaining);
+    ATRACE_END();
+
+    if (bytesWritten > 0 && (size_t)bytesWritten < mBytesRemaining) {
+        // The HAL accepted only part of the burst.  Move the unwritten tail
+        // into mSinkBuffer at the offset the regular path expects, so later
+        // iterations drain it without holding the client region.
+        memcpy((int8_t *)mSinkBuffer + bytesWritten,
+                (int8_t *)mPassthroughBuffer.raw + bytesWritten,
+                mBytesRemaining - bytesWritten);
+    }
+    releasePassthroughBuffer();
+    ++mPassthroughWrites;
+
+    mNumWrites++;
+    mInWrite = false;
+    if (mStandby) {
+        mThreadMetrics.logBeginInterval();
+        mThreadSnapshot.onBegin();
+        mStandby = false;
+    }
+    return bytesWritten;
+}
+
 void AudioFlinger::DirectOutputThread::threadLoop_sleepTime()
 {
     // do not write to HAL when paused
@@ -6549,6 +6795,7 @@ void AudioFlinger::DirectOutputThread::threadLoop_exit()
 {
     {
         Mutex::Autolock _l(mLock);
+        releasePassthroughBuffer();
         for (size_t i = 0; i < mTracks.size(); i++) {
             if (mTracks[i]->isFlushPending()) {
                 mTracks[i]->flushAck();
@@ -6673,6 +6920,8 @@ void AudioFlinger::DirectOutputThread::cacheParameters_l()
 
 void AudioFlinger::DirectOutputThread::flushHw_l()
 {
+    // Give back any held client region before the proxy positions are reset.
+    releasePassthroughBuffer();
     PlaybackThread::flushHw_l();
     mOutput->flush();
     mHwPaused = false;
@@ -8249,6 +8498,7 @@ reacquire_wakelock:
             case OVERRUN_TRUE:
                 // client isn't retrieving buffers fast enough
                 if (!activeTrack->setOverflow()) {
+                    mOverruns.fetch_add(1, std::memory_order_relaxed);
                     nsecs_t now = systemTime();
                     // FIXME should lastWarning per track?
                     if ((now - lastWarning) > kWarningThrottleNs) {
@@ -8287,6 +8537,7 @@ unlock:
             Mutex::Autolock _l(mLock);
             mIoJitterMs.add(jitterMs);
             mProcessTimeMs.add(processMs);
+            mIoTimeMs.add((lastIoEndNs - lastIoBeginNs) * 1e-6);
         }
         // update timing info.
         mLastIoBeginNs = lastIoBeginNs;
@@ -9958,7 +10209,7 @@ bool AudioFlinger::MmapThread::threadLoop()
             // A signal was raised while we were unlocked
             mSignalPending = false;
         } else {
-            if (mConfigEvents.isEmpty()) {
+            if (mConfigEvents.isEmpty() && mAsyncConfigEvents.isEmpty()) {
                 // we're about to wait, flush the binder command buffer
                 IPCThreadState::self()->flushCommands();
 
@@ -348,6 +348,10 @@ public:
                 // Can temporarily release the lock if waiting for a reply from
                 // processConfigEvents_l().
                 status_t    sendConfigEvent_l(sp<ConfigEvent>& event);
+                // Lock-free alternative for events that do not wait for a status:
+                // pushes to mAsyncConfigEvents without taking mLock, falling back to
+                // the locked path if the ring is full or the system is not ready.
+                void        sendAsyncConfigEvent(const sp<ConfigEvent>& event);
                 void        sendIoConfigEvent(audio_io_config_event_t event, pid_t pid = 0,
                                               audio_port_handle_t portId = AUDIO_PORT_HANDLE_NONE);
                 void        sendIoConfigEvent_l(audio_io_config_event_t event, pid_t pid = 0,
@@ -357,6 +361,13 @@ public:
                 status_t    sendSetParameterConfigEvent_l(const String8& keyValuePair);
                 status_t    sendCreateAudioPatchConfigEvent(const struct audio_patch *patch,
                                                             audio_patch_handle_t *handle);
+                // Posts a CreateAudioPatchConfigEvent without waiting for its status,
+                // so a caller creating several patches can overlap processing across
+                // threads.  Each posted event must be paired with a call to
+                // waitForCreateAudioPatchConfigEvent() to collect status and handle.
+                sp<ConfigEvent> postCreateAudioPatchConfigEvent(const struct audio_patch *patch);
+    static      status_t    waitForCreateAudioPatchConfigEvent(const sp<ConfigEvent>& event,
+                                                               audio_patch_handle_t *handle);
                 status_t    sendReleaseAudioPatchConfigEvent(audio_patch_handle_t handle);
                 status_t    sendUpdateOutDeviceConfigEvent(
                                     const DeviceDescriptorBaseVector& outDevices);
@@ -653,6 +664,9 @@ protected:
                 AudioDeviceTypeAddr       mInDeviceTypeAddr;   // input device type and address
                 Vector< sp<ConfigEvent> >     mConfigEvents;
                 Vector< sp<ConfigEvent> >     mPendingConfigEvents; // events awaiting system ready
+                // Lock-free side channel for fire-and-forget events pushed by binder
+                // threads without taking mLock; drained by processConfigEvents_l().
+                ConfigEventRing<ConfigEvent>  mAsyncConfigEvents;
 
                 // These fields are written and read by thread itself without lock or barrier,
                 // and read by other threads without lock or barrier via standby(), outDeviceTypes()
@@ -706,6 +720,18 @@ protected:
                 audio_utils::Statistics<double> mProcessTimeMs{0.995 /* alpha */};
                 audio_utils::Statistics<double> mLatencyMs{0.995 /* alpha */};
                 audio_utils::Statistics<double> mMonopipePipeDepthStats{0.999 /* alpha */};
+                audio_utils::Statistics<double> mIoTimeMs{0.995 /* alpha */};
+
+                // Always-on monotonic counters in the spirit of FastThreadDumpState,
+                // maintained by normal (non-fast) threads and readable through
+                // dumpBase_l() and sendStatistics() without stopping audio.
+                // Unlike the statistics above they are never reset for the life
+                // of the thread.  Playback threads tally underruns broken out by
+                // cause; record threads tally track overflow transitions.
+                std::atomic<uint64_t> mUnderrunPeriods{0}; // mix periods where a ready track underran
+                std::atomic<uint64_t> mUnderrunFrames{0};  // max underrun frames, summed per period
+                std::atomic<uint64_t> mSilentPeriods{0};   // periods of silence inserted on underrun
+                std::atomic<uint64_t> mOverruns{0};        // record track overflow transitions
 
                 // Save the last count when we delivered statistics to mediametrics.
                 int64_t                 mLastRecordedTimestampVerifierN = 0;
@@ -1505,6 +1531,21 @@ private:
                 //          mFastMixer->sq()    // for mutating and pushing state
                 int32_t     mFastMixerFutex;    // for cold idle
 
+                // Adaptive mixer cadence.  When every active track is deep-buffer
+                // tolerant (normal track with a client buffer of several mixer
+                // periods), the normal mixer lets the pipe to the fast mixer drain
+                // further before refilling, stretching its effective period up to
+                // kMaxRelaxedPeriodFactor normal periods; it snaps back to 1 the
+                // moment a latency-sensitive track becomes active.  Updated in
+                // prepareTracks_l(), consumed in threadLoop_sleepTime(); threadLoop
+                // only, no locks required.  The fast mixer cadence is tied to the
+                // HAL fast buffer and is not affected.
+                static constexpr uint32_t kMaxRelaxedPeriodFactor = 4;
+                static constexpr uint32_t kRelaxedEntryCycles = 32;
+                static constexpr uint32_t kDeepBufferMinPeriods = 3;
+                uint32_t    mRelaxedPeriodFactor = 1;
+                uint32_t    mRelaxedQualifyingCycles = 0;
+
                 std::atomic_bool mMasterMono;
 public:
     virtual     bool        hasFastMixer() const { return mFastMixer != 0; }
@@ -1572,6 +1613,7 @@ protected:
     // threadLoop snippets
     virtual     mixer_state prepareTracks_l(Vector< sp<Track> > *tracksToRemove);
     virtual     void        threadLoop_mix();
+    virtual     ssize_t     threadLoop_write();
     virtual     void        threadLoop_sleepTime();
     virtual     void        threadLoop_exit();
     virtual     bool        shouldStandby_l();
@@ -1587,6 +1629,17 @@ protected:
     // prepareTracks_l() tells threadLoop_mix() the name of the single active track
     sp<Track>               mActiveTrack;
 
+    // Bit-exact passthrough: region of the active track's shared memory ring
+    // handed to the HAL write as-is, bypassing the copy through mSinkBuffer.
+    // Only held from threadLoop_mix() to the following threadLoop_write();
+    // releasePassthroughBuffer() drops it on any path that skips the write.
+    AudioBufferProvider::Buffer mPassthroughBuffer;
+    sp<Track>               mPassthroughTrack;
+    uint64_t                mPassthroughWrites = 0; // wrote from the client ring
+    uint64_t                mCopiedWrites = 0;      // wrote through mSinkBuffer
+
+                void        releasePassthroughBuffer();
+
     wp<Track>               mPreviousTrack;         // used to detect track switch
 
     // This must be initialized for initial condition of mMasterBalance = 0 (disabled).
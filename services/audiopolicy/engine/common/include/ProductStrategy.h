@@ -20,6 +20,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -168,6 +169,13 @@ public:
 
 private:
     product_strategy_t mDefaultStrategy = PRODUCT_STRATEGY_NONE;
+
+    /**
+     * Memoized attributes to strategy lookups, keyed by the attributes fields the
+     * matching rules consider. Strategies and their attributes are fixed once the
+     * engine configuration is loaded, initialize() resets the cache.
+     */
+    mutable std::unordered_map<std::string, product_strategy_t> mAttributesToStrategyCache;
 };
 
 using ProductStrategyDevicesRoleMap =
@@ -23,6 +23,7 @@
 #include <media/TypeConverter.h>
 #include <utils/String8.h>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include <log/log.h>
@@ -30,6 +31,26 @@
 
 namespace android {
 
+namespace {
+
+/**
+ * Lookup key covering the audio_attributes_t fields considered by
+ * AudioProductStrategy::attributesMatches: usage, content type, flags and tags.
+ */
+std::string toCacheKey(const audio_attributes_t &attr)
+{
+    std::string key = std::to_string(attr.usage);
+    key += ';';
+    key += std::to_string(attr.content_type);
+    key += ';';
+    key += std::to_string(attr.flags);
+    key += ';';
+    key.append(attr.tags, strnlen(attr.tags, sizeof(attr.tags)));
+    return key;
+}
+
+} // namespace
+
 ProductStrategy::ProductStrategy(const std::string &name) :
     mName(name),
     mId(static_cast<product_strategy_t>(HandleGenerator<uint32_t>::getNextHandle()))
@@ -167,10 +188,28 @@ void ProductStrategy::dump(String8 *dst, int spaces) const
 product_strategy_t ProductStrategyMap::getProductStrategyForAttributes(
         const audio_attributes_t &attr, bool fallbackOnDefault) const
 {
-    for (const auto &iter : *this) {
-        if (iter.second->matches(attr)) {
-            return iter.second->getId();
+    // The first-match walk below evaluates attributesMatches against every
+    // attributes vector of every strategy. It sits on the getOutputForAttr()
+    // path and clients keep reusing the same few attributes, so memoize the raw
+    // match result; the fallback is applied after the cache so both fallback
+    // flavors share entries.
+    product_strategy_t strategy;
+    const std::string key = toCacheKey(attr);
+    const auto &cacheIter = mAttributesToStrategyCache.find(key);
+    if (cacheIter != mAttributesToStrategyCache.end()) {
+        strategy = cacheIter->second;
+    } else {
+        strategy = PRODUCT_STRATEGY_NONE;
+        for (const auto &iter : *this) {
+            if (iter.second->matches(attr)) {
+                strategy = iter.second->getId();
+                break;
+            }
         }
+        mAttributesToStrategyCache.emplace(key, strategy);
+    }
+    if (strategy != PRODUCT_STRATEGY_NONE) {
+        return strategy;
     }
     ALOGV("%s: No matching product strategy for attributes %s, return default", __FUNCTION__,
           toString(attr).c_str());
@@ -306,6 +345,9 @@ void ProductStrategyMap::initialize()
 {
     mDefaultStrategy = getDefault();
     ALOG_ASSERT(mDefaultStrategy != PRODUCT_STRATEGY_NONE, "No default product strategy found");
+    // Strategies may have been added or replaced since the last configuration
+    // load; drop any lookups memoized against the previous set.
+    mAttributesToStrategyCache.clear();
 }
 
 void ProductStrategyMap::dump(String8 *dst, int spaces) const
@@ -20,7 +20,11 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <chrono>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include <cutils/misc.h>
 #include <media/AudioEffect.h>
 #include <media/EffectsConfig.h>
@@ -270,34 +274,81 @@ status_t AudioPolicyEffects::addOutputSessionEffects(audio_io_handle_t output,
     ALOGV("addOutputSessionEffects(): session: %d, refCount: %d",
           audioSession, procDesc->mRefCount);
     if (procDesc->mRefCount == 1) {
-        // make sure effects are associated to audio server even if we are executing a binder call
-        int64_t token = IPCThreadState::self()->clearCallingIdentity();
-        Vector <EffectDesc *> effects = mOutputStreams.valueAt(index)->mEffects;
-        for (size_t i = 0; i < effects.size(); i++) {
-            EffectDesc *effect = effects[i];
-            AttributionSourceState attributionSource;
-            attributionSource.packageName = "android";
-            attributionSource.token = sp<BBinder>::make();
-            sp<AudioEffect> fx = new AudioEffect(attributionSource);
-            fx->set(NULL, &effect->mUuid, 0, 0, 0, audioSession, output);
-            status_t status = fx->initCheck();
-            if (status != NO_ERROR && status != ALREADY_EXISTS) {
-                ALOGE("addOutputSessionEffects(): failed to create Fx  %s on session %d",
-                      effect->mName, audioSession);
-                // fx goes out of scope and strong ref on AudioEffect is released
-                continue;
+        // Instantiate the effects asynchronously: vendor effect libraries can
+        // take tens of milliseconds to cold-load and this runs on the binder
+        // call starting the client's track. The track starts effect-free and
+        // the effects are attached and enabled once ready.
+        for (auto it = mOutputSessionEffectFutures.begin();
+                it != mOutputSessionEffectFutures.end();) {
+            if (it->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                it = mOutputSessionEffectFutures.erase(it);
+            } else {
+                ++it;
             }
-            ALOGV("addOutputSessionEffects(): added Fx %s on session: %d for stream: %d",
-                  effect->mName, audioSession, (int32_t)stream);
-            procDesc->mEffects.add(fx);
         }
-
-        procDesc->setProcessorEnabled(true);
-        IPCThreadState::self()->restoreCallingIdentity(token);
+        mOutputSessionEffectFutures.push_back(std::async(
+                std::launch::async, &AudioPolicyEffects::doAddOutputSessionEffects,
+                this, output, stream, audioSession));
     }
     return status;
 }
 
+void AudioPolicyEffects::doAddOutputSessionEffects(audio_io_handle_t output,
+                         audio_stream_type_t stream,
+                         audio_session_t audioSession)
+{
+    // Copy the effect descriptors under lock and instantiate without holding
+    // it, so that a slow effect library does not stall other sessions. The
+    // effects are created from this thread, so they are associated with audio
+    // server without juggling the binder calling identity.
+    std::vector<std::pair<effect_uuid_t, std::string>> effects;
+    {
+        Mutex::Autolock _l(mLock);
+        ssize_t index = mOutputStreams.indexOfKey(stream);
+        if (index < 0) {
+            return;
+        }
+        for (EffectDesc *effect : mOutputStreams.valueAt(index)->mEffects) {
+            effects.emplace_back(effect->mUuid, effect->mName);
+        }
+    }
+
+    Vector< sp<AudioEffect> > createdEffects;
+    for (const auto& [uuid, name] : effects) {
+        AttributionSourceState attributionSource;
+        attributionSource.packageName = "android";
+        attributionSource.token = sp<BBinder>::make();
+        sp<AudioEffect> fx = new AudioEffect(attributionSource);
+        fx->set(NULL, &uuid, 0, 0, 0, audioSession, output);
+        status_t status = fx->initCheck();
+        if (status != NO_ERROR && status != ALREADY_EXISTS) {
+            ALOGE("%s(): failed to create Fx %s on session %d", __func__,
+                  name.c_str(), audioSession);
+            // fx goes out of scope and strong ref on AudioEffect is released
+            continue;
+        }
+        ALOGV("%s(): added Fx %s on session: %d for stream: %d", __func__,
+              name.c_str(), audioSession, (int32_t)stream);
+        createdEffects.add(fx);
+    }
+
+    Mutex::Autolock _l(mLock);
+    ssize_t idx = mOutputSessions.indexOfKey(audioSession);
+    if (idx < 0) {
+        // Session was released while the effects were loading; the created
+        // effects are dropped as they go out of scope.
+        ALOGV("%s(): session %d released before effects were ready", __func__, audioSession);
+        return;
+    }
+    EffectVector *procDesc = mOutputSessions.valueAt(idx);
+    if (!procDesc->mEffects.isEmpty()) {
+        // Another creation already attached effects for this session.
+        return;
+    }
+    procDesc->mEffects = createdEffects;
+    procDesc->setProcessorEnabled(true);
+}
+
 status_t AudioPolicyEffects::releaseOutputSessionEffects(audio_io_handle_t output,
                          audio_stream_type_t stream,
                          audio_session_t audioSession)
@@ -28,6 +28,7 @@
 #include <android-base/thread_annotations.h>
 
 #include <future>
+#include <vector>
 
 namespace android {
 
@@ -109,6 +110,13 @@ public:
 private:
     void initDefaultDeviceEffects();
 
+    // Instantiates and attaches the default effects for an output session.
+    // Runs asynchronously to addOutputSessionEffects() so that loading vendor
+    // effect libraries does not delay the start of the client's track.
+    void doAddOutputSessionEffects(audio_io_handle_t output,
+                                   audio_stream_type_t stream,
+                                   audio_session_t audioSession);
+
     // class to store the description of an effects and its parameters
     // as defined in audio_effects.conf
     class EffectDesc {
@@ -276,6 +284,13 @@ private:
      * We must store the reference of the furture garantee real asynchronous operation.
      */
     std::future<void> mDefaultDeviceEffectFuture;
+
+    /**
+     * Pending output session effect creations, launched by
+     * addOutputSessionEffects(). The futures must be stored to guarantee real
+     * asynchronous operation; completed entries are pruned on the next launch.
+     */
+    std::vector<std::future<void>> mOutputSessionEffectFutures GUARDED_BY(mLock);
 };
 
 } // namespace android
@@ -1276,6 +1276,25 @@ Status AudioPolicyService::isStreamActiveRemotely(AudioStreamType streamAidl,
     return Status::ok();
 }
 
+Status AudioPolicyService::getActiveStreamTypes(int32_t inPastMsAidl,
+                                                std::vector<AudioStreamType>* _aidl_return) {
+    uint32_t inPastMs = VALUE_OR_RETURN_BINDER_STATUS(convertIntegral<uint32_t>(inPastMsAidl));
+
+    if (mAudioPolicyManager == NULL) {
+        return binderStatusFromStatusT(NO_INIT);
+    }
+    Mutex::Autolock _l(mLock);
+    AutoCallerClear acc;
+    for (int stream = AUDIO_STREAM_MIN; stream < AUDIO_STREAM_PUBLIC_CNT; stream++) {
+        if (mAudioPolicyManager->isStreamActive((audio_stream_type_t)stream, inPastMs)) {
+            _aidl_return->push_back(VALUE_OR_RETURN_BINDER_STATUS(
+                    legacy2aidl_audio_stream_type_t_AudioStreamType(
+                            (audio_stream_type_t)stream)));
+        }
+    }
+    return Status::ok();
+}
+
 Status AudioPolicyService::isSourceActive(AudioSource sourceAidl, bool* _aidl_return) {
     audio_source_t source = VALUE_OR_RETURN_BINDER_STATUS(
             aidl2legacy_AudioSource_audio_source_t(sourceAidl));
@@ -95,6 +95,7 @@ BINDER_METHOD_ENTRY(setEffectEnabled) \
 BINDER_METHOD_ENTRY(moveEffectsToIo) \
 BINDER_METHOD_ENTRY(isStreamActive) \
 BINDER_METHOD_ENTRY(isStreamActiveRemotely) \
+BINDER_METHOD_ENTRY(getActiveStreamTypes) \
 BINDER_METHOD_ENTRY(isSourceActive) \
 BINDER_METHOD_ENTRY(queryDefaultPreProcessing) \
 BINDER_METHOD_ENTRY(addSourceDefaultEffect) \
@@ -1289,6 +1290,7 @@ status_t AudioPolicyService::onTransact(
         case TRANSACTION_getMaxVolumeIndexForAttributes:
         case TRANSACTION_isStreamActive:
         case TRANSACTION_isStreamActiveRemotely:
+        case TRANSACTION_getActiveStreamTypes:
         case TRANSACTION_isSourceActive:
         case TRANSACTION_registerPolicyMixes:
         case TRANSACTION_setMasterMono:
@@ -148,6 +148,8 @@ public:
                                   bool* _aidl_return) override;
     binder::Status isStreamActiveRemotely(AudioStreamType stream, int32_t inPastMs,
                                           bool* _aidl_return) override;
+    binder::Status getActiveStreamTypes(int32_t inPastMs,
+                                        std::vector<AudioStreamType>* _aidl_return) override;
     binder::Status isSourceActive(AudioSource source, bool* _aidl_return) override;
     binder::Status queryDefaultPreProcessing(
             int32_t audioSession, Int* count,
@@ -478,10 +478,16 @@ Status Spatializer::setLevel(SpatializationLevel level) {
         mLevel = level;
         callback = mSpatializerCallback;
 
-        if (levelChanged && mEngine != nullptr) {
-            checkEngineState_l();
+        if (levelChanged) {
+            if (mEngine != nullptr) {
+                checkEngineState_l();
+            }
+            // Only reconfigure the sensors when the level actually changed:
+            // checkSensorsState_l() re-sends the head tracking mode to the effect HAL
+            // and re-requests the output latency mode from audioflinger, which is
+            // redundant binder and HAL traffic when nothing changed.
+            checkSensorsState_l();
         }
-        checkSensorsState_l();
     }
 
     if (levelChanged) {
@@ -312,8 +312,8 @@ void SpatializerPoseController::onPose(int64_t timestamp, int32_t sensor, const
     const float delayMs = (elapsedRealtimeNano() - timestamp) * NANOS_TO_MILLIS; // CLOCK_BOOTTIME
 
     if (sensor == mHeadSensor) {
-        std::vector<float> pryprydt(8);  // pitch, roll, yaw, d_pitch, d_roll, d_yaw,
-                                         // discontinuity, timestamp_delay
+        std::vector<float>& pryprydt = mHeadSensorRecord;  // pitch, roll, yaw, d_pitch, d_roll,
+                                                           // d_yaw, discontinuity, timestamp_delay
         media::quaternionToAngles(pose.rotation(), &pryprydt[0], &pryprydt[1], &pryprydt[2]);
         if (twist) {
             const auto rotationalVelocity = twist->rotationalVelocity();
@@ -325,6 +325,9 @@ void SpatializerPoseController::onPose(int64_t timestamp, int32_t sensor, const
             // as the initial head tracking sensor's world frame is arbitrary.
             media::quaternionToAngles(media::rotationVectorToQuaternion(rotationalVelocity),
                     &pryprydt[3], &pryprydt[4], &pryprydt[5]);
+        } else {
+            pryprydt[3] = pryprydt[4] = pryprydt[5] = 0.f;  // the buffer is reused, clear stale
+                                                            // velocities from the last sample.
         }
         pryprydt[6] = isNewReference;
         pryprydt[7] = delayMs;
@@ -343,8 +346,9 @@ void SpatializerPoseController::onPose(int64_t timestamp, int32_t sensor, const
         }
     }
     if (sensor == mScreenSensor) {
-        std::vector<float> pryt{ 0.f, 0.f, 0.f, delayMs}; // pitch, roll, yaw, timestamp_delay
+        std::vector<float>& pryt = mScreenSensorRecord;  // pitch, roll, yaw, timestamp_delay
         media::quaternionToAngles(pose.rotation(), &pryt[0], &pryt[1], &pryt[2]);
+        pryt[3] = delayMs;
         for (size_t i = 0; i < 3; ++i) {
             pryt[i] *= RAD_TO_DEGREE;
         }
@@ -146,6 +146,11 @@ class SpatializerPoseController : private media::SensorPoseProvider::Listener {
         4 /* vectorSize */, std::chrono::minutes(1), 10 /* maxLogLine */,
         { 3 } /* delimiterIdx */};
 
+    // Scratch buffers for the vectors recorded in onPose(), reused across samples so
+    // the sensor callback does not allocate at sensor rate. Guarded by mMutex.
+    std::vector<float> mHeadSensorRecord = std::vector<float>(8);
+    std::vector<float> mScreenSensorRecord = std::vector<float>(4);
+
     // It's important that mThread is the last variable in this class
     // since we starts mThread in initializer list
     std::thread mThread;
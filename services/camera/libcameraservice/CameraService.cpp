@@ -288,6 +288,11 @@ status_t CameraService::enumerateProviders() {
 
 void CameraService::broadcastTorchModeStatus(const String8& cameraId, TorchModeStatus status,
         SystemCameraKind systemCameraKind) {
+    // Convert the arguments once; the callbacks are oneway so the loop cost is
+    // dominated by what we marshal per listener.
+    String16 cameraId16(cameraId);
+    int32_t interfaceStatus = mapToInterface(status);
+
     Mutex::Autolock lock(mStatusListenerLock);
     for (auto& i : mListenerList) {
         if (shouldSkipStatusUpdates(systemCameraKind, i->isVendorListener(), i->getListenerPid(),
@@ -296,7 +301,7 @@ void CameraService::broadcastTorchModeStatus(const String8& cameraId, TorchModeS
                     cameraId.c_str());
             continue;
         }
-        i->getListener()->onTorchStatusChanged(mapToInterface(status), String16{cameraId});
+        i->getListener()->onTorchStatusChanged(interfaceStatus, cameraId16);
     }
 }
 
@@ -4769,8 +4774,12 @@ void CameraService::updateStatus(StatusInternal status, const String8& cameraId,
                 }
             }
 
+            // Convert the arguments once rather than per listener below.
+            String16 cameraId16(cameraId);
+            int32_t interfaceStatus = mapToInterface(status);
+
             Mutex::Autolock lock(mStatusListenerLock);
-            notifyPhysicalCameraStatusLocked(mapToInterface(status), String16(cameraId),
+            notifyPhysicalCameraStatusLocked(interfaceStatus, cameraId16,
                     logicalCameraIds, deviceKind);
 
             for (auto& listener : mListenerList) {
@@ -4782,8 +4791,7 @@ void CameraService::updateStatus(StatusInternal status, const String8& cameraId,
                             cameraId.c_str());
                     continue;
                 }
-                listener->getListener()->onStatusChanged(mapToInterface(status),
-                        String16(cameraId));
+                listener->getListener()->onStatusChanged(interfaceStatus, cameraId16);
             }
         });
 }
@@ -4802,6 +4810,8 @@ void CameraService::updateOpenCloseStatus(const String8& cameraId, bool open,
         state->setClientPackage(String8::empty());
     }
 
+    String16 cameraId64(cameraId);
+
     Mutex::Autolock lock(mStatusListenerLock);
 
     for (const auto& it : mListenerList) {
@@ -4810,7 +4820,6 @@ void CameraService::updateOpenCloseStatus(const String8& cameraId, bool open,
         }
 
         binder::Status ret;
-        String16 cameraId64(cameraId);
         if (open) {
             ret = it->getListener()->onCameraOpened(cameraId64, clientPackageName);
         } else {
@@ -33,6 +33,11 @@ Camera3BufferManager::Camera3BufferManager() {
 }
 
 Camera3BufferManager::~Camera3BufferManager() {
+    for (const auto& entry : mWarmBufferPool) {
+        if (entry.fenceFd != -1) {
+            close(entry.fenceFd);
+        }
+    }
 }
 
 status_t Camera3BufferManager::registerStream(wp<Camera3OutputStream>& stream,
@@ -217,7 +222,9 @@ status_t Camera3BufferManager::checkAndFreeBufferOnOtherStreamsLocked(
             return INVALID_OPERATION;
         }
 
-        // Detach and then drop the buffer.
+        // Detach the buffer and park it in the warm pool instead of dropping
+        // it, so an upcoming request (possibly after a reconfiguration) with
+        // matching geometry can reuse the allocation.
         //
         // Need to unlock because the stream may also be calling
         // into the buffer manager in parallel to signal buffer
@@ -226,10 +233,14 @@ status_t Camera3BufferManager::checkAndFreeBufferOnOtherStreamsLocked(
         {
             mLock.unlock();
             sp<GraphicBuffer> buffer;
-            stream->detachBuffer(&buffer, /*fenceFd*/ nullptr);
+            int fenceFd = -1;
+            stream->detachBuffer(&buffer, &fenceFd);
             mLock.lock();
             if (buffer.get() != nullptr) {
                 bufferFreed = true;
+                addToWarmPoolLocked(GraphicBufferEntry(buffer, fenceFd));
+            } else if (fenceFd != -1) {
+                close(fenceFd);
             }
         }
         if (bufferFreed) {
@@ -286,21 +297,26 @@ status_t Camera3BufferManager::getBufferForStream(int streamId, int streamSetId,
         const StreamInfo& info = streamSet.streamInfoMap.valueFor(streamId);
         GraphicBufferEntry buffer;
         buffer.fenceFd = -1;
-        buffer.graphicBuffer = new GraphicBuffer(
-                info.width, info.height, PixelFormat(info.format), info.combinedUsage,
-                std::string("Camera3BufferManager pid [") +
-                        std::to_string(getpid()) + "]");
-        status_t res = buffer.graphicBuffer->initCheck();
-
-        ALOGV("%s: allocating a new graphic buffer (%dx%d, format 0x%x) %p with handle %p",
-                __FUNCTION__, info.width, info.height, info.format,
-                buffer.graphicBuffer.get(), buffer.graphicBuffer->handle);
-        if (res < 0) {
-            ALOGE("%s: graphic buffer allocation failed: (error %d %s) ",
-                    __FUNCTION__, res, strerror(-res));
-            return res;
+        status_t res;
+        // Reuse a warm pooled buffer with matching geometry and usage if one
+        // is available before falling back to a fresh allocation.
+        if (!getWarmBufferLocked(info, &buffer)) {
+            buffer.graphicBuffer = new GraphicBuffer(
+                    info.width, info.height, PixelFormat(info.format), info.combinedUsage,
+                    std::string("Camera3BufferManager pid [") +
+                            std::to_string(getpid()) + "]");
+            res = buffer.graphicBuffer->initCheck();
+
+            ALOGV("%s: allocating a new graphic buffer (%dx%d, format 0x%x) %p with handle %p",
+                    __FUNCTION__, info.width, info.height, info.format,
+                    buffer.graphicBuffer.get(), buffer.graphicBuffer->handle);
+            if (res < 0) {
+                ALOGE("%s: graphic buffer allocation failed: (error %d %s) ",
+                        __FUNCTION__, res, strerror(-res));
+                return res;
+            }
+            ALOGV("%s: allocation done", __FUNCTION__);
         }
-        ALOGV("%s: allocation done", __FUNCTION__);
 
         // Increase the hand-out and attached buffer counts for tracking purposes.
         bufferCount++;
@@ -455,6 +471,7 @@ void Camera3BufferManager::dump(int fd, [[maybe_unused]] const Vector<String16>&
     Mutex::Autolock l(mLock);
 
     String8 lines;
+    lines.appendFormat("      Warm buffer pool size: %zu\n", mWarmBufferPool.size());
     lines.appendFormat("      Total stream sets: %zu\n", mStreamSetMap.size());
     for (size_t i = 0; i < mStreamSetMap.size(); i++) {
         lines.appendFormat("        Stream set %d(%d) has below streams:\n",
@@ -484,6 +501,37 @@ void Camera3BufferManager::dump(int fd, [[maybe_unused]] const Vector<String16>&
     write(fd, lines.string(), lines.size());
 }
 
+bool Camera3BufferManager::getWarmBufferLocked(const StreamInfo& info,
+        GraphicBufferEntry* entry) {
+    for (auto it = mWarmBufferPool.begin(); it != mWarmBufferPool.end(); it++) {
+        const sp<GraphicBuffer>& gb = it->graphicBuffer;
+        if (gb->getWidth() == info.width && gb->getHeight() == info.height &&
+                gb->getPixelFormat() == PixelFormat(info.format) &&
+                gb->getUsage() == info.combinedUsage) {
+            *entry = *it;
+            mWarmBufferPool.erase(it);
+            ALOGV("%s: reusing warm buffer %p (%dx%d, format 0x%x)", __FUNCTION__,
+                    entry->graphicBuffer.get(), info.width, info.height, info.format);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Camera3BufferManager::addToWarmPoolLocked(const GraphicBufferEntry& entry) {
+    if (entry.graphicBuffer.get() == nullptr) {
+        return;
+    }
+    if (mWarmBufferPool.size() >= kMaxWarmBuffers) {
+        // Evict (and actually free) the oldest pooled buffer.
+        if (mWarmBufferPool.front().fenceFd != -1) {
+            close(mWarmBufferPool.front().fenceFd);
+        }
+        mWarmBufferPool.pop_front();
+    }
+    mWarmBufferPool.push_back(entry);
+}
+
 bool Camera3BufferManager::checkIfStreamRegisteredLocked(int streamId,
         StreamSetKey streamSetKey) const {
     ssize_t setIdx = mStreamSetMap.indexOfKey(streamSetKey);
@@ -225,6 +225,19 @@ private:
 
     typedef std::list<BufferEntry> BufferList;
 
+    /**
+     * Warm pool of buffers detached from the streams but kept allocated. The
+     * pool survives stream unregistration, so a reconfiguration (e.g. photo
+     * to video mode switch) that brings back a stream with matching geometry
+     * and usage reuses the memory instead of round-tripping the allocator.
+     * Entries keep the release fence of the detached buffer so a reused
+     * buffer is handed out with any pending consumer read still tracked.
+     * The pool is bounded by kMaxWarmBuffers; the oldest entry is evicted
+     * (and actually freed) when the bound is hit.
+     */
+    std::list<GraphicBufferEntry> mWarmBufferPool;
+    static const size_t kMaxWarmBuffers = 4;
+
     /**
      * Stream info map (indexed by stream ID) tracks all the streams registered to a particular
      * stream set.
@@ -324,6 +337,18 @@ private:
      * free one if so.
      */
     status_t checkAndFreeBufferOnOtherStreamsLocked(int streamId, StreamSetKey streamSetKey);
+
+    /**
+     * Take a buffer matching the stream's geometry and usage out of the warm
+     * pool. Returns true and fills in entry if one was found.
+     */
+    bool getWarmBufferLocked(const StreamInfo& info, GraphicBufferEntry* entry);
+
+    /**
+     * Park a buffer that is no longer attached to any stream in the warm
+     * pool, evicting the oldest pooled buffer if the pool is full.
+     */
+    void addToWarmPoolLocked(const GraphicBufferEntry& entry);
 };
 
 } // namespace camera3
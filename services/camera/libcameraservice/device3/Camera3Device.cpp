@@ -83,12 +83,14 @@
 
 #include <inttypes.h>
 
+#include <thread>
 #include <utility>
 
 #include <utils/Log.h>
 #include <utils/Trace.h>
 #include <utils/Timers.h>
 #include <cutils/properties.h>
+#include <media/nblog/WriterPool.h>
 
 #include <android/hardware/camera/device/3.7/ICameraInjectionSession.h>
 #include <android/hardware/camera2/ICameraDeviceUser.h>
@@ -126,6 +128,7 @@ Camera3Device::Camera3Device(const String8 &id, bool overrideForPerfClass, bool
         mNumPartialResults(1),
         mDeviceTimeBaseIsRealtime(false),
         mTimestampOffset(0),
+        mCaptureLatency(kCaptureLatencyBinSize),
         mNextResultFrameNumber(0),
         mNextReprocessResultFrameNumber(0),
         mNextZslStillResultFrameNumber(0),
@@ -144,6 +147,8 @@ Camera3Device::Camera3Device(const String8 &id, bool overrideForPerfClass, bool
 {
     ATRACE_CALL();
     ALOGV("%s: Created device for camera %s", __FUNCTION__, mId.string());
+    mNBLogWriter = NBLog::WriterPool::getDefault()->newWriter(
+            kNBLogSize, String8::format("Camera3Device %s", mId.string()).c_str());
 }
 
 Camera3Device::~Camera3Device()
@@ -151,6 +156,7 @@ Camera3Device::~Camera3Device()
     ATRACE_CALL();
     ALOGV("%s: Tearing down for camera id %s", __FUNCTION__, mId.string());
     disconnectImpl();
+    NBLog::WriterPool::getDefault()->unregisterWriter(mNBLogWriter);
 }
 
 const String8& Camera3Device::getId() const {
@@ -659,6 +665,8 @@ status_t Camera3Device::dump(int fd, [[maybe_unused]] const Vector<String16> &ar
                 "    ProcessCaptureRequest latency histogram:");
     }
 
+    mCaptureLatency.dump(fd, "    Request submit to capture complete latency histogram:");
+
     {
         lines = String8("    Last request sent:\n");
         write(fd, lines.string(), lines.size());
@@ -2610,23 +2618,55 @@ status_t Camera3Device::configureStreamsLocked(int operatingMode,
         }
     }
 
+    // Finish the output streams in parallel: each stream's finalization
+    // talks to its own consumer surface and allocates or registers its own
+    // buffers, so on a multi-stream session the serial loop was the bulk of
+    // reconfiguration time. Failure handling and HAL notification stay on
+    // this thread after the join, with the same semantics as the serial loop.
+    std::vector<sp<Camera3OutputStreamInterface>> streamsToFinish;
     for (size_t i = 0; i < mOutputStreams.size(); i++) {
         sp<Camera3OutputStreamInterface> outputStream = mOutputStreams[i];
         if (outputStream->isConfiguring() && !outputStream->isConsumerConfigurationDeferred()) {
-            bool streamReConfigured = false;
-            res = outputStream->finishConfiguration(&streamReConfigured);
-            if (res != OK) {
-                CLOGE("Can't finish configuring output stream %d: %s (%d)",
-                        outputStream->getId(), strerror(-res), res);
-                cancelStreamsConfigurationLocked();
-                if ((res == NO_INIT || res == DEAD_OBJECT) && outputStream->isAbandoned()) {
-                    return DEAD_OBJECT;
-                }
-                return BAD_VALUE;
-            }
-            if (streamReConfigured) {
-                mInterface->onStreamReConfigured(outputStream->getId());
+            streamsToFinish.push_back(outputStream);
+        }
+    }
+
+    struct StreamFinishResult {
+        status_t res = OK;
+        bool streamReConfigured = false;
+    };
+    std::vector<StreamFinishResult> finishResults(streamsToFinish.size());
+    auto finishStream = [&](size_t idx) {
+        finishResults[idx].res = streamsToFinish[idx]->finishConfiguration(
+                &finishResults[idx].streamReConfigured);
+    };
+    if (streamsToFinish.size() > 1) {
+        std::vector<std::thread> finishThreads;
+        finishThreads.reserve(streamsToFinish.size());
+        for (size_t i = 0; i < streamsToFinish.size(); i++) {
+            finishThreads.emplace_back(finishStream, i);
+        }
+        for (auto& finishThread : finishThreads) {
+            finishThread.join();
+        }
+    } else if (streamsToFinish.size() == 1) {
+        finishStream(0);
+    }
+
+    for (size_t i = 0; i < streamsToFinish.size(); i++) {
+        const sp<Camera3OutputStreamInterface>& outputStream = streamsToFinish[i];
+        res = finishResults[i].res;
+        if (res != OK) {
+            CLOGE("Can't finish configuring output stream %d: %s (%d)",
+                    outputStream->getId(), strerror(-res), res);
+            cancelStreamsConfigurationLocked();
+            if ((res == NO_INIT || res == DEAD_OBJECT) && outputStream->isAbandoned()) {
+                return DEAD_OBJECT;
             }
+            return BAD_VALUE;
+        }
+        if (finishResults[i].streamReConfigured) {
+            mInterface->onStreamReConfigured(outputStream->getId());
         }
     }
 
@@ -2860,7 +2900,10 @@ status_t Camera3Device::registerInFlight(uint32_t frameNumber,
     return OK;
 }
 
-void Camera3Device::onInflightEntryRemovedLocked(nsecs_t duration) {
+void Camera3Device::onInflightEntryRemovedLocked(nsecs_t duration, nsecs_t requestTimeNs) {
+    if (requestTimeNs > 0) {
+        mCaptureLatency.add(requestTimeNs, systemTime());
+    }
     // Indicate idle inFlightMap to the status tracker
     if (mInFlightMap.size() == 0) {
         mRequestBufferSM.onInflightMapEmpty();
@@ -2898,9 +2941,10 @@ void Camera3Device::onInflightMapFlushedLocked() {
 void Camera3Device::removeInFlightMapEntryLocked(int idx) {
     ATRACE_HFR_CALL();
     nsecs_t duration = mInFlightMap.valueAt(idx).maxExpectedDuration;
+    nsecs_t requestTimeNs = mInFlightMap.valueAt(idx).requestTimeNs;
     mInFlightMap.removeItemsAt(idx, 1);
 
-    onInflightEntryRemovedLocked(duration);
+    onInflightEntryRemovedLocked(duration, requestTimeNs);
 }
 
 
@@ -30,6 +30,7 @@
 #include <utils/Timers.h>
 
 #include <camera/CaptureResult.h>
+#include <media/nblog/Writer.h>
 
 #include "CameraServiceWatchdog.h"
 #include <aidl/android/hardware/camera/device/CameraBlob.h>
@@ -325,6 +326,8 @@ class Camera3Device :
     static const nsecs_t       kBaseGetBufferWait = 3000000000; // 3 sec.
     // SCHED_FIFO priority for request submission thread in HFR mode
     static const int           kRequestThreadPriority = 1;
+    // size of the NBLog timeline for capture result handling times
+    static const size_t        kNBLogSize = 4096;
 
     struct                     RequestTrigger;
     // minimal jpeg buffer size: 256KB + blob header
@@ -626,6 +629,10 @@ class Camera3Device :
     // lock to ensure only one processCaptureResult is called at a time.
     Mutex mProcessCaptureResultLock;
 
+    // Typed log of time spent handling each capture result batch, merged
+    // into media.log. Only written with mProcessCaptureResultLock held.
+    sp<NBLog::Writer> mNBLogWriter;
+
     /**
      * Common initialization code shared by both HAL paths
      *
@@ -752,7 +759,7 @@ class Camera3Device :
     /////////////////////////////////////////////////////////////////////
     // Implements InflightRequestUpdateInterface
 
-    void onInflightEntryRemovedLocked(nsecs_t duration) override;
+    void onInflightEntryRemovedLocked(nsecs_t duration, nsecs_t requestTimeNs) override;
     void checkInflightMapLengthLocked() override;
     void onInflightMapFlushedLocked() override;
 
@@ -1107,6 +1114,10 @@ class Camera3Device :
     int64_t                       mLastCompletedRegularFrameNumber = -1;
     int64_t                       mLastCompletedReprocessFrameNumber = -1;
     int64_t                       mLastCompletedZslFrameNumber = -1;
+    // Histogram of request submission to capture completion latency,
+    // recorded as entries leave the in-flight map; shown in dumpsys.
+    static const int32_t          kCaptureLatencyBinSize = 40; // in ms
+    CameraLatencyHistogram        mCaptureLatency;
     // End of mInFlightLock protection scope
 
     int mInFlightStatusId; // const after initialize
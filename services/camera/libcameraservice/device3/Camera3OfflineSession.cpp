@@ -237,7 +237,8 @@ void Camera3OfflineSession::setErrorStateLockedV(const char *fmt, va_list args)
     CameraTraces::saveTrace();
 }
 
-void Camera3OfflineSession::onInflightEntryRemovedLocked(nsecs_t /*duration*/) {
+void Camera3OfflineSession::onInflightEntryRemovedLocked(
+        nsecs_t /*duration*/, nsecs_t /*requestTimeNs*/) {
     if (mOfflineReqs.size() == 0) {
         std::lock_guard<std::mutex> lock(mRequestBufferInterfaceLock);
         mAllowRequestBuffer = false;
@@ -257,7 +257,7 @@ class Camera3OfflineSession :
     void setErrorStateLocked(const char *fmt, ...) override;
 
     // InflightRequestUpdateInterface
-    void onInflightEntryRemovedLocked(nsecs_t duration) override;
+    void onInflightEntryRemovedLocked(nsecs_t duration, nsecs_t requestTimeNs) override;
     void checkInflightMapLengthLocked() override;
     void onInflightMapFlushedLocked() override;
 
@@ -74,7 +74,9 @@ namespace camera3 {
     public:
         // Caller must hold the lock proctecting InflightRequestMap
         // duration: the maxExpectedDuration of the removed entry
-        virtual void onInflightEntryRemovedLocked(nsecs_t duration) = 0;
+        // requestTimeNs: the time the removed entry's request was submitted
+        //     to the HAL, or 0 if not tracked
+        virtual void onInflightEntryRemovedLocked(nsecs_t duration, nsecs_t requestTimeNs) = 0;
 
         virtual void checkInflightMapLengthLocked() = 0;
 
@@ -155,9 +155,10 @@ void insertResultLocked(CaptureOutputStates& states, CaptureResult *result, uint
         physicalMetadata.mPhysicalCameraMetadata.unlock(pmeta);
     }
 
-    // Valid result, insert into queue
+    // Valid result, move into the queue; both callers are done with the
+    // result, so there is no need to clone the metadata blobs once more.
     std::list<CaptureResult>::iterator queuedResult =
-            states.resultQueue.insert(states.resultQueue.end(), CaptureResult(*result));
+            states.resultQueue.insert(states.resultQueue.end(), std::move(*result));
     ALOGV("%s: result requestId = %" PRId32 ", frameNumber = %" PRId64
            ", burstId = %" PRId32, __FUNCTION__,
            queuedResult->mResultExtras.requestId,
@@ -364,14 +365,19 @@ void sendCaptureResult(
         }
     }
 
-    std::unordered_map<std::string, CameraMetadata> monitoredPhysicalMetadata;
-    for (auto& m : physicalMetadatas) {
-        monitoredPhysicalMetadata.emplace(String8(m.mPhysicalCameraId).string(),
-                CameraMetadata(m.mPhysicalCameraMetadata));
+    // Cloning the physical metadata for the tag monitor is only worth doing
+    // when monitoring is actually on; it is one full metadata copy per
+    // physical camera per frame otherwise.
+    if (states.tagMonitor.isMonitoring()) {
+        std::unordered_map<std::string, CameraMetadata> monitoredPhysicalMetadata;
+        for (auto& m : physicalMetadatas) {
+            monitoredPhysicalMetadata.emplace(String8(m.mPhysicalCameraId).string(),
+                    CameraMetadata(m.mPhysicalCameraMetadata));
+        }
+        states.tagMonitor.monitorMetadata(TagMonitor::RESULT,
+                frameNumber, sensorTimestamp, captureResult.mMetadata,
+                monitoredPhysicalMetadata);
     }
-    states.tagMonitor.monitorMetadata(TagMonitor::RESULT,
-            frameNumber, sensorTimestamp, captureResult.mMetadata,
-            monitoredPhysicalMetadata);
 
     insertResultLocked(states, &captureResult, frameNumber);
 }
@@ -380,9 +386,10 @@ void removeInFlightMapEntryLocked(CaptureOutputStates& states, int idx) {
     ATRACE_CALL();
     InFlightRequestMap& inflightMap = states.inflightMap;
     nsecs_t duration = inflightMap.valueAt(idx).maxExpectedDuration;
+    nsecs_t requestTimeNs = inflightMap.valueAt(idx).requestTimeNs;
     inflightMap.removeItemsAt(idx, 1);
 
-    states.inflightIntf.onInflightEntryRemovedLocked(duration);
+    states.inflightIntf.onInflightEntryRemovedLocked(duration, requestTimeNs);
 }
 
 void removeInFlightRequestIfReadyLocked(CaptureOutputStates& states, int idx) {
@@ -715,6 +722,13 @@ void returnOutputBuffers(
         const CaptureResultExtras &inResultExtras,
         ERROR_BUF_STRATEGY errorBufStrategy, int32_t transform) {
 
+    // All buffers of a result group complete together, so sample the capture
+    // latency once for the whole group rather than per buffer.
+    int32_t captureLatencyMs = 0;
+    if (requested) {
+        captureLatencyMs = ns2ms(systemTime() - requestTimeNs);
+    }
+
     for (size_t i = 0; i < numBuffers; i++)
     {
         Camera3StreamInterface *stream = Camera3Stream::cast(outputBuffers[i].stream);
@@ -778,8 +792,6 @@ void returnOutputBuffers(
             }
         }
         if (requested) {
-            nsecs_t bufferTimeNs = systemTime();
-            int32_t captureLatencyMs = ns2ms(bufferTimeNs - requestTimeNs);
             sessionStatsBuilder.incCounter(streamId, dropped, captureLatencyMs);
         }
 
@@ -820,14 +832,19 @@ void returnAndRemovePendingOutputBuffers(bool useHalBufManager,
             request.outputSurfaces, request.resultExtras,
             request.errorBufStrategy, request.transform);
 
-    // Remove error buffers that are not cached.
-    for (auto iter = request.pendingOutputBuffers.begin();
-            iter != request.pendingOutputBuffers.end(); ) {
-        if (request.errorBufStrategy != ERROR_BUF_CACHE ||
-                iter->status != CAMERA_BUFFER_STATUS_ERROR) {
-            iter = request.pendingOutputBuffers.erase(iter);
-        } else {
-            iter++;
+    // Remove error buffers that are not cached. Unless error buffers are
+    // being cached, every pending buffer was just returned, so drop the whole
+    // group at once instead of erasing element by element.
+    if (request.errorBufStrategy != ERROR_BUF_CACHE) {
+        request.pendingOutputBuffers.clear();
+    } else {
+        for (auto iter = request.pendingOutputBuffers.begin();
+                iter != request.pendingOutputBuffers.end(); ) {
+            if (iter->status != CAMERA_BUFFER_STATUS_ERROR) {
+                iter = request.pendingOutputBuffers.erase(iter);
+            } else {
+                iter++;
+            }
         }
     }
 }
@@ -734,9 +734,9 @@ bool Camera3Stream::isOutstandingBuffer(const camera_stream_buffer &buffer) cons
     return false;
 }
 
-void Camera3Stream::removeOutstandingBuffer(const camera_stream_buffer &buffer) {
+bool Camera3Stream::removeOutstandingBuffer(const camera_stream_buffer &buffer) {
     if (buffer.buffer == nullptr) {
-        return;
+        return false;
     }
 
     Mutex::Autolock l(mOutstandingBuffersLock);
@@ -744,9 +744,10 @@ void Camera3Stream::removeOutstandingBuffer(const camera_stream_buffer &buffer)
     for (auto b = mOutstandingBuffers.begin(); b != mOutstandingBuffers.end(); b++) {
         if (*b == *buffer.buffer) {
             mOutstandingBuffers.erase(b);
-            return;
+            return true;
         }
     }
+    return false;
 }
 
 status_t Camera3Stream::returnBuffer(const camera_stream_buffer &buffer,
@@ -755,14 +756,12 @@ status_t Camera3Stream::returnBuffer(const camera_stream_buffer &buffer,
     ATRACE_HFR_CALL();
     Mutex::Autolock l(mLock);
 
-    // Check if this buffer is outstanding.
-    if (!isOutstandingBuffer(buffer)) {
+    // Check if this buffer is outstanding, and stop tracking it if so.
+    if (!removeOutstandingBuffer(buffer)) {
         ALOGE("%s: Stream %d: Returning an unknown buffer.", __FUNCTION__, mId);
         return BAD_VALUE;
     }
 
-    removeOutstandingBuffer(buffer);
-
     // Buffer status may be changed, so make a copy of the stream_buffer struct.
     camera_stream_buffer b = buffer;
     if (timestampIncreasing && timestamp != 0 && timestamp <= mLastTimestamp) {
@@ -839,14 +838,12 @@ status_t Camera3Stream::returnInputBuffer(const camera_stream_buffer &buffer) {
     ATRACE_CALL();
     Mutex::Autolock l(mLock);
 
-    // Check if this buffer is outstanding.
-    if (!isOutstandingBuffer(buffer)) {
+    // Check if this buffer is outstanding, and stop tracking it if so.
+    if (!removeOutstandingBuffer(buffer)) {
         ALOGE("%s: Stream %d: Returning an unknown buffer.", __FUNCTION__, mId);
         return BAD_VALUE;
     }
 
-    removeOutstandingBuffer(buffer);
-
     status_t res = returnInputBufferLocked(buffer);
     if (res == OK) {
         fireBufferListenersLocked(buffer, /*acquired*/false, /*output*/false);
@@ -598,8 +598,11 @@ class Camera3Stream :
 
     status_t        cancelPrepareLocked();
 
-    // Remove the buffer from the list of outstanding buffers.
-    void removeOutstandingBuffer(const camera_stream_buffer& buffer);
+    // Remove the buffer from the list of outstanding buffers, with a single
+    // pass over the list. Returns whether the buffer was tracked. Combined
+    // with the outstanding check so the buffer return path only pays one
+    // list scan per buffer instead of a lookup followed by a removal.
+    bool removeOutstandingBuffer(const camera_stream_buffer& buffer);
 
     // Tracking for PREPARING state
 
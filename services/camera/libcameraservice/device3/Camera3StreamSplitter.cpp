@@ -518,7 +518,8 @@ void Camera3StreamSplitter::onFrameAvailable(const BufferItem& /*item*/) {
     }
     bufferId = bufferItem.mGraphicBuffer->getId();
 
-    if (mBuffers.find(bufferId) == mBuffers.end()) {
+    auto trackerIter = mBuffers.find(bufferId);
+    if (trackerIter == mBuffers.end()) {
         SP_LOGE("%s: Acquired buffer doesn't exist in attached buffer map",
                 __FUNCTION__);
         mOnFrameAvailableRes.store(INVALID_OPERATION);
@@ -534,7 +535,8 @@ void Camera3StreamSplitter::onFrameAvailable(const BufferItem& /*item*/) {
     }
 
     // Attach and queue the buffer to each of the outputs
-    BufferTracker& tracker = *(mBuffers[bufferId]);
+    BufferTracker& tracker = *(trackerIter->second);
+    tracker.setInputSlot(bufferItem.mSlot);
 
     SP_LOGV("%s: BufferTracker for buffer %" PRId64 ", number of requests %zu",
            __FUNCTION__, bufferItem.mGraphicBuffer->getId(), tracker.requestedSurfaces().size());
@@ -586,14 +588,25 @@ void Camera3StreamSplitter::decrementBufRefCountLocked(uint64_t id, size_t surfa
     uint64_t bufferId = tracker_ptr->getBuffer()->getId();
     int consumerSlot = -1;
     uint64_t frameNumber;
-    auto inputSlot = mInputSlots.begin();
-    for (; inputSlot != mInputSlots.end(); inputSlot++) {
-        if (inputSlot->second.mGraphicBuffer->getId() == bufferId) {
-            consumerSlot = inputSlot->second.mSlot;
-            frameNumber = inputSlot->second.mFrameNumber;
-            break;
+    // The tracker remembers the input slot it was last acquired at, so the
+    // slot entry can be looked up directly; fall back to a scan in case the
+    // slot was since reused by a different buffer.
+    auto inputSlot = mInputSlots.find(tracker_ptr->getInputSlot());
+    if (inputSlot != mInputSlots.end() &&
+            inputSlot->second.mGraphicBuffer->getId() != bufferId) {
+        inputSlot = mInputSlots.end();
+    }
+    if (inputSlot == mInputSlots.end()) {
+        for (inputSlot = mInputSlots.begin(); inputSlot != mInputSlots.end(); inputSlot++) {
+            if (inputSlot->second.mGraphicBuffer->getId() == bufferId) {
+                break;
+            }
         }
     }
+    if (inputSlot != mInputSlots.end()) {
+        consumerSlot = inputSlot->second.mSlot;
+        frameNumber = inputSlot->second.mFrameNumber;
+    }
     if (consumerSlot == -1) {
         SP_LOGE("%s: Buffer missing inside input slots!", __FUNCTION__);
         return;
@@ -17,6 +17,7 @@
 #ifndef ANDROID_SERVERS_STREAMSPLITTER_H
 #define ANDROID_SERVERS_STREAMSPLITTER_H
 
+#include <limits>
 #include <unordered_set>
 
 #include <camera/CameraMetadata.h>
@@ -190,7 +191,14 @@ private:
         // Only called while mMutex is held
         size_t decrementReferenceCountLocked(size_t surfaceId);
 
-        const std::vector<size_t> requestedSurfaces() const { return mRequestedSurfaces; }
+        const std::vector<size_t>& requestedSurfaces() const { return mRequestedSurfaces; }
+
+        // Input consumer slot the buffer was last acquired at; lets the
+        // release path look the slot up directly instead of scanning all
+        // input slots for a matching buffer ID.
+        // Only accessed while mMutex is held
+        void setInputSlot(uint64_t slot) { mInputSlot = slot; }
+        uint64_t getInputSlot() const { return mInputSlot; }
 
     private:
 
@@ -206,6 +214,7 @@ private:
         // which output is the buffer sent to.
         std::vector<size_t> mRequestedSurfaces;
         size_t mReferenceCount;
+        uint64_t mInputSlot = std::numeric_limits<uint64_t>::max();
     };
 
     // Must be accessed through RefBase
@@ -157,6 +157,9 @@ class DistortionMapper : public CoordinateMapper {
         std::vector<GridQuad> mDistortedGrid;
     };
 
+    // Check whether the point is inside (or on the boundary of) the quad
+    static bool pointInQuad(const int32_t pt[2], const GridQuad& quad);
+
     // Find which grid quad encloses the point; returns null if none do
     static const GridQuad* findEnclosingQuad(
             const int32_t pt[2], const std::vector<GridQuad>& grid);
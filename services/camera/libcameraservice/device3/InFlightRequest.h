@@ -17,10 +17,12 @@
 #ifndef ANDROID_SERVERS_CAMERA3_INFLIGHT_REQUEST_H
 #define ANDROID_SERVERS_CAMERA3_INFLIGHT_REQUEST_H
 
+#include <map>
 #include <set>
 
 #include <camera/CaptureResult.h>
 #include <camera/CameraMetadata.h>
+#include <utils/Errors.h>
 #include <utils/String8.h>
 #include <utils/Timers.h>
 
@@ -247,8 +249,59 @@ struct InFlightRequest {
     }
 };
 
-// Map from frame number to the in-flight request state
-typedef KeyedVector<uint32_t, InFlightRequest> InFlightRequestMap;
+// Map from frame number to the in-flight request state.
+//
+// Keeps the KeyedVector-style index interface its call sites were written
+// against, but stores the entries as std::map nodes so that registering or
+// removing a request never copies the other in-flight entries around -
+// each entry carries metadata, buffer vectors and surface maps that are
+// expensive to copy, and both the request and the result threads do this
+// under mInFlightLock on every frame. Indices are positions in frame
+// number order and are invalidated by add()/removeItemsAt(), matching the
+// KeyedVector semantics callers already assume.
+class InFlightRequestMap {
+public:
+    ssize_t add(uint32_t frameNumber, const InFlightRequest& value) {
+        auto result = mMap.emplace(frameNumber, value);
+        if (!result.second) {
+            result.first->second = value;
+        }
+        return std::distance(mMap.begin(), result.first);
+    }
+
+    ssize_t indexOfKey(uint32_t frameNumber) const {
+        auto it = mMap.find(frameNumber);
+        if (it == mMap.end()) {
+            return NAME_NOT_FOUND;
+        }
+        return std::distance(mMap.begin(), it);
+    }
+
+    uint32_t keyAt(size_t index) const {
+        return std::next(mMap.begin(), index)->first;
+    }
+
+    const InFlightRequest& valueAt(size_t index) const {
+        return std::next(mMap.begin(), index)->second;
+    }
+
+    InFlightRequest& editValueAt(size_t index) {
+        return std::next(mMap.begin(), index)->second;
+    }
+
+    void removeItemsAt(size_t index, size_t count = 1) {
+        auto first = std::next(mMap.begin(), index);
+        auto last = std::next(first, count);
+        mMap.erase(first, last);
+    }
+
+    size_t size() const { return mMap.size(); }
+
+    void clear() { mMap.clear(); }
+
+private:
+    std::map<uint32_t, InFlightRequest> mMap;
+};
 
 } // namespace camera3
 
@@ -79,6 +79,16 @@ bool PreviewFrameSpacer::threadLoop() {
             return false;
         }
         currentTime = systemTime();
+        // Anchor the pacing cadence to the intended queue time when the timer
+        // overshoots. Otherwise wakeup scheduling jitter accumulates into
+        // mLastCameraPresentTime, the next frame's wait alternates between too
+        // short and too long, and the consumer's vsync latching oscillates,
+        // which shows up as preview judder. If the thread is genuinely lagging,
+        // the next iteration computes a non-positive wait and catches up
+        // immediately, so the anchor cannot drift without bound.
+        if (currentTime > expectedQueueTime) {
+            currentTime = expectedQueueTime;
+        }
     }
     ALOGV("%s: readoutInterval %" PRId64 ", waited for %" PRId64
             ", timestamp %" PRId64, __FUNCTION__, readoutInterval,
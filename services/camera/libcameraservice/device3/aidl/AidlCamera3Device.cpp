@@ -379,9 +379,11 @@ status_t AidlCamera3Device::initialize(sp<CameraProviderManager> manager,
         mOverrideToPortrait, mActivePhysicalId}, mResultMetadataQueue
     };
 
+    const nsecs_t startNs = systemTime();
     for (const auto& result : results) {
         processOneCaptureResultLocked(states, result, result.physicalCameraMetadata);
     }
+    mNBLogWriter->log<NBLog::EVENT_WORK_TIME>(systemTime() - startNs);
     mProcessCaptureResultLock.unlock();
     return ::ndk::ScopedAStatus::ok();
 }
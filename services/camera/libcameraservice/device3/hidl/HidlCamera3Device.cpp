@@ -384,9 +384,11 @@ hardware::Return<void> HidlCamera3Device::processCaptureResult_3_4(
     //HidlCaptureOutputStates hidlStates {
     //}
 
+    const nsecs_t startNs = systemTime();
     for (const auto& result : results) {
         processOneCaptureResultLocked(states, result.v3_2, result.physicalCameraMetadata);
     }
+    mNBLogWriter->log<NBLog::EVENT_WORK_TIME>(systemTime() - startNs);
     mProcessCaptureResultLock.unlock();
     return hardware::Void();
 }
@@ -444,9 +446,11 @@ hardware::Return<void> HidlCamera3Device::processCaptureResult(
         mActivePhysicalId}, mResultMetadataQueue
     };
 
+    const nsecs_t startNs = systemTime();
     for (const auto& result : results) {
         processOneCaptureResultLocked(states, result, noPhysMetadata);
     }
+    mNBLogWriter->log<NBLog::EVENT_WORK_TIME>(systemTime() - startNs);
     mProcessCaptureResultLock.unlock();
     return hardware::Void();
 }
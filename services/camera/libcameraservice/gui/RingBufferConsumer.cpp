@@ -101,7 +101,13 @@ sp<PinnedBufferItem> RingBufferConsumer::pinSelectedBuffer(
         }
 
         pinnedBuffer = new PinnedBufferItem(this, *accIt);
-        pinBufferLocked(pinnedBuffer->getBufferItem());
+
+        // The selection scan already located the item; pin it through the
+        // iterator directly instead of re-walking the list to find it by
+        // graphic buffer.
+        accIt->mPinCount++;
+        BI_LOGV("Pinned buffer (frame %" PRIu64 ", timestamp %" PRId64 ")",
+                accIt->mFrameNumber, accIt->mTimestamp);
 
     } // end scope of mMutex autolock
 
@@ -161,29 +167,6 @@ nsecs_t RingBufferConsumer::getLatestTimestamp() {
     return mLatestTimestamp;
 }
 
-void RingBufferConsumer::pinBufferLocked(const BufferItem& item) {
-    List<RingBufferItem>::iterator it, end;
-
-    for (it = mBufferItemList.begin(), end = mBufferItemList.end();
-         it != end;
-         ++it) {
-
-        RingBufferItem& find = *it;
-        if (item.mGraphicBuffer == find.mGraphicBuffer) {
-            find.mPinCount++;
-            break;
-        }
-    }
-
-    if (it == end) {
-        BI_LOGE("Failed to pin buffer (timestamp %" PRId64 ", framenumber %" PRIu64 ")",
-                 item.mTimestamp, item.mFrameNumber);
-    } else {
-        BI_LOGV("Pinned buffer (frame %" PRIu64 ", timestamp %" PRId64 ")",
-                item.mFrameNumber, item.mTimestamp);
-    }
-}
-
 status_t RingBufferConsumer::releaseOldestBufferLocked(size_t* pinnedFrames) {
     status_t err = OK;
 
@@ -215,7 +198,7 @@ status_t RingBufferConsumer::releaseOldestBufferLocked(size_t* pinnedFrames) {
             continue;
         }
 
-        if (find.mTimestamp < accIt->mTimestamp || accIt == end) {
+        if (accIt == end || find.mTimestamp < accIt->mTimestamp) {
             accIt = it;
         }
     }
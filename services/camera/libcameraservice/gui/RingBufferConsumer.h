@@ -164,7 +164,6 @@ class RingBufferConsumer : public ConsumerBase,
     // Override ConsumerBase::onFrameAvailable
     virtual void onFrameAvailable(const BufferItem& item);
 
-    void pinBufferLocked(const BufferItem& item);
     void unpinBuffer(const BufferItem& item);
 
     // Releases oldest buffer. Returns NO_BUFFER_AVAILABLE
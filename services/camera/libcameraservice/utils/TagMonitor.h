@@ -64,6 +64,10 @@ class TagMonitor {
     // Disable monitoring; does not clear the event log
     void disableMonitoring();
 
+    // Whether monitoring is currently enabled; lets callers skip preparing
+    // metadata for monitorMetadata when it would be discarded anyway
+    bool isMonitoring() const { return mMonitoringEnabled; }
+
     // Scan through the metadata and update the monitoring information
     void monitorMetadata(eventSource source, int64_t frameNumber,
             nsecs_t timestamp, const CameraMetadata& metadata,
@@ -31,6 +31,11 @@ namespace android {
 
 MediaExtractorService::MediaExtractorService() {
     MediaExtractorFactory::LoadExtractors();
+    // Perform the remaining lazy one-time setup here rather than on the first
+    // makeExtractor()/makeIDataSource() transaction, so clients see a fully
+    // warm service from the first open after boot or a service restart.
+    MediaBuffer::useSharedMemory();
+    DataSourceFactory::getInstance();
 }
 
 MediaExtractorService::~MediaExtractorService() {
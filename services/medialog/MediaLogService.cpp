@@ -54,7 +54,7 @@ MediaLogService::~MediaLogService()
 
 void MediaLogService::registerWriter(const sp<IMemory>& shared, size_t size, const char *name)
 {
-    if (!isAudioServerOrMediaServerUid(IPCThreadState::self()->getCallingUid()) || shared == 0 ||
+    if (!isMediaLogWriterUid(IPCThreadState::self()->getCallingUid()) || shared == 0 ||
             size < kMinSize || size > kMaxSize || name == NULL ||
             shared->size() < NBLog::Timeline::sharedSize(size)) {
         return;
@@ -68,7 +68,7 @@ void MediaLogService::registerWriter(const sp<IMemory>& shared, size_t size, con
 
 void MediaLogService::unregisterWriter(const sp<IMemory>& shared)
 {
-    if (!isAudioServerOrMediaServerUid(IPCThreadState::self()->getCallingUid()) || shared == 0) {
+    if (!isMediaLogWriterUid(IPCThreadState::self()->getCallingUid()) || shared == 0) {
         return;
     }
     Mutex::Autolock _l(mLock);
@@ -114,6 +114,9 @@ MediaMetricsService::MediaMetricsService()
 MediaMetricsService::~MediaMetricsService()
 {
     ALOGD("%s", __func__);
+    // Stop the ingestion thread before tearing down the consumers it feeds.
+    // Items still queued at this point are dropped, which is fine for metrics.
+    mIngestionThread.quit();
     // the class destructor clears anyhow, but we enforce clearing items first.
     mItemsDiscarded += (int64_t)mItems.size();
     mItems.clear();
@@ -205,19 +208,28 @@ status_t MediaMetricsService::submitInternal(mediametrics::Item *item, bool rele
     // now attach either the item or its dup to a const shared pointer
     std::shared_ptr<const mediametrics::Item> sitem(release ? item : item->dup());
 
-    // register log session ids with singleton.
-    if (startsWith(item->getKey(), "metrics.manager")) {
-        std::string logSessionId;
-        if (item->get("logSessionId", &logSessionId)
-                && mediametrics::stringutils::isLogSessionId(logSessionId.c_str())) {
-            mediametrics::ValidateId::get()->registerId(logSessionId);
+    // The item is sanitized and validated; hand it to the ingestion thread and
+    // return. Although submit is oneway, oneway transactions to the same node
+    // are serialized and the submitter stalls in transact() once the kernel
+    // async buffer fills, so the consumers (analytics, the statsd socket,
+    // history expiry) must not run on the binder thread. The single ingestion
+    // thread consumes items in submission order.
+    mIngestionThread.postIn(std::chrono::seconds(0),
+            [this, sitem = std::move(sitem), isTrusted] {
+        // register log session ids with singleton.
+        if (startsWith(sitem->getKey(), "metrics.manager")) {
+            std::string logSessionId;
+            if (sitem->get("logSessionId", &logSessionId)
+                    && mediametrics::stringutils::isLogSessionId(logSessionId.c_str())) {
+                mediametrics::ValidateId::get()->registerId(logSessionId);
+            }
         }
-    }
 
-    (void)mAudioAnalytics.submit(sitem, isTrusted);
+        (void)mAudioAnalytics.submit(sitem, isTrusted);
 
-    (void)dump2Statsd(sitem, mStatsdLog);  // failure should be logged in function.
-    saveItem(sitem);
+        (void)dump2Statsd(sitem, mStatsdLog);  // failure should be logged in function.
+        saveItem(sitem);
+    });
     return NO_ERROR;
 }
 
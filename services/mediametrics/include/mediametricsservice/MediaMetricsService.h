@@ -30,6 +30,7 @@
 #include <utils/String8.h>
 
 #include "AudioAnalytics.h"
+#include "TimedAction.h"
 
 namespace android {
 
@@ -153,6 +154,12 @@ private:
     using ItemKey = std::string;
     using WeakItemQueue = std::deque<std::weak_ptr<const mediametrics::Item>>;
     std::unordered_map<ItemKey, WeakItemQueue> mPullableItems GUARDED_BY(mLock);
+
+    // Single FIFO worker that feeds validated items to the analytics consumers.
+    // The binder thread only sanitizes and validates; consumption happens here
+    // so that oneway submitters are not back-pressured by our processing time.
+    // Declared last so it is stopped first on destruction.
+    mediametrics::TimedAction mIngestionThread;
 };
 
 } // namespace android
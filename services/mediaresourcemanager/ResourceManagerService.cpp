@@ -441,54 +441,58 @@ Status ResourceManagerService::addResource(int32_t pid, int32_t uid, int64_t cli
             pid, (long long) clientId, getString(resources).string());
     mServiceLog->add(log);
 
-    Mutex::Autolock lock(mLock);
-    if (!mProcessInfo->isPidUidTrusted(pid, uid)) {
-        pid_t callingPid = IPCThreadState::self()->getCallingPid();
-        uid_t callingUid = IPCThreadState::self()->getCallingUid();
-        ALOGW("%s called with untrusted pid %d or uid %d, using calling pid %d, uid %d",
-                __FUNCTION__, pid, uid, callingPid, callingUid);
-        pid = callingPid;
-        uid = callingUid;
-    }
-    ResourceInfos& infos = getResourceInfosForEdit(pid, mMap);
-    ResourceInfo& info = getResourceInfoForEdit(uid, clientId, client, infos);
-    ResourceList resourceAdded;
+    {
+        Mutex::Autolock lock(mLock);
+        if (!mProcessInfo->isPidUidTrusted(pid, uid)) {
+            pid_t callingPid = IPCThreadState::self()->getCallingPid();
+            uid_t callingUid = IPCThreadState::self()->getCallingUid();
+            ALOGW("%s called with untrusted pid %d or uid %d, using calling pid %d, uid %d",
+                    __FUNCTION__, pid, uid, callingPid, callingUid);
+            pid = callingPid;
+            uid = callingUid;
+        }
+        ResourceInfos& infos = getResourceInfosForEdit(pid, mMap);
+        ResourceInfo& info = getResourceInfoForEdit(uid, clientId, client, infos);
+        ResourceList resourceAdded;
 
-    for (size_t i = 0; i < resources.size(); ++i) {
-        const auto &res = resources[i];
-        const auto resType = std::tuple(res.type, res.subType, res.id);
+        for (size_t i = 0; i < resources.size(); ++i) {
+            const auto &res = resources[i];
+            const auto resType = std::tuple(res.type, res.subType, res.id);
 
-        if (res.value < 0 && res.type != MediaResource::Type::kDrmSession) {
-            ALOGW("Ignoring request to remove negative value of non-drm resource");
-            continue;
-        }
-        if (info.resources.find(resType) == info.resources.end()) {
-            if (res.value <= 0) {
-                // We can't init a new entry with negative value, although it's allowed
-                // to merge in negative values after the initial add.
-                ALOGW("Ignoring request to add new resource entry with value <= 0");
+            if (res.value < 0 && res.type != MediaResource::Type::kDrmSession) {
+                ALOGW("Ignoring request to remove negative value of non-drm resource");
                 continue;
             }
-            onFirstAdded(res, info);
-            info.resources[resType] = res;
-        } else {
-            mergeResources(info.resources[resType], res);
+            if (info.resources.find(resType) == info.resources.end()) {
+                if (res.value <= 0) {
+                    // We can't init a new entry with negative value, although it's allowed
+                    // to merge in negative values after the initial add.
+                    ALOGW("Ignoring request to add new resource entry with value <= 0");
+                    continue;
+                }
+                onFirstAdded(res, info);
+                info.resources[resType] = res;
+            } else {
+                mergeResources(info.resources[resType], res);
+            }
+            // Add it to the list of added resources for observers.
+            auto it = resourceAdded.find(resType);
+            if (it == resourceAdded.end()) {
+                resourceAdded[resType] = res;
+            } else {
+                mergeResources(it->second, res);
+            }
         }
-        // Add it to the list of added resources for observers.
-        auto it = resourceAdded.find(resType);
-        if (it == resourceAdded.end()) {
-            resourceAdded[resType] = res;
-        } else {
-            mergeResources(it->second, res);
+        if (info.cookie == 0 && client != nullptr) {
+            info.cookie = addCookieAndLink_l(client,
+                    new DeathNotifier(ref<ResourceManagerService>(), pid, clientId));
+        }
+        if (mObserverService != nullptr && !resourceAdded.empty()) {
+            mObserverService->onResourceAdded(uid, pid, resourceAdded);
         }
     }
-    if (info.cookie == 0 && client != nullptr) {
-        info.cookie = addCookieAndLink_l(client,
-                new DeathNotifier(ref<ResourceManagerService>(), pid, clientId));
-    }
-    if (mObserverService != nullptr && !resourceAdded.empty()) {
-        mObserverService->onResourceAdded(uid, pid, resourceAdded);
-    }
+    // The resource monitor lives in another process; don't make other binder
+    // threads wait on our lock while we look up its service and notify it.
     notifyResourceGranted(pid, resources);
     return Status::ok();
 }
@@ -623,6 +627,7 @@ Status ResourceManagerService::reclaimResource(int32_t callingPid,
     Vector<std::shared_ptr<IResourceManagerClient>> clients;
     {
         Mutex::Autolock lock(mLock);
+        mPriorityCache.clear();
         if (!mProcessInfo->isPidTrusted(callingPid)) {
             pid_t actualCallingPid = IPCThreadState::self()->getCallingPid();
             ALOGW("%s called with untrusted pid %d, using actual calling pid %d", __FUNCTION__,
@@ -960,7 +965,17 @@ bool ResourceManagerService::getPriority_l(int pid, int* priority) {
                 newPid, pid);
     }
 
-    return mProcessInfo->getPriority(newPid, priority);
+    auto it = mPriorityCache.find(newPid);
+    if (it != mPriorityCache.end()) {
+        *priority = it->second;
+        return true;
+    }
+
+    if (!mProcessInfo->getPriority(newPid, priority)) {
+        return false;
+    }
+    mPriorityCache.emplace(newPid, *priority);
+    return true;
 }
 
 bool ResourceManagerService::getAllClients_l(int callingPid, MediaResource::Type type,
@@ -186,6 +186,11 @@ private:
     };
     std::map<int, int> mOverridePidMap;
     std::map<pid_t, ProcessInfoOverride> mProcessInfoOverrideMap;
+    // Priorities looked up during the current reclaim operation. Each priority lookup is a
+    // binder round trip to ActivityManager, and a reclaim scans every tracked pid on up to
+    // four passes, so repeats are served from this cache. Cleared at the start of each
+    // reclaim so priorities never go stale across operations.
+    std::map<int, int> mPriorityCache;
     static std::mutex sCookieLock;
     static uintptr_t sCookieCounter GUARDED_BY(sCookieLock);
     static std::map<uintptr_t, sp<DeathNotifier> > sCookieToDeathNotifierMap
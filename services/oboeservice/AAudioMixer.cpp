@@ -42,7 +42,7 @@ void AAudioMixer::allocate(int32_t samplesPerFrame, int32_t framesPerBurst) {
 }
 
 void AAudioMixer::clear() {
-    memset(mOutputBuffer.get(), 0, mBufferSizeInBytes);
+    mPristine = true; // defer the clearing to the first mix() or getOutputBuffer()
 }
 
 int32_t AAudioMixer::mix(int streamIndex, std::shared_ptr<FifoBuffer> fifo, bool allowUnderflow) {
@@ -78,6 +78,8 @@ int32_t AAudioMixer::mix(int streamIndex, std::shared_ptr<FifoBuffer> fifo, bool
     }
 
     // Mix data in one or two parts.
+    // The first stream after clear() is stored instead of accumulated.
+    const bool pristine = mPristine;
     int partIndex = 0;
     int32_t framesLeft = framesDesired;
     while (framesLeft > 0 && partIndex < WrappingBuffer::SIZE) {
@@ -87,8 +89,13 @@ int32_t AAudioMixer::mix(int streamIndex, std::shared_ptr<FifoBuffer> fifo, bool
             if (framesToMixFromPart > framesAvailableFromPart) {
                 framesToMixFromPart = framesAvailableFromPart;
             }
-            mixPart(destination, (float *)wrappingBuffer.data[partIndex],
-                    framesToMixFromPart);
+            if (pristine) {
+                copyPart(destination, (float *)wrappingBuffer.data[partIndex],
+                        framesToMixFromPart);
+            } else {
+                mixPart(destination, (float *)wrappingBuffer.data[partIndex],
+                        framesToMixFromPart);
+            }
 
             destination += framesToMixFromPart * mSamplesPerFrame;
             framesLeft -= framesToMixFromPart;
@@ -97,6 +104,14 @@ int32_t AAudioMixer::mix(int streamIndex, std::shared_ptr<FifoBuffer> fifo, bool
     }
     fifo->advanceReadIndex(framesDesired);
 
+    if (pristine) {
+        // Zero the part of the burst that this stream had no data for.
+        const int32_t framesMixed = framesDesired - framesLeft;
+        memset(destination, 0,
+                (mFramesPerBurst - framesMixed) * mSamplesPerFrame * sizeof(float));
+        mPristine = false;
+    }
+
 #if AAUDIO_MIXER_ATRACE_ENABLED
     ATRACE_END();
 #endif /* AAUDIO_MIXER_ATRACE_ENABLED */
@@ -112,6 +127,15 @@ void AAudioMixer::mixPart(float *destination, float *source, int32_t numFrames)
     }
 }
 
+void AAudioMixer::copyPart(float *destination, float *source, int32_t numFrames) {
+    memcpy(destination, source, numFrames * mSamplesPerFrame * sizeof(float));
+}
+
 float *AAudioMixer::getOutputBuffer() {
+    if (mPristine) {
+        // No stream was mixed since clear(), output silence.
+        memset(mOutputBuffer.get(), 0, mBufferSizeInBytes);
+        mPristine = false;
+    }
     return mOutputBuffer.get();
 }
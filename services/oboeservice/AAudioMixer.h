@@ -28,6 +28,12 @@ public:
 
     void allocate(int32_t samplesPerFrame, int32_t framesPerBurst);
 
+    /**
+     * Invalidate the output buffer before mixing the next burst.
+     * The actual clearing is deferred: the first stream mixed stores its data
+     * and zero-fills the rest of the burst, so the common one or two stream
+     * case never pays for a full memset plus an accumulate pass.
+     */
     void clear();
 
     /**
@@ -45,11 +51,13 @@ public:
 
 private:
     void mixPart(float *destination, float *source, int32_t numFrames);
+    void copyPart(float *destination, float *source, int32_t numFrames);
 
     std::unique_ptr<float[]> mOutputBuffer;
     int32_t  mSamplesPerFrame = 0;
     int32_t  mFramesPerBurst = 0;
     int32_t  mBufferSizeInBytes = 0;
+    bool     mPristine = true;   // true if no stream has been mixed since clear()
 };
 
 #endif //AAUDIO_AAUDIO_MIXER_H
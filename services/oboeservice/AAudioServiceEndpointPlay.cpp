@@ -121,6 +121,8 @@ void *AAudioServiceEndpointPlay::callbackLoop() {
                                                && framesMixed < mMixer.getFramesPerBurst();
                             if (underflowed) {
                                 streamShared->incrementXRunCount();
+                                streamShared->addUnderrunFrames(
+                                        mMixer.getFramesPerBurst() - framesMixed);
                             }
                         } else if (framesMixed > 0) {
                             // Mark beginning of data flow after a start.
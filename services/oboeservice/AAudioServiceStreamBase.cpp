@@ -425,27 +425,10 @@ void AAudioServiceStreamBase::run() {
             break;
         }
 
-        if (isRunning() && AudioClock::getNanoseconds() >= nextTime) {
-            // It is time to update timestamp.
-            if (sendCurrentTimestamp_l() != AAUDIO_OK) {
-                ALOGE("Failed to send current timestamp, stop updating timestamp");
-                disconnect_l();
-            } else {
-                nextTime = timestampScheduler.nextAbsoluteTime();
-            }
-        }
-        if (isIdle_l() && AudioClock::getNanoseconds() >= standbyTime) {
-            aaudio_result_t result = standby_l();
-            if (result != AAUDIO_OK) {
-                // If standby failed because of the function is not implemented, there is no
-                // need to retry. Otherwise, retry standby later.
-                ALOGW("Failed to enter standby, error=%d", result);
-                standbyTime = result == AAUDIO_ERROR_UNIMPLEMENTED
-                        ? std::numeric_limits<int64_t>::max()
-                        : AudioClock::getNanoseconds() + IDLE_TIMEOUT_NANOS;
-            }
-        }
-
+        // Handle any pending command before the periodic work. A client is blocked
+        // in binder waiting for the reply, and processing the periodic work first
+        // would delay a start or stop behind a timestamp update, or needlessly
+        // enter standby just before a START or EXIT_STANDBY takes us out of it.
         if (command != nullptr) {
             std::scoped_lock<std::mutex> _commandLock(command->lock);
             switch (command->operationCode) {
@@ -511,6 +494,27 @@ void AAudioServiceStreamBase::run() {
                 command->conditionVariable.notify_one();
             }
         }
+
+        if (isRunning() && AudioClock::getNanoseconds() >= nextTime) {
+            // It is time to update timestamp.
+            if (sendCurrentTimestamp_l() != AAUDIO_OK) {
+                ALOGE("Failed to send current timestamp, stop updating timestamp");
+                disconnect_l();
+            } else {
+                nextTime = timestampScheduler.nextAbsoluteTime();
+            }
+        }
+        if (isIdle_l() && AudioClock::getNanoseconds() >= standbyTime) {
+            aaudio_result_t result = standby_l();
+            if (result != AAUDIO_OK) {
+                // If standby failed because of the function is not implemented, there is no
+                // need to retry. Otherwise, retry standby later.
+                ALOGW("Failed to enter standby, error=%d", result);
+                standbyTime = result == AAUDIO_ERROR_UNIMPLEMENTED
+                        ? std::numeric_limits<int64_t>::max()
+                        : AudioClock::getNanoseconds() + IDLE_TIMEOUT_NANOS;
+            }
+        }
     }
     ALOGD("%s() %s exiting after %d loops <<<<<<<<<<<<<< COMMANDS",
           __func__, getTypeText(), loopCount);
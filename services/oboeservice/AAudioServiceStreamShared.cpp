@@ -42,13 +42,14 @@ using namespace aaudio;
 AAudioServiceStreamShared::AAudioServiceStreamShared(AAudioService &audioService)
     : AAudioServiceStreamBase(audioService)
     , mTimestampPositionOffset(0)
-    , mXRunCount(0) {
+    , mXRunCount(0)
+    , mUnderrunFrames(0) {
 }
 
 std::string AAudioServiceStreamShared::dumpHeader() {
     std::stringstream result;
     result << AAudioServiceStreamBase::dumpHeader();
-    result << "    Write#     Read#   Avail   XRuns";
+    result << "    Write#     Read#   Avail   XRuns  UndrFrms";
     return result.str();
 }
 
@@ -67,6 +68,7 @@ std::string AAudioServiceStreamShared::dump() const NO_THREAD_SAFETY_ANALYSIS {
 
     result << mAudioDataQueue->dump();
     result << std::setw(8) << getXRunCount();
+    result << std::setw(10) << getUnderrunFrames();
 
     if (isLocked) {
         audioDataQueueLock.unlock();
@@ -80,6 +80,17 @@ public:
         return mXRunCount.load();
     }
 
+    // Called by the endpoint mixer with the number of frames the client was
+    // short of a full burst, so dumpsys can show which client missed its
+    // deadline and by how much.
+    void addUnderrunFrames(int32_t numFrames) {
+        mUnderrunFrames += numFrames;
+    }
+
+    int64_t getUnderrunFrames() const {
+        return mUnderrunFrames.load();
+    }
+
     const char *getTypeText() const override { return "Shared"; }
 
     // This is public so that the thread safety annotation, GUARDED_BY(),
@@ -111,6 +122,7 @@ private:
 
     std::atomic<int64_t>     mTimestampPositionOffset;
     std::atomic<int32_t>     mXRunCount;
+    std::atomic<int64_t>     mUnderrunFrames;
 
 };
 
@@ -43,9 +43,10 @@ aaudio_result_t SharedRingBuffer::allocate(fifo_frames_t   bytesPerFrame,
                                          fifo_frames_t   capacityInFrames) {
     mCapacityInFrames = capacityInFrames;
 
-    // Create shared memory large enough to hold the data and the read and write counters.
+    // Create shared memory large enough to hold the data and the read and write counters,
+    // each on its own cache line.
     mDataMemorySizeInBytes = bytesPerFrame * capacityInFrames;
-    mSharedMemorySizeInBytes = mDataMemorySizeInBytes + (2 * (sizeof(fifo_counter_t)));
+    mSharedMemorySizeInBytes = mDataMemorySizeInBytes + SHARED_RINGBUFFER_DATA_OFFSET;
     mFileDescriptor.reset(ashmem_create_region("AAudioSharedRingBuffer", mSharedMemorySizeInBytes));
     if (mFileDescriptor.get() == -1) {
         ALOGE("allocate() ashmem_create_region() failed %d", errno);
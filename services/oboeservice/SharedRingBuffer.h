@@ -30,9 +30,14 @@
 namespace aaudio {
 
 // Determine the placement of the counters and data in shared memory.
+// Each counter gets its own cache line, and the data starts on another one,
+// so that the reader's and writer's counter updates do not ping-pong a line
+// that also holds the other side's counter or the first frames of data.
+// The offsets travel in the RingBufferParcelable so clients need no changes.
+#define SHARED_RINGBUFFER_CACHE_LINE    64
 #define SHARED_RINGBUFFER_READ_OFFSET   0
-#define SHARED_RINGBUFFER_WRITE_OFFSET  sizeof(fifo_counter_t)
-#define SHARED_RINGBUFFER_DATA_OFFSET   (SHARED_RINGBUFFER_WRITE_OFFSET + sizeof(fifo_counter_t))
+#define SHARED_RINGBUFFER_WRITE_OFFSET  SHARED_RINGBUFFER_CACHE_LINE
+#define SHARED_RINGBUFFER_DATA_OFFSET   (2 * SHARED_RINGBUFFER_CACHE_LINE)
 
 /**
  * Atomic FIFO that uses shared memory.